@@ -15,6 +15,7 @@ UIConfiguration::build_metadata ()
 	VAR_META (X_("blink-rec-arm"), _("appearance"), _("blink"), _("record"), _("rec"), _("enable"), _("rec-enable"), _("record-enable"),  NULL);
 	VAR_META (X_("boxy-buttons"), _("appearance"), _("style"), _("boxy"), _("buttons"), _("theme"),  NULL);
 	VAR_META (X_("buggy-gradients"), _("appearance"), _("bugs"), _("tweaks"), _("kwirks"),  NULL);
+	VAR_META (X_("cache-canvas-tiles"), _("canvas"), _("cache"), _("tiles"), _("render"), _("graphics"), _("performance"),  NULL);
 	VAR_META (X_("check-announcements"), _("check"), _("announcements"), _("phone"), _("home"),  NULL);
 	VAR_META (X_("clock-display-limit"), _("clock"), _("display"), _("limit"), _("length"), _("maximum"), _("duration"),  NULL);
 	VAR_META (X_("color-file"), _("theme"), _("colors"), _("appearance"), _("style"), _("themeing"),  NULL);
@@ -211,6 +212,7 @@ UIConfiguration::build_metadata ()
 	VAR_META (X_("plugin-path-lxvst"), _("plugins"), _("paths"), _("folders"), _("directory"), _("directories"), _("linux"), _("vst"), _("lxvst"), _("search"),  NULL);
 	VAR_META (X_("plugin-path-vst"), _("plugins"), _("paths"), _("folders"), _("directory"), _("directories"), _("vst"), _("search"),  NULL);
 	VAR_META (X_("plugin-path-vst3"), _("plugins"), _("paths"), _("folders"), _("directory"), _("directories"), _("vst3"), _("search"),  NULL);
+	VAR_META (X_("plugin-scan-jobs"), _("plugins"), _("scan"), _("parallel"), _("concurrent"), _("jobs"), _("processes"),  NULL);
 	VAR_META (X_("plugin-scan-timeout"), _("plugins"), _("scan"), _("timeout"), _("fail"), _("wait"),  NULL);
 	VAR_META (X_("plugins-stop-with-transport"), _("plugins"), _("stop"), _("transport"), _("tail"), _("reverb"), _("ringing"), _("reset"),  NULL);
 	VAR_META (X_("port-resampler-quality"), _("resampling"), _("audioengine"), _("global"), _("quality"), _("level"),  NULL);
@@ -24,6 +24,7 @@
 #include "ardour/session.h"
 #include "ardour/audioengine.h"
 #include "ardour/audio_backend.h"
+#include "ardour/rc_configuration.h"
 
 #include "widgets/tooltips.h"
 
@@ -40,6 +41,7 @@ using namespace Gtk;
 
 DspStatisticsGUI::DspStatisticsGUI ()
 	: buffer_size_label ("", ALIGN_END, ALIGN_CENTER)
+	, sleeping_routes_label ("", ALIGN_END, ALIGN_CENTER)
 	, reset_button (_("Reset"))
 {
 	const size_t nlabels = Session::NTT + AudioEngine::NTT + AudioBackend::NTT;
@@ -81,6 +83,10 @@ DspStatisticsGUI::DspStatisticsGUI ()
 	table.attach (*labels[AudioEngine::NTT + Session::OverallProcess], 2, 3, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
 	row++;
 
+	table.attach (*manage (new Gtk::Label (_("Sleeping routes: "), ALIGN_END, ALIGN_CENTER)), 0, 1, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	table.attach (sleeping_routes_label, 2, 3, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	row++;
+
 	HBox* hbox2 = manage (new HBox);
 	hbox2->pack_start (reset_button, true, true);
 
@@ -152,6 +158,14 @@ DspStatisticsGUI::update ()
 	snprintf (buf, sizeof (buf), "%d samples / %5.2f msecs", bufsize, bufsize_msecs);
 	buffer_size_label.set_text (buf);
 
+	if (_session && Config->get_sleep_silent_plugins ()) {
+		/* routes whose plugins were not processed in the most recent cycle */
+		snprintf (buf, sizeof (buf), "%u / %u", _session->n_sleeping_routes (), _session->nroutes ());
+		sleeping_routes_label.set_text (buf);
+	} else {
+		sleeping_routes_label.set_text (not_measured_string);
+	}
+
 	if (AudioEngine::instance()->current_backend()->dsp_stats[AudioBackend::DeviceWait].get_stats (min, max, avg, dev)) {
 
 		/* We show the min time here, since that's the worst case
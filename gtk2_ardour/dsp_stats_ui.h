@@ -44,6 +44,7 @@ private:
 
 	Gtk::Table table;
 	Gtk::Label buffer_size_label;
+	Gtk::Label sleeping_routes_label;
 	Gtk::Label** labels;
 	Gtk::Button reset_button;
 	Gtk::Label info_text;
@@ -468,6 +468,8 @@ Editor::Editor ()
 
 	edit_controls_vbox.set_spacing (0);
 	vertical_adjustment.signal_value_changed().connect (sigc::mem_fun(*this, &Editor::tie_vertical_scrolling), true);
+	vertical_adjustment.signal_value_changed().connect (sigc::mem_fun(*this, &Editor::queue_track_virtualization));
+	vertical_adjustment.signal_changed().connect (sigc::mem_fun(*this, &Editor::queue_track_virtualization));
 	_track_canvas->signal_map_event().connect (sigc::mem_fun (*this, &Editor::track_canvas_map_handler));
 
 	_group_tabs = new EditorGroupTabs (this);
@@ -4650,6 +4652,44 @@ Editor::queue_redisplay_track_views ()
 	}
 }
 
+void
+Editor::queue_track_virtualization ()
+{
+	if (!_track_virtualization_connection.connected ()) {
+		_track_virtualization_connection = Glib::signal_idle().connect (sigc::mem_fun (*this, &Editor::update_track_virtualization));
+	}
+}
+
+/** Replace the controls of tracks that are far outside the visible area
+ * by placeholders, and bring back those that were scrolled (close to) into view.
+ *
+ * The TimeAxisViews themselves (and their controls) are still created for
+ * every track, this only saves layout, drawing and meter updates.
+ */
+bool
+Editor::update_track_virtualization ()
+{
+	bool const enable = UIConfiguration::instance().get_virtualize_strips ();
+
+	/* keep a page above and below the visible area, so that
+	 * scrolling does not reveal placeholders.
+	 */
+	double const y0 = vertical_adjustment.get_value() - vertical_adjustment.get_page_size();
+	double const y1 = vertical_adjustment.get_value() + 2 * vertical_adjustment.get_page_size();
+
+	for (auto & tv : track_views) {
+		if (!enable) {
+			tv->set_virtualized (false);
+		} else if (tv->hidden ()) {
+			tv->set_virtualized (true);
+		} else {
+			tv->set_virtualized (tv->y_position () + tv->effective_height () < y0 || tv->y_position () > y1);
+		}
+	}
+
+	return false;
+}
+
 bool
 Editor::process_redisplay_track_views ()
 {
@@ -5024,6 +5064,8 @@ Editor::redisplay_track_views ()
 	reset_controls_layout_width ();
 	_full_canvas_height = position;
 
+	queue_track_virtualization ();
+
 	if ((vertical_adjustment.get_value() + _visible_canvas_height) > vertical_adjustment.get_upper()) {
 		/*
 		 * We're increasing the size of the canvas while the bottom is visible.
@@ -5261,7 +5303,7 @@ Editor::super_rapid_screen_update ()
 	if (!UIConfiguration::instance().get_no_strobe() && contents().get_mapped() && meters_running) {
 		RouteTimeAxisView* rtv;
 		for (TrackViewList::iterator i = track_views.begin(); i != track_views.end(); ++i) {
-			if ((rtv = dynamic_cast<RouteTimeAxisView*>(*i)) != 0) {
+			if ((rtv = dynamic_cast<RouteTimeAxisView*>(*i)) != 0 && !rtv->virtualized ()) {
 				rtv->fast_update ();
 			}
 		}
@@ -5419,6 +5461,7 @@ Editor::session_going_away ()
 	_session_connections.drop_connections ();
 
 	super_rapid_screen_update_connection.disconnect ();
+	_track_virtualization_connection.disconnect ();
 
 	selection->clear ();
 	cut_buffer->clear ();
@@ -5600,11 +5643,17 @@ Editor::ui_parameter_changed (string parameter)
 		}
 	} else if (parameter == "use-note-bars-for-velocity") {
 		ArdourCanvas::Note::set_show_velocity_bars (UIConfiguration::instance().get_use_note_bars_for_velocity());
+		/* notes are not individually invalidated, the cached tiles are stale */
+		_trackview_group->drop_tiles ();
 		_track_canvas->request_redraw (_track_canvas->visible_area());
 	} else if (parameter == "use-note-color-for-velocity") {
 		/* handled individually by each MidiRegionView */
 	} else if (parameter == "show-selection-marker") {
 		update_ruler_visibility ();
+	} else if (parameter == "cache-canvas-tiles") {
+		_trackview_group->set_cache_enabled (UIConfiguration::instance().get_cache_canvas_tiles());
+	} else if (parameter == "virtualize-strips") {
+		queue_track_virtualization ();
 	}
 }
 
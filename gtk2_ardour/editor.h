@@ -59,6 +59,7 @@
 #include "ardour/types.h"
 
 #include "canvas/fwd.h"
+#include "canvas/cached_container.h"
 #include "canvas/ruler.h"
 
 #include "widgets/ardour_button.h"
@@ -815,7 +816,7 @@ private:
 	ArdourCanvas::Container* no_scroll_group;
 
 	/* The group containing all trackviews. */
-	ArdourCanvas::Container* _trackview_group;
+	ArdourCanvas::CachedContainer* _trackview_group;
 
 	/* The group holding things (mostly regions) while dragging so they
 	 * are on top of everything else
@@ -1088,6 +1089,10 @@ private:
 	bool             _tvl_redisplay_on_resume;
 	sigc::connection _tvl_redisplay_connection;
 
+	sigc::connection _track_virtualization_connection;
+	void queue_track_virtualization ();
+	bool update_track_virtualization ();
+
 	sigc::connection super_rapid_screen_update_connection;
 	void center_screen_internal (samplepos_t, float);
 
@@ -133,7 +133,8 @@ Editor::initialize_canvas ()
 	time_line_group = new ArdourCanvas::Container (h_scroll_group);
 	CANVAS_DEBUG_NAME (time_line_group, "time line group");
 
-	_trackview_group = new ArdourCanvas::Container (hv_scroll_group);
+	_trackview_group = new ArdourCanvas::CachedContainer (hv_scroll_group);
+	_trackview_group->set_cache_enabled (UIConfiguration::instance().get_cache_canvas_tiles());
 	CANVAS_DEBUG_NAME (_trackview_group, "Canvas TrackViews");
 
 	// used as rubberband rect
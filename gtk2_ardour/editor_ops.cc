@@ -32,16 +32,19 @@
 
 #include <unistd.h>
 
+#include <atomic>
 #include <cstdlib>
 #include <cmath>
 #include <string>
 #include <map>
 #include <set>
 
+#include <glibmm/timer.h>
 #include <ytkmm/messagedialog.h>
 
 #include "pbd/error.h"
 #include "pbd/basename.h"
+#include "pbd/cpus.h"
 #include "pbd/pthread_utils.h"
 #include "pbd/memento_command.h"
 #include "pbd/stacktrace.h"
@@ -71,6 +74,7 @@
 #include "ardour/profile.h"
 #include "ardour/quantize.h"
 #include "ardour/legatize.h"
+#include "ardour/region_batch_edit.h"
 #include "ardour/region_factory.h"
 #include "ardour/reverse.h"
 #include "ardour/selection.h"
@@ -479,7 +483,7 @@ Editor::nudge_forward (bool next, bool force_playhead)
 
 	if (!force_playhead && !rs.empty()) {
 
-		begin_reversible_command (_("nudge regions forward"));
+		RegionBatchEdit edit;
 
 		for (RegionSelection::iterator i = rs.begin(); i != rs.end(); ++i) {
 			std::shared_ptr<Region> r ((*i)->region());
@@ -490,12 +494,15 @@ Editor::nudge_forward (bool next, bool force_playhead)
 				distance = next_distance;
 			}
 
-			r->clear_changes ();
+			edit.add (r);
 			r->set_position (r->position() + distance);
-			_session->add_command (new StatefulDiffCommand (r));
 		}
 
-		commit_reversible_command ();
+		if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+			begin_reversible_command (_("nudge regions forward"));
+			_session->add_command (cmd);
+			commit_reversible_command ();
+		}
 
 
 	} else if (!force_playhead && !selection->markers.empty()) {
@@ -602,7 +609,7 @@ Editor::nudge_backward (bool next, bool force_playhead)
 
 	if (!force_playhead && !rs.empty()) {
 
-		begin_reversible_command (_("nudge regions backward"));
+		RegionBatchEdit edit;
 
 		for (RegionSelection::iterator i = rs.begin(); i != rs.end(); ++i) {
 			std::shared_ptr<Region> r ((*i)->region());
@@ -613,17 +620,20 @@ Editor::nudge_backward (bool next, bool force_playhead)
 				distance = next_distance;
 			}
 
-			r->clear_changes ();
+			edit.add (r);
 
 			if (r->position() > distance) {
 				r->set_position (r->position().earlier (distance));
 			} else {
 				r->set_position (timepos_t());
 			}
-			_session->add_command (new StatefulDiffCommand (r));
 		}
 
-		commit_reversible_command ();
+		if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+			begin_reversible_command (_("nudge regions backward"));
+			_session->add_command (cmd);
+			commit_reversible_command ();
+		}
 
 	} else if (!force_playhead && !selection->markers.empty()) {
 
@@ -798,13 +808,11 @@ Editor::sequence_regions ()
 
 	if (!rs.empty()) {
 
-		bool in_command = false;
+		RegionBatchEdit edit;
 
 		for (RegionSelection::iterator i = rs.begin(); i != rs.end(); ++i) {
 			std::shared_ptr<Region> r ((*i)->region());
 
-			r->clear_changes();
-
 			if(r->locked())
 			{
 				continue;
@@ -813,24 +821,23 @@ Editor::sequence_regions ()
 			{
 				continue;
 			}
+
+			edit.add (r);
+
 			if(iCount>0)
 			{
 				r_end_prev=r_end;
 				r->set_position(r_end_prev);
 			}
 
-			if (!in_command) {
-				begin_reversible_command (_("sequence regions"));
-				in_command = true;
-			}
-			_session->add_command (new StatefulDiffCommand (r));
-
 			r_end=r->position() + r->length();
 
 			iCount++;
 		}
 
-		if (in_command) {
+		if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+			begin_reversible_command (_("sequence regions"));
+			_session->add_command (cmd);
 			commit_reversible_command ();
 		}
 	}
@@ -2881,13 +2888,16 @@ Editor::group_selected_regions ()
 	}
 
 	Region::RegionGroupRetainer rgr;
-	begin_reversible_command (_("group regions"));
+	RegionBatchEdit edit;
 	for (RegionSelection::iterator i = rs.begin (); i != rs.end (); ++i) {
-		(*i)->region ()->clear_changes ();
+		edit.add ((*i)->region ());
 		(*i)->region ()->set_region_group (Region::get_retained_group_id(), true);
-		_session->add_command (new StatefulDiffCommand ((*i)->region ()));
 	}
-	commit_reversible_command ();
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command (_("group regions"));
+		_session->add_command (cmd);
+		commit_reversible_command ();
+	}
 }
 
 void
@@ -2899,14 +2909,17 @@ Editor::ungroup_selected_regions ()
 		return;
 	}
 
-	begin_reversible_command (_("ungroup regions"));
+	RegionBatchEdit edit;
 	for (RegionSelection::iterator i = rs.begin (); i != rs.end (); ++i) {
-		(*i)->region ()->clear_changes ();
+		edit.add ((*i)->region ());
 		(*i)->region ()->unset_region_group (true);
-		_session->add_command (new StatefulDiffCommand ((*i)->region ()));
 	}
-	selection->clear_regions ();
-	commit_reversible_command ();
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command (_("ungroup regions"));
+		_session->add_command (cmd);
+		selection->clear_regions ();
+		commit_reversible_command ();
+	}
 }
 
 void
@@ -3532,16 +3545,18 @@ Editor::remove_region_sync ()
 		return;
 	}
 
-	begin_reversible_command (_("remove region sync"));
+	RegionBatchEdit edit;
 
 	for (RegionSelection::iterator i = rs.begin(); i != rs.end(); ++i) {
-
-		(*i)->region()->clear_changes ();
+		edit.add ((*i)->region());
 		(*i)->region()->clear_sync_position ();
-		_session->add_command(new StatefulDiffCommand ((*i)->region()));
 	}
 
-	commit_reversible_command ();
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command (_("remove region sync"));
+		_session->add_command (cmd);
+		commit_reversible_command ();
+	}
 }
 
 void
@@ -3553,18 +3568,26 @@ Editor::naturalize_region ()
 		return;
 	}
 
+	RegionBatchEdit edit;
+
+	for (RegionSelection::iterator i = rs.begin(); i != rs.end(); ++i) {
+		edit.add ((*i)->region());
+		(*i)->region()->move_to_natural_position ();
+	}
+
+	RegionBatchDiffCommand* cmd = edit.commit ();
+
+	if (!cmd) {
+		return;
+	}
+
 	if (rs.size() > 1) {
 		begin_reversible_command (_("move regions to original position"));
 	} else {
 		begin_reversible_command (_("move region to original position"));
 	}
 
-	for (RegionSelection::iterator i = rs.begin(); i != rs.end(); ++i) {
-		(*i)->region()->clear_changes ();
-		(*i)->region()->move_to_natural_position ();
-		_session->add_command (new StatefulDiffCommand ((*i)->region()));
-	}
-
+	_session->add_command (cmd);
 	commit_reversible_command ();
 }
 
@@ -3736,24 +3759,26 @@ Editor::trim_region (bool front)
 		return;
 	}
 
-	begin_reversible_command (front ? _("trim front") : _("trim back"));
+	RegionBatchEdit edit;
 
 	for (list<RegionView*>::const_iterator i = rs.by_layer().begin(); i != rs.by_layer().end(); ++i) {
 		if (!(*i)->region()->locked()) {
 
-			(*i)->region()->clear_changes ();
+			edit.add ((*i)->region());
 
 			if (front) {
 				(*i)->region()->trim_front (where);
 			} else {
 				(*i)->region()->trim_end (where);
 			}
-
-			_session->add_command (new StatefulDiffCommand ((*i)->region()));
 		}
 	}
 
-	commit_reversible_command ();
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command (front ? _("trim front") : _("trim back"));
+		_session->add_command (cmd);
+		commit_reversible_command ();
+	}
 }
 
 /** Trim the end of the selected regions to the position of the edit cursor */
@@ -5488,6 +5513,79 @@ Editor::tag_last_capture ()
 	tag_regions(rlist);
 }
 
+/** Analysis of a single region for normalization, run by a worker thread */
+class NormalizeAnalysis : public PBD::Progress
+{
+public:
+	NormalizeAnalysis (std::shared_ptr<AudioRegion> r)
+		: region (r)
+		, max_amp (0)
+		, rms (0)
+		, true_peak (0)
+		, lufs (-200)
+		, _progress (0)
+	{}
+
+	void run (bool use_rms, bool use_loudness)
+	{
+		/* every analysis reports progress from 0 to 1, give each its own part */
+		float const stage = 1.f / (1 + (use_rms ? 1 : 0) + (use_loudness ? 1 : 0));
+
+		descend (stage);
+		max_amp = region->maximum_amplitude (this);
+		ascend ();
+
+		if (use_rms && !cancelled ()) {
+			descend (stage);
+			rms = region->rms (this);
+			ascend ();
+		}
+
+		if (use_loudness && !cancelled ()) {
+			float integrated, max_short, max_momentary;
+			descend (stage);
+			region->loudness (true_peak, integrated, max_short, max_momentary, this);
+			ascend ();
+			lufs = integrated;
+			if (lufs == -200) {
+				lufs = max_short;
+			}
+			if (lufs == -200) {
+				lufs = max_momentary;
+			}
+		}
+
+		_progress = 1.f;
+	}
+
+	void cancel () { Progress::cancel (); }
+	float progress () const { return _progress; }
+
+	std::shared_ptr<AudioRegion> region;
+
+	double max_amp;
+	double rms;
+	float  true_peak;
+	float  lufs;
+
+private:
+	/* an analysis may restart (e.g. fall back to reading all samples),
+	 * do not let the progress bar go backwards.
+	 */
+	void set_overall_progress (float p) { _progress = std::max<float> (_progress, std::min (p, .99f)); }
+
+	std::atomic<float> _progress;
+};
+
+static void
+normalize_analysis_thread (std::vector<NormalizeAnalysis*>* jobs, std::atomic<size_t>* next, bool use_rms, bool use_loudness)
+{
+	size_t n;
+	while ((n = (*next)++) < jobs->size ()) {
+		(*jobs)[n]->run (use_rms, use_loudness);
+	}
+}
+
 void
 Editor::normalize_region ()
 {
@@ -5509,8 +5607,67 @@ Editor::normalize_region ()
 
 	CursorRAII cr (*this, _cursors->wait);
 
-	/* XXX: should really only count audio regions here */
-	int const regions = rs.size ();
+	bool use_rms  = dialog.constrain_rms ();
+	bool use_lufs = dialog.constrain_lufs ();
+	bool use_dbtp = dialog.use_true_peak ();
+
+	/* Analyze all selected audio regions in parallel */
+	std::vector<NormalizeAnalysis*> jobs;
+
+	for (RegionSelection::const_iterator i = rs.begin(); i != rs.end(); ++i) {
+		AudioRegionView const * arv = dynamic_cast<AudioRegionView const *> (*i);
+		if (arv) {
+			jobs.push_back (new NormalizeAnalysis (arv->audio_region ()));
+		}
+	}
+
+	std::atomic<size_t>       next (0);
+	std::vector<PBD::Thread*> threads;
+	uint32_t const            n_threads = std::min<size_t> (std::max<uint32_t> (1, hardware_concurrency ()), jobs.size ());
+
+	for (uint32_t n = 0; n < n_threads; ++n) {
+		PBD::Thread* t = PBD::Thread::create (std::bind (&normalize_analysis_thread, &jobs, &next, use_rms, use_dbtp || use_lufs), string_compose ("Normalize %1", n));
+		if (!t) {
+			break;
+		}
+		threads.push_back (t);
+	}
+
+	if (threads.empty ()) {
+		/* analyze in the GUI thread */
+		normalize_analysis_thread (&jobs, &next, use_rms, use_dbtp || use_lufs);
+	}
+
+	bool cancelled = false;
+
+	for (bool done = false; !done;) {
+		float progress = 0;
+		done = true;
+		for (std::vector<NormalizeAnalysis*>::const_iterator j = jobs.begin (); j != jobs.end (); ++j) {
+			float const p = (*j)->progress ();
+			progress += p;
+			done = done && p == 1.f;
+		}
+
+		dialog.set_progress (jobs.empty () ? 1.f : progress / jobs.size ());
+		ARDOUR::GUIIdle ();
+
+		if (dialog.cancelled () && !cancelled) {
+			cancelled = true;
+			for (std::vector<NormalizeAnalysis*>::const_iterator j = jobs.begin (); j != jobs.end (); ++j) {
+				(*j)->cancel ();
+			}
+		}
+
+		if (!done) {
+			Glib::usleep (20000);
+		}
+	}
+
+	for (std::vector<PBD::Thread*>::const_iterator t = threads.begin (); t != threads.end (); ++t) {
+		(*t)->join ();
+		delete *t;
+	}
 
 	/* Make a list of the selected audio regions' maximum amplitudes, and also
 	   obtain the maximum amplitude of them all.
@@ -5525,55 +5682,39 @@ Editor::normalize_region ()
 	double max_tp    = 0;
 	float max_lufs_i = -200;
 
-	bool use_rms  = dialog.constrain_rms ();
-	bool use_lufs = dialog.constrain_lufs ();
-	bool use_dbtp = dialog.use_true_peak ();
+	for (std::vector<NormalizeAnalysis*>::const_iterator j = jobs.begin (); j != jobs.end (); ++j) {
+		NormalizeAnalysis const* r = *j;
 
-	for (RegionSelection::const_iterator i = rs.begin(); i != rs.end(); ++i) {
-		AudioRegionView const * arv = dynamic_cast<AudioRegionView const *> (*i);
-		if (!arv) {
-			continue;
-		}
-		dialog.descend (1.0 / regions);
+		cancelled |= r->max_amp == -1 || r->rms == -1;
+
+		max_amps.push_back (r->max_amp);
+		max_amp = max (max_amp, r->max_amp);
 
-		double const a = arv->audio_region()->maximum_amplitude (&dialog);
 		if (use_rms) {
-			double r = arv->audio_region()->rms (&dialog);
-			max_rms = max (max_rms, r);
-			rms_vals.push_back (r);
+			max_rms = max (max_rms, r->rms);
+			rms_vals.push_back (r->rms);
 		}
 
-		if ((use_dbtp || use_lufs) && !dialog.cancelled ()) {
-			float true_peak, integrated, max_short, max_momentary;
-			arv->audio_region()->loudness (true_peak, integrated, max_short, max_momentary, &dialog);
-			float lufs = integrated;
-			if (lufs == -200) {
-				lufs = max_short;
-			}
-			if (lufs == -200) {
-				lufs = max_momentary;
-			}
-			max_tp     = max<double> (max_tp, true_peak);
-			max_lufs_i = max (max_lufs_i, lufs);
-			dbtp_vals.push_back (true_peak);
-			lufs_vals.push_back (lufs);
+		if (use_dbtp || use_lufs) {
+			max_tp     = max<double> (max_tp, r->true_peak);
+			max_lufs_i = max (max_lufs_i, r->lufs);
+			dbtp_vals.push_back (r->true_peak);
+			lufs_vals.push_back (r->lufs);
 		}
 
-		if (a == -1 || dialog.cancelled ()) {
-			/* the user cancelled the operation */
-			return;
-		}
+		delete r;
+	}
 
-		max_amps.push_back (a);
-		max_amp = max (max_amp, a);
-		dialog.ascend ();
+	if (cancelled) {
+		/* the user cancelled the operation */
+		return;
 	}
 
 	list<double>::const_iterator a = max_amps.begin ();
 	list<double>::const_iterator l = rms_vals.begin ();
 	list<float>::const_iterator  t = dbtp_vals.begin ();
 	list<float>::const_iterator  i = lufs_vals.begin ();
-	bool in_command = false;
+	RegionBatchEdit edit;
 
 	max_tp = max (max_tp, max_amp);
 
@@ -5583,7 +5724,7 @@ Editor::normalize_region ()
 			continue;
 		}
 
-		arv->region()->clear_changes ();
+		edit.add (arv->region());
 		double target = dialog.target_peak (); // dB
 
 		double amp;
@@ -5620,19 +5761,15 @@ Editor::normalize_region ()
 
 		arv->audio_region()->normalize (amp, target);
 
-		if (!in_command) {
-			begin_reversible_command (_("normalize"));
-			in_command = true;
-		}
-		_session->add_command (new StatefulDiffCommand (arv->region()));
-
 		++a;
 		++l;
 		++i;
 		++t;
 	}
 
-	if (in_command) {
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command (_("normalize"));
+		_session->add_command (cmd);
 		commit_reversible_command ();
 	}
 }
@@ -5646,13 +5783,7 @@ Editor::adjust_region_gain (bool up)
 		return;
 	}
 
-	bool in_command = false;
-	for (RegionSelection::iterator r = rs.begin(); r != rs.end(); ++r) {
-		AudioRegionView* const arv = dynamic_cast<AudioRegionView*>(*r);
-		if (arv) {
-			arv->region()->playlist()->freeze ();
-		}
-	}
+	RegionBatchEdit edit;
 
 	for (RegionSelection::iterator r = rs.begin(); r != rs.end(); ++r) {
 		AudioRegionView* const arv = dynamic_cast<AudioRegionView*>(*r);
@@ -5660,7 +5791,7 @@ Editor::adjust_region_gain (bool up)
 			continue;
 		}
 
-		arv->region()->clear_changes ();
+		edit.add (arv->region());
 
 		gain_t scale_amplitude = arv->audio_region()->scale_amplitude ();
 		double dB = accurate_coefficient_to_dB (fabsf (scale_amplitude));
@@ -5672,24 +5803,13 @@ Editor::adjust_region_gain (bool up)
 		}
 
 		arv->audio_region()->set_scale_amplitude (dB_to_coefficient (dB) * (scale_amplitude < 0 ? -1. : 1.));
-
-		if (!in_command) {
-				begin_reversible_command ("adjust region gain");
-				in_command = true;
-		}
-		_session->add_command (new StatefulDiffCommand (arv->region()));
 	}
 
-	if (in_command) {
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command ("adjust region gain");
+		_session->add_command (cmd);
 		commit_reversible_command ();
 	}
-
-	for (RegionSelection::iterator r = rs.begin(); r != rs.end(); ++r) {
-		AudioRegionView* const arv = dynamic_cast<AudioRegionView*>(*r);
-		if (arv) {
-			arv->region()->playlist()->thaw ();
-		}
-	}
 }
 
 void
@@ -5701,7 +5821,7 @@ Editor::reset_region_gain ()
 		return;
 	}
 
-	bool in_command = false;
+	RegionBatchEdit edit;
 
 	for (RegionSelection::iterator r = rs.begin(); r != rs.end(); ++r) {
 		AudioRegionView* const arv = dynamic_cast<AudioRegionView*>(*r);
@@ -5709,18 +5829,13 @@ Editor::reset_region_gain ()
 			continue;
 		}
 
-		arv->region()->clear_changes ();
-
+		edit.add (arv->region());
 		arv->audio_region()->set_scale_amplitude (1.0f);
-
-		if (!in_command) {
-				begin_reversible_command ("reset region gain");
-				in_command = true;
-		}
-		_session->add_command (new StatefulDiffCommand (arv->region()));
 	}
 
-	if (in_command) {
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command ("reset region gain");
+		_session->add_command (cmd);
 		commit_reversible_command ();
 	}
 }
@@ -6131,24 +6246,20 @@ Editor::toggle_region_polarity ()
 		return;
 	}
 
-	bool in_command = false;
+	RegionBatchEdit edit;
 
 	for (RegionSelection::iterator i = rs.begin(); i != rs.end(); ++i) {
 		AudioRegionView* const arv = dynamic_cast<AudioRegionView*>(*i);
 		if (arv) {
-			arv->region()->clear_changes ();
+			edit.add (arv->region());
 			gain_t scale_amplitude = arv->audio_region()->scale_amplitude ();
 			arv->audio_region()->set_scale_amplitude (-1 * scale_amplitude);
-
-			if (!in_command) {
-				begin_reversible_command (_("region polarity invert"));
-				in_command = true;
-			}
-			_session->add_command (new StatefulDiffCommand (arv->region()));
 		}
 	}
 
-	if (in_command) {
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command (_("region polarity invert"));
+		_session->add_command (cmd);
 		commit_reversible_command ();
 	}
 }
@@ -6166,23 +6277,19 @@ Editor::toggle_gain_envelope_active ()
 		return;
 	}
 
-	bool in_command = false;
+	RegionBatchEdit edit;
 
 	for (RegionSelection::iterator i = rs.begin(); i != rs.end(); ++i) {
 		AudioRegionView* const arv = dynamic_cast<AudioRegionView*>(*i);
 		if (arv) {
-			arv->region()->clear_changes ();
+			edit.add (arv->region());
 			arv->audio_region()->set_envelope_active (!arv->audio_region()->envelope_active());
-
-			if (!in_command) {
-				begin_reversible_command (_("region gain envelope active"));
-				in_command = true;
-			}
-			_session->add_command (new StatefulDiffCommand (arv->region()));
 		}
 	}
 
-	if (in_command) {
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command (_("region gain envelope active"));
+		_session->add_command (cmd);
 		commit_reversible_command ();
 	}
 }
@@ -6200,15 +6307,18 @@ Editor::region_lock ()
 		return;
 	}
 
-	begin_reversible_command (_("region lock"));
+	RegionBatchEdit edit;
 
 	for (RegionSelection::iterator i = rs.begin(); i != rs.end(); ++i) {
-		(*i)->region()->clear_changes ();
+		edit.add ((*i)->region());
 		(*i)->region()->set_locked (true);
-		_session->add_command (new StatefulDiffCommand ((*i)->region()));
 	}
 
-	commit_reversible_command ();
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command (_("region lock"));
+		_session->add_command (cmd);
+		commit_reversible_command ();
+	}
 }
 
 void
@@ -6224,15 +6334,18 @@ Editor::region_unlock ()
 		return;
 	}
 
-	begin_reversible_command (_("region unlock"));
+	RegionBatchEdit edit;
 
 	for (RegionSelection::iterator i = rs.begin(); i != rs.end(); ++i) {
-		(*i)->region()->clear_changes ();
+		edit.add ((*i)->region());
 		(*i)->region()->set_locked (false);
-		_session->add_command (new StatefulDiffCommand ((*i)->region()));
 	}
 
-	commit_reversible_command ();
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command (_("region unlock"));
+		_session->add_command (cmd);
+		commit_reversible_command ();
+	}
 }
 
 void
@@ -6248,15 +6361,18 @@ Editor::toggle_region_lock ()
 		return;
 	}
 
-	begin_reversible_command (_("toggle region lock"));
+	RegionBatchEdit edit;
 
 	for (RegionSelection::iterator i = rs.begin(); i != rs.end(); ++i) {
-		(*i)->region()->clear_changes ();
+		edit.add ((*i)->region());
 		(*i)->region()->set_locked (!(*i)->region()->locked());
-		_session->add_command (new StatefulDiffCommand ((*i)->region()));
 	}
 
-	commit_reversible_command ();
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command (_("toggle region lock"));
+		_session->add_command (cmd);
+		commit_reversible_command ();
+	}
 }
 
 void
@@ -6272,15 +6388,18 @@ Editor::toggle_region_video_lock ()
 		return;
 	}
 
-	begin_reversible_command (_("Toggle Video Lock"));
+	RegionBatchEdit edit;
 
 	for (RegionSelection::iterator i = rs.begin(); i != rs.end(); ++i) {
-		(*i)->region()->clear_changes ();
+		edit.add ((*i)->region());
 		(*i)->region()->set_video_locked (!(*i)->region()->video_locked());
-		_session->add_command (new StatefulDiffCommand ((*i)->region()));
 	}
 
-	commit_reversible_command ();
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command (_("Toggle Video Lock"));
+		_session->add_command (cmd);
+		commit_reversible_command ();
+	}
 }
 
 void
@@ -6296,15 +6415,18 @@ Editor::toggle_opaque_region ()
 		return;
 	}
 
-	begin_reversible_command (_("change region opacity"));
+	RegionBatchEdit edit;
 
 	for (RegionSelection::iterator i = rs.begin(); i != rs.end(); ++i) {
-		(*i)->region()->clear_changes ();
+		edit.add ((*i)->region());
 		(*i)->region()->set_opaque (!(*i)->region()->opaque());
-		_session->add_command (new StatefulDiffCommand ((*i)->region()));
 	}
 
-	commit_reversible_command ();
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command (_("change region opacity"));
+		_session->add_command (cmd);
+		commit_reversible_command ();
+	}
 }
 
 void
@@ -6614,7 +6736,7 @@ Editor::set_fade_in_active (bool yn)
 	if (rs.empty()) {
 		return;
 	}
-	bool in_command = false;
+	RegionBatchEdit edit;
 
 	for (RegionSelection::iterator x = rs.begin(); x != rs.end(); ++x) {
 		AudioRegionView* tmp = dynamic_cast<AudioRegionView*> (*x);
@@ -6626,17 +6748,13 @@ Editor::set_fade_in_active (bool yn)
 
 		std::shared_ptr<AudioRegion> ar (tmp->audio_region());
 
-		ar->clear_changes ();
+		edit.add (ar);
 		ar->set_fade_in_active (yn);
-
-		if (!in_command) {
-			begin_reversible_command (_("set fade in active"));
-			in_command = true;
-		}
-		_session->add_command (new StatefulDiffCommand (ar));
 	}
 
-	if (in_command) {
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command (_("set fade in active"));
+		_session->add_command (cmd);
 		commit_reversible_command ();
 	}
 }
@@ -6649,7 +6767,7 @@ Editor::set_fade_out_active (bool yn)
 	if (rs.empty()) {
 		return;
 	}
-	bool in_command = false;
+	RegionBatchEdit edit;
 
 	for (RegionSelection::iterator x = rs.begin(); x != rs.end(); ++x) {
 		AudioRegionView* tmp = dynamic_cast<AudioRegionView*> (*x);
@@ -6660,17 +6778,13 @@ Editor::set_fade_out_active (bool yn)
 
 		std::shared_ptr<AudioRegion> ar (tmp->audio_region());
 
-		ar->clear_changes ();
+		edit.add (ar);
 		ar->set_fade_out_active (yn);
-
-		if (!in_command) {
-			begin_reversible_command (_("set fade out active"));
-			in_command = true;
-		}
-		_session->add_command(new StatefulDiffCommand (ar));
 	}
 
-	if (in_command) {
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command (_("set fade out active"));
+		_session->add_command (cmd);
 		commit_reversible_command ();
 	}
 }
@@ -6708,13 +6822,13 @@ Editor::toggle_region_fades (int dir)
 	}
 
 	/* XXX should this undo-able? */
-	bool in_command = false;
+	RegionBatchEdit edit;
 
 	for (RegionSelection::iterator i = rs.begin(); i != rs.end(); ++i) {
 		if ((ar = std::dynamic_pointer_cast<AudioRegion>((*i)->region())) == 0) {
 			continue;
 		}
-		ar->clear_changes ();
+		edit.add (ar);
 
 		if (dir == 1 || dir == 0) {
 			ar->set_fade_in_active (!yn);
@@ -6723,14 +6837,11 @@ Editor::toggle_region_fades (int dir)
 		if (dir == -1 || dir == 0) {
 			ar->set_fade_out_active (!yn);
 		}
-		if (!in_command) {
-			begin_reversible_command (_("toggle fade active"));
-			in_command = true;
-		}
-		_session->add_command(new StatefulDiffCommand (ar));
 	}
 
-	if (in_command) {
+	if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+		begin_reversible_command (_("toggle fade active"));
+		_session->add_command (cmd);
 		commit_reversible_command ();
 	}
 }
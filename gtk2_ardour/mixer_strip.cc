@@ -171,6 +171,12 @@ MixerStrip::MixerStrip (Mixer_UI& mx, Session* sess, std::shared_ptr<Route> rt,
 	, control_slave_ui (sess)
 {
 	init ();
+
+	if (_mixer_owned && !rt->is_master () && UIConfiguration::instance().get_virtualize_strips ()) {
+		/* don't create processor entries until the strip is scrolled into view */
+		set_virtualized (true);
+	}
+
 	set_route (rt);
 
 	if (is_master () && !_route->comment().empty () && _session->config.get_show_master_bus_comment_on_load () && self_destruct) {
@@ -386,8 +392,12 @@ MixerStrip::init ()
 	set_selected (false);
 
 	_packed = false;
+	_virtualized = false;
 	_embedded = false;
 
+	_placeholder.set_name ("AudioBusStripBase");
+	_placeholder.show ();
+
 	number_label.signal_button_press_event().connect (sigc::mem_fun(*this, &MixerStrip::number_button_button_press), false);
 
 	name_button.set_fallthrough_to_parent (true);
@@ -855,6 +865,13 @@ MixerStrip::set_width_enum (Width w, void* owner)
 	setup_comment_button ();
 	route_group_changed ();
 	name_changed ();
+
+	if (_virtualized) {
+		int w, h;
+		get_size_request (w, h);
+		_placeholder.set_size_request (w, -1);
+	}
+
 	WidthChanged ();
 }
 
@@ -864,6 +881,33 @@ MixerStrip::set_packed (bool yn)
 	_packed = yn;
 }
 
+void
+MixerStrip::set_virtualized (bool yn)
+{
+	if (_virtualized == yn) {
+		return;
+	}
+
+	if (yn) {
+		/* get_width() is invalid for strips that were never realized */
+		int w, h;
+		get_size_request (w, h);
+		_placeholder.set_size_request (w, -1);
+	}
+
+	_virtualized = yn;
+	processor_box.set_virtualized (yn);
+}
+
+Gtk::Widget&
+MixerStrip::packed_widget ()
+{
+	if (_virtualized) {
+		return _placeholder;
+	}
+	return *this;
+}
+
 void
 MixerStrip::connect_to_pan ()
 {
@@ -939,6 +983,9 @@ MixerStrip::update_output_display ()
 void
 MixerStrip::fast_update ()
 {
+	if (_virtualized) {
+		return;
+	}
 	gpm.update_meters ();
 }
 
@@ -1126,6 +1173,20 @@ MixerStrip::build_route_ops_menu ()
 		denormal_menu_item->set_active (_route->denormal_protection());
 	}
 
+	if (active && plugin_insert_cnt > 1) {
+		Gtk::Menu* pipeline_menu = new Menu;
+		MenuList& pipeline_items = pipeline_menu->items();
+		RadioMenuItem::Group pipeline_group;
+		uint32_t const stages = _route->pipeline_stages () < 2 ? 0 : _route->pipeline_stages ();
+		for (uint32_t n = 0; n <= std::min<uint32_t> (4, plugin_insert_cnt); n = n ? n + 1 : 2) {
+			pipeline_items.push_back (RadioMenuElem (pipeline_group, n ? string_compose (_("%1 Stages"), n) : _("Off")));
+			Gtk::RadioMenuItem* i = dynamic_cast<Gtk::RadioMenuItem *> (&pipeline_items.back());
+			i->set_active (stages == n);
+			i->signal_activate().connect (sigc::bind (sigc::mem_fun (*_route, &Route::set_pipeline_stages), n));
+		}
+		items.push_back (MenuElem (_("Plugin Pipeline"), *pipeline_menu));
+	}
+
 	/* Disk I/O */
 
 	if (active && is_track()) {
@@ -164,6 +164,14 @@ protected:
 	void set_packed (bool yn);
 	bool packed () { return _packed; }
 
+	/* a virtualized strip is represented in the mixer by an empty
+	 * placeholder of the same width, see Mixer_UI::update_strip_virtualization.
+	 * The strip's widgets are kept, except for the processor entries.
+	 */
+	void set_virtualized (bool yn);
+	bool virtualized () const { return _virtualized; }
+	Gtk::Widget& packed_widget ();
+
 	void set_stuff_from_route ();
 
 private:
@@ -173,10 +181,13 @@ private:
 
 	bool  _embedded;
 	bool  _packed;
+	bool  _virtualized;
 	bool  _mixer_owned;
 	Width _width;
 	void*  _width_owner;
 
+	Gtk::EventBox _placeholder;
+
 	ArdourWidgets::ArdourButton hide_button;
 	ArdourWidgets::ArdourButton width_button;
 	ArdourWidgets::ArdourButton number_label;
@@ -206,6 +206,10 @@ Mixer_UI::Mixer_UI ()
 
 	scroller.add (strip_group_box);
 	scroller.set_policy (Gtk::POLICY_ALWAYS, Gtk::POLICY_AUTOMATIC);
+	scroller.get_hadjustment ()->signal_value_changed ().connect (sigc::mem_fun (*this, &Mixer_UI::queue_strip_virtualization));
+	scroller.get_hadjustment ()->signal_changed ().connect (sigc::mem_fun (*this, &Mixer_UI::queue_strip_virtualization));
+
+	UIConfiguration::instance().ParameterChanged.connect (sigc::mem_fun (*this, &Mixer_UI::ui_parameter_changed));
 
 	setup_track_display ();
 
@@ -449,6 +453,7 @@ Mixer_UI::Mixer_UI ()
 
 Mixer_UI::~Mixer_UI ()
 {
+	strip_virtualization_connection.disconnect ();
 	monitor_section_detached ();
 
 	delete _surround_strip;
@@ -1365,6 +1370,8 @@ Mixer_UI::session_going_away ()
 	_selection.clear ();
 	track_model->clear ();
 
+	strip_virtualization_connection.disconnect ();
+
 	for (list<MixerStrip *>::iterator i = strips.begin(); i != strips.end(); ++i) {
 		delete (*i);
 	}
@@ -1729,16 +1736,16 @@ Mixer_UI::spill_redisplay (std::shared_ptr<Stripable> s)
 		if (should_show) {
 
 			if (strip->packed()) {
-				strip_packer.reorder_child (*strip, -1); /* put at end */
+				strip_packer.reorder_child (strip->packed_widget (), -1); /* put at end */
 			} else {
-				strip_packer.pack_start (*strip, false, false);
+				strip_packer.pack_start (strip->packed_widget (), false, false);
 				strip->set_packed (true);
 			}
 
 		} else {
 
 			if (strip->packed()) {
-				strip_packer.remove (*strip);
+				strip_packer.remove (strip->packed_widget ());
 				strip->set_packed (false);
 			}
 		}
@@ -1752,6 +1759,8 @@ Mixer_UI::redisplay_track_list ()
 		return;
 	}
 
+	queue_strip_virtualization ();
+
 	std::shared_ptr<Stripable> ss = spilled_strip.lock ();
 	if (ss) {
 		std::shared_ptr<VCA> sv = std::dynamic_pointer_cast<VCA> (ss);
@@ -1813,9 +1822,9 @@ Mixer_UI::redisplay_track_list ()
 		if (visible) {
 
 			if (strip->packed()) {
-				strip_packer.reorder_child (*strip, -1); /* put at end */
+				strip_packer.reorder_child (strip->packed_widget (), -1); /* put at end */
 			} else {
-				strip_packer.pack_start (*strip, false, false);
+				strip_packer.pack_start (strip->packed_widget (), false, false);
 				strip->set_packed (true);
 			}
 
@@ -1825,7 +1834,7 @@ Mixer_UI::redisplay_track_list ()
 				/* do nothing, these cannot be hidden */
 			} else {
 				if (strip->packed()) {
-					strip_packer.remove (*strip);
+					strip_packer.remove (strip->packed_widget ());
 					strip->set_packed (false);
 				}
 			}
@@ -1869,6 +1878,96 @@ Mixer_UI::redisplay_track_list ()
 	}
 }
 
+void
+Mixer_UI::queue_strip_virtualization ()
+{
+	if (!strip_virtualization_connection.connected ()) {
+		strip_virtualization_connection = Glib::signal_idle().connect (sigc::mem_fun (*this, &Mixer_UI::update_strip_virtualization));
+	}
+}
+
+/** Replace strips that are far outside the visible part of the mixer by
+ * placeholders, and bring back strips that were scrolled (close to) into view.
+ *
+ * Note that a MixerStrip still exists for every route, placeholders only
+ * save layout, drawing, meters and the processor entries of hidden strips.
+ */
+bool
+Mixer_UI::update_strip_virtualization ()
+{
+	if (!scroller.get_hscrollbar()) {
+		return false;
+	}
+
+	bool const enable = UIConfiguration::instance().get_virtualize_strips ();
+
+	/* keep a page left and right of the visible area, so that
+	 * scrolling does not reveal placeholders.
+	 */
+	Adjustment* adj = scroller.get_hscrollbar()->get_adjustment();
+	double const x0 = adj->get_value() - adj->get_page_size();
+	double const x1 = adj->get_value() + 2 * adj->get_page_size();
+
+	for (list<MixerStrip*>::const_iterator i = strips.begin(); i != strips.end(); ++i) {
+		MixerStrip* strip = *i;
+
+		if (strip->route()->is_master()) {
+			/* packed in out_packer, always visible */
+			continue;
+		}
+
+		if (!enable) {
+			virtualize_strip (strip, false);
+			continue;
+		}
+
+		if (!strip->packed()) {
+			/* hidden strips are not displayed at all */
+			virtualize_strip (strip, true);
+			continue;
+		}
+
+		Gtk::Allocation const alloc = strip->packed_widget ().get_allocation ();
+
+		if (alloc.get_width () <= 1) {
+			/* not yet allocated, Mixer_UI is not mapped */
+			continue;
+		}
+
+		virtualize_strip (strip, alloc.get_x () + alloc.get_width () < x0 || alloc.get_x () > x1);
+	}
+
+	return false;
+}
+
+void
+Mixer_UI::virtualize_strip (MixerStrip* strip, bool yn)
+{
+	if (strip->virtualized () == yn) {
+		return;
+	}
+
+	if (!strip->packed()) {
+		strip->set_virtualized (yn);
+		return;
+	}
+
+	/* swap strip and placeholder at the same position */
+	int pos = 0;
+	using namespace Gtk::Box_Helpers;
+	const BoxList& children = strip_packer.children();
+	for (BoxList::const_iterator i = children.begin(); i != children.end(); ++i, ++pos) {
+		if (i->get_widget() == &strip->packed_widget ()) {
+			break;
+		}
+	}
+
+	strip_packer.remove (strip->packed_widget ());
+	strip->set_virtualized (yn);
+	strip_packer.pack_start (strip->packed_widget (), false, false);
+	strip_packer.reorder_child (strip->packed_widget (), pos);
+}
+
 void
 Mixer_UI::strip_width_changed ()
 {
@@ -2027,8 +2126,8 @@ Mixer_UI::move_stripable_into_view (std::shared_ptr<ARDOUR::Stripable> s)
 		if ((*i)->route() == s) {
 			int y;
 			found = true;
-			(*i)->translate_coordinates (strip_packer, 0, 0, x0, y);
-			alloc = (*i)->get_allocation ();
+			(*i)->packed_widget ().translate_coordinates (strip_packer, 0, 0, x0, y);
+			alloc = (*i)->packed_widget ().get_allocation ();
 			break;
 		}
 	}
@@ -2924,6 +3023,14 @@ Mixer_UI::parameter_changed (string const & p)
 	}
 }
 
+void
+Mixer_UI::ui_parameter_changed (string const & p)
+{
+	if (p == "virtualize-strips") {
+		queue_strip_virtualization ();
+	}
+}
+
 void
 Mixer_UI::set_route_group_activation (RouteGroup* g, bool a)
 {
@@ -4337,6 +4444,14 @@ Mixer_UI::screenshot (std::string const& filename)
 	bool with_vca = vca_vpacker.get_visible ();
 	MixerStrip* master = strip_by_route (_session->master_out ());
 
+	/* all strips are rendered, replace placeholders */
+	strip_virtualization_connection.disconnect ();
+	for (list<MixerStrip*>::const_iterator i = strips.begin(); i != strips.end(); ++i) {
+		if (!(*i)->route()->is_master()) {
+			virtualize_strip (*i, false);
+		}
+	}
+
 	Gtk::OffscreenWindow osw;
 	Gtk::HBox b;
 	osw.add (b);
@@ -4408,6 +4523,8 @@ Mixer_UI::screenshot (std::string const& filename)
 		master->hide_master_spacer (false);
 		out_packer.pack_start (*master, false, false);
 	}
+
+	queue_strip_virtualization ();
 	return true;
 }
 
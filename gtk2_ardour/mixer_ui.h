@@ -278,6 +278,11 @@ private:
 
 	void redisplay_track_list ();
 	void spill_redisplay (std::shared_ptr<ARDOUR::Stripable>);
+
+	sigc::connection strip_virtualization_connection;
+	void queue_strip_virtualization ();
+	bool update_strip_virtualization ();
+	void virtualize_strip (MixerStrip*, bool);
 	bool no_track_list_redisplay;
 	bool track_display_button_press (GdkEventButton*);
 	void strip_width_changed ();
@@ -420,6 +425,7 @@ private:
 	bool ignore_plugin_reorder;
 
 	void parameter_changed (std::string const &);
+	void ui_parameter_changed (std::string const &);
 	void set_route_group_activation (ARDOUR::RouteGroup *, bool);
 
 	void setup_track_display ();
@@ -19,6 +19,7 @@
 #include "gtkmm2ext/utils.h"
 
 #include "ardour/audioengine.h"
+#include "ardour/plugin_insert.h"
 
 #include "plugin_dspload_ui.h"
 #include "timers.h"
@@ -34,6 +35,7 @@ PluginLoadStatsGui::PluginLoadStatsGui (std::shared_ptr<ARDOUR::PlugInsertBase>
 	, _lbl_max ("", ALIGN_END, ALIGN_CENTER)
 	, _lbl_avg ("", ALIGN_END, ALIGN_CENTER)
 	, _lbl_dev ("", ALIGN_END, ALIGN_CENTER)
+	, _lbl_inst ("", ALIGN_START, ALIGN_CENTER)
 	, _reset_button (_("Reset"))
 	, _valid (false)
 {
@@ -63,6 +65,14 @@ PluginLoadStatsGui::PluginLoadStatsGui (std::shared_ptr<ARDOUR::PlugInsertBase>
 	attach (_darea, 3, 4, 0, 4, Gtk::FILL|Gtk::EXPAND, Gtk::FILL, 4, 4);
 
 	attach (_reset_button, 4, 5, 2, 4, Gtk::FILL, Gtk::SHRINK);
+
+	std::shared_ptr<ARDOUR::PluginInsert> pi = std::dynamic_pointer_cast<ARDOUR::PluginInsert> (_pib);
+	if (pi && pi->get_count () > 1) {
+		/* replicated plugin, see also RCConfiguration::get_parallel_plugin_instances */
+		attach (*manage (new Gtk::Label (_("Instances"), ALIGN_END, ALIGN_CENTER)),
+				0, 1, 4, 5, Gtk::FILL, Gtk::SHRINK, 2, 0);
+		attach (_lbl_inst, 1, 4, 4, 5, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	}
 }
 
 void
@@ -95,6 +105,15 @@ PluginLoadStatsGui::update_cpu_label()
 		_lbl_avg.set_text ("-");
 		_lbl_dev.set_text ("-");
 	}
+
+	double inst_avg, parallel;
+	std::shared_ptr<ARDOUR::PluginInsert> pi = std::dynamic_pointer_cast<ARDOUR::PluginInsert> (_pib);
+	if (pi && pi->get_instance_stats (inst_avg, parallel)) {
+		_lbl_inst.set_text (string_compose (_("%1 [ms] CPU time, processed in parallel: %2%%"), rint (inst_avg) / 1000., rint (parallel * 100.)));
+	} else {
+		_lbl_inst.set_text ("-");
+	}
+
 	_darea.queue_draw ();
 }
 
@@ -54,6 +54,7 @@ private:
 	Gtk::Label _lbl_max;
 	Gtk::Label _lbl_avg;
 	Gtk::Label _lbl_dev;
+	Gtk::Label _lbl_inst;
 
 	ArdourWidgets::ArdourButton _reset_button;
 	Gtk::DrawingArea _darea;
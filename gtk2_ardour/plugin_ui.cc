@@ -51,6 +51,7 @@
 #include "ardour/lv2_plugin.h"
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/region_fx_plugin.h"
 #include "ardour/session.h"
 #include "lv2_plugin_ui.h"
@@ -712,7 +713,8 @@ PlugUIBase::add_common_widgets (Gtk::HBox* b, bool with_focus)
 		b->pack_end (_pin_management_button, false, false);
 		b->pack_start (_latency_button, false, false, 4);
 	}
-	else if (std::dynamic_pointer_cast<ARDOUR::RegionFxPlugin> (_pib)) {
+	/* the tail-time of plugin inserts only matters for sleeping plugins */
+	if (std::dynamic_pointer_cast<ARDOUR::RegionFxPlugin> (_pib) || (_pi && Config->get_sleep_silent_plugins ())) {
 		b->pack_start (_tailtime_button, false, false, 4);
 	}
 }
@@ -732,12 +734,13 @@ void
 
 PlugUIBase::set_tailtime_label ()
 {
-	auto rfx = std::dynamic_pointer_cast<ARDOUR::RegionFxPlugin> (_pib); /* may be NULL */
-	if (!rfx) {
+	auto tt = std::dynamic_pointer_cast<ARDOUR::TailTime> (_pib); /* may be NULL */
+	auto so = std::dynamic_pointer_cast<ARDOUR::SessionObject> (_pib);
+	if (!tt || !so) {
 		return;
 	}
-	samplecnt_t const l  = rfx->effective_tailtime ();
-	float const       sr = rfx->session ().sample_rate ();
+	samplecnt_t const l  = tt->effective_tailtime ();
+	float const       sr = so->session ().sample_rate ();
 
 	_tailtime_button.set_text (samples_as_time_string (l, sr, true));
 }
@@ -767,10 +770,11 @@ PlugUIBase::latency_button_clicked ()
 void
 PlugUIBase::tailtime_button_clicked ()
 {
-	auto rfx = std::dynamic_pointer_cast<ARDOUR::RegionFxPlugin> (_pib); /* may be NULL */
-	assert (rfx);
+	auto tt = std::dynamic_pointer_cast<ARDOUR::TailTime> (_pib);
+	auto so = std::dynamic_pointer_cast<ARDOUR::SessionObject> (_pib);
+	assert (tt && so);
 	if (!tailtime_gui) {
-		tailtime_gui    = new TimeCtlGUI (*dynamic_cast<TailTime*>(rfx.get()), rfx->session ().sample_rate (), rfx->session ().get_block_size ());
+		tailtime_gui    = new TimeCtlGUI (*tt, so->session ().sample_rate (), so->session ().get_block_size ());
 		tailtime_dialog = new ArdourWindow (_("Edit Tail Time"));
 		/* use both keep-above and transient for to try cover as many
 		   different WM's as possible.
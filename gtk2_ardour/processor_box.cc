@@ -1963,6 +1963,7 @@ ProcessorBox::ProcessorBox (ARDOUR::Session* sess, std::function<PluginSelector*
 	_width = Wide;
 	processor_menu = 0;
 	no_processor_redisplay = false;
+	_virtualized = false;
 
 	processor_scroller.set_policy (Gtk::POLICY_NEVER, Gtk::POLICY_AUTOMATIC);
 	processor_scroller.set_name ("ProcessorScroller");
@@ -2039,6 +2040,20 @@ ProcessorBox::set_route (std::shared_ptr<Route> r)
 	redisplay_processors ();
 }
 
+void
+ProcessorBox::set_virtualized (bool yn)
+{
+	if (_virtualized == yn) {
+		return;
+	}
+
+	_virtualized = yn;
+
+	if (_route) {
+		redisplay_processors ();
+	}
+}
+
 void
 ProcessorBox::route_going_away ()
 {
@@ -3053,7 +3068,9 @@ ProcessorBox::redisplay_processors ()
 
 	processor_display.clear ();
 
-	_route->foreach_processor (sigc::mem_fun (*this, &ProcessorBox::add_processor_to_display));
+	if (!_virtualized) {
+		_route->foreach_processor (sigc::mem_fun (*this, &ProcessorBox::add_processor_to_display));
+	}
 	_route->foreach_processor (sigc::mem_fun (*this, &ProcessorBox::maybe_add_processor_to_ui_list));
 	_route->foreach_processor (sigc::mem_fun (*this, &ProcessorBox::maybe_add_processor_pin_mgr));
 
@@ -448,6 +448,9 @@ public:
 
 	void hide_things ();
 
+	/* drop processor entries while the parent strip is not displayed */
+	void set_virtualized (bool);
+
 	bool edit_aux_send (std::shared_ptr<ARDOUR::Processor>);
 
 	/* Everything except a WindowProxy object should use this to get the window */
@@ -546,6 +549,7 @@ private:
 	bool use_plugins (const SelectedPlugins&);
 
 	bool no_processor_redisplay;
+	bool _virtualized;
 
 	bool enter_notify (GdkEventCrossing *ev);
 	bool leave_notify (GdkEventCrossing *ev);
@@ -2618,6 +2618,16 @@ RCOptionEditor::RCOptionEditor ()
 	Gtkmm2ext::UI::instance()->set_tip (strobe->tip_widget(), _("If enabled, disables meters in editor &amp; mixer, running clock updates and most blinking."));
 	add_option (_("Appearance"), strobe);
 
+	BoolOption* vstrips = new BoolOption (
+		"virtualize-strips",
+		_("Detach mixer strips and track headers that are off screen"),
+		sigc::mem_fun (UIConfiguration::instance(), &UIConfiguration::get_virtualize_strips),
+		sigc::mem_fun (UIConfiguration::instance(), &UIConfiguration::set_virtualize_strips)
+		);
+
+	Gtkmm2ext::UI::instance()->set_tip (vstrips->tip_widget(), _("If enabled, mixer strips and editor track headers that are scrolled far out of view are replaced by empty placeholders. They are neither drawn nor metered, and mixer strips drop their plugin entries. This speeds up scrolling and redraws in sessions with many tracks. Strips are still created for every track, so it does not reduce session load time."));
+	add_option (_("Appearance"), vstrips);
+
 	add_option (_("Appearance/Recorder"), new OptionEditorHeading (_("Input Meter Layout")));
 
 	ComboOption<InputMeterLayout>* iml = new ComboOption<InputMeterLayout> (
@@ -2716,6 +2726,16 @@ RCOptionEditor::RCOptionEditor ()
 	gap->add (4, _("Large"));
 	add_option (_("Appearance/Editor"), gap);
 
+	BoolOption* cct = new BoolOption (
+		"cache-canvas-tiles",
+		_("Cache rendered tracks in the editor"),
+		sigc::mem_fun (UIConfiguration::instance(), &UIConfiguration::get_cache_canvas_tiles),
+		sigc::mem_fun (UIConfiguration::instance(), &UIConfiguration::set_cache_canvas_tiles)
+		);
+
+	Gtkmm2ext::UI::instance()->set_tip (cct->tip_widget(), _("Keep the rendered regions, waveforms and automation of the editor in image tiles, which are only re-rendered when their content changes.\nThis speeds up scrolling and playhead-follow in large sessions, at the cost of additional memory."));
+	add_option (_("Appearance/Editor"), cct);
+
 	add_option (_("Appearance/Editor"), new OptionEditorHeading (_("Editor Meters")));
 
 	add_option (_("Appearance/Editor"),
@@ -3993,6 +4013,21 @@ These settings will only take effect after %1 is restarted.\n\
 				sigc::mem_fun (*this, &RCOptionEditor::plugin_scan_refresh)));
 
 	add_option (_("Plugins"), new PluginScanTimeOutSliderOption (_rc_config));
+
+#if (defined WINDOWS_VST_SUPPORT || defined LXVST_SUPPORT || defined MACVST_SUPPORT || defined VST3_SUPPORT)
+	{
+		SpinOption<uint32_t>* so = new SpinOption<uint32_t> (
+			"plugin-scan-jobs",
+			_("Concurrent plugin scanners"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_plugin_scan_jobs),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_plugin_scan_jobs),
+			0, 32, 1, 4
+			);
+		add_option (_("Plugins"), so);
+		Gtkmm2ext::UI::instance()->set_tip (so->tip_widget(),
+				_("Number of VST plugins that are scanned at the same time, each in a separate process.\n\n0: automatic, depending on the number of CPU cores."));
+	}
+#endif
 #endif
 
 	add_option (_("Plugins"), new OptionEditorHeading (_("General")));
@@ -4060,6 +4095,67 @@ These settings will only take effect after %1 is restarted.\n\
 	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
 					    _("<b>When enabled</b> sidechain ports are created for plugins at instantiation time if a plugin has sidechain inputs. Note that the ports themselves will have to be manually connected, so while the plugin pins are connected they are initially fed with silence.\n<b>When disabled</b> sidechain input pins will remain unconnected."));
 
+	{
+		SpinOption<uint32_t>* so = new SpinOption<uint32_t> (
+			"region-fx-render-cache-size",
+			_("Disk space for rendered Region FX (MiB)"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_region_fx_render_cache_size),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_region_fx_render_cache_size),
+			0, 1048576, 256, 1024
+			);
+		add_option (_("Plugins"), so);
+		Gtkmm2ext::UI::instance()->set_tip (so->tip_widget(),
+				_("Region FX of regions that have not been modified for a few seconds are rendered in the background, and playback uses the rendered audio instead of running the plugins. This limits the disk space used by the rendered files, the least recently played renders are discarded first.\n\n0: always run Region FX plugins during playback."));
+	}
+
+	{
+		SpinOption<uint32_t>* so = new SpinOption<uint32_t> (
+			"lua-dsp-gc-budget",
+			_("Lua DSP garbage-collection budget (microseconds per cycle)"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_lua_dsp_gc_budget),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_lua_dsp_gc_budget),
+			0, 1000, 10, 100
+			);
+		add_option (_("Plugins"), so);
+		Gtkmm2ext::UI::instance()->set_tip (so->tip_widget(),
+				_("Limit the time each Lua DSP script spends collecting garbage in the realtime thread. Collection cycles that do not complete in time are continued in the following cycles.\n\n0: perform a single incremental collection step per cycle, memory allocation by the script may trigger additional collection."));
+	}
+
+	{
+		BoolOption* bo = new BoolOption (
+			"parallel-plugin-instances",
+			_("Process replicated plugin instances in parallel"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_parallel_plugin_instances),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_parallel_plugin_instances)
+			);
+		add_option (_("Plugins"), bo);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+				_("When a plugin is replicated for each channel of a track or bus, run the instances concurrently on additional realtime threads."));
+
+		SpinOption<uint32_t>* so = new SpinOption<uint32_t> (
+			"parallel-plugin-threshold",
+			_("Minimum cost of parallel plugin instances (microseconds per cycle)"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_parallel_plugin_threshold),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_parallel_plugin_threshold),
+			0, 10000, 10, 100
+			);
+		add_option (_("Plugins"), so);
+		Gtkmm2ext::UI::instance()->set_tip (so->tip_widget(),
+				_("Replicated plugins whose instances together use less CPU time per cycle are processed serially, since dispatching them to other threads would cost more than it saves."));
+	}
+
+	{
+		BoolOption* bo = new BoolOption (
+			"sleep-silent-plugins",
+			_("Do not process plugins with silent input"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_sleep_silent_plugins),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_sleep_silent_plugins)
+			);
+		add_option (_("Plugins"), bo);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+				_("When the input of a plugin has been silent for longer than the plugin's latency and tail-time, skip processing the plugin until data arrives again.\n\nThis saves CPU time for idle tracks and busses, but plugins that generate sound without input (e.g. test tone generators) will fall silent."));
+	}
+
 	add_option (_("Plugins/GUI"), new OptionEditorHeading (_("Plugin GUI")));
 	add_option (_("Plugins/GUI"),
 	     new BoolOption (
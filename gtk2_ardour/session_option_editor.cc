@@ -408,6 +408,18 @@ SessionOptionEditor::SessionOptionEditor (Session* s)
 	tdo->add (Temporal::BeatTime, _("Musical (beats) time"));
 	add_option (_("Misc"), tdo);
 
+	bo = new BoolOption (
+		"binary-automation-events",
+		_("Save large automation lists as binary data"),
+		sigc::mem_fun (*_session_config, &SessionConfiguration::get_binary_automation_events),
+		sigc::mem_fun (*_session_config, &SessionConfiguration::set_binary_automation_events)
+		);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+	                                    _("When enabled, automation lanes with many points are saved in the session's automation folder instead of as text in the session file. "
+	                                      "This makes loading and saving sessions with dense automation considerably faster.\n\n"
+	                                      "Templates and archives always use text."));
+	add_option (_("Misc"), bo);
+
 #if 0
 	/* We cannot expose this option until it is possible (and sane) to
 	 * allow MIDI tracks to use audio time and audio tracks to use music time.
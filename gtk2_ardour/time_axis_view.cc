@@ -113,6 +113,7 @@ TimeAxisView::TimeAxisView (ARDOUR::Session* sess, PublicEditor& ed, TimeAxisVie
 	, _editor (ed)
 	, control_parent (0)
 	, _order (0)
+	, _virtualized (false)
 	, _effective_height (0)
 	, _resize_drag_start (-1)
 	, _did_resize (false)
@@ -217,6 +218,8 @@ TimeAxisView::TimeAxisView (ARDOUR::Session* sess, PublicEditor& ed, TimeAxisVie
 	controls_ebox.signal_leave_notify_event().connect (sigc::mem_fun (*this, &TimeAxisView::controls_ebox_leave));
 	controls_ebox.show ();
 
+	_controls_placeholder.show ();
+
 	time_axis_frame.set_shadow_type (Gtk::SHADOW_NONE);
 	time_axis_frame.add(top_hbox);
 	time_axis_frame.show();
@@ -285,7 +288,7 @@ TimeAxisView::hide ()
 	_canvas_separator->hide ();
 
 	if (control_parent) {
-		control_parent->remove (TOP_LEVEL_WIDGET);
+		control_parent->remove (controls_widget ());
 		control_parent = 0;
 	}
 
@@ -318,11 +321,11 @@ guint32
 TimeAxisView::show_at (double y, int& nth, VBox *parent)
 {
 	if (control_parent) {
-		control_parent->reorder_child (TOP_LEVEL_WIDGET, nth);
+		control_parent->reorder_child (controls_widget (), nth);
 	} else {
 		control_parent = parent;
-		parent->pack_start (TOP_LEVEL_WIDGET, false, false);
-		parent->reorder_child (TOP_LEVEL_WIDGET, nth);
+		parent->pack_start (controls_widget (), false, false);
+		parent->reorder_child (controls_widget (), nth);
 	}
 
 	_order = nth;
@@ -363,6 +366,43 @@ TimeAxisView::show_at (double y, int& nth, VBox *parent)
 	return _effective_height;
 }
 
+Gtk::Widget&
+TimeAxisView::controls_widget ()
+{
+	if (_virtualized) {
+		return _controls_placeholder;
+	}
+	return TOP_LEVEL_WIDGET;
+}
+
+void
+TimeAxisView::set_virtualized (bool yn)
+{
+	if (_virtualized == yn) {
+		return;
+	}
+
+	if (!control_parent) {
+		_virtualized = yn;
+		return;
+	}
+
+	/* swap controls and placeholder at the same position */
+	int pos = 0;
+	using namespace Gtk::Box_Helpers;
+	const BoxList& children = control_parent->children ();
+	for (BoxList::const_iterator i = children.begin (); i != children.end (); ++i, ++pos) {
+		if (i->get_widget () == &controls_widget ()) {
+			break;
+		}
+	}
+
+	control_parent->remove (controls_widget ());
+	_virtualized = yn;
+	control_parent->pack_start (controls_widget (), false, false);
+	control_parent->reorder_child (controls_widget (), pos);
+}
+
 bool
 TimeAxisView::controls_ebox_scroll (GdkEventScroll* ev)
 {
@@ -657,6 +697,7 @@ TimeAxisView::set_height (uint32_t h, TrackHeightMode m, bool from_idle)
 	}
 
 	TOP_LEVEL_WIDGET.property_height_request () = h;
+	_controls_placeholder.property_height_request () = h;
 	height = h;
 
 	set_gui_property ("height", height);
@@ -141,6 +141,13 @@ public:
 	/** @return true if hidden, otherwise false */
 	bool hidden () const { return _hidden; }
 
+	/** Replace the controls by an empty placeholder of the same height,
+	 * used for tracks that are scrolled far out of view. The controls
+	 * are kept (not destroyed), they are only unparented.
+	 */
+	void set_virtualized (bool);
+	bool virtualized () const { return _virtualized; }
+
 	void set_selected (bool);
 
 	virtual bool selectable() const { return true; }
@@ -313,6 +320,10 @@ protected:
 private:
 	Gtk::VBox*            control_parent;
 	int                  _order;
+	bool                 _virtualized;
+	Gtk::EventBox        _controls_placeholder;
+
+	Gtk::Widget& controls_widget ();
 	uint32_t             _effective_height;
 	double               _resize_drag_start;
 	bool                 _did_resize;
@@ -110,6 +110,7 @@ UI_CONFIG_VARIABLE (double, waveform_clip_level, "waveform-clip-level", -0.09339
 UI_CONFIG_VARIABLE (bool, no_new_session_dialog, "no-new-session-dialog", false)
 UI_CONFIG_VARIABLE (bool, buggy_gradients, "buggy-gradients", false)
 UI_CONFIG_VARIABLE (bool, cairo_image_surface, "cairo-image-surface", false)
+UI_CONFIG_VARIABLE (bool, cache_canvas_tiles, "cache-canvas-tiles", false)
 UI_CONFIG_VARIABLE (ARDOUR::AppleNSGLViewMode, nsgl_view_mode, "nsgl-view-mode", NSGLHiRes)
 UI_CONFIG_VARIABLE (uint64_t, waveform_cache_size, "waveform-cache-size", 100) /* units of megagbytes */
 UI_CONFIG_VARIABLE (int32_t, recent_session_sort, "recent-session-sort", 0)
@@ -165,3 +166,4 @@ UI_CONFIG_VARIABLE (uint32_t, insert_at_position, "insert-at-position", 3)
 UI_CONFIG_VARIABLE (Editing::NoteNameDisplay, note_name_display, "note-name-display", Editing::Always)
 UI_CONFIG_VARIABLE (bool, scroll_velocity_editing, "scroll-velocity-editing", true)
 UI_CONFIG_VARIABLE (bool, no_strobe, "no-strobe", false)
+UI_CONFIG_VARIABLE (bool, virtualize_strips, "virtualize-strips", false)
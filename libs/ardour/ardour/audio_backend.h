@@ -25,6 +25,7 @@
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <pthread.h>
 
 
 #include "ardour/audioengine.h"
@@ -791,6 +792,30 @@ public:
 	 */
 	virtual int join_process_threads () = 0;
 
+	/** Create a thread that runs part of the buffer process cycle on
+	 * behalf of a process thread (e.g. the stage of a pipelined route),
+	 * with the same realtime scheduling as process threads.
+	 *
+	 * Unlike threads created by create_process_thread(), this is
+	 * not counted by process_thread_count() and not joined by
+	 * join_process_threads(). The caller must use join_worker_thread()
+	 * once \p func returned.
+	 *
+	 * The default implementation is suitable for backends which create
+	 * process threads with PBD_RT_PRI_PROC.
+	 *
+	 * @param func process function to run
+	 * @param thread set to the created thread
+	 * @return zero on success, non-zero if no realtime thread could be created
+	 */
+	virtual int create_worker_thread (std::function<void()> func, pthread_t* thread);
+
+	/** Wait for a thread created by create_worker_thread() to exit.
+	 *
+	 * Return zero on success, non-zero on failure.
+	 */
+	virtual int join_worker_thread (pthread_t thread);
+
 	/** Return true if execution context is in a backend thread */
 	virtual bool in_process_thread () = 0;
 
@@ -39,6 +39,12 @@ public:
 
 	void cycle_start (pframes_t);
 	void cycle_end (pframes_t);
+
+	/** Start a cycle without reading (and resampling) data from the backend.
+	 * Instead use the data that @p source read in its ::cycle_start().
+	 * The source must be connected to the same external port(s) as this port.
+	 */
+	void cycle_start_shared (pframes_t, AudioPort const* source);
 	void cycle_split ();
 
 	void flush_buffers (pframes_t nframes);
@@ -66,6 +72,8 @@ private:
 	ArdourZita::VMResampler _src;
 	Sample*                 _data;
 	bool                    _buf_valid;
+	AudioPort const*        _shared_input; ///< port that resamples our input this cycle, if any
+	bool                    _src_stale;    ///< _src did not process the previous cycle(s)
 };
 
 } // namespace ARDOUR
@@ -36,8 +36,10 @@
 
 #include <glibmm/threads.h>
 
+#include "pbd/microseconds.h"
 #include "pbd/signals.h"
 #include "pbd/pthread_utils.h"
+#include "pbd/ringbuffer.h"
 
 #include "ardour/ardour.h"
 #include "ardour/data_type.h"
@@ -106,6 +108,8 @@ class LIBARDOUR_API AudioEngine : public PortManager, public SessionHandlePtr
 
 	int            create_process_thread (std::function<void()> func);
 	int            join_process_threads ();
+	int            create_worker_thread (std::function<void()> func, pthread_t* thread);
+	int            join_worker_thread (pthread_t thread);
 	bool           in_process_thread ();
 	uint32_t       process_thread_count ();
 
@@ -256,6 +260,12 @@ class LIBARDOUR_API AudioEngine : public PortManager, public SessionHandlePtr
 
 	PBD::TimingStats dsp_stats[NTT];
 
+	/** If set, the duration of every process callback (in microseconds)
+	 * is written to the given buffer, e.g. for benchmarks. The caller
+	 * has to read the buffer regularly, and unset it before it is deleted.
+	 */
+	void set_cycle_time_log (PBD::RingBuffer<PBD::microseconds_t>* rb) { _cycle_time_log.store (rb); }
+
   private:
 	AudioEngine ();
 
@@ -309,6 +319,8 @@ class LIBARDOUR_API AudioEngine : public PortManager, public SessionHandlePtr
 	std::atomic<int>         _pending_playback_latency_callback;
 	std::atomic<int>         _pending_capture_latency_callback;
 
+	std::atomic<PBD::RingBuffer<PBD::microseconds_t>*> _cycle_time_log;
+
 	void start_hw_event_processing();
 	void stop_hw_event_processing();
 	void do_reset_backend();
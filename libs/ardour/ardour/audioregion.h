@@ -39,6 +39,11 @@
 
 class XMLNode;
 class AudioRegionReadTest;
+class RegionFxRenderTest;
+
+namespace PBD {
+	class EventLoop;
+}
 class PlaylistReadTest;
 
 namespace ARDOUR {
@@ -62,6 +67,7 @@ class Playlist;
 class Session;
 class Filter;
 class AudioSource;
+class AudioFileSource;
 class RegionFxPlugin;
 class PlugInsertBase;
 
@@ -95,6 +101,11 @@ class LIBARDOUR_API AudioRegion : public Region, public AudioReadable
 	 */
 	double rms (PBD::Progress* p = 0) const;
 
+	/** Compute true-peak, integrated, max short-term and max momentary
+	 *  loudness of the region. Regions with up to 5 channels use the
+	 *  cached per-block statistics of the sources.
+	 *  @return false if the analysis failed or was cancelled.
+	 */
 	bool loudness (float& tp, float& i, float& s, float& m, PBD::Progress* p = 0) const;
 
 	bool envelope_active () const { return _envelope_active; }
@@ -172,6 +183,39 @@ class LIBARDOUR_API AudioRegion : public Region, public AudioReadable
 
 	timecnt_t tail () const;
 
+	/* Region FX render cache, see RegionFxRenderer */
+
+	/** @return true if playback uses a render of the region FX
+	 * that is up to date.
+	 */
+	bool fx_render_valid () const;
+	/** @return disk space used by the render of the region FX, in bytes */
+	size_t fx_render_bytes () const;
+	/** @return time (g_get_monotonic_time) of the last change that affects the region FX output */
+	int64_t fx_changed_at () const { return _fx_changed_at.load (); }
+	/** @return time (g_get_monotonic_time) the render of the region FX was last read */
+	int64_t fx_render_used () const { return _fx_render_used.load (); }
+	/** @return counter that is incremented with every change that affects the region FX output */
+	uint64_t fx_generation () const { return _fx_generation.load (); }
+
+	/** Create the copy of this region (with its own plugin instances)
+	 * that is processed by render_fx (). This must be called from the
+	 * GUI thread, the plugins are also destroyed in that thread.
+	 */
+	void prepare_fx_render ();
+	/** @return true if prepare_fx_render () was called since the last change */
+	bool fx_render_prepared () const;
+
+	/** Process the copy made by prepare_fx_render (), and write the
+	 * result into hidden, unannounced sources that are used for playback
+	 * instead of running the FX until the next change.
+	 * This is not realtime safe.
+	 * @param abort is polled while rendering
+	 * @return true if the render was installed
+	 */
+	bool render_fx (std::atomic<bool> const& abort);
+	void drop_fx_render ();
+
 	/* automation */
 
 	std::shared_ptr<Evoral::Control>
@@ -216,9 +260,11 @@ class LIBARDOUR_API AudioRegion : public Region, public AudioReadable
 
   private:
 	friend class ::AudioRegionReadTest;
+	friend class ::RegionFxRenderTest;
 	friend class ::PlaylistReadTest;
 
 	void build_transients ();
+	bool loudness_analysis (float& tp, float& i, float& s, float& m, PBD::Progress* p) const;
 
 	PBD::Property<bool>     _envelope_active;
 	PBD::Property<bool>     _default_fade_in;
@@ -267,6 +313,8 @@ class LIBARDOUR_API AudioRegion : public Region, public AudioReadable
 	void fx_latency_changed (bool no_emit);
 	void fx_tail_changed (bool no_emit);
 	void copy_plugin_state (std::shared_ptr<const AudioRegion>);
+	void fx_render_invalidate ();
+	bool render_fx (std::shared_ptr<AudioRegion>, uint64_t, bool, std::atomic<bool> const&);
 
 	mutable samplepos_t _fx_pos;
 	pframes_t           _fx_block_size;
@@ -279,6 +327,21 @@ class LIBARDOUR_API AudioRegion : public Region, public AudioReadable
 	mutable samplecnt_t          _cache_tail;
 	mutable std::atomic<bool>    _invalidated;
 
+	/* render of the region FX, protected by _cache_lock */
+	std::vector<std::shared_ptr<AudioFileSource> > _fx_render;
+	uint64_t                     _fx_render_generation;
+	bool                         _fx_render_fades;
+	size_t                       _fx_render_bytes;
+	bool                         _fx_render_clone;
+
+	std::shared_ptr<AudioRegion> _fx_render_prep;            ///< copy to render, see prepare_fx_render
+	uint64_t                     _fx_render_prep_generation; ///< UINT64_MAX: none
+	PBD::EventLoop*              _fx_render_prep_loop;       ///< thread that created _fx_render_prep
+
+	std::atomic<uint64_t>        _fx_generation;
+	std::atomic<int64_t>         _fx_changed_at;
+	mutable std::atomic<int64_t> _fx_render_used;
+
   protected:
 	/* default constructor for derived (compound) types */
 
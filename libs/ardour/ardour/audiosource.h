@@ -23,6 +23,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <time.h>
 
@@ -34,6 +35,10 @@
 #include "pbd/stateful.h"
 #include "pbd/xml++.h"
 
+namespace PBD {
+	class Progress;
+}
+
 namespace ARDOUR {
 
 class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioReadable
@@ -62,6 +67,37 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	int read_peaks (PeakData *peaks, samplecnt_t npeaks,
 			samplepos_t start, samplecnt_t cnt, double samples_per_visual_peak) const;
 
+	/** Compute the maximum absolute sample value of the given range from
+	 *  the peakfile, reading raw data only for partial peaks at the edges.
+	 *  @param peak is updated if a larger value is found.
+	 *  @return false if the peakfile cannot be used, e.g. it has not
+	 *  been built yet, or the range is too short.
+	 */
+	bool peak_amplitude (samplepos_t start, samplecnt_t cnt, double& peak) const;
+
+	/** Signal statistics of a 100ms block of the source. */
+	struct LIBARDOUR_API BlockStats {
+		double sumsq;     ///< sum of squared samples
+		float  kpower;    ///< sum of squared K-weighted samples (ITU-R BS.1770)
+		float  true_peak; ///< max oversampled absolute sample value
+	};
+
+	typedef std::vector<BlockStats> BlockStatsList;
+
+	samplecnt_t block_stats_size () const;
+
+	/** Analyze the source in blocks of block_stats_size() samples.
+	 *  The result is cached, and saved in the session's analysis folder.
+	 *  @return the statistics or an empty pointer if the analysis failed
+	 *  or was cancelled.
+	 */
+	std::shared_ptr<BlockStatsList const> block_stats (PBD::Progress* p = 0) const;
+
+	/** Drop cached block statistics, and remove the file. This is done
+	 *  whenever the peakfile is removed.
+	 */
+	void remove_block_stats ();
+
 	int  build_peaks ();
 	bool peaks_ready (std::function<void()> callWhenReady, PBD::ScopedConnection** connection_created_if_not_ready, PBD::EventLoop* event_loop) const;
 
@@ -112,6 +148,7 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	std::string         _peakpath;
 
 	int initialize_peakfile (const std::string& path, const bool in_session = false);
+	std::string get_block_stats_path () const;
 	int build_peaks_from_scratch ();
 	int compute_and_write_peaks (Sample const * buf, samplecnt_t first_sample, samplecnt_t cnt,
 	bool force, bool intermediate_peaks_ready_signal);
@@ -153,6 +190,13 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	mutable off_t _last_map_off;
 	mutable size_t  _last_raw_map_length;
 	mutable std::unique_ptr<PeakData[]> peak_cache;
+
+	int load_block_stats (BlockStatsList&) const;
+	int save_block_stats (BlockStatsList const&) const;
+
+	mutable Glib::Threads::Mutex                  _block_stats_lock;
+	mutable std::shared_ptr<BlockStatsList const> _block_stats;
+	mutable samplecnt_t                           _block_stats_length;
 };
 
 }
@@ -0,0 +1,122 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <glib.h>
+#include <glibmm/threads.h>
+
+#include "temporal/timeline.h"
+
+#include "evoral/ControlList.h"
+
+#include "ardour/libardour_visibility.h"
+
+namespace ARDOUR
+{
+
+/** Binary storage of automation events in the session folder.
+ *
+ * Large automation lists are saved as a "blob" file of fixed size
+ * (time, value) records instead of formatting every event as text in
+ * the session file. The XML only references the blob by name.
+ * Blobs are named after a checksum of their content, so they are never
+ * modified once written: snapshots can share them, and unmodified lists
+ * are not written again.
+ *
+ * Blobs are memory-mapped when loading.
+ *
+ * AutomationList uses the store that is in scope in the calling thread
+ * (see Scope), and saves text otherwise, e.g. for undo history,
+ * templates or archives.
+ */
+class LIBARDOUR_API AutomationEventStore
+{
+public:
+	AutomationEventStore (std::string const& dir);
+
+	std::string const& dir () const { return _dir; }
+
+	/** Write events to a blob.
+	 * @return name of the blob, empty if the events could not be stored
+	 */
+	std::string write (Evoral::ControlList::EventList const&, Temporal::TimeDomain) const;
+
+	/** A memory-mapped blob */
+	class LIBARDOUR_API Mapping
+	{
+	public:
+		~Mapping ();
+
+		size_t               n_events () const { return _n_events; }
+		Temporal::TimeDomain time_domain () const { return _time_domain; }
+		Temporal::timepos_t  when (size_t) const;
+		double               value (size_t) const;
+
+	private:
+		friend class AutomationEventStore;
+		Mapping (GMappedFile*);
+
+		GMappedFile*         _file;
+		char const*          _events;
+		size_t               _n_events;
+		Temporal::TimeDomain _time_domain;
+	};
+
+	/** Map a blob, return a null pointer if it is missing or invalid */
+	std::shared_ptr<Mapping> map (std::string const& blob) const;
+
+	/** path of the blob with the given name */
+	std::string blob_path (std::string const& blob) const;
+
+	/** Remove blobs that are not referenced by any of the given session
+	 * files (snapshots, backups, pending state). Nothing is removed if
+	 * one of the files cannot be read.
+	 * @return number of removed blobs
+	 */
+	size_t remove_unreferenced (std::vector<std::string> const& state_files) const;
+
+	/** lists with fewer events are stored as text */
+	static const size_t min_events = 1024;
+
+	/** Make a store available to AutomationList state in this thread */
+	class LIBARDOUR_API Scope
+	{
+	public:
+		Scope (AutomationEventStore*);
+		~Scope ();
+
+	private:
+		AutomationEventStore* _old;
+	};
+
+	/** store in scope in the calling thread, if any */
+	static AutomationEventStore* thread_store ();
+
+private:
+	std::string _dir;
+
+	static bool referenced_blobs (std::string const& state_file, std::set<std::string>&);
+
+	static Glib::Threads::Private<AutomationEventStore> _thread_store;
+};
+
+} // namespace ARDOUR
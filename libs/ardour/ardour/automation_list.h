@@ -127,6 +127,7 @@ public:
 private:
 	void create_curve_if_necessary ();
 	int deserialize_events (const XMLNode&);
+	int deserialize_blob (std::string const&);
 
 	XMLNode& state (bool save_auto_state, bool need_lock) const;
 	XMLNode& serialize_events (bool need_lock) const;
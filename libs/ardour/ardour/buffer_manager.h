@@ -41,9 +41,21 @@ public:
 
 	static void ensure_buffers (ChanCount howmany = ChanCount::ZERO, size_t custom = 0);
 
+	/** Account for \p n threads that keep thread-buffers for their lifetime
+	 * (in addition to those budgeted by init), the pool is grown as needed.
+	 * Must be called with the process lock held.
+	 */
+	static void reserve_thread_buffers (uint32_t n);
+	static void release_thread_buffers (uint32_t n);
+
 private:
 	static Glib::Threads::Mutex rb_mutex;
 
+	static ChanCount _howmany;
+	static size_t    _custom;
+	static uint32_t  _n_reserved;
+	static uint32_t  _n_added;
+
 	typedef PBD::RingBufferNPT<ThreadBuffers*> ThreadBufferFIFO;
 	typedef std::list<ThreadBuffers*> ThreadBufferList;
 
@@ -32,6 +32,7 @@
 #include "pbd/pool.h"
 #include "pbd/ringbuffer.h"
 #include "pbd/mpmc_queue.h"
+#include "pbd/timing.h"
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/session_handle.h"
@@ -83,6 +84,9 @@ public:
 
 	mutable std::atomic<int> should_do_transport_work;
 
+	/** duration of track refill passes */
+	PBD::TimingStats refill_stats;
+
 private:
 	struct Request {
 		enum Type {
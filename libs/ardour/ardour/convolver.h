@@ -18,8 +18,13 @@
 #ifndef _ardour_convolver_h_
 #define _ardour_convolver_h_
 
+#include <atomic>
+#include <memory>
+#include <string>
 #include <vector>
 
+#include <glibmm/threads.h>
+
 #include "zita-convolver/zita-convolver.h"
 
 #include "ardour/libardour_visibility.h"
@@ -29,13 +34,17 @@
 #include "ardour/readable.h"
 #include "ardour/session_handle.h"
 
+namespace PBD {
+	class Thread;
+}
+
 namespace ARDOUR { namespace DSP {
 
 class LIBARDOUR_API Convolution : public SessionHandleRef
 {
 public:
 	Convolution (Session&, uint32_t n_in, uint32_t n_out);
-	virtual ~Convolution () {}
+	virtual ~Convolution ();
 
 	bool add_impdata (
 	    uint32_t                    c_in,
@@ -54,19 +63,54 @@ public:
 
 	void clear_impdata ();
 	void restart ();
+
+	/** Load the current impulse-response data in the background.
+	 *
+	 * Processing continues with the previous impulse-response until
+	 * the new one is ready, which is then swapped in at the next
+	 * partition boundary. Partition sizes and latency are retained.
+	 */
+	void reload ();
+
+	/** Use explicit non-uniform partitioning.
+	 *
+	 * Partitions of \p head_size samples are processed in the calling
+	 * process thread, larger partitions up to \p tail_size samples
+	 * are processed by low-priority worker threads that are shared by
+	 * all convolvers. The latency is \p head_size.
+	 * This is not enabled by default, set both to 0 to return to
+	 * the default partitioning. Takes effect on restart ().
+	 */
+	void set_partitioning (uint32_t head_size, uint32_t tail_size);
+
 	void run (BufferSet&, ChanMapping const&, ChanMapping const&, pframes_t, samplecnt_t);
 
 	void run_mono_buffered (float*, uint32_t);
 	void run_mono_no_latency (float*, uint32_t);
 
 protected:
-	ArdourZita::Convproc _convproc;
+	/** swap in an impulse-response that was loaded by reload (),
+	 * called by the process thread with _proc_lock held.
+	 */
+	void swap_pending ()
+	{
+		if (_offset == 0 && _pending.load (std::memory_order_relaxed)) {
+			swap_pending_convproc ();
+		}
+	}
+
+	ArdourZita::Convproc* _convproc;
+
+	/** held by the process thread (try-lock) while processing,
+	 * and by restart () while the processor is replaced.
+	 */
+	Glib::Threads::Mutex _proc_lock;
 
-	uint32_t _n_samples;
-	uint32_t _max_size;
-	uint32_t _offset;
-	bool     _configured;
-	bool     _threaded;
+	uint32_t    _n_samples;
+	uint32_t    _offset;
+	bool        _configured;
+	bool        _threaded;
+	std::string _ir_key; ///< identical keys share impulse-response data, empty: no sharing
 
 private:
 	class ImpData : public AudioReadable
@@ -115,9 +159,37 @@ private:
 		uint32_t       _channel;
 	};
 
+	/** A processor and the objects it depends on */
+	struct ConvprocRef {
+		ConvprocRef () : proc (0) {}
+		~ConvprocRef ();
+
+		ArdourZita::Convproc*                  proc;
+		std::shared_ptr<ArdourZita::Convproc>  master; ///< impulse-response data referenced by proc
+		std::shared_ptr<ArdourZita::Convsched> sched;  ///< tail partition scheduler used by proc
+	};
+
+	void swap_pending_convproc ();
+	void load_async (std::vector<ImpData>);
+	void drop_pending ();
+
+	ConvprocRef* create_convproc (std::vector<ImpData> const&) const;
+
+	static int load_impdata (ArdourZita::Convproc&, std::vector<ImpData> const&, uint32_t max_size);
+
 	std::vector<ImpData> _impdata;
 	uint32_t             _n_inputs;
 	uint32_t             _n_outputs;
+
+	uint32_t _head_size;
+	uint32_t _tail_size;
+	uint32_t _max_part;
+
+	ConvprocRef*              _active;  ///< in use by the process thread, provides _convproc
+	std::atomic<ConvprocRef*> _pending; ///< published by load_async (), picked up by the process thread
+	std::atomic<ConvprocRef*> _retired; ///< published by the process thread only, freed by drop_pending () only
+
+	PBD::Thread* _loader;
 };
 
 class LIBARDOUR_API Convolver : public Convolution
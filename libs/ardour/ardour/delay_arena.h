@@ -0,0 +1,85 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include <glibmm/threads.h>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+/** Session-wide memory pool for latency compensation delay buffers.
+ *
+ * Delay-line ring-buffers are power-of-two sized and most delay-lines of
+ * a session use the same size. Buffers are carved from large contiguous
+ * slabs and recycled per size, instead of each DelayLine allocating and
+ * freeing its own buffers whenever the latency changes.
+ *
+ * Slabs are first touched by the thread that creates them, and only
+ * released when the arena is destroyed.
+ *
+ * alloc() and free() must not be called from a realtime thread.
+ */
+class LIBARDOUR_API DelayArena
+{
+public:
+	DelayArena (size_t slab_samples = 1 << 20);
+	~DelayArena ();
+
+	/** Allocate a zeroed buffer.
+	 * @param n_samples buffer size, must be a power of two
+	 */
+	Sample* alloc (samplecnt_t n_samples);
+
+	/** Return a buffer that was allocated with the same size */
+	void free (Sample*, samplecnt_t n_samples);
+
+	/** total memory reserved by the arena, in bytes */
+	size_t reserved_bytes () const;
+	/** memory currently handed out to delay-lines, in bytes */
+	size_t used_bytes () const;
+	/** number of buffers currently handed out to delay-lines */
+	size_t n_buffers () const;
+
+private:
+	DelayArena (DelayArena const&) = delete;
+	DelayArena& operator= (DelayArena const&) = delete;
+
+	struct Slab {
+		Slab (Sample* d, size_t s) : data (d), size (s), used (0) {}
+		Sample* data;
+		size_t  size;
+		size_t  used;
+	};
+
+	typedef std::map<samplecnt_t, std::vector<Sample*> > FreeList;
+
+	mutable Glib::Threads::Mutex _lock;
+
+	std::vector<Slab> _slabs;
+	FreeList          _free;
+	size_t            _slab_samples;
+	size_t            _reserved;
+	size_t            _used;
+	size_t            _n_buffers;
+};
+
+} // namespace ARDOUR
@@ -27,6 +27,7 @@ namespace ARDOUR {
 
 class BufferSet;
 class ChanCount;
+class DelayArena;
 class Session;
 
 /** Meters peaks on the input and stores them for access.
@@ -65,10 +66,12 @@ private:
 	sampleoffset_t _roff, _woff;
 	bool           _pending_flush;
 
-	typedef std::vector<std::shared_ptr<Sample[]>>   AudioDlyBuf;
+	typedef std::vector<Sample*>                     AudioDlyBuf;
 	typedef std::vector<std::shared_ptr<MidiBuffer>> MidiDlyBuf;
 
-	AudioDlyBuf _buf;
+	std::shared_ptr<DelayArena> _arena;
+
+	AudioDlyBuf _buf; // allocated from _arena, _bsiz samples each
 	MidiDlyBuf  _midi_buf;
 
 #ifndef NDEBUG
@@ -21,6 +21,8 @@
 #ifndef __IEC2PPMDSP_H
 #define __IEC2PPMDSP_H
 
+#include <stdint.h>
+
 #include "ardour/libardour_visibility.h"
 
 class LIBARDOUR_API Iec2ppmdsp
@@ -32,6 +34,9 @@ public:
 
     void process (float const *p, int n);
     float read (void);
+
+    /* process multiple channels at once, one meter per channel */
+    static void process (Iec2ppmdsp* const* m, float const* const* p, uint32_t n_chn, int n);
     void reset ();
 
     static void init (float fsamp);
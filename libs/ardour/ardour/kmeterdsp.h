@@ -21,6 +21,8 @@
 #ifndef __KMETERDSP_H
 #define __KMETERDSP_H
 
+#include <stdint.h>
+
 #include "ardour/libardour_visibility.h"
 
 class LIBARDOUR_API Kmeterdsp
@@ -32,12 +34,17 @@ public:
 
     void process (float const *p, int n);
     float read ();
+
+    /* process multiple channels at once, one meter per channel */
+    static void process (Kmeterdsp* const* m, float const* const* p, uint32_t n_chn, int n);
     void reset ();
 
     static void init (int fsamp);
 
 private:
 
+    void update (float z1, float z2);
+
     float          _z1;          // filter state
     float          _z2;          // filter state
     float          _rms;         // max rms value since last read()
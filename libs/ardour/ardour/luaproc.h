@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <set>
 #include <vector>
 #include <string>
@@ -144,6 +145,20 @@ private:
 public:
 	void set_origin (std::string& path) { _origin = path; }
 
+	/** Garbage-collection statistics of the Lua interpreter */
+	struct GCStats {
+		uint64_t cycles;    ///< number of process cycles
+		int64_t  avg_us;    ///< average time spent in the GC per process cycle
+		int64_t  max_us;    ///< longest time spent in the GC during a process cycle
+		uint64_t spread;    ///< GC cycles that exceeded the budget and were continued in later process cycles
+		size_t   mem_used;  ///< memory currently used by the interpreter, in bytes
+		size_t   mem_peak;  ///< peak memory used by the interpreter, in bytes
+		size_t   pool_size; ///< size of the memory pool, 0 if the system allocator is used
+	};
+
+	GCStats gc_stats () const;
+	void    reset_gc_stats ();
+
 protected:
 	const std::string& script() const { return _script; }
 	const std::string& origin() const { return _origin; }
@@ -175,6 +190,8 @@ private:
 
 	void init ();
 	bool load_script ();
+
+	void run_gc ();
 	void lua_print (std::string s);
 
 	bool load_user_preset (PresetRecord const&);
@@ -210,6 +227,19 @@ private:
 	bool _has_midi_output;
 
 
+	/* process thread only */
+	bool   _gc_stopped;  // automatic collector is stopped
+	bool   _gc_paused;   // the last GC cycle completed
+	bool   _gc_spread;   // the current GC cycle exceeded the budget
+	size_t _gc_estimate; // memory in use after the last completed GC cycle
+
+	std::atomic<uint64_t> _gc_cycles;
+	std::atomic<int64_t>  _gc_total;
+	std::atomic<int64_t>  _gc_max;
+	std::atomic<uint64_t> _gc_spread_cycles;
+	std::atomic<size_t>   _mem_used;
+	std::atomic<size_t>   _mem_peak;
+
 #ifdef WITH_LUAPROC_STATS
 	int64_t _stats_avg[2];
 	int64_t _stats_max[2];
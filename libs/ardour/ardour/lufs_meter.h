@@ -19,12 +19,12 @@
 #define _lufs_meter_h_
 
 #include <cstdint>
-#include <functional>
 #include <map>
 
 #include "pbd/stack_allocator.h"
 
 #include "ardour/libardour_visibility.h"
+#include "ardour/runtime_functions.h"
 
 namespace ARDOUR {
 
@@ -43,6 +43,9 @@ public:
 	float max_momentary () const;
 	float dbtp () const;
 
+	/** K-weighting filter coefficients (ITU-R BS.1770) for the given rate */
+	static KWeightCoeff kweight_coefficients (double samplerate);
+
 private:
 	void init ();
 
@@ -50,9 +53,6 @@ private:
 	float sumfrag (uint32_t) const;
 
 	void  calc_true_peak (float const** data, const uint32_t n_samples);
-	float upsample_x4 (int chn, float const x);
-	float upsample_x2 (int chn, float const x);
-	std::function< float(int, const float) > upsample;
 
 	const float _g[5] = { 1.0, 1.0, 1.0, 1.41, 1.41 };
 
@@ -62,9 +62,7 @@ private:
 	uint32_t _n_fragment;
 
 	/* filter coeff */
-	float _a0, _a1, _a2;
-	float _b1, _b2;
-	float _c3, _c4;
+	KWeightCoeff _kw;
 
 	/* state */
 	uint32_t _frag_pos;
@@ -89,15 +87,10 @@ private:
 
 	History _hist;
 
-	struct FilterState {
-		void reset ();
-		void sanitize ();
-
-		float z1, z2, z3, z4;
-	};
-
-	FilterState _fst[5];
-	float*      _z[5];
+	/* filter state, per channel */
+	float  _z1[5], _z2[5], _z3[5], _z4[5];
+	/* true-peak upsampler history, per channel */
+	float* _z[5];
 };
 
 } // namespace ARDOUR
@@ -410,6 +410,13 @@ public:
 	LV2PluginInfo (const char* plugin_uri);
 	~LV2PluginInfo ();
 
+	/** Discover all LV2 plugins.
+	 *
+	 * Plugin descriptors and scan-log are cached and re-used as long as
+	 * the set of LV2 bundles and their modification times are unchanged.
+	 * In that case the lilv world is only loaded once a plugin is
+	 * instantiated.
+	 */
 	static PluginInfoList* discover (std::function <void (std::string const&, PluginScanLogEntry::PluginScanResult, std::string const&, bool)> cb);
 
 	PluginPtr load (Session& session);
@@ -422,9 +429,16 @@ public:
 	char * _plugin_uri;
 
 private:
+	LV2PluginInfo (XMLNode const&);
+	XMLNode& state () const;
+
 	bool _is_instrument;
 	bool _is_utility;
 	bool _is_analyzer;
+
+	/* presets index, used until the lilv world is loaded */
+	bool                              _have_cached_presets;
+	std::vector<Plugin::PresetRecord> _cached_presets;
 };
 
 typedef std::shared_ptr<LV2PluginInfo> LV2PluginInfoPtr;
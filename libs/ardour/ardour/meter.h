@@ -112,6 +112,7 @@ private:
 	std::vector<Iec1ppmdsp*> _iec1meter;
 	std::vector<Iec2ppmdsp*> _iec2meter;
 	std::vector<Vumeterdsp*> _vumeter;
+	std::vector<float const*> _meter_bufs;
 
 	MeterType _meter_type;
 };
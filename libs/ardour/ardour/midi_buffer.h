@@ -210,6 +210,18 @@ private:
 #endif
 	}
 
+	/** @return total (aligned) size of the event record at @p ev
+	 * including its header, or -1 if the event size is unknown.
+	 */
+	static int event_bytes (uint8_t const* ev) {
+		const size_t header_size = sizeof (TimeType) + sizeof (Evoral::EventType);
+		int event_size = Evoral::midi_event_size (ev + header_size);
+		if (event_size < 0) {
+			return -1;
+		}
+		return align32 (header_size + event_size);
+	}
+
 	uint8_t* _data; ///< [timestamp, event-type, event]*
 	pframes_t _size;
 };
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "ardour/libardour_visibility.h"
+#include "ardour/runtime_functions.h"
 #include "ardour/types.h"
 #include "ardour/utils.h"
 
@@ -34,6 +35,14 @@ extern "C" {
 
 LIBARDOUR_API void x86_sse_find_peaks              (float const* buf, uint32_t nsamples, float* min, float* max);
 
+/* SSE meter kernels */
+LIBARDOUR_API void x86_sse_kmeter_process          (float const* const* bufs, uint32_t n_chn, ARDOUR::pframes_t nframes, float omega, float* z1, float* z2);
+LIBARDOUR_API void x86_sse_ppm_process             (float const* const* bufs, uint32_t n_chn, ARDOUR::pframes_t nframes, float w1, float w2, float w3, float* z1, float* z2, float* m);
+LIBARDOUR_API void x86_sse_vumeter_process         (float const* const* bufs, uint32_t n_chn, ARDOUR::pframes_t nframes, float w, float* z1, float* z2, float* m);
+LIBARDOUR_API void x86_sse_kweight_process         (float const* const* bufs, uint32_t n_chn, ARDOUR::pframes_t nframes, uint32_t offset, ARDOUR::KWeightCoeff const&, float* z1, float* z2, float* z3, float* z4, float* pwr);
+LIBARDOUR_API void x86_sse_true_peak_x2            (float const* const* bufs, uint32_t n_chn, ARDOUR::pframes_t nframes, float* const* hist, float* peak);
+LIBARDOUR_API void x86_sse_true_peak_x4            (float const* const* bufs, uint32_t n_chn, ARDOUR::pframes_t nframes, float* const* hist, float* peak);
+
 extern "C" {
 /* AVX functions */
 	LIBARDOUR_API float x86_sse_avx_compute_peak          (float const* buf, uint32_t nsamples, float current);
@@ -105,3 +114,13 @@ LIBARDOUR_API void  default_mix_buffers_with_gain     (ARDOUR::Sample* dst, ARDO
 LIBARDOUR_API void  default_mix_buffers_no_gain       (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  default_copy_vector               (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 
+LIBARDOUR_API void  default_kmeter_process            (float const* const* bufs, uint32_t n_chn, ARDOUR::pframes_t nframes, float omega, float* z1, float* z2);
+LIBARDOUR_API void  default_ppm_process               (float const* const* bufs, uint32_t n_chn, ARDOUR::pframes_t nframes, float w1, float w2, float w3, float* z1, float* z2, float* m);
+LIBARDOUR_API void  default_vumeter_process           (float const* const* bufs, uint32_t n_chn, ARDOUR::pframes_t nframes, float w, float* z1, float* z2, float* m);
+LIBARDOUR_API void  default_kweight_process           (float const* const* bufs, uint32_t n_chn, ARDOUR::pframes_t nframes, uint32_t offset, ARDOUR::KWeightCoeff const&, float* z1, float* z2, float* z3, float* z4, float* pwr);
+LIBARDOUR_API void  default_true_peak_x2              (float const* const* bufs, uint32_t n_chn, ARDOUR::pframes_t nframes, float* const* hist, float* peak);
+LIBARDOUR_API void  default_true_peak_x4              (float const* const* bufs, uint32_t n_chn, ARDOUR::pframes_t nframes, float* const* hist, float* peak);
+
+/* true-peak interpolation filters, cosine windowed sinc: 1/4, 1/2, 3/4 sample */
+LIBARDOUR_API extern float const true_peak_fir[3][48];
+
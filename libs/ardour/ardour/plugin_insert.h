@@ -28,6 +28,7 @@
 #include <string>
 #include <vector>
 
+#include "pbd/semutils.h"
 #include "pbd/stack_allocator.h"
 #include "pbd/timing.h"
 
@@ -42,6 +43,7 @@
 #include "ardour/processor.h"
 #include "ardour/readonly_control.h"
 #include "ardour/sidechain.h"
+#include "ardour/tailtime.h"
 
 class XMLNode;
 
@@ -53,7 +55,7 @@ class Plugin;
 
 /** Plugin inserts: send data through a plugin
  */
-class LIBARDOUR_API PluginInsert : public Processor, public PlugInsertBase, public std::enable_shared_from_this <PluginInsert>
+class LIBARDOUR_API PluginInsert : public Processor, public PlugInsertBase, public TailTime, public std::enable_shared_from_this <PluginInsert>
 {
 public:
 	PluginInsert (Session&, Temporal::TimeDomainProvider const & tdp, std::shared_ptr<Plugin> = std::shared_ptr<Plugin>());
@@ -206,6 +208,25 @@ public:
 	bool get_stats (PBD::microseconds_t& min, PBD::microseconds_t& max, double& avg, double& dev) const;
 	void clear_stats ();
 
+	/** Statistics of replicated plugin instances.
+	 *
+	 * @param avg average CPU time [usec] of all instances per cycle
+	 * @param parallel fraction of cycles in which the instances were processed in parallel
+	 * @return false if there is only a single instance, or no data was collected yet
+	 */
+	bool get_instance_stats (double& avg, double& parallel) const;
+
+	/** start worker threads for replicated plugin instances (if not already running) */
+	static void start_instance_workers ();
+	/** join worker threads and free the pool, see ARDOUR::cleanup */
+	static void drop_instance_workers ();
+
+	/** true if the plugin was not processed in the last cycle, because its
+	 * input has been silent for longer than its latency and tail-time.
+	 * see RCConfiguration::get_sleep_silent_plugins
+	 */
+	bool asleep () const { return _asleep.load (); }
+
 	struct PIControl : public PluginControl
 	{
 		PIControl (Session&                        s,
@@ -246,6 +267,7 @@ public:
 	std::string describe_parameter (Evoral::Parameter param);
 
 	samplecnt_t signal_latency () const;
+	samplecnt_t signal_tailtime () const;
 
 	std::shared_ptr<Plugin> get_impulse_analysis_plugin();
 
@@ -360,6 +382,40 @@ private:
 	void bypass (BufferSet& bufs, pframes_t nframes);
 	void inplace_silence_unconnected (BufferSet&, const PinMappings&, samplecnt_t nframes, samplecnt_t offset) const;
 
+	/* replicated instances, see RCConfiguration::get_parallel_plugin_instances */
+	bool run_instances_parallel (BufferSet&, samplepos_t start, samplepos_t end, double speed, PinMappings const& in_map, PinMappings const& out_map, pframes_t nframes, samplecnt_t offset);
+	static void run_instance (void*, uint32_t);
+	void update_instance_stats (PBD::microseconds_t, bool parallel);
+	void reset_instance_stats ();
+
+	struct InstanceArgs {
+		BufferSet*         bufs;
+		PinMappings const* in_map;
+		PinMappings const* out_map;
+		samplepos_t        start;
+		samplepos_t        end;
+		double             speed;
+		pframes_t          nframes;
+		samplecnt_t        offset;
+	};
+
+	InstanceArgs          _instance_args;
+	PBD::Semaphore        _instances_done;
+	std::atomic<int64_t>  _instance_dsp;    /* usec, all instances in the current cycle */
+	std::atomic<bool>     _instance_failed;
+	double                _instance_cost;   /* usec, moving average */
+	std::atomic<uint64_t> _instance_total;  /* usec, all instances since last stats reset */
+	std::atomic<uint64_t> _instance_cycles;
+	std::atomic<uint64_t> _parallel_cycles;
+
+	/* skip processing silent input, see RCConfiguration::get_sleep_silent_plugins */
+	bool may_sleep () const;
+	bool check_asleep (BufferSet const*, pframes_t);
+	void set_asleep (bool);
+
+	samplecnt_t       _silent_samples;
+	std::atomic<bool> _asleep;
+
 	void create_automatable_parameters ();
 	void control_list_automation_state_changed (Evoral::Parameter, AutoState);
 	void set_parameter_state_2X (const XMLNode& node, int version);
@@ -31,6 +31,7 @@
 #include <map>
 #include <string>
 #include <set>
+#include <vector>
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
@@ -356,6 +357,31 @@ private:
 #ifdef VST3_SUPPORT
 	void vst3_plugin (std::string const&, std::string const&, VST3Info const&);
 	bool run_vst3_scanner_app (std::string bundle_path, PSLEPtr) const;
+	void vst3_scan_outdated (std::vector<std::string> const&, std::set<std::string>& failed);
+#endif
+
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT)
+	void vst2_scan_outdated (std::vector<std::string> const&, ARDOUR::PluginType, std::set<std::string>& failed);
+#endif
+
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT || defined VST3_SUPPORT)
+	struct ScanJob {
+		ScanJob (ARDOUR::PluginType t, std::string const& p, std::string const& m, PSLEPtr l)
+			: type (t), path (p), module_path (m), psle (l) {}
+
+		ARDOUR::PluginType type;
+		std::string        path;        ///< passed to the scanner app
+		std::string        module_path; ///< identifies the cache file and blacklist entry
+		PSLEPtr            psle;
+	};
+
+	/** Run the scanner app for each of the given plugins, with up to
+	 * n_scan_jobs() processes concurrently. Each job has its own timeout.
+	 * Paths of plugins that could not be scanned are added to @p failed.
+	 */
+	void run_scanner_apps (std::string const& scanner_bin, std::vector<ScanJob> const&, std::set<std::string>& failed);
+
+	static uint32_t n_scan_jobs ();
 #endif
 
 	int ladspa_discover (std::string path);
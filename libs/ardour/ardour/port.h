@@ -100,6 +100,11 @@ public:
 	int reestablish ();
 	int reconnect ();
 
+	/* batched reconnect, see PortManager::reconnect_ports () */
+	void reconnect_targets (std::vector<std::string>&) const;
+	PortEngine::PortConnection connection_to (std::string const&) const;
+	int  reconnect_failed (std::vector<std::string> const& failed, size_t n_targets);
+
 	bool last_monitor() const { return _last_monitor; }
 	void set_last_monitor (bool yn) { _last_monitor = yn; }
 
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <utility>
 #include <vector>
 #include <string>
 
@@ -265,6 +266,34 @@ public:
 	 */
 	virtual int   disconnect_all (PortHandle port) = 0;
 
+	/** A pair of port names: source, destination (sink) */
+	typedef std::pair<std::string, std::string> PortConnection;
+
+	/** Connect several pairs of ports at once.
+	 *
+	 * Backends may apply the whole set in one go, which is considerably
+	 * faster than individual calls to connect() for large sessions.
+	 *
+	 * @param connections pairs of source and destination port names
+	 * @param status if not NULL, filled with the result of each connection (zero on success)
+	 * @return zero if all connections were made, non-zero otherwise.
+	 */
+	virtual int   connect_batch (std::vector<PortConnection> const& connections, std::vector<int>* status = 0)
+	{
+		return apply_connections (connections, status, true);
+	}
+
+	/** Remove the connections between several pairs of ports at once.
+	 *
+	 * @param connections pairs of source and destination port names
+	 * @param status if not NULL, filled with the result of each disconnection (zero on success)
+	 * @return zero if all connections were removed, non-zero otherwise.
+	 */
+	virtual int   disconnect_batch (std::vector<PortConnection> const& connections, std::vector<int>* status = 0)
+	{
+		return apply_connections (connections, status, false);
+	}
+
 	/** Test if given \p port is connected
 	 *
 	 * @param port \ref PortHandle of port to test
@@ -503,6 +532,23 @@ public:
 
 protected:
 	PortManager& manager;
+
+private:
+	int apply_connections (std::vector<PortConnection> const& connections, std::vector<int>* status, bool yn)
+	{
+		int rv = 0;
+		if (status) {
+			status->resize (connections.size ());
+		}
+		for (size_t i = 0; i < connections.size (); ++i) {
+			int const r = yn ? connect (connections[i].first, connections[i].second) : disconnect (connections[i].first, connections[i].second);
+			if (status) {
+				(*status)[i] = r;
+			}
+			rv |= r;
+		}
+		return rv ? -1 : 0;
+	}
 };
 
 } // namespace
@@ -89,10 +89,26 @@ class LIBARDOUR_API BackendPort : public ProtoPort
 		return _connections;
 	}
 
-	int  connect (BackendPortHandle port, BackendPortHandle self);
-	int  disconnect (BackendPortHandle port, BackendPortHandle self);
+	typedef std::vector<BackendPortPtr> ConnectionTable;
+
+	/** Flat copy of the connections for use in the process thread.
+	 * It is replaced (RCU) whenever a connection is made or removed.
+	 */
+	std::shared_ptr<ConnectionTable const> connection_table () const {
+		return _connection_table.reader ();
+	}
+
+	/* with update_table == false, the caller has to call
+	 * update_connection_table () on both ports
+	 */
+	int  connect (BackendPortHandle port, BackendPortHandle self, bool update_table = true);
+	int  disconnect (BackendPortHandle port, BackendPortHandle self, bool update_table = true);
 	void disconnect_all (BackendPortHandle self);
+	void update_connection_table ();
 
+	/* the buffer of an input port may be the buffer of the
+	 * connected output port, and must not be modified.
+	 */
 	virtual void* get_buffer (pframes_t nframes) = 0;
 
 	const LatencyRange latency_range (bool for_playback) const
@@ -116,8 +132,10 @@ private:
 	LatencyRange           _playback_latency_range;
 	std::set<BackendPortPtr> _connections;
 
-	void store_connection (BackendPortHandle);
-	void remove_connection (BackendPortHandle);
+	SerializedRCUManager<ConnectionTable> _connection_table;
+
+	void store_connection (BackendPortHandle, bool update_table = true);
+	void remove_connection (BackendPortHandle, bool update_table = true);
 
 }; // class BackendPort
 
@@ -157,6 +175,23 @@ public:
 
 	int get_ports (const std::string& port_name_pattern, DataType type, PortFlags flags, std::vector<std::string>&) const;
 
+	enum PortPattern {
+		PatternAll,
+		PatternRegex,
+		PatternSubstring,
+		PatternPrefix,
+		PatternSuffix,
+		PatternExact
+	};
+
+	/** Classify a get_ports() pattern, patterns which are not a regex
+	 * are matched without using regexec().
+	 *
+	 * @param pattern POSIX extended regular expression
+	 * @param literal set to the pattern without anchors
+	 */
+	static PortPattern classify_port_pattern (std::string const& pattern, std::string& literal);
+
 	DataType port_data_type (PortEngine::PortHandle) const;
 
 	PortEngine::PortPtr register_port (const std::string& shortname, ARDOUR::DataType, ARDOUR::PortFlags);
@@ -167,6 +202,8 @@ public:
 	int connect (PortEngine::PortHandle, const std::string&);
 	int disconnect (PortEngine::PortHandle, const std::string&);
 	int disconnect_all (PortEngine::PortHandle);
+	int connect_batch (std::vector<PortEngine::PortConnection> const&, std::vector<int>* status);
+	int disconnect_batch (std::vector<PortEngine::PortConnection> const&, std::vector<int>* status);
 
 	bool connected (PortEngine::PortHandle, bool process_callback_safe);
 	bool connected_to (PortEngine::PortHandle, const std::string&, bool process_callback_safe);
@@ -212,6 +249,8 @@ protected:
 
 	void clear_ports ();
 
+	int apply_connection_batch (std::vector<PortEngine::PortConnection> const&, std::vector<int>* status, bool yn);
+
 	BackendPortPtr add_port (const std::string& shortname, ARDOUR::DataType, ARDOUR::PortFlags);
 	void                unregister_ports (bool system_only = false);
 
@@ -40,6 +40,7 @@ namespace ARDOUR {
 
 class PortEngine;
 class AudioBackend;
+class AudioPort;
 class Session;
 
 class CircularSampleBuffer;
@@ -274,6 +275,16 @@ public:
 		return _monitor_port;
 	}
 
+	/* Audio input ports that are connected to the very same external
+	 * port(s) receive identical data. When enabled (the default), only
+	 * one of them reads and resamples the data, the others share its buffer.
+	 */
+	void set_share_resampled_inputs (bool);
+	bool share_resampled_inputs () const { return _share_resampled_inputs; }
+
+	/** @return number of input ports that currently use the buffer of another port */
+	size_t n_shared_inputs () const;
+
 protected:
 	std::shared_ptr<AudioBackend> _backend;
 
@@ -320,9 +331,17 @@ private:
 	void load_port_info ();
 	void save_port_info ();
 	void update_input_ports (bool);
+	void update_shared_inputs ();
 
 	MonitorPort _monitor_port;
 
+	/** input port -> port that reads and resamples the same external source(s) */
+	typedef std::map<Port const*, std::shared_ptr<AudioPort> > SharedInputs;
+
+	SerializedRCUManager<SharedInputs> _shared_inputs;
+	std::atomic<int>                   _shared_inputs_dirty;
+	bool                               _share_resampled_inputs;
+
 	struct PortID {
 		PortID (std::shared_ptr<AudioBackend>, DataType, bool, std::string const&);
 		PortID (XMLNode const&, bool old_midi_format = false);
@@ -102,6 +102,7 @@ CONFIG_VARIABLE (float, audio_playback_buffer_seconds, "playback-buffer-seconds"
 CONFIG_VARIABLE (float, midi_track_buffer_seconds, "midi-track-buffer-seconds", 1.0)
 CONFIG_VARIABLE (uint32_t, disk_choice_space_threshold,  "disk-choice-space-threshold", 57600000)
 CONFIG_VARIABLE (bool, auto_analyse_audio, "auto-analyse-audio", false)
+CONFIG_VARIABLE (uint32_t, region_fx_render_cache_size, "region-fx-render-cache-size", 0) /* MiB, 0: do not render Region FX */
 CONFIG_VARIABLE (float, transient_sensitivity, "transient-sensitivity", 50)
 CONFIG_VARIABLE (float, max_transport_speed, "max-transport-speed", 2.0)
 
@@ -254,11 +255,16 @@ CONFIG_VARIABLE (bool, ask_replace_instrument, "ask-replace-instrument", true)
 CONFIG_VARIABLE (bool, ask_setup_instrument, "ask-setup-instrument", true)
 CONFIG_VARIABLE (bool, setup_sidechain, "setup-sidechain", false)
 CONFIG_VARIABLE (uint32_t, plugin_scan_timeout, "plugin-scan-timeout", 150) /* deci-seconds */
+CONFIG_VARIABLE (uint32_t, plugin_scan_jobs, "plugin-scan-jobs", 0) /* concurrent scanner processes, 0: automatic */
 CONFIG_VARIABLE (uint32_t, limit_n_automatables, "limit-n-automatables", 512)
 CONFIG_VARIABLE (uint32_t, plugin_cache_version, "plugin-cache-version", 0)
 
 CONFIG_VARIABLE (float, tail_duration_sec, "tail-duration-sec", 2.0)
 CONFIG_VARIABLE (uint32_t, max_tail_samples, "max-tail-samples", 0xffffffff) // aka kInfiniteTail
+CONFIG_VARIABLE (uint32_t, lua_dsp_gc_budget, "lua-dsp-gc-budget", 0) /* microseconds per cycle, 0: one incremental step per cycle */
+CONFIG_VARIABLE (bool, parallel_plugin_instances, "parallel-plugin-instances", false)
+CONFIG_VARIABLE (uint32_t, parallel_plugin_threshold, "parallel-plugin-threshold", 100) /* microseconds per cycle of all instances */
+CONFIG_VARIABLE (bool, sleep_silent_plugins, "sleep-silent-plugins", false)
 
 /* custom user plugin paths */
 CONFIG_VARIABLE (std::string, plugin_path_vst, "plugin-path-vst", "@default@")
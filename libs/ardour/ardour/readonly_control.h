@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include "pbd/destructible.h"
@@ -38,10 +39,16 @@ public:
 	std::string describe_parameter ();
 	const ParameterDescriptor& desc() const { return _desc; }
 
+	/** While the plugin is not run (see PluginInsert::asleep), report
+	 * the parameter's normal value instead of the last (stale) output.
+	 */
+	void set_resting (bool yn) { _resting.store (yn); }
+
 protected:
 	std::weak_ptr<Plugin> _plugin;
 	const ParameterDescriptor _desc;
 	uint32_t _parameter_num;
+	std::atomic<bool> _resting;
 };
 
 } // namespace ARDOUR
@@ -0,0 +1,120 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "pbd/command.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/thawlist.h"
+#include "ardour/types.h"
+
+namespace PBD {
+class PropertyList;
+}
+
+namespace ARDOUR
+{
+
+class Playlist;
+class Region;
+
+/** A Command which stores property changes of many regions.
+ *
+ * This is the equivalent of one PBD::StatefulDiffCommand per region,
+ * except that undo and redo apply all changes with each playlist frozen
+ * and region property change signals suspended, so that every playlist
+ * and region is notified only once.
+ */
+class LIBARDOUR_API RegionBatchDiffCommand : public PBD::Command
+{
+public:
+	/** Collect the changes of the given regions since clear_changes was called on them */
+	RegionBatchDiffCommand (RegionList const&);
+	RegionBatchDiffCommand (XMLNode const&);
+	~RegionBatchDiffCommand ();
+
+	void operator() ();
+	void undo ();
+
+	XMLNode& get_state () const;
+
+	bool empty () const;
+
+private:
+	struct Change {
+		std::weak_ptr<Region> region;
+		PBD::PropertyList*    changes;
+	};
+
+	std::vector<Change> _changes;
+
+	void add (std::shared_ptr<Region>, PBD::PropertyList*);
+	void region_going_away (std::weak_ptr<Region>);
+	void apply (bool invert);
+};
+
+/** Edit many regions as one operation.
+ *
+ * Regions that are added are prepared for a diff (clear_changes), their
+ * property change signals are suspended, and their playlists are frozen
+ * until commit() is called. Relayering, playlist notifications and
+ * Region::RegionsPropertyChanged are emitted once for the whole edit.
+ *
+ * @code
+ * RegionBatchEdit edit;
+ * for (auto const& r : regions) {
+ *   edit.add (r);
+ *   r->set_position (...);
+ * }
+ * if (RegionBatchDiffCommand* cmd = edit.commit ()) {
+ *   session->add_command (cmd);
+ * }
+ * @endcode
+ */
+class LIBARDOUR_API RegionBatchEdit
+{
+public:
+	RegionBatchEdit ();
+	~RegionBatchEdit ();
+
+	/** add @a r to the edit, must be called before modifying the region */
+	void add (std::shared_ptr<Region> r);
+
+	bool empty () const { return _thawlist.empty (); }
+
+	/** end the edit and send notifications.
+	 * @return a single command with the changes of all regions, owned by the caller,
+	 * or 0 if no region was changed
+	 */
+	RegionBatchDiffCommand* commit ();
+
+private:
+	RegionBatchEdit (RegionBatchEdit const&);
+	RegionBatchEdit& operator= (RegionBatchEdit const&);
+
+	ThawList                            _thawlist;
+	std::set<std::shared_ptr<Region>>   _regions;
+	std::set<std::shared_ptr<Playlist>> _playlists;
+
+	void release ();
+};
+
+} // namespace ARDOUR
@@ -0,0 +1,85 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <map>
+
+#include <glibmm/threads.h>
+
+#include "pbd/id.h"
+#include "pbd/pthread_utils.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/session_handle.h"
+
+namespace PBD
+{
+	class EventLoop;
+}
+
+namespace ARDOUR
+{
+
+/** Background renderer for Region FX.
+ *
+ * Once the FX chain, plugin parameters, automation and bounds of an audio
+ * region with Region FX have not been modified for a while, the region's
+ * output is rendered to hidden session sources, and playback reads the
+ * render instead of running the plugins (see AudioRegion::render_fx).
+ *
+ * Plugin instances for rendering are created in the thread that created
+ * the session (the GUI thread), which is asked to call
+ * AudioRegion::prepare_fx_render.
+ *
+ * The disk space used by renders is limited by the
+ * "region-fx-render-cache-size" preference (disabled by default); the
+ * least recently played renders are dropped first.
+ */
+class LIBARDOUR_API RegionFxRenderer : public SessionHandleRef
+{
+public:
+	RegionFxRenderer (Session&);
+	~RegionFxRenderer ();
+
+	int  start_thread ();
+	void terminate_thread ();
+
+	/** disk space used by all current renders, in bytes */
+	size_t disk_usage () const;
+
+	/** remove renders left over from a previous session, e.g. after a crash */
+	void remove_stale_renders ();
+
+	/** time in microseconds a region has to remain unmodified before it is rendered */
+	static const int64_t settle_time = 5000000;
+
+private:
+	void thread_work ();
+	void run_once ();
+
+	PBD::EventLoop*           _event_loop; ///< where plugins are instantiated
+	PBD::Thread*              _thread;
+	std::atomic<bool>         _quit;
+	Glib::Threads::Mutex      _lock;
+	Glib::Threads::Cond       _wakeup;
+	std::atomic<size_t>       _disk_usage;
+	std::map<PBD::ID, uint64_t> _failed;    ///< region -> generation that could not be rendered
+	std::map<PBD::ID, uint64_t> _requested; ///< region -> generation for which prepare_fx_render was requested
+};
+
+} // namespace ARDOUR
@@ -83,6 +83,7 @@ class PortSet;
 class Processor;
 class PluginInsert;
 class RouteGroup;
+class RoutePipeline;
 class Send;
 class InternalReturn;
 class Location;
@@ -330,6 +331,21 @@ public:
 
 	bool strict_io () const { return _strict_io; }
 	bool set_strict_io (bool);
+
+	/** Number of pipeline stages for the route's plugins, 0 or 1 for serial processing.
+	 *
+	 * The longest run of consecutive audio plugins (without sidechain) is split
+	 * into stages, that process concurrently. Every stage after the first adds
+	 * one block of latency.
+	 */
+	uint32_t pipeline_stages () const { return _pipeline_stages; }
+	void set_pipeline_stages (uint32_t);
+
+	/** true if all active plugins of the route were asleep in the last cycle,
+	 * see PluginInsert::asleep
+	 */
+	bool asleep () const { return _asleep.load (); }
+
 	/** reset plugin-insert configuration to default, disable customizations.
 	 *
 	 * This is equivalent to calling
@@ -429,7 +445,7 @@ public:
 	virtual int set_state (const XMLNode&, int version);
 
 	XMLNode& get_processor_state ();
-	void set_processor_state (const XMLNode&, int version);
+	void set_processor_state (XMLNodeList const&, int version);
 	virtual bool set_processor_state (XMLNode const & node, int version, XMLProperty const* prop, ProcessorList& new_order, bool& must_configure);
 
 	std::weak_ptr<Route> weakroute ();
@@ -788,6 +804,15 @@ private:
 	int64_t _track_number;
 	bool    _strict_io;
 	bool    _in_configure_processors;
+
+	uint32_t                       _pipeline_stages;
+	std::unique_ptr<RoutePipeline> _pipeline;
+
+	void setup_pipeline ();
+
+	std::atomic<bool> _asleep;
+	void update_asleep ();
+
 	bool    _initial_io_setup;
 	bool    _in_sidechain_setup;
 	gain_t  _monitor_gain;
@@ -0,0 +1,131 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <pthread.h>
+
+#include "pbd/semutils.h"
+
+#include "ardour/chan_count.h"
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR
+{
+
+class BufferSet;
+class Processor;
+class Session;
+
+/** Run a contiguous section of a route's plugins as a pipeline.
+ *
+ * The plugins are split into stages. The first stage runs in the calling
+ * process thread, every later stage runs concurrently in a dedicated
+ * realtime thread, processing the data that the previous stage produced
+ * one block earlier. The threads are created by the audio backend,
+ * see AudioBackend::create_worker_thread.
+ *
+ * Each additional stage adds a fixed latency of one block (the nominal
+ * buffer size), which Route reports as part of its signal latency.
+ */
+class LIBARDOUR_API RoutePipeline
+{
+public:
+	typedef std::vector<std::shared_ptr<Processor> > Processors;
+
+	/** @param procs processors to run, in order, see can_pipeline()
+	 *  @param n_stages number of stages, at least 2 and at most procs.size ()
+	 *  @param block_size nominal block size, the latency of a stage
+	 */
+	RoutePipeline (Session&, Processors const& procs, uint32_t n_stages, pframes_t block_size);
+	~RoutePipeline ();
+
+	/** true if the given processor may be part of a pipeline */
+	static bool can_pipeline (std::shared_ptr<Processor> const&);
+
+	std::shared_ptr<Processor> front () const { return _stages.front ().procs.front (); }
+	std::shared_ptr<Processor> back () const { return _stages.back ().procs.back (); }
+
+	uint32_t n_stages () const { return _stages.size (); }
+
+	/** additional latency of the whole pipeline */
+	samplecnt_t latency () const { return (_stages.size () - 1) * _block_size; }
+
+	/** latency that is added in front of the given processor,
+	 * one block for the first processor of every stage but the first.
+	 */
+	samplecnt_t input_delay (std::shared_ptr<Processor> const&) const;
+
+	void set_block_size (pframes_t);
+
+	/** Discard the data that is in flight between stages, e.g. after a
+	 * locate or when the route is (re)activated. The buffers are cleared
+	 * by the next call to run().
+	 */
+	void flush ();
+
+	/** Run all stages, called from Route::process_output_buffers ().
+	 *
+	 * @param latency accumulated processor latency of the route, this is
+	 * updated in the same way as it is for serial processing.
+	 */
+	void run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sample, int speed, pframes_t nframes, samplecnt_t& latency);
+
+private:
+	struct Stage {
+		Processors               procs;
+		std::vector<samplecnt_t> offset; /* start_sample offset of each processor */
+		ChanCount                in;
+		ChanCount                out;
+		PBD::Semaphore*          sem;
+	};
+
+	void worker_thread ();
+
+	void stage_thread (size_t);
+	void run_stage (size_t, BufferSet&);
+	void allocate_fifos ();
+	void terminate ();
+
+	Session&           _session;
+	std::vector<Stage> _stages;
+	ChanCount          _max_streams;
+	pframes_t          _block_size;
+
+	/* stage (n) reads fifo (n - 1) and writes fifo (n), the last stage writes _out */
+	std::vector<std::vector<std::vector<Sample> > > _fifo;
+	std::vector<std::vector<Sample> >               _out;
+	samplecnt_t                                     _fifo_pos;
+	std::atomic<bool>                               _flush;
+
+	samplepos_t _start_sample;
+	samplepos_t _end_sample;
+	int         _speed;
+	pframes_t   _nframes;
+
+	std::vector<pthread_t> _workers;
+	uint32_t               _n_reserved;
+	std::atomic<size_t>    _n_workers;
+	std::atomic<bool>      _terminate;
+	PBD::Semaphore         _done_sem;
+};
+
+} // namespace ARDOUR
@@ -37,5 +37,27 @@ namespace ARDOUR {
 	LIBARDOUR_API extern mix_buffers_with_gain_t mix_buffers_with_gain;
 	LIBARDOUR_API extern mix_buffers_no_gain_t   mix_buffers_no_gain;
 	LIBARDOUR_API extern copy_vector_t           copy_vector;
+
+	/* Multi-channel meter kernels. Each channel has its own filter state,
+	 * which is passed as array with one element per channel.
+	 */
+	struct LIBARDOUR_API KWeightCoeff {
+		float a0, a1, a2; // shelf, normalized
+		float b1, b2;     // shelf
+		float c3, c4;     // high-pass
+	};
+
+	typedef void  (*kmeter_process_t)        (float const* const*, uint32_t n_chn, pframes_t, float omega, float* z1, float* z2);
+	typedef void  (*ppm_process_t)           (float const* const*, uint32_t n_chn, pframes_t, float w1, float w2, float w3, float* z1, float* z2, float* m);
+	typedef void  (*vumeter_process_t)       (float const* const*, uint32_t n_chn, pframes_t, float w, float* z1, float* z2, float* m);
+	typedef void  (*kweight_process_t)       (float const* const*, uint32_t n_chn, pframes_t, uint32_t offset, KWeightCoeff const&, float* z1, float* z2, float* z3, float* z4, float* pwr);
+	typedef void  (*true_peak_t)             (float const* const*, uint32_t n_chn, pframes_t, float* const* hist, float* peak);
+
+	LIBARDOUR_API extern kmeter_process_t        kmeter_process;
+	LIBARDOUR_API extern ppm_process_t           ppm_process;
+	LIBARDOUR_API extern vumeter_process_t       vumeter_process;
+	LIBARDOUR_API extern kweight_process_t       kweight_process;
+	LIBARDOUR_API extern true_peak_t             true_peak_x2;
+	LIBARDOUR_API extern true_peak_t             true_peak_x4;
 }
 
@@ -142,6 +142,7 @@ class Bundle;
 class Butler;
 class Click;
 class CoreSelection;
+class DelayArena;
 class ExportHandler;
 class ExportStatus;
 class Graph;
@@ -168,6 +169,7 @@ class PortManager;
 class ProcessThread;
 class Processor;
 class Region;
+class RegionFxRenderer;
 class Return;
 class Route;
 class RouteGroup;
@@ -323,6 +325,7 @@ public:
 
 	void refill_all_track_buffers ();
 	Butler* butler() { return _butler; }
+	RegionFxRenderer* region_fx_renderer () const { return _region_fx_renderer; }
 	void butler_transport_work (bool have_process_lock = false);
 
 	void refresh_disk_space ();
@@ -335,6 +338,9 @@ public:
 	std::shared_ptr<RTTaskList> rt_tasklist () { return _rt_tasklist; }
 	std::shared_ptr<IOTaskList> io_tasklist () { return _io_tasklist; }
 
+	/** memory pool for latency compensation delay-lines */
+	std::shared_ptr<DelayArena> delay_arena () const { return _delay_arena; }
+
 	RouteList get_routelist (bool mixer_order = false, PresentationInfo::Flag fl = PresentationInfo::MixerRoutes) const;
 
 	CoreSelection& selection () const { return *_selection; }
@@ -357,6 +363,8 @@ public:
 	uint32_t ntracks () const;
 	uint32_t naudiotracks () const;
 	uint32_t nbusses () const;
+	/** number of routes whose plugins were asleep in the last cycle, see Route::asleep */
+	uint32_t n_sleeping_routes () const;
 
 	bool plot_process_graph (std::string const& file_name) const;
 
@@ -1617,6 +1625,7 @@ private:
 	mutable Glib::Threads::RWLock              _mixer_scenes_lock;
 
 	Butler* _butler;
+	RegionFxRenderer* _region_fx_renderer;
 
 	TransportFSM* _transport_fsm;
 
@@ -1657,6 +1666,7 @@ private:
 	int  post_engine_init ();
 	int  immediately_post_engine ();
 	void remove_empty_sounds ();
+	void remove_unused_automation_events ();
 
 	void session_loaded ();
 
@@ -2281,6 +2291,7 @@ private:
 
 	std::shared_ptr<RTTaskList> _rt_tasklist;
 	std::shared_ptr<IOTaskList> _io_tasklist;
+	std::shared_ptr<DelayArena> _delay_arena;
 
 	/* Scene Changing */
 	SceneChanger* _scene_changer;
@@ -21,6 +21,8 @@
 #ifndef __VUMETERDSP_H
 #define __VUMETERDSP_H
 
+#include <stdint.h>
+
 #include "ardour/libardour_visibility.h"
 
 class LIBARDOUR_API Vumeterdsp
@@ -34,6 +36,9 @@ public:
     float read (void);
     void reset ();
 
+    /* process multiple channels at once, one meter per channel */
+    static void process (Vumeterdsp* const* v, float const* const* p, uint32_t n_chn, int n);
+
     static void init (float fsamp);
 
 private:
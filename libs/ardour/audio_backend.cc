@@ -17,12 +17,23 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include "pbd/pthread_utils.h"
+
 #include "ardour/audio_backend.h"
 
 #include "pbd/i18n.h"
 
 namespace ARDOUR {
 
+static void*
+start_worker_thread (void* arg)
+{
+	std::function<void()>* f = static_cast<std::function<void()>*> (arg);
+	(*f) ();
+	delete f;
+	return 0;
+}
+
 std::string
 AudioBackend::get_error_string (ErrorCode error_code)
 {
@@ -111,4 +122,23 @@ AudioBackend::get_standard_device_name (StandardDeviceName device_name)
 	return std::string();
 }
 
+int
+AudioBackend::create_worker_thread (std::function<void()> func, pthread_t* thread)
+{
+	std::function<void()>* f = new std::function<void()> (func);
+
+	if (pbd_realtime_pthread_create ("Worker", PBD_SCHED_FIFO, PBD_RT_PRI_PROC, PBD_RT_STACKSIZE_PROC, thread, start_worker_thread, f)) {
+		delete f;
+		return -1;
+	}
+	return 0;
+}
+
+int
+AudioBackend::join_worker_thread (pthread_t thread)
+{
+	void* status;
+	return pthread_join (thread, &status);
+}
+
 } // namespace ARDOUR
@@ -40,6 +40,8 @@ AudioPort::AudioPort (const std::string& name, PortFlags flags)
 	: Port (name, DataType::AUDIO, flags)
 	, _buffer (new AudioBuffer (0))
 	, _data (0)
+	, _shared_input (0)
+	, _src_stale (false)
 {
 	assert (name.find_first_of (':') == string::npos);
 	_src.setup (resampler_quality ());
@@ -65,6 +67,14 @@ AudioPort::cycle_start (pframes_t nframes)
 	/* caller must hold process lock */
 	Port::cycle_start (nframes);
 
+	_shared_input = 0;
+
+	if (_src_stale) {
+		/* resampler history is from before we used a shared input */
+		_src.reset ();
+		_src_stale = false;
+	}
+
 	if (sends_output()) {
 		_buffer->prepare ();
 	} else if (!externally_connected ()) {
@@ -86,6 +96,17 @@ AudioPort::cycle_start (pframes_t nframes)
 	}
 }
 
+void
+AudioPort::cycle_start_shared (pframes_t nframes, AudioPort const* source)
+{
+	/* caller must hold process lock */
+	assert (receives_input () && source && source != this);
+	Port::cycle_start (nframes);
+
+	_shared_input = source;
+	_src_stale    = true;
+}
+
 void
 AudioPort::cycle_end (pframes_t nframes)
 {
@@ -166,6 +187,9 @@ AudioPort::get_audio_buffer (pframes_t nframes)
 
 	if (!externally_connected () || (0 != (flags() & TransportSyncPort))) {
 		addr = (Sample *) port_engine.get_buffer (_port_handle, nframes);
+	} else if (_shared_input) {
+		/* another port read and resampled the same source(s) */
+		addr = &_shared_input->_data[_global_port_buffer_offset];
 	} else {
 		/* _data was read and resampled as necessary in ::cycle_start */
 		addr = &_data[_global_port_buffer_offset];
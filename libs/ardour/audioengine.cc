@@ -73,6 +73,32 @@ using namespace std;
 using namespace ARDOUR;
 using namespace PBD;
 
+namespace {
+
+/* append the duration of the enclosing scope to a cycle-time log */
+class CycleTimeLog
+{
+public:
+	CycleTimeLog (RingBuffer<microseconds_t>* rb)
+		: _rb (rb)
+		, _start (rb ? get_microseconds () : 0)
+	{}
+
+	~CycleTimeLog ()
+	{
+		if (_rb) {
+			microseconds_t const elapsed = get_microseconds () - _start;
+			_rb->write (&elapsed, 1);
+		}
+	}
+
+private:
+	RingBuffer<microseconds_t>* _rb;
+	microseconds_t              _start;
+};
+
+} // namespace
+
 AudioEngine* AudioEngine::_instance = 0;
 
 static std::atomic<int> audioengine_thread_cnt (1);
@@ -104,6 +130,7 @@ AudioEngine::AudioEngine ()
 	, _hw_devicelist_update_thread(0)
 	, _start_cnt (0)
 	, _init_countdown (0)
+	, _cycle_time_log (0)
 #ifdef SILENCE_AFTER_SECONDS
 	, _silence_countdown (0)
 	, _silence_hit_cnt (0)
@@ -235,6 +262,7 @@ int
 AudioEngine::process_callback (pframes_t nframes)
 {
 	TimerRAII tr (dsp_stats[ProcessCallback]);
+	CycleTimeLog ctl (_cycle_time_log.load ());
 	Glib::Threads::Mutex::Lock tm (_process_lock, Glib::Threads::TRY_LOCK);
 	Port::set_varispeed_ratio (1.0);
 
@@ -1339,6 +1367,24 @@ AudioEngine::join_process_threads ()
 	return _backend->join_process_threads ();
 }
 
+int
+AudioEngine::create_worker_thread (std::function<void()> func, pthread_t* thread)
+{
+	if (!_backend) {
+		return -1;
+	}
+	return _backend->create_worker_thread (func, thread);
+}
+
+int
+AudioEngine::join_worker_thread (pthread_t thread)
+{
+	if (!_backend) {
+		return -1;
+	}
+	return _backend->join_worker_thread (thread);
+}
+
 bool
 AudioEngine::in_process_thread ()
 {
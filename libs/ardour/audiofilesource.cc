@@ -165,6 +165,7 @@ AudioFileSource::~AudioFileSource ()
 	if (removable()) {
 		::g_unlink (_path.c_str());
 		::g_unlink (_peakpath.c_str());
+		remove_block_stats ();
 	}
 }
 
@@ -261,6 +262,7 @@ AudioFileSource::mark_streaming_write_completed (const WriterLock& lock, Tempora
 int
 AudioFileSource::move_dependents_to_trash()
 {
+	remove_block_stats ();
 	return ::g_unlink (_peakpath.c_str());
 }
 
@@ -30,12 +30,15 @@
 #include <set>
 
 #include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
 #include <glibmm/threads.h>
 
 #include "pbd/gstdio_compat.h"
 #include "pbd/basename.h"
 #include "pbd/xml++.h"
 #include "pbd/enumwriter.h"
+#include "pbd/error.h"
+#include "pbd/event_loop.h"
 #include "pbd/convert.h"
 #include "pbd/progress.h"
 
@@ -56,8 +59,10 @@
 #include "ardour/region_fx_plugin.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/sndfilesource.h"
+#include "ardour/source_factory.h"
 #include "ardour/transient_detector.h"
 #include "ardour/parameter_descriptor.h"
+#include "ardour/utils.h"
 
 #include "audiographer/general/interleaver.h"
 #include "audiographer/general/sample_format_converter.h"
@@ -240,6 +245,17 @@ AudioRegion::register_properties ()
 void
 AudioRegion::init ()
 {
+	/* before any property change is sent */
+	_fx_render_generation = 0;
+	_fx_render_fades = false;
+	_fx_render_bytes = 0;
+	_fx_render_clone = false;
+	_fx_render_prep_generation = UINT64_MAX;
+	_fx_render_prep_loop = 0;
+	_fx_generation = 0;
+	_fx_changed_at = g_get_monotonic_time ();
+	_fx_render_used = 0;
+
 	register_properties ();
 
 	suspend_property_changes();
@@ -276,6 +292,14 @@ AudioRegion::send_change (const PropertyChange& what_changed)
 		_invalidated.exchange (true);
 	}
 
+	our_interests.add (Properties::length);
+	our_interests.add (Properties::fade_before_fx);
+	our_interests.add (Properties::region_fx);
+
+	if (what_changed.contains (our_interests)) {
+		fx_render_invalidate ();
+	}
+
 	Region::send_change (what_changed);
 }
 
@@ -351,6 +375,16 @@ AudioRegion::AudioRegion (std::shared_ptr<const AudioRegion> other)
 	_fx_block_size = 0;
 	_fx_latent_read = false;
 
+	_fx_render_generation = 0;
+	_fx_render_fades = false;
+	_fx_render_bytes = 0;
+	_fx_render_clone = false;
+	_fx_render_prep_generation = UINT64_MAX;
+	_fx_render_prep_loop = 0;
+	_fx_generation = 0;
+	_fx_changed_at = g_get_monotonic_time ();
+	_fx_render_used = 0;
+
 	copy_plugin_state (other);
 
 	assert(_type == DataType::AUDIO);
@@ -380,6 +414,16 @@ AudioRegion::AudioRegion (std::shared_ptr<const AudioRegion> other, timecnt_t co
 	_fx_block_size = 0;
 	_fx_latent_read = false;
 
+	_fx_render_generation = 0;
+	_fx_render_fades = false;
+	_fx_render_bytes = 0;
+	_fx_render_clone = false;
+	_fx_render_prep_generation = UINT64_MAX;
+	_fx_render_prep_loop = 0;
+	_fx_generation = 0;
+	_fx_changed_at = g_get_monotonic_time ();
+	_fx_render_used = 0;
+
 	copy_plugin_state (other);
 
 	assert(_type == DataType::AUDIO);
@@ -407,6 +451,16 @@ AudioRegion::AudioRegion (std::shared_ptr<const AudioRegion> other, const Source
 	_fx_block_size = 0;
 	_fx_latent_read = false;
 
+	_fx_render_generation = 0;
+	_fx_render_fades = false;
+	_fx_render_bytes = 0;
+	_fx_render_clone = false;
+	_fx_render_prep_generation = UINT64_MAX;
+	_fx_render_prep_loop = 0;
+	_fx_generation = 0;
+	_fx_changed_at = g_get_monotonic_time ();
+	_fx_render_used = 0;
+
 	copy_plugin_state (other);
 
 	assert (_sources.size() == _master_sources.size());
@@ -534,6 +588,205 @@ AudioRegion::tail () const
 	}
 }
 
+void
+AudioRegion::fx_render_invalidate ()
+{
+	/* called from the GUI, or from plugin GUI threads. The render is only
+	 * marked as stale here, read_at() holds _cache_lock while reading it.
+	 * RegionFxRenderer drops stale renders.
+	 */
+	if (_fx_render_clone) {
+		return;
+	}
+	_fx_changed_at = g_get_monotonic_time ();
+	++_fx_generation;
+}
+
+bool
+AudioRegion::fx_render_valid () const
+{
+	Glib::Threads::Mutex::Lock cl (_cache_lock);
+	return !_fx_render.empty () && _fx_render_generation == _fx_generation.load ();
+}
+
+size_t
+AudioRegion::fx_render_bytes () const
+{
+	Glib::Threads::Mutex::Lock cl (_cache_lock);
+	return _fx_render_bytes;
+}
+
+void
+AudioRegion::drop_fx_render ()
+{
+	std::vector<std::shared_ptr<AudioFileSource> > srcs;
+	{
+		Glib::Threads::Mutex::Lock cl (_cache_lock);
+		_fx_render.swap (srcs);
+		_fx_render_bytes = 0;
+	}
+	/* sources are removed from disk when the last reference is dropped */
+	srcs.clear ();
+}
+
+void
+AudioRegion::prepare_fx_render ()
+{
+	if (_fx_render_clone || !has_region_fx ()) {
+		return;
+	}
+
+	uint64_t const gen = _fx_generation.load ();
+
+	/* Render a private copy with its own plugin instances, so that
+	 * playback of this region is not affected. The copy is not
+	 * announced nor added to the region map.
+	 */
+	std::shared_ptr<AudioRegion> clone (new AudioRegion (std::dynamic_pointer_cast<const AudioRegion> (shared_from_this ()), timecnt_t::from_superclock (0)));
+	clone->_fx_render_clone = true;
+
+	if (!clone->has_region_fx () || clone->n_region_fx () != n_region_fx ()) {
+		/* plugin(s) could not be instantiated */
+		clone.reset ();
+	} else if (!_fade_before_fx) {
+		/* fades are applied after the FX when playing the render */
+		clone->_fade_in_active  = false;
+		clone->_fade_out_active = false;
+	}
+
+	Glib::Threads::Mutex::Lock cl (_cache_lock);
+	/* a previous copy, if any, is released when clone goes out of scope */
+	_fx_render_prep.swap (clone);
+	_fx_render_prep_generation = gen;
+	_fx_render_prep_loop       = PBD::EventLoop::get_event_loop_for_thread ();
+}
+
+bool
+AudioRegion::fx_render_prepared () const
+{
+	Glib::Threads::Mutex::Lock cl (_cache_lock);
+	return _fx_render_prep_generation == _fx_generation.load ();
+}
+
+/** Release a copy made by prepare_fx_render () in the thread that created it */
+static void
+release_fx_render_copy (std::shared_ptr<AudioRegion>& clone, PBD::EventLoop* event_loop)
+{
+	if (!clone || !event_loop) {
+		clone.reset ();
+		return;
+	}
+	std::shared_ptr<AudioRegion>* rp = new std::shared_ptr<AudioRegion> (clone);
+	clone.reset ();
+	if (!event_loop->call_slot (MISSING_INVALIDATOR, [rp] () { delete rp; })) {
+		delete rp;
+	}
+}
+
+bool
+AudioRegion::render_fx (std::atomic<bool> const& abort)
+{
+	if (_fx_render_clone || !has_region_fx ()) {
+		return false;
+	}
+
+	uint64_t const gen              = _fx_generation.load ();
+	bool const     use_region_fades = _session.config.get_use_region_fades ();
+
+	std::shared_ptr<AudioRegion> clone;
+	PBD::EventLoop*              event_loop;
+	{
+		Glib::Threads::Mutex::Lock cl (_cache_lock);
+		if (_fx_render_prep_generation != gen) {
+			return false;
+		}
+		clone.swap (_fx_render_prep);
+		event_loop = _fx_render_prep_loop;
+		_fx_render_prep_generation = UINT64_MAX;
+		_fx_render_prep_loop       = 0;
+	}
+
+	bool const rv = render_fx (clone, gen, use_region_fades, abort);
+	release_fx_render_copy (clone, event_loop);
+	return rv;
+}
+
+bool
+AudioRegion::render_fx (std::shared_ptr<AudioRegion> clone, uint64_t gen, bool use_region_fades, std::atomic<bool> const& abort)
+{
+	if (!clone) {
+		/* plugin(s) could not be instantiated */
+		return false;
+	}
+
+	uint32_t const    n_chn = clone->n_channels ();
+	samplepos_t const pos   = clone->position ().samples ();
+	samplecnt_t const len   = clone->length_samples () + clone->tail ().samples ();
+
+	std::vector<std::shared_ptr<AudioFileSource> > srcs;
+
+	try {
+		std::string const ext = native_header_format_extension (_session.config.get_native_file_header_format (), DataType::AUDIO);
+		for (uint32_t c = 0; c < n_chn; ++c) {
+			std::string const path = Glib::build_filename (_session.analysis_dir (), string_compose ("%1-%2.%3.fxrender%4", id ().to_s (), gen, c, ext));
+			std::shared_ptr<AudioFileSource> afs = std::dynamic_pointer_cast<AudioFileSource> (SourceFactory::createWritable (DataType::AUDIO, _session, path, _session.sample_rate (), false));
+			if (!afs) {
+				throw failed_constructor ();
+			}
+			afs->mark_for_remove ();
+			srcs.push_back (afs);
+		}
+	} catch (failed_constructor& err) {
+		error << string_compose (_("AudioRegion: cannot create files to render region FX of \"%1\""), name ()) << endmsg;
+		return false;
+	}
+
+	samplecnt_t const         chunk = 8192;
+	std::unique_ptr<Sample[]> buf (new Sample[chunk]);
+	std::unique_ptr<Sample[]> mixdown (new Sample[chunk]);
+	std::unique_ptr<gain_t[]> gain (new gain_t[chunk]);
+
+	for (samplecnt_t off = 0; off < len; off += chunk) {
+		if (abort.load () || gen != _fx_generation.load ()) {
+			return false;
+		}
+		samplecnt_t const cnt = min (chunk, len - off);
+		for (uint32_t c = 0; c < n_chn; ++c) {
+			memset (buf.get (), 0, sizeof (Sample) * cnt);
+			clone->read_at (buf.get (), mixdown.get (), gain.get (), pos + off, cnt, c);
+			if (srcs[c]->write (buf.get (), cnt) != cnt) {
+				return false;
+			}
+		}
+	}
+
+	time_t now;
+	time (&now);
+	struct tm* xnow = localtime (&now);
+
+	size_t bytes = 0;
+	for (auto const& afs : srcs) {
+		afs->update_header (0, *xnow, now);
+		afs->flush_header ();
+		GStatBuf statbuf;
+		if (g_stat (afs->path ().c_str (), &statbuf) == 0) {
+			bytes += statbuf.st_size;
+		}
+	}
+
+	Glib::Threads::Mutex::Lock cl (_cache_lock);
+	if (gen != _fx_generation.load ()) {
+		return false;
+	}
+	/* previous render, if any, is released when srcs goes out of scope */
+	_fx_render.swap (srcs);
+	_fx_render_generation = gen;
+	_fx_render_fades      = use_region_fades;
+	_fx_render_bytes      = bytes;
+	_fx_render_used       = g_get_monotonic_time ();
+	return true;
+}
+
 /** @param buf Buffer to put peak data in.
  *  @param npeaks Number of peaks to read (ie the number of PeakDatas in buf)
  *  @param offset Start position, as an offset from the start of this region's source.
@@ -626,7 +879,7 @@ AudioRegion::read_at (Sample*     buf,
 	}
 
 	std::shared_ptr<Playlist> pl (playlist());
-	if (!pl){
+	if (!pl && !_fx_render_clone){
 		return 0;
 	}
 
@@ -748,6 +1001,35 @@ AudioRegion::read_at (Sample*     buf,
 		samplecnt_t    n_read = to_read; //< data to read from disk
 		sampleoffset_t offset = internal_offset;
 
+		/* play the render of the region FX, if it is up to date */
+		if (have_fx && !_fx_render.empty () && _fx_render_generation == _fx_generation.load () && _fx_render_fades == use_region_fades) {
+			samplecnt_t n_tail = 0;
+			if (tsamples > 0 && cnt >= esamples) {
+				n_tail = can_read - to_read;
+			}
+
+			uint32_t chn = chan_n;
+			if (chn >= n_chn && Config->get_replicate_missing_region_channels ()) {
+				chn = chn % n_chn;
+			}
+
+			if (chn < n_chn) {
+				if (_fx_render[chn]->read (mixdown_buffer, internal_offset + suffix, to_read + n_tail) != to_read + n_tail) {
+					return 0;
+				}
+			} else {
+				memset (mixdown_buffer, 0, sizeof (Sample) * (to_read + n_tail));
+			}
+
+			_fx_render_used = g_get_monotonic_time ();
+
+			/* the FX did not run, next live read needs to flush them */
+			_cache_start = _cache_end = -1;
+			_cache_tail  = n_tail;
+			cl.release ();
+			goto endread;
+		}
+
 		/* don't use cache when there are no region FX */
 		if (!have_fx) {
 			cl.release ();
@@ -1195,6 +1477,11 @@ AudioRegion::state () const
 int
 AudioRegion::_set_state (const XMLNode& node, int version, PropertyChange& what_changed, bool send)
 {
+	static const XMLPropertyName prop_scale_gain ("scale-gain");
+	static const XMLPropertyName prop_default ("default");
+	static const XMLPropertyName prop_steepness ("steepness");
+	static const XMLPropertyName prop_active ("active");
+
 	const XMLNodeList& nlist = node.children();
 	std::shared_ptr<Playlist> the_playlist (_playlist.lock());
 
@@ -1212,7 +1499,7 @@ AudioRegion::_set_state (const XMLNode& node, int version, PropertyChange& what_
 	Region::_set_state (node, version, what_changed, false);
 
 	float val;
-	if (node.get_property ("scale-gain", val)) {
+	if (node.get_property (prop_scale_gain, val)) {
 		if (val != _scale_amplitude) {
 			_scale_amplitude = val;
 			what_changed.add (Properties::scale_amplitude);
@@ -1233,7 +1520,7 @@ AudioRegion::_set_state (const XMLNode& node, int version, PropertyChange& what_
 
 			_envelope->clear ();
 
-			if ((prop = child->property ("default")) != 0 || _envelope->set_state (*child, version)) {
+			if ((prop = child->property (prop_default)) != 0 || _envelope->set_state (*child, version)) {
 				set_default_envelope ();
 			}
 
@@ -1245,7 +1532,7 @@ AudioRegion::_set_state (const XMLNode& node, int version, PropertyChange& what_
 			_fade_in->clear ();
 
 			bool is_default;
-			if ((child->get_property ("default", is_default) && is_default) || (prop = child->property ("steepness")) != 0) {
+			if ((child->get_property (prop_default, is_default) && is_default) || (prop = child->property (prop_steepness)) != 0) {
 				set_default_fade_in ();
 			} else {
 				XMLNode* grandchild = child->child ("AutomationList");
@@ -1255,7 +1542,7 @@ AudioRegion::_set_state (const XMLNode& node, int version, PropertyChange& what_
 			}
 
 			bool is_active;
-			if (child->get_property ("active", is_active)) {
+			if (child->get_property (prop_active, is_active)) {
 				set_fade_in_active (is_active);
 			}
 
@@ -1264,7 +1551,7 @@ AudioRegion::_set_state (const XMLNode& node, int version, PropertyChange& what_
 			_fade_out->clear ();
 
 			bool is_default;
-			if ((child->get_property ("default", is_default) && is_default) || (prop = child->property ("steepness")) != 0) {
+			if ((child->get_property (prop_default, is_default) && is_default) || (prop = child->property (prop_steepness)) != 0) {
 				set_default_fade_out ();
 			} else {
 				XMLNode* grandchild = child->child ("AutomationList");
@@ -1274,7 +1561,7 @@ AudioRegion::_set_state (const XMLNode& node, int version, PropertyChange& what_
 			}
 
 			bool is_active;
-			if (child->get_property ("active", is_active)) {
+			if (child->get_property (prop_active, is_active)) {
 				set_fade_out_active (is_active);
 			}
 
@@ -1780,6 +2067,23 @@ AudioRegion::maximum_amplitude (Progress* p) const
 	samplepos_t const fend = start_sample() + length_samples();
 	double maxamp = 0;
 
+	/* use the peakfiles if possible, those only need raw data at the edges */
+	uint32_t c;
+	for (c = 0; c < n_channels(); ++c) {
+		if (!audio_source (c)->peak_amplitude (start_sample(), length_samples(), maxamp)) {
+			break;
+		}
+	}
+
+	if (c == n_channels()) {
+		if (p) {
+			p->set_progress (1.0);
+		}
+		return maxamp;
+	}
+
+	maxamp = 0;
+
 	samplecnt_t const blocksize = 64 * 1024;
 	Sample buf[blocksize];
 
@@ -1832,6 +2136,60 @@ AudioRegion::rms (Progress* p) const
 		return 0;
 	}
 
+	/* use the cached block statistics of the sources,
+	 * read raw data only for partial blocks at the edges
+	 */
+	uint32_t c;
+	for (c = 0; c < n_chan; ++c) {
+		std::shared_ptr<AudioSource const> src (audio_source (c));
+		samplecnt_t const bs = src->block_stats_size ();
+
+		if (p) {
+			p->descend (1.0 / n_chan);
+		}
+		std::shared_ptr<AudioSource::BlockStatsList const> stats (src->block_stats (p));
+		if (p) {
+			p->ascend ();
+			if (p->cancelled ()) {
+				return -1;
+			}
+		}
+
+		samplepos_t const first = (fpos + bs - 1) / bs;
+		samplepos_t const last  = fend / bs;
+
+		if (!stats || last <= first || (samplecnt_t) stats->size () < last || bs > blocksize) {
+			break;
+		}
+
+		for (samplepos_t b = first; b < last; ++b) {
+			rms += (*stats)[b].sumsq;
+		}
+
+		samplecnt_t const head = first * bs - fpos;
+		samplecnt_t const tail = fend - last * bs;
+
+		if (head > 0 && read_raw_internal (buf, fpos, head, c) != head) {
+			break;
+		}
+		for (samplecnt_t i = 0; i < head; ++i) {
+			rms += buf[i] * buf[i];
+		}
+
+		if (tail > 0 && read_raw_internal (buf, last * bs, tail, c) != tail) {
+			break;
+		}
+		for (samplecnt_t i = 0; i < tail; ++i) {
+			rms += buf[i] * buf[i];
+		}
+	}
+
+	if (c == n_chan) {
+		return sqrt (2. * rms / (double)((fend - fpos) * n_chan));
+	}
+
+	rms = 0;
+
 	while (fpos < fend) {
 		samplecnt_t const to_read = min (fend - fpos, blocksize);
 		for (uint32_t c = 0; c < n_chan; ++c) {
@@ -1856,6 +2214,130 @@ AudioRegion::rms (Progress* p) const
 
 bool
 AudioRegion::loudness (float& tp, float& i, float& s, float& m, Progress* p) const
+{
+	uint32_t const n_chan = n_channels ();
+
+	tp = i = s = m = -200;
+
+	if (n_chan == 0 || n_chan > 5) {
+		return loudness_analysis (tp, i, s, m, p);
+	}
+
+	/* compute loudness from the cached block statistics of the sources,
+	 * with the same channel weighting as LUFSMeter
+	 */
+	samplecnt_t const bs = audio_source (0)->block_stats_size ();
+	std::vector<std::shared_ptr<AudioSource::BlockStatsList const> > stats;
+
+	for (uint32_t c = 0; c < n_chan; ++c) {
+		if (p) {
+			p->descend (1.0 / n_chan);
+		}
+		stats.push_back (audio_source (c)->block_stats (p));
+		if (p) {
+			p->ascend ();
+			if (p->cancelled ()) {
+				return false;
+			}
+		}
+		if (!stats.back () || audio_source (c)->block_stats_size () != bs) {
+			return loudness_analysis (tp, i, s, m, p);
+		}
+	}
+
+	samplepos_t const fpos = start_sample ();
+	samplepos_t const fend = start_sample () + length_samples ();
+
+	/* true-peak: all blocks touching the region */
+	float peak = 0;
+	for (uint32_t c = 0; c < n_chan; ++c) {
+		samplepos_t const last = std::min<samplepos_t> ((fend + bs - 1) / bs, stats[c]->size ());
+		for (samplepos_t b = fpos / bs; b < last; ++b) {
+			peak = std::max (peak, (*stats[c])[b].true_peak);
+		}
+	}
+	tp = peak;
+
+	/* loudness: only blocks that are completely inside the region */
+	samplepos_t const first = (fpos + bs - 1) / bs;
+	samplepos_t       last  = fend / bs;
+
+	for (uint32_t c = 0; c < n_chan; ++c) {
+		last = std::min<samplepos_t> (last, stats[c]->size ());
+	}
+
+	if (last - first < 4) {
+		return true;
+	}
+
+	float const g[5] = { 1.0, 1.0, 1.0, 1.41, 1.41 };
+
+	std::vector<double> pwr;
+	pwr.reserve (last - first);
+
+	for (samplepos_t b = first; b < last; ++b) {
+		double sum = 0;
+		for (uint32_t c = 0; c < n_chan; ++c) {
+			sum += (*stats[c])[b].kpower * g[c];
+		}
+		if (n_chan == 1) {
+			sum *= 2;
+		}
+		pwr.push_back (sum / bs);
+	}
+
+	/* momentary (400ms) blocks with 75% overlap, short term (3s) windows */
+	std::vector<double> gated;
+	double              sum_m = 0;
+	double              sum_s = 0;
+
+	for (size_t b = 0; b < pwr.size (); ++b) {
+		sum_m += pwr[b];
+		sum_s += pwr[b];
+		if (b >= 4) {
+			sum_m -= pwr[b - 4];
+		}
+		if (b >= 30) {
+			sum_s -= pwr[b - 30];
+		}
+		if (b >= 3 && sum_m > 0) {
+			float const l_m = -0.691f + 10.f * log10f (sum_m / 4);
+			m = std::max (m, l_m);
+			if (l_m > -70.f) {
+				gated.push_back (sum_m / 4);
+			}
+		}
+		if (b >= 29 && sum_s > 0) {
+			s = std::max (s, -0.691f + 10.f * log10f (sum_s / 30));
+		}
+	}
+
+	/* ITU-R BS.1770 gating, absolute -70 LUFS, relative -10 LU */
+	if (!gated.empty ()) {
+		double sum = 0;
+		for (std::vector<double>::const_iterator b = gated.begin (); b != gated.end (); ++b) {
+			sum += *b;
+		}
+		double const thresh = sum / gated.size () * 0.1;
+
+		size_t n = 0;
+		sum      = 0;
+		for (std::vector<double>::const_iterator b = gated.begin (); b != gated.end (); ++b) {
+			if (*b > thresh) {
+				sum += *b;
+				++n;
+			}
+		}
+		if (n > 0) {
+			i = -0.691f + 10.f * log10f (sum / n);
+		}
+	}
+
+	return true;
+}
+
+bool
+AudioRegion::loudness_analysis (float& tp, float& i, float& s, float& m, Progress* p) const
 {
 	ARDOUR::AnalysisGraph ag (&_session);
 	tp = i = s = m = -200;
@@ -2511,6 +2993,7 @@ AudioRegion::_add_plugin (std::shared_ptr<RegionFxPlugin> rfx, std::shared_ptr<R
 					if (ac && ac->automation_playback ()) {
 						return;
 					}
+					fx_render_invalidate ();
 					if (!_invalidated.exchange (true)) {
 					  /* catch changes from some custom plugin GUI threads (VST2, and JUCE) */
 						if (SessionEvent::has_per_thread_pool ()) {
@@ -2525,6 +3008,7 @@ AudioRegion::_add_plugin (std::shared_ptr<RegionFxPlugin> rfx, std::shared_ptr<R
 		}
 		ac->alist()->StateChanged.connect_same_thread (*this, [this] ()
 				{
+					fx_render_invalidate ();
 					if (!_invalidated.exchange (true)) {
 						send_change (PropertyChange (Properties::region_fx)); // trigger DiskReader overwrite
 					}
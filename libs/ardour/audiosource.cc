@@ -34,6 +34,7 @@
 #include <cerrno>
 #include <ctime>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <algorithm>
 #include <vector>
@@ -54,10 +55,12 @@
 
 #include "pbd/file_utils.h"
 #include "pbd/playback_buffer.h"
+#include "pbd/progress.h"
 #include "pbd/scoped_file_descriptor.h"
 #include "pbd/xml++.h"
 
 #include "ardour/audiosource.h"
+#include "ardour/lufs_meter.h"
 #include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/session.h"
@@ -90,6 +93,7 @@ AudioSource::AudioSource (Session& s, const string& name)
 	, _last_scale (0.0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
+	, _block_stats_length (0)
 {
 }
 
@@ -106,6 +110,7 @@ AudioSource::AudioSource (Session& s, const XMLNode& node)
 	, _last_scale (0.0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
+	, _block_stats_length (0)
 {
 	if (set_state (node, Stateful::loading_state_version)) {
 		throw failed_constructor();
@@ -881,6 +886,7 @@ AudioSource::close_peakfile ()
 		::g_unlink (_peakpath.c_str());
 	}
 	_peaks_built = false;
+	remove_block_stats ();
 	return 0;
 }
 
@@ -1172,3 +1178,233 @@ AudioSource::mark_streaming_write_completed (const WriterLock& lock, Temporal::t
 		PeaksReady (); /* EMIT SIGNAL */
 	}
 }
+
+bool
+AudioSource::peak_amplitude (samplepos_t start, samplecnt_t cnt, double& peak) const
+{
+	{
+		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
+		if (!_peaks_built) {
+			return false;
+		}
+	}
+
+	if (start < 0 || cnt <= 0 || start + cnt > _length.samples ()) {
+		return false;
+	}
+
+	/* whole peaks inside the range */
+	samplepos_t const first = (start + _FPP - 1) / _FPP;
+	samplepos_t const last  = (start + cnt) / _FPP;
+
+	if (last <= first) {
+		return false;
+	}
+
+	/* partial peaks at the edges, read raw data */
+	Sample            buf[_FPP];
+	samplecnt_t const head = first * _FPP - start;
+	samplecnt_t const tail = start + cnt - last * _FPP;
+
+	if (head > 0) {
+		if (read (buf, start, head) != head) {
+			return false;
+		}
+		peak = compute_peak (buf, head, peak);
+	}
+
+	if (tail > 0) {
+		if (read (buf, last * _FPP, tail) != tail) {
+			return false;
+		}
+		peak = compute_peak (buf, tail, peak);
+	}
+
+	samplecnt_t const            chunk = 16384;
+	std::unique_ptr<PeakData[]> peaks (new PeakData[chunk]);
+
+	for (samplepos_t p = first; p < last; p += chunk) {
+		samplecnt_t const n = std::min (chunk, last - p);
+		if (read_peaks (peaks.get (), n, p * _FPP, n * _FPP, _FPP)) {
+			return false;
+		}
+		for (samplecnt_t i = 0; i < n; ++i) {
+			peak = std::max<double> (peak, std::max (fabsf (peaks[i].min), fabsf (peaks[i].max)));
+		}
+	}
+
+	return true;
+}
+
+/* header of the block statistics file in the session's analysis folder */
+struct BlockStatsHeader {
+	char    magic[8];
+	int64_t length;
+	int64_t block_size;
+	int64_t n_blocks;
+};
+
+static const char block_stats_magic[8] = { 'A', 'R', 'D', 'B', 'L', 'K', 'S', '1' };
+
+samplecnt_t
+AudioSource::block_stats_size () const
+{
+	return std::max<samplecnt_t> (1, floor (sample_rate () / 10.0));
+}
+
+std::string
+AudioSource::get_block_stats_path () const
+{
+	return Glib::build_filename (_session.analysis_dir (), id ().to_s () + ".blockstats");
+}
+
+int
+AudioSource::load_block_stats (BlockStatsList& stats) const
+{
+	FILE* f = g_fopen (get_block_stats_path ().c_str (), "rb");
+	if (!f) {
+		return -1;
+	}
+
+	BlockStatsHeader h;
+	int              rv = -1;
+
+	if (fread (&h, sizeof (h), 1, f) == 1
+	    && memcmp (h.magic, block_stats_magic, sizeof (h.magic)) == 0
+	    && h.length == _length.samples ()
+	    && h.block_size == block_stats_size ()
+	    && h.n_blocks == (h.length + h.block_size - 1) / h.block_size) {
+		stats.resize (h.n_blocks);
+		if (h.n_blocks == 0 || fread (&stats[0], sizeof (BlockStats), h.n_blocks, f) == (size_t) h.n_blocks) {
+			rv = 0;
+		}
+	}
+
+	::fclose (f);
+	return rv;
+}
+
+int
+AudioSource::save_block_stats (BlockStatsList const& stats) const
+{
+	std::string const path = get_block_stats_path ();
+
+	FILE* f = g_fopen (path.c_str (), "wb");
+	if (!f) {
+		return -1;
+	}
+
+	BlockStatsHeader h;
+	memcpy (h.magic, block_stats_magic, sizeof (h.magic));
+	h.length     = _length.samples ();
+	h.block_size = block_stats_size ();
+	h.n_blocks   = stats.size ();
+
+	bool ok = fwrite (&h, sizeof (h), 1, f) == 1;
+	if (ok && !stats.empty ()) {
+		ok = fwrite (&stats[0], sizeof (BlockStats), stats.size (), f) == stats.size ();
+	}
+
+	::fclose (f);
+
+	if (!ok) {
+		::g_unlink (path.c_str ());
+		return -1;
+	}
+	return 0;
+}
+
+void
+AudioSource::remove_block_stats ()
+{
+	Glib::Threads::Mutex::Lock lm (_block_stats_lock);
+	_block_stats.reset ();
+	_block_stats_length = 0;
+	::g_unlink (get_block_stats_path ().c_str ());
+}
+
+std::shared_ptr<AudioSource::BlockStatsList const>
+AudioSource::block_stats (Progress* p) const
+{
+	Glib::Threads::Mutex::Lock lm (_block_stats_lock);
+
+	samplecnt_t const len = _length.samples ();
+
+	if (_block_stats && _block_stats_length == len) {
+		return _block_stats;
+	}
+
+	std::shared_ptr<BlockStatsList> stats (new BlockStatsList);
+
+	if (load_block_stats (*stats) == 0) {
+		_block_stats        = stats;
+		_block_stats_length = len;
+		return _block_stats;
+	}
+
+	samplecnt_t const bs    = block_stats_size ();
+	samplecnt_t const chunk = 16 * bs;
+
+	std::unique_ptr<Sample[]> buf (new Sample[chunk]);
+
+	/* K-weighting filter and true-peak upsampler state, same as LUFSMeter */
+	KWeightCoeff const kw       = LUFSMeter::kweight_coefficients (sample_rate ());
+	true_peak_t const  upsample = sample_rate () > 48000 ? true_peak_x2 : true_peak_x4;
+
+	float  z1 = 0, z2 = 0, z3 = 0, z4 = 0;
+	float  hist[48];
+	float* h = hist;
+
+	memset (hist, 0, sizeof (hist));
+	stats->reserve ((len + bs - 1) / bs);
+
+	for (samplepos_t pos = 0; pos < len;) {
+		samplecnt_t const to_read = std::min (chunk, len - pos);
+
+		if (read (buf.get (), pos, to_read) != to_read) {
+			return std::shared_ptr<BlockStatsList const> ();
+		}
+
+		for (samplecnt_t off = 0; off < to_read; off += bs) {
+			samplecnt_t const n = std::min (bs, to_read - off);
+			Sample const*     d = &buf[off];
+			BlockStats        b;
+
+			b.sumsq = 0;
+			for (samplecnt_t i = 0; i < n; ++i) {
+				b.sumsq += d[i] * d[i];
+			}
+
+			b.kpower = 0;
+			kweight_process (&d, 1, n, 0, kw, &z1, &z2, &z3, &z4, &b.kpower);
+
+			z1 = std::isfinite (z1) ? z1 : 0;
+			z2 = std::isfinite (z2) ? z2 : 0;
+			z3 = std::isfinite (z3) ? z3 : 0;
+			z4 = std::isfinite (z4) ? z4 : 0;
+
+			b.true_peak = 0;
+			upsample (&d, 1, n, &h, &b.true_peak);
+
+			stats->push_back (b);
+		}
+
+		pos += to_read;
+
+		if (p) {
+			p->set_progress (pos / (float) len);
+			if (p->cancelled ()) {
+				return std::shared_ptr<BlockStatsList const> ();
+			}
+		}
+	}
+
+	if (save_block_stats (*stats)) {
+		warning << string_compose (_("Cannot save analysis data of source %1"), name ()) << endmsg;
+	}
+
+	_block_stats        = stats;
+	_block_stats_length = len;
+
+	return _block_stats;
+}
@@ -0,0 +1,292 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <vector>
+
+#include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
+
+#include "pbd/compose.h"
+#include "pbd/error.h"
+#include "pbd/file_utils.h"
+#include "pbd/gstdio_compat.h"
+
+#include "ardour/automation_event_store.h"
+
+#include "pbd/i18n.h"
+
+using namespace ARDOUR;
+using namespace PBD;
+using namespace Temporal;
+
+namespace {
+
+const char     blob_magic[8]  = { 'A', 'r', 'd', 'A', 'E', 'v', 't', '1' };
+const uint32_t blob_byteorder = 0x01020304;
+const char*    blob_suffix    = ".events";
+
+struct BlobHeader {
+	char     magic[8];
+	uint32_t byte_order;  /* blob_byteorder in the byte order of the writer */
+	uint32_t time_domain; /* 0: audio time (superclock), 1: beat time (ticks) */
+	uint64_t n_events;
+};
+
+struct BlobEvent {
+	int64_t when;
+	double  value;
+};
+
+void
+no_delete (void*)
+{
+}
+
+} // namespace
+
+Glib::Threads::Private<AutomationEventStore> AutomationEventStore::_thread_store (no_delete);
+
+AutomationEventStore::AutomationEventStore (std::string const& dir)
+	: _dir (dir)
+{
+}
+
+std::string
+AutomationEventStore::blob_path (std::string const& blob) const
+{
+	return Glib::build_filename (_dir, blob + blob_suffix);
+}
+
+bool
+AutomationEventStore::referenced_blobs (std::string const& state_file, std::set<std::string>& blobs)
+{
+	std::string xml;
+	try {
+		xml = Glib::file_get_contents (state_file);
+	} catch (Glib::FileError const& e) {
+		error << string_compose (_("Cannot read \"%1\" to find unused automation data (%2)"), state_file, e.what ()) << endmsg;
+		return false;
+	}
+
+	/* <events blob="SHA1" .../>, see AutomationList::serialize_events */
+	std::string const      key = X_("blob=\"");
+	std::string::size_type pos = 0;
+	while ((pos = xml.find (key, pos)) != std::string::npos) {
+		pos += key.size ();
+		std::string::size_type const end = xml.find ('"', pos);
+		if (end == std::string::npos) {
+			break;
+		}
+		blobs.insert (xml.substr (pos, end - pos));
+		pos = end;
+	}
+	return true;
+}
+
+size_t
+AutomationEventStore::remove_unreferenced (std::vector<std::string> const& state_files) const
+{
+	if (!Glib::file_test (_dir, Glib::FILE_TEST_IS_DIR)) {
+		return 0;
+	}
+
+	std::set<std::string> used;
+	for (std::vector<std::string>::const_iterator i = state_files.begin (); i != state_files.end (); ++i) {
+		if (!referenced_blobs (*i, used)) {
+			return 0;
+		}
+	}
+
+	std::vector<std::string> files;
+	find_files_matching_pattern (files, _dir, std::string ("*") + blob_suffix);
+
+	size_t n = 0;
+	for (std::vector<std::string>::const_iterator i = files.begin (); i != files.end (); ++i) {
+		std::string const name = Glib::path_get_basename (*i);
+		if (used.find (name.substr (0, name.size () - strlen (blob_suffix))) != used.end ()) {
+			continue;
+		}
+		if (::g_unlink (i->c_str ()) == 0) {
+			++n;
+		}
+	}
+
+	/* left over from failed writes */
+	files.clear ();
+	find_files_matching_pattern (files, _dir, std::string ("*") + blob_suffix + X_(".tmp"));
+	for (std::vector<std::string>::const_iterator i = files.begin (); i != files.end (); ++i) {
+		::g_unlink (i->c_str ());
+	}
+
+	return n;
+}
+
+std::string
+AutomationEventStore::write (Evoral::ControlList::EventList const& events, TimeDomain td) const
+{
+	size_t const size = sizeof (BlobHeader) + events.size () * sizeof (BlobEvent);
+	std::vector<char> buf (size);
+
+	BlobHeader h;
+	memcpy (h.magic, blob_magic, sizeof (h.magic));
+	h.byte_order  = blob_byteorder;
+	h.time_domain = td == BeatTime ? 1 : 0;
+	h.n_events    = events.size ();
+	memcpy (&buf[0], &h, sizeof (h));
+
+	char* p = &buf[sizeof (h)];
+	for (Evoral::ControlList::EventList::const_iterator i = events.begin (); i != events.end (); ++i) {
+		if ((*i)->when.time_domain () != td) {
+			/* mixed time domains, use text */
+			return std::string ();
+		}
+		BlobEvent e;
+		e.when  = td == BeatTime ? (*i)->when.ticks () : (*i)->when.superclocks ();
+		e.value = (*i)->value;
+		memcpy (p, &e, sizeof (e));
+		p += sizeof (e);
+	}
+
+	gchar* sum = g_compute_checksum_for_data (G_CHECKSUM_SHA1, (guchar const*) &buf[0], size);
+	std::string const blob (sum);
+	g_free (sum);
+
+	std::string const path = blob_path (blob);
+
+	GStatBuf statbuf;
+	if (g_stat (path.c_str (), &statbuf) == 0 && (size_t) statbuf.st_size == size) {
+		/* identical content, already stored */
+		return blob;
+	}
+
+	if (g_mkdir_with_parents (_dir.c_str (), 0755) < 0) {
+		error << string_compose (_("Cannot create automation folder \"%1\" (%2)"), _dir, strerror (errno)) << endmsg;
+		return std::string ();
+	}
+
+	std::string const tmp = path + X_(".tmp");
+
+	FILE* f = g_fopen (tmp.c_str (), "wb");
+	if (!f) {
+		error << string_compose (_("Cannot write automation data to \"%1\" (%2)"), tmp, strerror (errno)) << endmsg;
+		return std::string ();
+	}
+
+	bool ok = fwrite (&buf[0], 1, size, f) == size;
+	ok      = fclose (f) == 0 && ok;
+
+	if (!ok || ::g_rename (tmp.c_str (), path.c_str ()) != 0) {
+		error << string_compose (_("Cannot write automation data to \"%1\" (%2)"), path, strerror (errno)) << endmsg;
+		::g_unlink (tmp.c_str ());
+		return std::string ();
+	}
+
+	return blob;
+}
+
+std::shared_ptr<AutomationEventStore::Mapping>
+AutomationEventStore::map (std::string const& blob) const
+{
+	std::string const path = blob_path (blob);
+	GError*           err  = 0;
+
+	GMappedFile* file = g_mapped_file_new (path.c_str (), false, &err);
+	if (!file) {
+		error << string_compose (_("Cannot map automation data \"%1\" (%2)"), path, err ? err->message : "") << endmsg;
+		if (err) {
+			g_error_free (err);
+		}
+		return std::shared_ptr<Mapping> ();
+	}
+
+	std::shared_ptr<Mapping> m (new Mapping (file));
+	if (!m->_events) {
+		error << string_compose (_("Invalid automation data in \"%1\""), path) << endmsg;
+		return std::shared_ptr<Mapping> ();
+	}
+	return m;
+}
+
+AutomationEventStore::Mapping::Mapping (GMappedFile* file)
+	: _file (file)
+	, _events (0)
+	, _n_events (0)
+	, _time_domain (AudioTime)
+{
+	char const* data = g_mapped_file_get_contents (_file);
+	size_t      len  = g_mapped_file_get_length (_file);
+
+	BlobHeader h;
+	if (!data || len < sizeof (h)) {
+		return;
+	}
+
+	memcpy (&h, data, sizeof (h));
+
+	if (memcmp (h.magic, blob_magic, sizeof (h.magic)) || h.byte_order != blob_byteorder) {
+		return;
+	}
+	if (h.n_events > (len - sizeof (h)) / sizeof (BlobEvent)) {
+		/* truncated */
+		return;
+	}
+
+	_events      = data + sizeof (h);
+	_n_events    = h.n_events;
+	_time_domain = h.time_domain ? BeatTime : AudioTime;
+}
+
+AutomationEventStore::Mapping::~Mapping ()
+{
+	g_mapped_file_unref (_file);
+}
+
+timepos_t
+AutomationEventStore::Mapping::when (size_t i) const
+{
+	BlobEvent e;
+	memcpy (&e, _events + i * sizeof (e), sizeof (e));
+	return _time_domain == BeatTime ? timepos_t::from_ticks (e.when) : timepos_t::from_superclock (e.when);
+}
+
+double
+AutomationEventStore::Mapping::value (size_t i) const
+{
+	BlobEvent e;
+	memcpy (&e, _events + i * sizeof (e), sizeof (e));
+	return e.value;
+}
+
+AutomationEventStore::Scope::Scope (AutomationEventStore* store)
+	: _old (_thread_store.get ())
+{
+	_thread_store.set (store);
+}
+
+AutomationEventStore::Scope::~Scope ()
+{
+	_thread_store.set (_old);
+}
+
+AutomationEventStore*
+AutomationEventStore::thread_store ()
+{
+	return _thread_store.get ();
+}
@@ -30,6 +30,7 @@
 
 #include "temporal/types_convert.h"
 
+#include "ardour/automation_event_store.h"
 #include "ardour/automation_list.h"
 #include "ardour/event_type_map.h"
 #include "ardour/parameter_descriptor.h"
@@ -374,6 +375,17 @@ AutomationList::serialize_events (bool need_lock) const
 	if (need_lock) {
 		lm.acquire ();
 	}
+
+	AutomationEventStore const* store = AutomationEventStore::thread_store ();
+	if (store && _events.size () >= AutomationEventStore::min_events) {
+		std::string const blob = store->write (_events, time_domain ());
+		if (!blob.empty ()) {
+			node->set_property (X_("blob"), blob);
+			node->set_property (X_("count"), (uint64_t) _events.size ());
+			return *node;
+		}
+	}
+
 	for (const_iterator xx = _events.begin(); xx != _events.end(); ++xx) {
 		str << PBD::to_string ((*xx)->when);
 		str << ' ';
@@ -394,6 +406,11 @@ AutomationList::serialize_events (bool need_lock) const
 int
 AutomationList::deserialize_events (const XMLNode& node)
 {
+	std::string blob;
+	if (node.get_property (X_("blob"), blob)) {
+		return deserialize_blob (blob);
+	}
+
 	if (node.children().empty()) {
 		return -1;
 	}
@@ -442,15 +459,51 @@ AutomationList::deserialize_events (const XMLNode& node)
 	return 0;
 }
 
+int
+AutomationList::deserialize_blob (std::string const& blob)
+{
+	AutomationEventStore const* store = AutomationEventStore::thread_store ();
+	if (!store) {
+		error << string_compose (_("automation list: automation data \"%1\" is not available here, all points ignored"), blob) << endmsg;
+		return -1;
+	}
+
+	std::shared_ptr<AutomationEventStore::Mapping> m (store->map (blob));
+	if (!m) {
+		return -1;
+	}
+
+	ControlList::freeze ();
+	clear ();
+
+	for (size_t i = 0; i < m->n_events (); ++i) {
+		double const y = std::min ((double)_desc.upper, std::max ((double)_desc.lower, m->value (i)));
+		fast_simple_add (m->when (i), y);
+	}
+
+	mark_dirty ();
+	maybe_signal_changed ();
+	thaw ();
+
+	return 0;
+}
+
 int
 AutomationList::set_state (const XMLNode& node, int version)
 {
-	XMLNodeList nlist = node.children();
+	static const XMLPropertyName prop_time_domain ("time-domain");
+	static const XMLPropertyName prop_x ("x");
+	static const XMLPropertyName prop_y ("y");
+	static const XMLPropertyName prop_automation_id ("automation-id");
+	static const XMLPropertyName prop_interpolation_style ("interpolation-style");
+	static const XMLPropertyName prop_state ("state");
+
+	XMLNodeList const& nlist = node.children();
 	XMLNode* nsos;
-	XMLNodeIterator niter;
+	XMLNodeConstIterator niter;
 	Temporal::TimeDomain time_domain;
 
-	if (node.get_property ("time-domain", time_domain)) {
+	if (node.get_property (prop_time_domain, time_domain)) {
 		set_time_domain (time_domain);
 	}
 
@@ -477,13 +530,13 @@ AutomationList::set_state (const XMLNode& node, int version)
 		for (i = elist.begin(); i != elist.end(); ++i) {
 
 			pframes_t x;
-			if (!(*i)->get_property ("x", x)) {
+			if (!(*i)->get_property (prop_x, x)) {
 				error << _("automation list: no x-coordinate stored for control point (point ignored)") << endmsg;
 				continue;
 			}
 
 			double y;
-			if (!(*i)->get_property ("y", y)) {
+			if (!(*i)->get_property (prop_y, y)) {
 				error << _("automation list: no y-coordinate stored for control point (point ignored)") << endmsg;
 				continue;
 			}
@@ -508,17 +561,17 @@ AutomationList::set_state (const XMLNode& node, int version)
 	}
 
 	std::string value;
-	if (node.get_property (X_("automation-id"), value)) {
+	if (node.get_property (prop_automation_id, value)) {
 		_parameter = EventTypeMap::instance().from_symbol(value);
 	} else {
 		warning << "Legacy session: automation list has no automation-id property." << endmsg;
 	}
 
-	if (!node.get_property (X_("interpolation-style"), _interpolation)) {
+	if (!node.get_property (prop_interpolation_style, _interpolation)) {
 		_interpolation = default_interpolation ();
 	}
 
-	if (node.get_property (X_("state"), _state)) {
+	if (node.get_property (prop_state, _state)) {
 		if (_state == Write) {
 			_state = Off;
 		}
@@ -18,6 +18,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 
 #include "pbd/compose.h"
@@ -31,6 +33,10 @@ using namespace PBD;
 RingBufferNPT<ThreadBuffers*>* BufferManager::thread_buffers      = 0;
 std::list<ThreadBuffers*>*     BufferManager::thread_buffers_list = 0;
 Glib::Threads::Mutex           BufferManager::rb_mutex;
+ChanCount                      BufferManager::_howmany;
+size_t                         BufferManager::_custom     = 0;
+uint32_t                       BufferManager::_n_reserved = 0;
+uint32_t                       BufferManager::_n_added    = 0;
 
 using std::cerr;
 using std::endl;
@@ -81,4 +87,53 @@ BufferManager::ensure_buffers (ChanCount howmany, size_t custom)
 	for (ThreadBufferList::iterator i = thread_buffers_list->begin (); i != thread_buffers_list->end (); ++i) {
 		(*i)->ensure_buffers (howmany, custom);
 	}
+
+	/* for buffers added later */
+	_howmany = howmany;
+	_custom  = custom;
+}
+
+void
+BufferManager::reserve_thread_buffers (uint32_t n)
+{
+	Glib::Threads::Mutex::Lock em (rb_mutex);
+
+	_n_reserved += n;
+
+	if (_n_reserved <= _n_added) {
+		/* buffers of threads that exited are re-used */
+		return;
+	}
+
+	uint32_t const add = _n_reserved - _n_added;
+
+	ThreadBufferFIFO* fifo = new ThreadBufferFIFO (thread_buffers->bufsize () + add);
+	ThreadBuffers*    tbp;
+
+	while (thread_buffers->read (&tbp, 1) == 1) {
+		fifo->write (&tbp, 1);
+	}
+
+	delete thread_buffers;
+	thread_buffers = fifo;
+
+	for (uint32_t i = 0; i < add; ++i) {
+		ThreadBuffers* ts = new ThreadBuffers;
+		if (_howmany.n_total () > 0) {
+			ts->ensure_buffers (_howmany, _custom);
+		}
+		thread_buffers->write (&ts, 1);
+		thread_buffers_list->push_back (ts);
+	}
+
+	_n_added = _n_reserved;
+}
+
+void
+BufferManager::release_thread_buffers (uint32_t n)
+{
+	Glib::Threads::Mutex::Lock em (rb_mutex);
+
+	assert (_n_reserved >= n);
+	_n_reserved -= std::min (n, _n_reserved);
 }
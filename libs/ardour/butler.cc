@@ -276,6 +276,8 @@ Butler::thread_work ()
 
 		std::shared_ptr<IOTaskList> tl = _session.io_tasklist ();
 
+		refill_stats.start ();
+
 		for (i = rl_with_auditioner.begin (); !transport_work_requested () && should_run && i != rl_with_auditioner.end (); ++i) {
 			std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (*i);
 
@@ -313,6 +315,8 @@ Butler::thread_work ()
 		tl->process ();
 		tl.reset ();
 
+		refill_stats.update ();
+
 		if (i != rl_with_auditioner.begin () && i != rl_with_auditioner.end ()) {
 			/* we didn't get to all the streams */
 			disk_work_outstanding = true;
@@ -17,9 +17,17 @@
  */
 
 #include <assert.h>
+#include <map>
 
+#include <glibmm/threads.h>
+
+#include "pbd/compose.h"
+#include "pbd/cpus.h"
 #include "pbd/error.h"
+#include "pbd/gstdio_compat.h"
+#include "pbd/mpmc_queue.h"
 #include "pbd/pthread_utils.h"
+#include "pbd/semutils.h"
 
 #include "ardour/audio_buffer.h"
 #include "ardour/audioengine.h"
@@ -39,19 +47,187 @@ using namespace ARDOUR;
 using namespace ARDOUR::DSP;
 using namespace ArdourZita;
 
+namespace {
+
+/** Worker threads that process tail partitions of all convolvers
+ * which use non-uniform partitioning.
+ *
+ * Jobs are queued by partition size. Smaller partitions are due
+ * earlier and are processed first. A job that was not started when
+ * its result is due, is processed by the process thread itself (see
+ * Convlevel::complete), the process thread only waits for jobs that
+ * are in progress.
+ *
+ * The pool is shared by all processors that use it, and the
+ * threads are stopped when the last one is deleted.
+ */
+class ConvTailPool : public Convsched
+{
+public:
+	ConvTailPool ()
+		: _sem ("convolver tail", 0)
+		, _run (true)
+	{
+		for (uint32_t l = 0; l < N_LANES; ++l) {
+			_lanes[l].reserve (1024);
+		}
+
+		uint32_t const n_threads = std::min<uint32_t> (4, std::max<uint32_t> (1, hardware_concurrency () / 2));
+
+		/* same as process-threads, which may wait for a job in progress */
+		int const priority = PBD_RT_PRI_PROC;
+
+		for (uint32_t i = 0; i < n_threads; ++i) {
+			pthread_t t;
+			if (pbd_realtime_pthread_create ("ConvTail", PBD_SCHED_FIFO, priority, PBD_RT_STACKSIZE_HELP, &t, &_worker_thread, this)) {
+				if (pbd_pthread_create (PBD_RT_STACKSIZE_HELP, &t, &_worker_thread, this)) {
+					break;
+				}
+			}
+			_workers.push_back (t);
+		}
+	}
+
+	~ConvTailPool ()
+	{
+		/* all processors that used the pool were cleaned up, no jobs are queued */
+		_run.store (false);
+		for (size_t i = 0; i < _workers.size (); ++i) {
+			_sem.signal ();
+		}
+		for (std::vector<pthread_t>::const_iterator i = _workers.begin (); i != _workers.end (); ++i) {
+			pthread_join (*i, 0);
+		}
+	}
+
+	bool available () const
+	{
+		return !_workers.empty ();
+	}
+
+	bool schedule (Convjob* job)
+	{
+		if (!_lanes[lane (job->parsize ())].push_back (job)) {
+			/* queue overflow, the process thread runs the job */
+			return false;
+		}
+		_sem.signal ();
+		return true;
+	}
+
+private:
+	enum { N_LANES = 8 }; /* Convproc::MINPART .. Convproc::MAXPART */
+
+	static uint32_t lane (uint32_t parsize)
+	{
+		uint32_t l = 0;
+		for (parsize /= Convproc::MINPART; parsize > 1 && l < N_LANES - 1; parsize >>= 1) {
+			++l;
+		}
+		return l;
+	}
+
+	static void* _worker_thread (void* me)
+	{
+		pthread_set_name ("ConvTail");
+		static_cast<ConvTailPool*> (me)->run ();
+		return 0;
+	}
+
+	void run ()
+	{
+		while (true) {
+			_sem.wait ();
+			if (!_run.load ()) {
+				break;
+			}
+			Convjob* job;
+			for (uint32_t l = 0; l < N_LANES; ++l) {
+				if (_lanes[l].pop_front (job)) {
+					job->run ();
+					break;
+				}
+			}
+		}
+	}
+
+	PBD::MPMCQueue<Convjob*> _lanes[N_LANES];
+	PBD::Semaphore           _sem;
+	std::atomic<bool>        _run;
+	std::vector<pthread_t>   _workers;
+};
+
+Glib::Threads::Mutex        _tail_pool_lock;
+std::weak_ptr<ConvTailPool> _tail_pool;
+
+/** @return the shared tail pool, or NULL if no worker threads could be started */
+std::shared_ptr<Convsched>
+acquire_tail_pool ()
+{
+	Glib::Threads::Mutex::Lock lm (_tail_pool_lock);
+
+	std::shared_ptr<ConvTailPool> pool = _tail_pool.lock ();
+
+	if (!pool) {
+		pool.reset (new ConvTailPool ());
+		if (!pool->available ()) {
+			PBD::warning << _("Convolver: cannot start tail partition worker threads.") << endmsg;
+			return std::shared_ptr<Convsched> ();
+		}
+		_tail_pool = pool;
+	}
+
+	return pool;
+}
+
+/** Impulse-response data shared by convolvers with identical settings */
+Glib::Threads::Mutex                             _ir_cache_lock;
+std::map<std::string, std::weak_ptr<Convproc> > _ir_cache;
+
+void
+delete_convproc (Convproc* cp)
+{
+	cp->stop_process ();
+	cp->cleanup ();
+	delete cp;
+}
+
+} // namespace
+
 Convolution::Convolution (Session& session, uint32_t n_in, uint32_t n_out)
     : SessionHandleRef (session)
+    , _convproc (0)
     , _n_samples (0)
-    , _max_size (0)
     , _offset (0)
     , _configured (false)
     , _threaded (false)
     , _n_inputs (n_in)
     , _n_outputs (n_out)
+    , _head_size (0)
+    , _tail_size (0)
+    , _max_part (0)
+    , _active (0)
+    , _pending (0)
+    , _retired (0)
+    , _loader (0)
 {
 	AudioEngine::instance ()->BufferSizeChanged.connect_same_thread (*this, std::bind (&Convolution::restart, this));
 }
 
+Convolution::~Convolution ()
+{
+	drop_pending ();
+	delete _active;
+}
+
+Convolution::ConvprocRef::~ConvprocRef ()
+{
+	/* before releasing the data and scheduler it uses */
+	if (proc) {
+		delete_convproc (proc);
+	}
+}
+
 bool
 Convolution::add_impdata (
     uint32_t                    c_in,
@@ -83,51 +259,226 @@ Convolution::clear_impdata ()
 bool
 Convolution::ready () const
 {
-	return _configured && _convproc.state () == Convproc::ST_PROC;
+	return _configured && _convproc && _convproc->state () == Convproc::ST_PROC;
+}
+
+void
+Convolution::set_partitioning (uint32_t head_size, uint32_t tail_size)
+{
+	if (head_size == 0) {
+		_head_size = _tail_size = 0;
+		return;
+	}
+
+	uint32_t power_of_two;
+	for (power_of_two = 1; 1U << power_of_two < head_size; ++power_of_two) ;
+	_head_size = std::max<uint32_t> (Convproc::MINPART, std::min<uint32_t> (Convproc::MAXPART, 1U << power_of_two));
+
+	for (power_of_two = 1; 1U << power_of_two < tail_size; ++power_of_two) ;
+	_tail_size = std::max<uint32_t> (_head_size, std::min<uint32_t> (Convproc::MAXPART, 1U << power_of_two));
+}
+
+void
+Convolution::drop_pending ()
+{
+	if (_loader) {
+		_loader->join ();
+		delete _loader;
+		_loader = 0;
+	}
+
+	/* withdraw an impulse-response that was not yet picked up */
+	delete _pending.exchange (0);
+
+	/* the previous one, replaced by the process thread */
+	delete _retired.exchange (0);
 }
 
 void
 Convolution::restart ()
 {
-	_convproc.stop_process ();
-	_convproc.cleanup ();
-	_convproc.set_options (0);
+	/* wait for the process thread to leave run () */
+	Glib::Threads::Mutex::Lock lm (_proc_lock);
+
+	drop_pending ();
+
+	delete _active;
+	_active     = 0;
+	_convproc   = 0;
+	_configured = false;
 
 	if (_impdata.empty ()) {
-		_configured = false;
 		return;
 	}
 
-	uint32_t n_part;
-
-	if (_threaded) {
+	if (_head_size > 0) {
+		_n_samples = _head_size;
+		_max_part  = _tail_size;
+	} else if (_threaded) {
 		_n_samples = 64;
-		n_part     = Convproc::MAXPART;
+		_max_part  = Convproc::MAXPART;
 	} else {
 		_n_samples = _session.get_block_size ();
 		uint32_t power_of_two;
 		for (power_of_two = 1; 1U << power_of_two < _n_samples; ++power_of_two) ;
 		_n_samples = 1 << power_of_two;
-		n_part     = std::min ((uint32_t)Convproc::MAXPART, _n_samples);
+		_max_part  = std::min ((uint32_t)Convproc::MAXPART, _n_samples);
+	}
+
+	_offset = 0;
+
+	_active = create_convproc (_impdata);
+
+	assert (_active); // bail out in debug builds
+
+	if (!_active) {
+		return;
+	}
+
+	_convproc   = _active->proc;
+	_configured = true;
+
+#ifndef NDEBUG
+	_convproc->print (stdout);
+#endif
+}
+
+void
+Convolution::reload ()
+{
+	if (!_configured) {
+		restart ();
+		return;
+	}
+
+	drop_pending ();
+
+	_loader = PBD::Thread::create (std::bind (&Convolution::load_async, this, _impdata), "ConvolverLoad");
+
+	if (!_loader) {
+		restart ();
+	}
+}
+
+void
+Convolution::load_async (std::vector<ImpData> impdata)
+{
+	if (impdata.empty ()) {
+		return;
+	}
+
+	ConvprocRef* ref = create_convproc (impdata);
+
+	if (ref) {
+		_pending.store (ref);
+	}
+}
+
+void
+Convolution::swap_pending_convproc ()
+{
+	/* called in rt-context, at a partition boundary.
+	 * The previous processor is handed back to be freed by drop_pending (),
+	 * keep the current one until the retire slot is available.
+	 */
+	if (_retired.load ()) {
+		return;
 	}
+	ConvprocRef* ref = _pending.exchange (0);
+	if (!ref) {
+		return;
+	}
+	_retired.store (_active);
+	_active     = ref;
+	_convproc   = ref->proc;
+	_configured = true;
+}
 
-	_offset    = 0;
-	_max_size  = 0;
+Convolution::ConvprocRef*
+Convolution::create_convproc (std::vector<ImpData> const& impdata) const
+{
+	uint32_t max_size = 0;
 
-	for (std::vector<ImpData>::const_iterator i = _impdata.begin (); i != _impdata.end (); ++i) {
-		_max_size = std::max (_max_size, (uint32_t)i->readable_length_samples ());
+	for (std::vector<ImpData>::const_iterator i = impdata.begin (); i != impdata.end (); ++i) {
+		max_size = std::max (max_size, (uint32_t)i->readable_length_samples ());
 	}
 
-	int rv = _convproc.configure (
+	ConvprocRef* ref = new ConvprocRef;
+	Convproc*    cp  = new Convproc;
+
+	ref->proc = cp;
+
+	int rv = cp->configure (
 	    /*in*/ _n_inputs,
 	    /*out*/ _n_outputs,
-	    /*max-convolution length */ _max_size,
+	    /*max-convolution length */ max_size,
 	    /*quantum, nominal-buffersize*/ _n_samples,
 	    /*Convproc::MINPART*/ _n_samples,
-	    /*Convproc::MAXPART*/ n_part,
+	    /*Convproc::MAXPART*/ _max_part,
 	    /*density 0 = auto, i/o dependent */ 0);
 
-	for (std::vector<ImpData>::const_iterator i = _impdata.begin (); i != _impdata.end (); ++i) {
+	if (rv == 0 && !_ir_key.empty ()) {
+		/* share the FFT of the impulse-response with identical convolvers */
+		std::string const key = string_compose ("%1:%2:%3:%4:%5:%6", _ir_key, _n_inputs, _n_outputs, _n_samples, _max_part, max_size);
+
+		Glib::Threads::Mutex::Lock lm (_ir_cache_lock);
+
+		std::shared_ptr<Convproc>& master (ref->master);
+
+		master = _ir_cache[key].lock ();
+
+		if (!master) {
+			for (std::map<std::string, std::weak_ptr<Convproc> >::iterator i = _ir_cache.begin (); i != _ir_cache.end ();) {
+				if (i->second.expired ()) {
+					_ir_cache.erase (i++);
+				} else {
+					++i;
+				}
+			}
+
+			master.reset (new Convproc, &delete_convproc);
+			rv = master->configure (_n_inputs, _n_outputs, max_size, _n_samples, _n_samples, _max_part, 0);
+			if (rv == 0) {
+				rv = load_impdata (*master, impdata, max_size);
+			}
+			if (rv == 0) {
+				_ir_cache[key] = master;
+			}
+		}
+
+		if (rv == 0) {
+			rv = cp->impdata_link (*master);
+		}
+	} else if (rv == 0) {
+		rv = load_impdata (*cp, impdata, max_size);
+	}
+
+	if (rv == 0 && _head_size > 0) {
+		/* without worker threads, zita-convolver uses a thread per level */
+		ref->sched = acquire_tail_pool ();
+		if (ref->sched) {
+			rv = cp->set_scheduler (ref->sched.get ());
+		}
+	}
+
+	if (rv == 0) {
+		rv = cp->start_process (pbd_absolute_rt_priority (PBD_SCHED_FIFO, PBD_RT_PRI_PROC), PBD_SCHED_FIFO);
+	}
+
+	if (rv != 0) {
+		delete ref;
+		return 0;
+	}
+
+	return ref;
+}
+
+int
+Convolution::load_impdata (Convproc& cp, std::vector<ImpData> const& impdata, uint32_t max_size)
+{
+	int rv = 0;
+
+	for (std::vector<ImpData>::const_iterator i = impdata.begin (); i != impdata.end (); ++i) {
 		uint32_t pos = 0;
 
 		const float    ir_gain  = i->gain;
@@ -150,7 +501,7 @@ Convolution::restart ()
 				}
 			}
 
-			rv = _convproc.impdata_create (
+			rv = cp.impdata_create (
 			    /*i/o map */ i->c_in, i->c_out,
 			    /*stride, de-interleave */ 1,
 			    ir,
@@ -162,36 +513,25 @@ Convolution::restart ()
 
 			pos += ns;
 
-			if (pos == _max_size) {
+			if (pos == max_size) {
 				break;
 			}
 		}
 	}
 
-	if (rv == 0) {
-		rv = _convproc.start_process (pbd_absolute_rt_priority (PBD_SCHED_FIFO, PBD_RT_PRI_PROC), PBD_SCHED_FIFO);
-	}
-
-	assert (rv == 0); // bail out in debug builds
-
-	if (rv != 0) {
-		_convproc.stop_process ();
-		_convproc.cleanup ();
-		_configured = false;
-		return;
-	}
-
-	_configured = true;
-
-#ifndef NDEBUG
-	_convproc.print (stdout);
-#endif
+	return rv;
 }
 
 void
 Convolution::run (BufferSet& bufs, ChanMapping const& in_map, ChanMapping const& out_map, pframes_t n_samples, samplecnt_t offset)
 {
-	if (!ready ()) {
+	Glib::Threads::Mutex::Lock lm (_proc_lock, Glib::Threads::TRY_LOCK);
+
+	if (lm.locked ()) {
+		swap_pending ();
+	}
+
+	if (!lm.locked () || !ready ()) {
 		process_map (&bufs, ChanCount (DataType::AUDIO, _n_outputs), in_map, out_map, n_samples, offset);
 		return;
 	}
@@ -206,10 +546,10 @@ Convolution::run (BufferSet& bufs, ChanMapping const& in_map, ChanMapping const&
 			bool valid;
 			const uint32_t idx = in_map.get (DataType::AUDIO, c, &valid);
 			if (!valid) {
-				::memset (&_convproc.inpdata (c)[_offset], 0, sizeof (float) * ns);
+				::memset (&_convproc->inpdata (c)[_offset], 0, sizeof (float) * ns);
 			} else {
 				AudioBuffer const& ab (bufs.get_audio (idx));
-				memcpy (&_convproc.inpdata (c)[_offset], ab.data (done + offset), sizeof (float) * ns);
+				memcpy (&_convproc->inpdata (c)[_offset], ab.data (done + offset), sizeof (float) * ns);
 			}
 		}
 
@@ -218,7 +558,7 @@ Convolution::run (BufferSet& bufs, ChanMapping const& in_map, ChanMapping const&
 			const uint32_t idx = out_map.get (DataType::AUDIO, c, &valid);
 			if (valid) {
 				AudioBuffer& ab (bufs.get_audio (idx));
-				memcpy (ab.data (done + offset), &_convproc.outdata (c)[_offset], sizeof (float) * ns);
+				memcpy (ab.data (done + offset), &_convproc->outdata (c)[_offset], sizeof (float) * ns);
 			}
 		}
 
@@ -227,7 +567,7 @@ Convolution::run (BufferSet& bufs, ChanMapping const& in_map, ChanMapping const&
 		remain  -= ns;
 
 		if (_offset == _n_samples) {
-			_convproc.process ();
+			_convproc->process ();
 			_offset = 0;
 		}
 	}
@@ -319,6 +659,15 @@ Convolver::Convolver (
 #endif
 
 		add_impdata (io_i, io_o, r, chan_gain, chan_delay);
+		_ir_key += string_compose ("%1:%2:%3:%4:%5;", ir_c, io_i, io_o, chan_gain, chan_delay);
+	}
+
+	/* a modified file must not be served from the cache */
+	GStatBuf statbuf;
+	if (g_stat (path.c_str (), &statbuf) == 0) {
+		_ir_key = string_compose ("%1|%2|%3|%4", path, (int64_t) statbuf.st_mtime, _irc, _ir_key);
+	} else {
+		_ir_key.clear ();
 	}
 
 	Convolution::restart ();
@@ -334,7 +683,16 @@ Convolver::run_mono_buffered (float* buf, uint32_t n_samples)
 void
 Convolution::run_mono_buffered (float* buf, uint32_t n_samples)
 {
-	assert (_convproc.state () == Convproc::ST_PROC);
+	Glib::Threads::Mutex::Lock lm (_proc_lock, Glib::Threads::TRY_LOCK);
+
+	if (lm.locked ()) {
+		swap_pending ();
+	}
+
+	if (!lm.locked () || !ready ()) {
+		memset (buf, 0, sizeof (float) * n_samples);
+		return;
+	}
 
 	uint32_t done   = 0;
 	uint32_t remain = n_samples;
@@ -342,8 +700,8 @@ Convolution::run_mono_buffered (float* buf, uint32_t n_samples)
 	while (remain > 0) {
 		uint32_t ns = std::min (remain, _n_samples - _offset);
 
-		float* const       in  = _convproc.inpdata (/*channel*/ 0);
-		float const* const out = _convproc.outdata (/*channel*/ 0);
+		float* const       in  = _convproc->inpdata (/*channel*/ 0);
+		float const* const out = _convproc->outdata (/*channel*/ 0);
 
 		memcpy (&in[_offset], &buf[done], sizeof (float) * ns);
 		memcpy (&buf[done], &out[_offset], sizeof (float) * ns);
@@ -353,7 +711,7 @@ Convolution::run_mono_buffered (float* buf, uint32_t n_samples)
 		remain  -= ns;
 
 		if (_offset == _n_samples) {
-			_convproc.process ();
+			_convproc->process ();
 			_offset = 0;
 		}
 	}
@@ -362,28 +720,39 @@ Convolution::run_mono_buffered (float* buf, uint32_t n_samples)
 void
 Convolver::run_stereo_buffered (float* left, float* right, uint32_t n_samples)
 {
-	assert (_convproc.state () == Convproc::ST_PROC);
 	assert (_irc != Mono);
 
+	Glib::Threads::Mutex::Lock lm (_proc_lock, Glib::Threads::TRY_LOCK);
+
+	if (lm.locked ()) {
+		swap_pending ();
+	}
+
+	if (!lm.locked () || !ready ()) {
+		memset (left, 0, sizeof (float) * n_samples);
+		memset (right, 0, sizeof (float) * n_samples);
+		return;
+	}
+
 	uint32_t done   = 0;
 	uint32_t remain = n_samples;
 
 	while (remain > 0) {
 		uint32_t ns = std::min (remain, _n_samples - _offset);
 
-		memcpy (&_convproc.inpdata (0)[_offset], &left[done], sizeof (float) * ns);
+		memcpy (&_convproc->inpdata (0)[_offset], &left[done], sizeof (float) * ns);
 		if (_irc >= Stereo) {
-			memcpy (&_convproc.inpdata (1)[_offset], &right[done], sizeof (float) * ns);
+			memcpy (&_convproc->inpdata (1)[_offset], &right[done], sizeof (float) * ns);
 		}
-		memcpy (&left[done],  &_convproc.outdata (0)[_offset], sizeof (float) * ns);
-		memcpy (&right[done], &_convproc.outdata (1)[_offset], sizeof (float) * ns);
+		memcpy (&left[done],  &_convproc->outdata (0)[_offset], sizeof (float) * ns);
+		memcpy (&right[done], &_convproc->outdata (1)[_offset], sizeof (float) * ns);
 
 		_offset += ns;
 		done    += ns;
 		remain  -= ns;
 
 		if (_offset == _n_samples) {
-			_convproc.process ();
+			_convproc->process ();
 			_offset = 0;
 		}
 	}
@@ -399,7 +768,16 @@ Convolver::run_mono_no_latency (float* buf, uint32_t n_samples)
 void
 Convolution::run_mono_no_latency (float* buf, uint32_t n_samples)
 {
-	assert (_convproc.state () == Convproc::ST_PROC);
+	Glib::Threads::Mutex::Lock lm (_proc_lock, Glib::Threads::TRY_LOCK);
+
+	if (lm.locked ()) {
+		swap_pending ();
+	}
+
+	if (!lm.locked () || !ready ()) {
+		memset (buf, 0, sizeof (float) * n_samples);
+		return;
+	}
 
 	uint32_t done   = 0;
 	uint32_t remain = n_samples;
@@ -407,18 +785,18 @@ Convolution::run_mono_no_latency (float* buf, uint32_t n_samples)
 	while (remain > 0) {
 		uint32_t ns = std::min (remain, _n_samples - _offset);
 
-		float* const in  = _convproc.inpdata (/*channel*/ 0);
-		float* const out = _convproc.outdata (/*channel*/ 0);
+		float* const in  = _convproc->inpdata (/*channel*/ 0);
+		float* const out = _convproc->outdata (/*channel*/ 0);
 
 		memcpy (&in[_offset], &buf[done], sizeof (float) * ns);
 
 		if (_offset + ns == _n_samples) {
-			_convproc.process ();
+			_convproc->process ();
 			memcpy (&buf[done], &out[_offset], sizeof (float) * ns);
 			_offset = 0;
 		} else {
 			assert (remain == ns);
-			_convproc.tailonly (_offset + ns);
+			_convproc->tailonly (_offset + ns);
 			memcpy (&buf[done], &out[_offset], sizeof (float) * ns);
 			_offset += ns;
 		}
@@ -430,31 +808,42 @@ Convolution::run_mono_no_latency (float* buf, uint32_t n_samples)
 void
 Convolver::run_stereo_no_latency (float* left, float* right, uint32_t n_samples)
 {
-	assert (_convproc.state () == Convproc::ST_PROC);
 	assert (_irc != Mono);
 
+	Glib::Threads::Mutex::Lock lm (_proc_lock, Glib::Threads::TRY_LOCK);
+
+	if (lm.locked ()) {
+		swap_pending ();
+	}
+
+	if (!lm.locked () || !ready ()) {
+		memset (left, 0, sizeof (float) * n_samples);
+		memset (right, 0, sizeof (float) * n_samples);
+		return;
+	}
+
 	uint32_t done   = 0;
 	uint32_t remain = n_samples;
 
-	float* const outL = _convproc.outdata (0);
-	float* const outR = _convproc.outdata (1);
+	float* const outL = _convproc->outdata (0);
+	float* const outR = _convproc->outdata (1);
 
 	while (remain > 0) {
 		uint32_t ns = std::min (remain, _n_samples - _offset);
 
-		memcpy (&_convproc.inpdata (0)[_offset], &left[done], sizeof (float) * ns);
+		memcpy (&_convproc->inpdata (0)[_offset], &left[done], sizeof (float) * ns);
 		if (_irc >= Stereo) {
-			memcpy (&_convproc.inpdata (1)[_offset], &right[done], sizeof (float) * ns);
+			memcpy (&_convproc->inpdata (1)[_offset], &right[done], sizeof (float) * ns);
 		}
 
 		if (_offset + ns == _n_samples) {
-			_convproc.process ();
+			_convproc->process ();
 			memcpy (&left[done],  &outL[_offset], sizeof (float) * ns);
 			memcpy (&right[done], &outR[_offset], sizeof (float) * ns);
 			_offset = 0;
 		} else {
 			assert (remain == ns);
-			_convproc.tailonly (_offset + ns);
+			_convproc->tailonly (_offset + ns);
 			memcpy (&left[done],  &outL[_offset], sizeof (float) * ns);
 			memcpy (&right[done], &outR[_offset], sizeof (float) * ns);
 			_offset += ns;
@@ -0,0 +1,132 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <assert.h>
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include "pbd/compose.h"
+#include "pbd/malign.h"
+
+#include "ardour/debug.h"
+#include "ardour/delay_arena.h"
+
+using namespace ARDOUR;
+
+DelayArena::DelayArena (size_t slab_samples)
+	: _slab_samples (slab_samples)
+	, _reserved (0)
+	, _used (0)
+	, _n_buffers (0)
+{
+}
+
+DelayArena::~DelayArena ()
+{
+	assert (_n_buffers == 0);
+	for (std::vector<Slab>::const_iterator i = _slabs.begin (); i != _slabs.end (); ++i) {
+		cache_aligned_free (i->data);
+	}
+}
+
+Sample*
+DelayArena::alloc (samplecnt_t n_samples)
+{
+	assert (n_samples > 0 && (n_samples & (n_samples - 1)) == 0);
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	Sample* rv = 0;
+
+	/* re-use a buffer of the same size */
+	FreeList::iterator f = _free.find (n_samples);
+	if (f != _free.end () && !f->second.empty ()) {
+		rv = f->second.back ();
+		f->second.pop_back ();
+		memset (rv, 0, n_samples * sizeof (Sample));
+	}
+
+	/* carve from an existing slab */
+	for (std::vector<Slab>::iterator i = _slabs.begin (); !rv && i != _slabs.end (); ++i) {
+		if (i->size - i->used >= (size_t) n_samples) {
+			rv = &i->data[i->used];
+			i->used += n_samples;
+		}
+	}
+
+	/* add a new slab, large buffers get a slab of their own */
+	if (!rv) {
+		size_t const size = std::max<size_t> (_slab_samples, n_samples);
+		void*        data;
+		if (cache_aligned_malloc (&data, size * sizeof (Sample))) {
+			throw std::bad_alloc ();
+		}
+		/* first touch: map pages local to this thread's NUMA node */
+		memset (data, 0, size * sizeof (Sample));
+
+		_slabs.push_back (Slab ((Sample*) data, size));
+		_reserved += size * sizeof (Sample);
+
+		rv = _slabs.back ().data;
+		_slabs.back ().used = n_samples;
+
+		DEBUG_TRACE (DEBUG::LatencyDelayLine, string_compose ("DelayArena: new slab of %1 samples, reserved: %2 bytes\n", size, _reserved));
+	}
+
+	_used += n_samples * sizeof (Sample);
+	++_n_buffers;
+
+	return rv;
+}
+
+void
+DelayArena::free (Sample* buf, samplecnt_t n_samples)
+{
+	if (!buf) {
+		return;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	assert (_n_buffers > 0);
+	assert (_used >= n_samples * sizeof (Sample));
+
+	_free[n_samples].push_back (buf);
+	_used -= n_samples * sizeof (Sample);
+	--_n_buffers;
+}
+
+size_t
+DelayArena::reserved_bytes () const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return _reserved;
+}
+
+size_t
+DelayArena::used_bytes () const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return _used;
+}
+
+size_t
+DelayArena::n_buffers () const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return _n_buffers;
+}
@@ -24,10 +24,12 @@
 #include "ardour/audio_buffer.h"
 #include "ardour/buffer_set.h"
 #include "ardour/debug.h"
+#include "ardour/delay_arena.h"
 #include "ardour/delayline.h"
 #include "ardour/midi_buffer.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/rc_configuration.h"
+#include "ardour/session.h"
 
 #define MAX_BUFFER_SIZE 8192
 
@@ -43,11 +45,15 @@ DelayLine::DelayLine (Session& s, const std::string& name)
 	, _roff (0)
 	, _woff (0)
 	, _pending_flush (false)
+	, _arena (s.delay_arena ())
 {
 }
 
 DelayLine::~DelayLine ()
 {
+	for (AudioDlyBuf::const_iterator i = _buf.begin (); i != _buf.end (); ++i) {
+		_arena->free (*i, _bsiz);
+	}
 }
 
 bool
@@ -98,7 +104,7 @@ DelayLine::run (BufferSet& bufs, samplepos_t /* start_sample */, samplepos_t /*
 				if (add > 0) {
 					AudioDlyBuf::iterator bi = _buf.begin ();
 					for (BufferSet::audio_iterator i = bufs.audio_begin (); i != bufs.audio_end (); ++i, ++bi) {
-						Sample* rb = (*bi).get ();
+						Sample* rb = *bi;
 						write_to_rb (rb, i->data (), add);
 					}
 					_woff = (_woff + add) & _bsiz_mask;
@@ -108,7 +114,7 @@ DelayLine::run (BufferSet& bufs, samplepos_t /* start_sample */, samplepos_t /*
 
 			/* fade-out, end of previously written data */
 			for (AudioDlyBuf::iterator i = _buf.begin(); i != _buf.end (); ++i) {
-				Sample* rb = (*i).get ();
+				Sample* rb = *i;
 				for (uint32_t s = 0; s < fade_out_len; ++s) {
 					sampleoffset_t off = (_woff + _bsiz - s) & _bsiz_mask;
 					rb[off] *= s / (float) fade_out_len;
@@ -142,7 +148,7 @@ DelayLine::run (BufferSet& bufs, samplepos_t /* start_sample */, samplepos_t /*
 
 			AudioDlyBuf::iterator bi = _buf.begin ();
 			for (BufferSet::audio_iterator i = bufs.audio_begin (); i != bufs.audio_end (); ++i, ++bi) {
-				Sample* rb = (*bi).get ();
+				Sample* rb = *bi;
 				Sample* src = i->data ();
 
 				for (uint32_t s = 0; s < xfade_len; ++s) {
@@ -170,7 +176,7 @@ DelayLine::run (BufferSet& bufs, samplepos_t /* start_sample */, samplepos_t /*
 			const samplecnt_t fade_out_len = std::min<samplecnt_t> (_delay, FADE_LEN);
 
 			for (AudioDlyBuf::iterator i = _buf.begin(); i != _buf.end (); ++i) {
-				Sample* rb = (*i).get ();
+				Sample* rb = *i;
 				uint32_t s = 0;
 				for (; s < fade_out_len; ++s) {
 					sampleoffset_t off = (_roff + s) & _bsiz_mask;
@@ -192,7 +198,7 @@ DelayLine::run (BufferSet& bufs, samplepos_t /* start_sample */, samplepos_t /*
 		} else if (n_samples <= _delay) {
 			/* write all samples to rb, read all from rb */
 			for (BufferSet::audio_iterator i = bufs.audio_begin (); i != bufs.audio_end (); ++i, ++bi) {
-				Sample* rb = (*bi).get ();
+				Sample* rb = *bi;
 				write_to_rb (rb, i->data (), n_samples);
 				read_from_rb (rb, i->data (), n_samples);
 			}
@@ -202,7 +208,7 @@ DelayLine::run (BufferSet& bufs, samplepos_t /* start_sample */, samplepos_t /*
 			/* only write _delay samples to ringbuffer, memmove buffer */
 			samplecnt_t tail = n_samples - _delay;
 			for (BufferSet::audio_iterator i = bufs.audio_begin (); i != bufs.audio_end (); ++i, ++bi) {
-				Sample* rb = (*bi).get ();
+				Sample* rb = *bi;
 				Sample* src = i->data ();
 				write_to_rb (rb, &src[tail], _delay);
 				memmove (&src[_delay], src, tail * sizeof(Sample));
@@ -360,11 +366,12 @@ DelayLine::allocate_pending_buffers (samplecnt_t signal_delay, ChanCount const&
 		return;
 	}
 
+	/* allocate new buffers, copy the data and swap them, the old buffers
+	 * are returned to the arena for re-use by other delay-lines.
+	 */
 	AudioDlyBuf pending_buf;
 	for (uint32_t i = 0; i < cc.n_audio (); ++i) {
-		std::shared_ptr<Sample[]> b (new Sample[rbs]);
-		pending_buf.push_back (b);
-		memset (b.get (), 0, rbs * sizeof (Sample));
+		pending_buf.push_back (_arena->alloc (rbs));
 	}
 
 	AudioDlyBuf::iterator bo = _buf.begin ();
@@ -373,8 +380,8 @@ DelayLine::allocate_pending_buffers (samplecnt_t signal_delay, ChanCount const&
 	sampleoffset_t offset = (_roff <= _woff) ? 0 : rbs - _bsiz;
 
 	for (; bo != _buf.end () && bn != pending_buf.end(); ++bo, ++bn) {
-		Sample* rbo = (*bo).get ();
-		Sample* rbn = (*bn).get ();
+		Sample* rbo = *bo;
+		Sample* rbn = *bn;
 		if (_roff == _woff) {
 			continue;
 		} else if (_roff < _woff) {
@@ -394,9 +401,19 @@ DelayLine::allocate_pending_buffers (samplecnt_t signal_delay, ChanCount const&
 	_roff += offset;
 	assert (_roff < rbs);
 
+	samplecnt_t const old_bsiz = _bsiz;
+
 	_bsiz = rbs;
 	_bsiz_mask = _bsiz - 1;
 	_buf.swap (pending_buf);
+
+	for (AudioDlyBuf::const_iterator i = pending_buf.begin (); i != pending_buf.end (); ++i) {
+		_arena->free (*i, old_bsiz);
+	}
+
+	DEBUG_TRACE (DEBUG::LatencyDelayLine,
+			string_compose ("%1 allocated %2 x %3 samples, total delay-line memory: %4 bytes\n",
+				name (), _buf.size (), _bsiz, _arena->used_bytes ()));
 }
 
 bool
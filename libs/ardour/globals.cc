@@ -117,6 +117,7 @@
 #include "ardour/mix.h"
 #include "ardour/operations.h"
 #include "ardour/panner_manager.h"
+#include "ardour/plugin_insert.h"
 #include "ardour/plugin_manager.h"
 #include "ardour/presentation_info.h"
 #include "ardour/process_thread.h"
@@ -158,6 +159,13 @@ mix_buffers_with_gain_t ARDOUR::mix_buffers_with_gain = 0;
 mix_buffers_no_gain_t   ARDOUR::mix_buffers_no_gain   = 0;
 copy_vector_t           ARDOUR::copy_vector           = 0;
 
+kmeter_process_t        ARDOUR::kmeter_process        = default_kmeter_process;
+ppm_process_t           ARDOUR::ppm_process           = default_ppm_process;
+vumeter_process_t       ARDOUR::vumeter_process       = default_vumeter_process;
+kweight_process_t       ARDOUR::kweight_process       = default_kweight_process;
+true_peak_t             ARDOUR::true_peak_x2          = default_true_peak_x2;
+true_peak_t             ARDOUR::true_peak_x4          = default_true_peak_x4;
+
 PBD::Signal<void(std::string)>                    ARDOUR::BootMessage;
 PBD::Signal<void(std::string, std::string, bool)> ARDOUR::PluginScanMessage;
 PBD::Signal<void(int)>                            ARDOUR::PluginScanTimeout;
@@ -192,6 +200,14 @@ setup_hardware_optimization (bool try_optimization)
 {
 	bool generic_mix_functions = true;
 
+	/* meter and loudness kernels, process several channels at once */
+	kmeter_process  = default_kmeter_process;
+	ppm_process     = default_ppm_process;
+	vumeter_process = default_vumeter_process;
+	kweight_process = default_kweight_process;
+	true_peak_x2    = default_true_peak_x2;
+	true_peak_x4    = default_true_peak_x4;
+
 	if (try_optimization) {
 		FPU* fpu = FPU::instance ();
 
@@ -258,6 +274,15 @@ setup_hardware_optimization (bool try_optimization)
 			generic_mix_functions = false;
 		}
 
+		if (fpu->has_sse ()) {
+			kmeter_process  = x86_sse_kmeter_process;
+			ppm_process     = x86_sse_ppm_process;
+			vumeter_process = x86_sse_vumeter_process;
+			kweight_process = x86_sse_kweight_process;
+			true_peak_x2    = x86_sse_true_peak_x2;
+			true_peak_x4    = x86_sse_true_peak_x4;
+		}
+
 #elif defined ARM_NEON_SUPPORT
 		/* Use NEON routines */
 		if (fpu->has_neon ()) {
@@ -835,6 +860,7 @@ ARDOUR::cleanup ()
 	}
 
 	delete TriggerBox::worker;
+	PluginInsert::drop_instance_workers ();
 
 	Analyser::terminate ();
 	SourceFactory::terminate ();
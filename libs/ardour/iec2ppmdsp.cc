@@ -17,8 +17,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <math.h>
+
 #include "ardour/iec2ppmdsp.h"
+#include "ardour/runtime_functions.h"
 
 float Iec2ppmdsp::_w1;
 float Iec2ppmdsp::_w2;
@@ -37,36 +40,35 @@ Iec2ppmdsp::~Iec2ppmdsp (void) {}
 void
 Iec2ppmdsp::process (float const* p, int n)
 {
-	float z1, z2, m, t;
+	Iec2ppmdsp* self = this;
+	process (&self, &p, 1, n);
+}
+
+void
+Iec2ppmdsp::process (Iec2ppmdsp* const* m, float const* const* p, uint32_t n_chn, int n)
+{
+	float z1[8], z2[8], mx[8];
 
-	z1 = _z1 > 20 ? 20 : (_z1 < 0 ? 0 : _z1);
-	z2 = _z2 > 20 ? 20 : (_z2 < 0 ? 0 : _z2);
-	m = _res ? 0: _m;
-	_res = false;
+	for (uint32_t c0 = 0; c0 < n_chn; c0 += 8) {
+		uint32_t const nc = std::min<uint32_t> (8, n_chn - c0);
 
-	n /= 4;
-	while (n--) {
-		z1 *= _w3;
-		z2 *= _w3;
-		t = fabsf (*p++);
-		if (t > z1) z1 += _w1 * (t - z1);
-		if (t > z2) z2 += _w2 * (t - z2);
-		t = fabsf (*p++);
-		if (t > z1) z1 += _w1 * (t - z1);
-		if (t > z2) z2 += _w2 * (t - z2);
-		t = fabsf (*p++);
-		if (t > z1) z1 += _w1 * (t - z1);
-		if (t > z2) z2 += _w2 * (t - z2);
-		t = fabsf (*p++);
-		if (t > z1) z1 += _w1 * (t - z1);
-		if (t > z2) z2 += _w2 * (t - z2);
-		t = z1 + z2;
-		if (t > m) m = t;
-	}
+		for (uint32_t c = 0; c < nc; ++c) {
+			Iec2ppmdsp* k = m[c0 + c];
+			z1[c] = k->_z1 > 20 ? 20 : (k->_z1 < 0 ? 0 : k->_z1);
+			z2[c] = k->_z2 > 20 ? 20 : (k->_z2 < 0 ? 0 : k->_z2);
+			mx[c] = k->_res ? 0: k->_m;
+			k->_res = false;
+		}
 
-	_z1 = z1 + 1e-10f;
-	_z2 = z2 + 1e-10f;
-	_m = m;
+		ARDOUR::ppm_process (&p[c0], nc, n, _w1, _w2, _w3, z1, z2, mx);
+
+		for (uint32_t c = 0; c < nc; ++c) {
+			Iec2ppmdsp* k = m[c0 + c];
+			k->_z1 = z1[c] + 1e-10f;
+			k->_z2 = z2[c] + 1e-10f;
+			k->_m  = mx[c];
+		}
+	}
 }
 
 float
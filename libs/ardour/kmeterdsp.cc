@@ -17,8 +17,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <math.h>
+
 #include "ardour/kmeterdsp.h"
+#include "ardour/runtime_functions.h"
 
 float  Kmeterdsp::_omega;
 
@@ -40,30 +43,38 @@ Kmeterdsp::init (int fsamp)
 void
 Kmeterdsp::process (float const* p, int n)
 {
-	float  s, z1, z2;
-
-	// Get filter state.
-	z1 = _z1 > 50 ? 50 : (_z1 < 0 ? 0 : _z1);
-	z2 = _z2 > 50 ? 50 : (_z2 < 0 ? 0 : _z2);
-
-	// Perform filtering. The second filter is evaluated
-	// only every 4th sample - this is just an optimisation.
-	n /= 4;  // Loop is unrolled by 4.
-	while (n--) {
-		s = *p++;
-		s *= s;
-		z1 += _omega * (s - z1);      // Update first filter.
-		s = *p++;
-		s *= s;
-		z1 += _omega * (s - z1);      // Update first filter.
-		s = *p++;
-		s *= s;
-		z1 += _omega * (s - z1);      // Update first filter.
-		s = *p++;
-		s *= s;
-		z1 += _omega * (s - z1);      // Update first filter.
-		z2 += 4 * _omega * (z1 - z2); // Update second filter.
+	Kmeterdsp* self = this;
+	process (&self, &p, 1, n);
+}
+
+void
+Kmeterdsp::process (Kmeterdsp* const* m, float const* const* p, uint32_t n_chn, int n)
+{
+	float z1[8], z2[8];
+
+	for (uint32_t c0 = 0; c0 < n_chn; c0 += 8) {
+		uint32_t const nc = std::min<uint32_t> (8, n_chn - c0);
+
+		// Get filter state.
+		for (uint32_t c = 0; c < nc; ++c) {
+			Kmeterdsp const* k = m[c0 + c];
+			z1[c] = k->_z1 > 50 ? 50 : (k->_z1 < 0 ? 0 : k->_z1);
+			z2[c] = k->_z2 > 50 ? 50 : (k->_z2 < 0 ? 0 : k->_z2);
+		}
+
+		// Perform filtering, all channels at once.
+		ARDOUR::kmeter_process (&p[c0], nc, n, _omega, z1, z2);
+
+		for (uint32_t c = 0; c < nc; ++c) {
+			m[c0 + c]->update (z1[c], z2[c]);
+		}
 	}
+}
+
+void
+Kmeterdsp::update (float z1, float z2)
+{
+	float s;
 
 	if (isnan(z1)) z1 = 0;
 	if (isnan(z2)) z2 = 0;
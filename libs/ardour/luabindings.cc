@@ -1490,6 +1490,9 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("set_comment", &Route::set_comment)
 		.addFunction ("strict_io", &Route::strict_io)
 		.addFunction ("set_strict_io", &Route::set_strict_io)
+		.addFunction ("pipeline_stages", &Route::pipeline_stages)
+		.addFunction ("set_pipeline_stages", &Route::set_pipeline_stages)
+		.addFunction ("asleep", &Route::asleep)
 		.addFunction ("reset_plugin_insert", &Route::reset_plugin_insert)
 		.addFunction ("customize_plugin_insert", &Route::customize_plugin_insert)
 		.addFunction ("add_sidechain", &Route::add_sidechain)
@@ -2079,6 +2082,8 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("control_output", &PluginInsert::control_output)
 		.addFunction ("clear_stats", &PluginInsert::clear_stats)
 		.addRefFunction ("get_stats", &PluginInsert::get_stats)
+		.addRefFunction ("get_instance_stats", &PluginInsert::get_instance_stats)
+		.addFunction ("asleep", &PluginInsert::asleep)
 		.endClass ()
 
 		.deriveWSPtrClass <RegionFxPlugin, SessionObject> ("RegionFxPlugin")
@@ -3331,6 +3336,8 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("run_mono_buffered", &ARDOUR::DSP::Convolution::run_mono_buffered)
 		.addFunction ("run_mono_no_latency", &ARDOUR::DSP::Convolution::run_mono_no_latency)
 		.addFunction ("restart", &ARDOUR::DSP::Convolution::restart)
+		.addFunction ("reload", &ARDOUR::DSP::Convolution::reload)
+		.addFunction ("set_partitioning", &ARDOUR::DSP::Convolution::set_partitioning)
 		.addFunction ("ready", &ARDOUR::DSP::Convolution::ready)
 		.addFunction ("latency", &ARDOUR::DSP::Convolution::latency)
 		.addFunction ("n_inputs", &ARDOUR::DSP::Convolution::n_inputs)
@@ -34,6 +34,7 @@
 #include "ardour/luascripting.h"
 #include "ardour/midi_buffer.h"
 #include "ardour/plugin.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/session.h"
 
 #include "LuaBridge/LuaBridge.h"
@@ -43,11 +44,23 @@
 using namespace ARDOUR;
 using namespace PBD;
 
+static const size_t lua_pool_size = 3145728;
+
+namespace {
+
+size_t
+lua_mem_used (lua_State* L)
+{
+	return (size_t) lua_gc (L, LUA_GCCOUNT, 0) * 1024 + lua_gc (L, LUA_GCCOUNTB, 0);
+}
+
+} // namespace
+
 LuaProc::LuaProc (AudioEngine& engine,
                   Session& session,
                   const std::string &script)
 	: Plugin (engine, session)
-	, _mempool ("LuaProc", 3145728)
+	, _mempool ("LuaProc", lua_pool_size)
 #ifdef USE_TLSF
 	, lua (lua_newstate (&PBD::TLSF::lalloc, &_mempool))
 #elif defined USE_MALLOC
@@ -70,6 +83,16 @@ LuaProc::LuaProc (AudioEngine& engine,
 	, _configured (false)
 	, _has_midi_input (false)
 	, _has_midi_output (false)
+	, _gc_stopped (false)
+	, _gc_paused (false)
+	, _gc_spread (false)
+	, _gc_estimate (0)
+	, _gc_cycles (0)
+	, _gc_total (0)
+	, _gc_max (0)
+	, _gc_spread_cycles (0)
+	, _mem_used (0)
+	, _mem_peak (0)
 {
 	init ();
 
@@ -83,7 +106,7 @@ LuaProc::LuaProc (AudioEngine& engine,
 
 LuaProc::LuaProc (const LuaProc &other)
 	: Plugin (other)
-	, _mempool ("LuaProc", 3145728)
+	, _mempool ("LuaProc", lua_pool_size)
 #ifdef USE_TLSF
 	, lua (lua_newstate (&PBD::TLSF::lalloc, &_mempool))
 #elif defined USE_MALLOC
@@ -104,6 +127,16 @@ LuaProc::LuaProc (const LuaProc &other)
 	, _configured (false)
 	, _has_midi_input (false)
 	, _has_midi_output (false)
+	, _gc_stopped (false)
+	, _gc_paused (false)
+	, _gc_spread (false)
+	, _gc_estimate (0)
+	, _gc_cycles (0)
+	, _gc_total (0)
+	, _gc_max (0)
+	, _gc_spread_cycles (0)
+	, _mem_used (0)
+	, _mem_peak (0)
 {
 	init ();
 
@@ -189,6 +222,100 @@ LuaProc::drop_references ()
 	Plugin::drop_references ();
 }
 
+void
+LuaProc::run_gc ()
+{
+	lua_State*     L      = lua.getState ();
+	int64_t const  t0     = g_get_monotonic_time ();
+	uint32_t const budget = Config->get_lua_dsp_gc_budget ();
+
+	if (budget == 0) {
+		if (_gc_stopped) {
+			lua_gc (L, LUA_GCRESTART, 0);
+			_gc_stopped = false;
+		}
+		lua.collect_garbage_step ();
+	} else {
+		if (!_gc_stopped) {
+			/* only collect garbage here, not when allocating memory during run() */
+			lua_gc (L, LUA_GCSTOP, 0);
+			_gc_stopped = true;
+		}
+		/* similar to Lua's default "pause", start a new cycle
+		 * once memory use doubled since the last one completed.
+		 * A cycle that exceeds the budget is continued in the
+		 * next process cycle(s).
+		 */
+		if (!_gc_paused || lua_mem_used (L) >= 2 * _gc_estimate) {
+			int64_t const deadline = t0 + budget;
+#if !defined USE_TLSF && defined USE_MALLOC
+			bool const low_mem = false;
+#else
+			/* the collector does not run on allocation, complete the cycle
+			 * regardless of the budget before the pool is exhausted */
+			bool const low_mem = lua_mem_used (L) > lua_pool_size * 3 / 4;
+#endif
+			_gc_paused = false;
+			while (true) {
+				if (lua_gc (L, LUA_GCSTEP, 0)) {
+					if (_gc_spread) {
+						++_gc_spread_cycles;
+						_gc_spread = false;
+					}
+					_gc_paused   = true;
+					_gc_estimate = lua_mem_used (L);
+					break;
+				}
+				if (!low_mem && g_get_monotonic_time () >= deadline) {
+					_gc_spread = true;
+					break;
+				}
+			}
+		}
+	}
+
+	int64_t const elapsed = g_get_monotonic_time () - t0;
+	size_t const  used    = lua_mem_used (L);
+
+	++_gc_cycles;
+	_gc_total += elapsed;
+	if (elapsed > _gc_max) {
+		_gc_max = elapsed;
+	}
+	_mem_used = used;
+	if (used > _mem_peak) {
+		_mem_peak = used;
+	}
+}
+
+LuaProc::GCStats
+LuaProc::gc_stats () const
+{
+	GCStats s;
+	s.cycles   = _gc_cycles;
+	s.avg_us   = s.cycles > 0 ? _gc_total / (int64_t) s.cycles : 0;
+	s.max_us   = _gc_max;
+	s.spread   = _gc_spread_cycles;
+	s.mem_used = _mem_used;
+	s.mem_peak = _mem_peak;
+#if !defined USE_TLSF && defined USE_MALLOC
+	s.pool_size = 0;
+#else
+	s.pool_size = lua_pool_size;
+#endif
+	return s;
+}
+
+void
+LuaProc::reset_gc_stats ()
+{
+	_gc_cycles        = 0;
+	_gc_total         = 0;
+	_gc_max           = 0;
+	_gc_spread_cycles = 0;
+	_mem_peak         = _mem_used.load ();
+}
+
 std::weak_ptr<Route>
 LuaProc::route () const
 {
@@ -921,7 +1048,7 @@ LuaProc::connect_and_run (BufferSet& bufs,
 	int64_t t1 = g_get_monotonic_time ();
 #endif
 
-	lua.collect_garbage_step ();
+	run_gc ();
 #ifdef WITH_LUAPROC_STATS
 	if (++_stats_cnt > 0) {
 		int64_t t2 = g_get_monotonic_time ();
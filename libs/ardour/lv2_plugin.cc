@@ -25,10 +25,13 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <string>
 #include <vector>
 #include <limits>
+#include <map>
 
 #include <cmath>
 #include <cstdlib>
@@ -43,6 +46,7 @@
 #include "pbd/compose.h"
 #include "pbd/error.h"
 #include "pbd/locale_guard.h"
+#include "pbd/pathexpand.h"
 #include "pbd/pthread_utils.h"
 #include "pbd/replace_all.h"
 #include "pbd/xml++.h"
@@ -62,6 +66,7 @@
 #include "ardour/audioengine.h"
 #include "ardour/directory_names.h"
 #include "ardour/debug.h"
+#include "ardour/filesystem_paths.h"
 #include "ardour/lv2_evbuf.h"
 #include "ardour/lv2_plugin.h"
 #include "ardour/midi_patch_manager.h"
@@ -165,6 +170,7 @@ public:
 	~LV2World ();
 
 	void load_bundled_plugins(bool verbose=false);
+	bool loaded () const { return _bundle_checked.load (); }
 
 	LilvWorld* world;
 
@@ -241,7 +247,8 @@ public:
 #endif
 
 private:
-	bool _bundle_checked;
+	std::atomic<bool> _bundle_checked; // set with _load_lock held, once loading is complete
+	Glib::Threads::Mutex _load_lock;
 };
 
 static LV2World _world;
@@ -3652,6 +3659,7 @@ LV2World::~LV2World()
 void
 LV2World::load_bundled_plugins(bool verbose)
 {
+	Glib::Threads::Mutex::Lock lm (_load_lock);
 	if (!_bundle_checked) {
 		if (verbose) {
 			info << "Scanning folders for bundled LV2s: " << ARDOUR::lv2_bundled_search_path().to_string() << endmsg;
@@ -3676,11 +3684,92 @@ LV2World::load_bundled_plugins(bool verbose)
 }
 
 LV2PluginInfo::LV2PluginInfo (const char* plugin_uri)
+	: _is_instrument (false)
+	, _is_utility (false)
+	, _is_analyzer (false)
+	, _have_cached_presets (false)
 {
 	type = ARDOUR::LV2;
 	_plugin_uri = strdup(plugin_uri);
 }
 
+LV2PluginInfo::LV2PluginInfo (XMLNode const& node)
+	: _plugin_uri (NULL)
+	, _is_instrument (false)
+	, _is_utility (false)
+	, _is_analyzer (false)
+	, _have_cached_presets (true)
+{
+	bool err = false;
+
+	if (node.name() != "LV2Info") {
+		throw failed_constructor ();
+	}
+
+	err |= !node.get_property ("uri", unique_id);
+	err |= !node.get_property ("name", name);
+	err |= !node.get_property ("category", category);
+	err |= !node.get_property ("creator", creator);
+	err |= !node.get_property ("internal", internal);
+	err |= !node.get_property ("is_instrument", _is_instrument);
+	err |= !node.get_property ("is_utility", _is_utility);
+	err |= !node.get_property ("is_analyzer", _is_analyzer);
+
+	XMLNode const* in  = node.child ("Inputs");
+	XMLNode const* out = node.child ("Outputs");
+
+	if (err || !in || !out) {
+		throw failed_constructor ();
+	}
+
+	n_inputs  = ChanCount (*in);
+	n_outputs = ChanCount (*out);
+
+	for (XMLNodeConstIterator i = node.children ().begin (); i != node.children ().end (); ++i) {
+		if ((*i)->name () != "Preset") {
+			continue;
+		}
+		Plugin::PresetRecord r;
+		if (!(*i)->get_property ("uri", r.uri) || !(*i)->get_property ("label", r.label) || !(*i)->get_property ("user", r.user)) {
+			throw failed_constructor ();
+		}
+		(*i)->get_property ("description", r.description);
+		r.valid = true;
+		_cached_presets.push_back (r);
+	}
+
+	type        = ARDOUR::LV2;
+	path        = "/NOPATH"; // Meaningless for LV2
+	index       = 0;
+	_plugin_uri = strdup (unique_id.c_str ());
+}
+
+XMLNode&
+LV2PluginInfo::state () const
+{
+	XMLNode* node = new XMLNode ("LV2Info");
+	node->set_property ("uri",           unique_id);
+	node->set_property ("name",          name);
+	node->set_property ("category",      category);
+	node->set_property ("creator",       creator);
+	node->set_property ("internal",      internal);
+	node->set_property ("is_instrument", _is_instrument);
+	node->set_property ("is_utility",    _is_utility);
+	node->set_property ("is_analyzer",   _is_analyzer);
+
+	node->add_child_nocopy (*n_inputs.state ("Inputs"));
+	node->add_child_nocopy (*n_outputs.state ("Outputs"));
+
+	for (std::vector<Plugin::PresetRecord>::const_iterator i = _cached_presets.begin (); i != _cached_presets.end (); ++i) {
+		XMLNode* child = node->add_child ("Preset");
+		child->set_property ("uri",         i->uri);
+		child->set_property ("label",       i->label);
+		child->set_property ("user",        i->user);
+		child->set_property ("description", i->description);
+	}
+	return *node;
+}
+
 LV2PluginInfo::~LV2PluginInfo()
 {
 	free(_plugin_uri);
@@ -3690,6 +3779,8 @@ LV2PluginInfo::~LV2PluginInfo()
 PluginPtr
 LV2PluginInfo::load(Session& session)
 {
+	_world.load_bundled_plugins (true);
+
 	try {
 		PluginPtr plugin;
 		const LilvPlugins* plugins = lilv_world_get_all_plugins(_world.world);
@@ -3708,30 +3799,18 @@ LV2PluginInfo::load(Session& session)
 	return PluginPtr();
 }
 
-std::vector<Plugin::PresetRecord>
-LV2PluginInfo::get_presets (bool user_only) const
+static std::vector<Plugin::PresetRecord>
+lv2_find_presets (LilvWorld* world, const LilvPlugin* lp, bool user_only)
 {
 	std::vector<Plugin::PresetRecord> p;
 
-	const LilvPlugin* lp = NULL;
-	try {
-		PluginPtr plugin;
-		const LilvPlugins* plugins = lilv_world_get_all_plugins(_world.world);
-		LilvNode* uri = lilv_new_uri(_world.world, _plugin_uri);
-		if (!uri) { throw failed_constructor(); }
-		lp = lilv_plugins_get_by_uri(plugins, uri);
-		if (!lp) { throw failed_constructor(); }
-		lilv_node_free(uri);
-	} catch (failed_constructor& err) {
-		return p;
-	}
 	assert (lp);
 	/* see also  LV2Plugin::find_presets */
-	LilvNode* lv2_appliesTo = lilv_new_uri(_world.world, LV2_CORE__appliesTo);
-	LilvNode* pset_Preset   = lilv_new_uri(_world.world, LV2_PRESETS__Preset);
-	LilvNode* rdfs_label    = lilv_new_uri(_world.world, LILV_NS_RDFS "label");
-	LilvNode* rdfs_comment  = lilv_new_uri(_world.world, LILV_NS_RDFS "comment");
-	LilvNode* rdfs_seeAlso  = lilv_new_uri(_world.world, LILV_NS_RDFS "seeAlso");
+	LilvNode* lv2_appliesTo = lilv_new_uri(world, LV2_CORE__appliesTo);
+	LilvNode* pset_Preset   = lilv_new_uri(world, LV2_PRESETS__Preset);
+	LilvNode* rdfs_label    = lilv_new_uri(world, LILV_NS_RDFS "label");
+	LilvNode* rdfs_comment  = lilv_new_uri(world, LILV_NS_RDFS "comment");
+	LilvNode* rdfs_seeAlso  = lilv_new_uri(world, LILV_NS_RDFS "seeAlso");
 
 	/* query plugins bundle path */
 	const LilvNode* const bundle_uri = lilv_plugin_get_bundle_uri(lp);
@@ -3743,10 +3822,10 @@ LV2PluginInfo::get_presets (bool user_only) const
 	LilvNodes* presets = lilv_plugin_get_related(lp, pset_Preset);
 	LILV_FOREACH(nodes, i, presets) {
 		const LilvNode* preset = lilv_nodes_get(presets, i);
-		lilv_world_load_resource(_world.world, preset);
-		LilvNode* name = get_value(_world.world, preset, rdfs_label);
-		LilvNode* comment = get_value(_world.world, preset, rdfs_comment);
-		LilvNode* seealso = get_value(_world.world, preset, rdfs_seeAlso);
+		lilv_world_load_resource(world, preset);
+		LilvNode* name = get_value(world, preset, rdfs_label);
+		LilvNode* comment = get_value(world, preset, rdfs_comment);
+		LilvNode* seealso = get_value(world, preset, rdfs_seeAlso);
 
 		/* TODO properly identify user vs factory presets.
 		 * here's an indirect condition: only factory presets can have comments
@@ -3791,16 +3870,339 @@ LV2PluginInfo::get_presets (bool user_only) const
 	return p;
 }
 
+std::vector<Plugin::PresetRecord>
+LV2PluginInfo::get_presets (bool user_only) const
+{
+	if (!_world.loaded () && _have_cached_presets) {
+		std::vector<Plugin::PresetRecord> p;
+		for (std::vector<Plugin::PresetRecord>::const_iterator i = _cached_presets.begin (); i != _cached_presets.end (); ++i) {
+			if (!user_only || i->user) {
+				p.push_back (*i);
+			}
+		}
+		return p;
+	}
+
+	_world.load_bundled_plugins (true);
+
+	const LilvPlugin* lp = NULL;
+	try {
+		const LilvPlugins* plugins = lilv_world_get_all_plugins(_world.world);
+		LilvNode* uri = lilv_new_uri(_world.world, _plugin_uri);
+		if (!uri) { throw failed_constructor(); }
+		lp = lilv_plugins_get_by_uri(plugins, uri);
+		lilv_node_free(uri);
+		if (!lp) { throw failed_constructor(); }
+	} catch (failed_constructor& err) {
+		return std::vector<Plugin::PresetRecord> ();
+	}
+
+	return lv2_find_presets (_world.world, lp, user_only);
+}
+
+/* LV2 plugin cache
+ *
+ * Loading the lilv world parses the Turtle files of all installed
+ * bundles, which can take a few seconds with large collections.
+ * The result of LV2PluginInfo::discover is cached, and re-used as long as
+ * the set of bundles and their modification-times remains unchanged.
+ */
+
+#define LV2_CACHE_VERSION 1
+
+typedef std::map<std::string, int64_t> LV2BundleMTimes;
+
+static std::string
+lv2_cache_file ()
+{
+	return Glib::build_filename (ARDOUR::user_cache_directory (), "lv2_plugins.cache");
+}
+
+#ifndef PLATFORM_WINDOWS
+/* multiarch folders, e.g. /usr/lib/x86_64-linux-gnu/lv2 */
+static void
+lv2_add_multiarch_dirs (Searchpath& sp, std::string const& libdir)
+{
+	try {
+		Glib::Dir dir (libdir);
+		for (Glib::DirIterator i = dir.begin (); i != dir.end (); ++i) {
+			if ((*i).find ("-linux-") == std::string::npos) {
+				continue;
+			}
+			std::string const lv2dir = Glib::build_filename (libdir, *i, "lv2");
+			if (Glib::file_test (lv2dir, Glib::FILE_TEST_IS_DIR)) {
+				sp += lv2dir;
+			}
+		}
+	} catch (Glib::FileError const&) {
+	}
+}
+#endif
+
+/* Folders that lilv_world_load_all () scans. LV2_PATH replaces lilv's
+ * compiled-in default (LILV_DEFAULT_LV2_PATH), which is not public.
+ * Folders of bundles that lilv loaded are remembered in the cache, see
+ * lv2_cache_search_path ().
+ */
+static Searchpath
+lv2_system_search_path ()
+{
+	std::string const lv2_path = Glib::getenv ("LV2_PATH");
+	if (!lv2_path.empty ()) {
+		return Searchpath (search_path_expand (lv2_path));
+	}
+
+	Searchpath sp;
+#if defined PLATFORM_WINDOWS
+	sp += Glib::build_filename (Glib::getenv ("APPDATA"), "LV2");
+	sp += Glib::build_filename (Glib::getenv ("COMMONPROGRAMFILES"), "LV2");
+#elif defined __APPLE__
+	sp += Glib::build_filename (Glib::get_home_dir (), ".lv2");
+	sp += Glib::build_filename (Glib::get_home_dir (), "Library/Audio/Plug-Ins/LV2");
+	sp += "/usr/local/lib/lv2";
+	sp += "/usr/lib/lv2";
+	sp += "/Library/Audio/Plug-Ins/LV2";
+#else
+	sp += Glib::build_filename (Glib::get_home_dir (), ".lv2");
+	sp += "/usr/local/lib/lv2";
+	sp += "/usr/lib/lv2";
+	sp += "/usr/local/lib64/lv2";
+	sp += "/usr/lib64/lv2";
+	lv2_add_multiarch_dirs (sp, "/usr/local/lib");
+	lv2_add_multiarch_dirs (sp, "/usr/lib");
+#endif
+	return sp;
+}
+
+static void
+lv2_add_search_dir (Searchpath& sp, std::string const& dir)
+{
+	if (std::find (sp.begin (), sp.end (), dir) == sp.end ()) {
+		sp += dir;
+	}
+}
+
+/* add the folders of bundles that lilv loaded when the cache was written */
+static void
+lv2_cache_search_path (XMLNode const& root, Searchpath& sp)
+{
+	XMLNode const* sn = root.child ("SearchPath");
+	if (!sn) {
+		return;
+	}
+	for (XMLNodeConstIterator i = sn->children ().begin (); i != sn->children ().end (); ++i) {
+		std::string path;
+		if ((*i)->get_property ("path", path)) {
+			lv2_add_search_dir (sp, path);
+		}
+	}
+}
+
+static int64_t
+lv2_bundle_mtime (std::string const& bundle)
+{
+	GStatBuf sb;
+	int64_t  mtime = 0;
+
+	if (g_stat (bundle.c_str (), &sb) == 0) {
+		mtime = sb.st_mtime;
+	}
+
+	/* modifying a file in-place does not update the mtime of the bundle directory */
+	try {
+		Glib::Dir dir (bundle);
+		for (Glib::DirIterator i = dir.begin (); i != dir.end (); ++i) {
+			std::string const fn = Glib::build_filename (bundle, *i);
+			if (g_stat (fn.c_str (), &sb) == 0) {
+				mtime = std::max<int64_t> (mtime, sb.st_mtime);
+			}
+		}
+	} catch (Glib::FileError const&) {
+	}
+
+	return mtime;
+}
+
+static void
+lv2_bundle_mtimes (LV2BundleMTimes& bundles, Searchpath const& system_path)
+{
+	vector<string> paths;
+	find_paths_matching_filter (paths, ARDOUR::lv2_bundled_search_path (), lv2_filter, 0, true, true, true);
+	find_paths_matching_filter (paths, system_path, lv2_filter, 0, true, true, false);
+
+	for (vector<string>::const_iterator i = paths.begin (); i != paths.end (); ++i) {
+		bundles[*i] = lv2_bundle_mtime (*i);
+	}
+}
+
+static bool
+lv2_cache_valid (XMLNode const& root, LV2BundleMTimes const& bundles)
+{
+	int  version  = 0;
+	bool extended = false;
+
+	if (root.name () != "LV2Cache" || !root.get_property ("version", version) || version != LV2_CACHE_VERSION) {
+		return false;
+	}
+#ifdef LV2_EXTENDED
+	if (!root.get_property ("extended", extended) || !extended) {
+		return false;
+	}
+#else
+	if (!root.get_property ("extended", extended) || extended) {
+		return false;
+	}
+#endif
+
+	XMLNode const* bn = root.child ("Bundles");
+	if (!bn || !root.child ("Plugins") || bn->children ().size () != bundles.size ()) {
+		return false;
+	}
+
+	for (XMLNodeConstIterator i = bn->children ().begin (); i != bn->children ().end (); ++i) {
+		std::string path;
+		int64_t     mtime;
+		if (!(*i)->get_property ("path", path) || !(*i)->get_property ("mtime", mtime)) {
+			return false;
+		}
+		LV2BundleMTimes::const_iterator b = bundles.find (path);
+		if (b == bundles.end () || b->second != mtime) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static XMLNode*
+lv2_cache_plugin_node (XMLNode* plugins, std::string const& uri)
+{
+	if (!plugins->children ().empty ()) {
+		XMLNode* last = plugins->children ().back ();
+		std::string u;
+		if (last->get_property ("uri", u) && u == uri) {
+			return last;
+		}
+	}
+	XMLNode* node = plugins->add_child ("Plugin");
+	node->set_property ("uri", uri);
+	return node;
+}
+
+static void
+lv2_cache_log (XMLNode* plugins, std::function <void (std::string const&, PluginScanLogEntry::PluginScanResult, std::string const&, bool)> cb,
+               std::string const& uri, PluginScanLogEntry::PluginScanResult sr, std::string const& msg, bool reset)
+{
+	cb (uri, sr, msg, reset);
+
+	XMLNode* log = lv2_cache_plugin_node (plugins, uri)->add_child ("Log");
+	log->set_property ("result", (int) sr);
+	log->set_property ("msg", msg);
+	log->set_property ("reset", reset);
+}
+
 PluginInfoList*
-LV2PluginInfo::discover (std::function <void (std::string const&, PluginScanLogEntry::PluginScanResult, std::string const&, bool)> cb)
+LV2PluginInfo::discover (std::function <void (std::string const&, PluginScanLogEntry::PluginScanResult, std::string const&, bool)> scan_cb)
 {
+	std::string const cache_file = lv2_cache_file ();
+
+	XMLTree    cached;
+	bool const have_cache = Glib::file_test (cache_file, Glib::FILE_TEST_EXISTS) && cached.read (cache_file);
+
+	Searchpath search_path (lv2_system_search_path ());
+	if (have_cache) {
+		lv2_cache_search_path (*cached.root (), search_path);
+	}
+
+	LV2BundleMTimes bundles;
+	lv2_bundle_mtimes (bundles, search_path);
+
+	if (have_cache && lv2_cache_valid (*cached.root (), bundles)) {
+		PluginInfoList* plugs = new PluginInfoList;
+		XMLNode const*  pn    = cached.root ()->child ("Plugins");
+
+		try {
+			for (XMLNodeConstIterator i = pn->children ().begin (); i != pn->children ().end (); ++i) {
+				std::string uri;
+				if (!(*i)->get_property ("uri", uri)) {
+					throw failed_constructor ();
+				}
+				for (XMLNodeConstIterator j = (*i)->children ().begin (); j != (*i)->children ().end (); ++j) {
+					if ((*j)->name () == "Log") {
+						int         sr;
+						std::string msg;
+						bool        reset;
+						if (!(*j)->get_property ("result", sr) || !(*j)->get_property ("msg", msg) || !(*j)->get_property ("reset", reset)) {
+							throw failed_constructor ();
+						}
+						scan_cb (uri, PluginScanLogEntry::PluginScanResult (sr), msg, reset);
+					} else if ((*j)->name () == "LV2Info") {
+						plugs->push_back (LV2PluginInfoPtr (new LV2PluginInfo (**j)));
+					}
+				}
+			}
+			DEBUG_TRACE (DEBUG::LV2, string_compose ("Using LV2 plugin cache '%1' (%2 bundles)\n", cache_file, bundles.size ()));
+			return plugs;
+		} catch (failed_constructor& err) {
+			warning << string_compose (_("Ignoring invalid LV2 plugin cache '%1'"), cache_file) << endmsg;
+			delete plugs;
+		}
+	}
+
+	XMLNode* root = new XMLNode ("LV2Cache");
+	root->set_property ("version", LV2_CACHE_VERSION);
+#ifdef LV2_EXTENDED
+	root->set_property ("extended", true);
+#else
+	root->set_property ("extended", false);
+#endif
+
+	XMLNode* cache = root->add_child ("Plugins");
+
+	/* log messages are also written to the cache */
+	std::function <void (std::string const&, PluginScanLogEntry::PluginScanResult, std::string const&, bool)> cb
+		= std::bind (&lv2_cache_log, cache, scan_cb, _1, _2, _3, _4);
+
 	LV2World world;
 	world.load_bundled_plugins();
-	_world.load_bundled_plugins(true);
 
 	PluginInfoList*    plugs   = new PluginInfoList;
 	const LilvPlugins* plugins = lilv_world_get_all_plugins(world.world);
 
+	/* remember where lilv found bundles, its default search path may
+	 * include folders that lv2_system_search_path () does not know about.
+	 */
+	Searchpath const bundled_path (ARDOUR::lv2_bundled_search_path ());
+	Searchpath       lilv_path;
+	LILV_FOREACH(plugins, i, plugins) {
+		const LilvNode* bundle_uri = lilv_plugin_get_bundle_uri (lilv_plugins_get (plugins, i));
+		char*           bundle_path = bundle_uri ? lilv_file_uri_parse (lilv_node_as_uri (bundle_uri), NULL) : NULL;
+		if (!bundle_path) {
+			continue;
+		}
+		/* bundle URIs have a trailing slash */
+		std::string const dir = Glib::path_get_dirname (Glib::path_get_dirname (bundle_path));
+		lilv_free (bundle_path);
+		if (std::find (bundled_path.begin (), bundled_path.end (), dir) == bundled_path.end ()) {
+			lv2_add_search_dir (lilv_path, dir);
+		}
+	}
+
+	XMLNode* sn = root->add_child ("SearchPath");
+	for (Searchpath::const_iterator d = lilv_path.begin (); d != lilv_path.end (); ++d) {
+		sn->add_child ("Dir")->set_property ("path", *d);
+		lv2_add_search_dir (search_path, *d);
+	}
+
+	bundles.clear ();
+	lv2_bundle_mtimes (bundles, search_path);
+
+	XMLNode* bn = root->add_child ("Bundles");
+	for (LV2BundleMTimes::const_iterator b = bundles.begin (); b != bundles.end (); ++b) {
+		XMLNode* child = bn->add_child ("Bundle");
+		child->set_property ("path", b->first);
+		child->set_property ("mtime", b->second);
+	}
+
 	LILV_FOREACH(plugins, i, plugins) {
 		const LilvPlugin* p = lilv_plugins_get(plugins, i);
 		const LilvNode* pun = lilv_plugin_get_uri(p);
@@ -4028,9 +4430,19 @@ LV2PluginInfo::discover (std::function <void (std::string const&, PluginScanLogE
 			cb (uri, PluginScanLogEntry::OK, "", true);
 		}
 
+		info->_cached_presets      = lv2_find_presets (world.world, p, false);
+		info->_have_cached_presets = true;
+		lv2_cache_plugin_node (cache, uri)->add_child_nocopy (info->state ());
+
 		plugs->push_back(info);
 	}
 
+	XMLTree tree;
+	tree.set_root (root);
+	if (!tree.write (cache_file)) {
+		warning << string_compose (_("Could not write LV2 plugin cache '%1'"), cache_file) << endmsg;
+	}
+
 	return plugs;
 }
 
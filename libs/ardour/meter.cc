@@ -175,17 +175,22 @@ PeakMeter::run (BufferSet& bufs, samplepos_t /*start_sample*/, samplepos_t /*end
 			}
 		}
 
+		_meter_bufs[i] = bufs.get_audio (i).data ();
+	}
+
+	/* ballistic meters, all channels at once */
+	if (n_audio > 0) {
 		if (_meter_type & (MeterKrms | MeterK20 | MeterK14 | MeterK12)) {
-			_kmeter[i]->process (bufs.get_audio (i).data (), nframes);
+			Kmeterdsp::process (&_kmeter[0], &_meter_bufs[0], n_audio, nframes);
 		}
 		if (_meter_type & (MeterIEC1DIN | MeterIEC1NOR)) {
-			_iec1meter[i]->process (bufs.get_audio (i).data (), nframes);
+			Iec1ppmdsp::process (&_iec1meter[0], &_meter_bufs[0], n_audio, nframes);
 		}
 		if (_meter_type & (MeterIEC2BBC | MeterIEC2EBU)) {
-			_iec2meter[i]->process (bufs.get_audio (i).data (), nframes);
+			Iec2ppmdsp::process (&_iec2meter[0], &_meter_bufs[0], n_audio, nframes);
 		}
 		if (_meter_type & MeterVU) {
-			_vumeter[i]->process (bufs.get_audio (i).data (), nframes);
+			Vumeterdsp::process (&_vumeter[0], &_meter_bufs[0], n_audio, nframes);
 		}
 	}
 
@@ -349,6 +354,8 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 	assert (_iec2meter.size () == n_audio);
 	assert (_vumeter.size () == n_audio);
 
+	_meter_bufs.resize (n_audio);
+
 	reset ();
 	reset_max ();
 }
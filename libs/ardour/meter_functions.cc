@@ -0,0 +1,234 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/* Reference implementation of the meter kernels.
+ *
+ * Optimized versions must produce bit-identical results, they
+ * process channels in parallel and perform the same operations
+ * in the same order for each channel.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "ardour/mix.h"
+#include "ardour/runtime_functions.h"
+
+using namespace ARDOUR;
+
+/* clang-format off */
+float const true_peak_fir[3][48] = {
+	{
+		-2.330790e-05f, +1.321291e-04f, -3.394408e-04f, +6.562235e-04f, -1.094138e-03f, +1.665807e-03f, -2.385230e-03f, +3.268371e-03f,
+		-4.334012e-03f, +5.604985e-03f, -7.109989e-03f, +8.886314e-03f, -1.098403e-02f, +1.347264e-02f, -1.645206e-02f, +2.007155e-02f,
+		-2.456432e-02f, +3.031531e-02f, -3.800644e-02f, +4.896667e-02f, -6.616853e-02f, +9.788141e-02f, -1.788607e-01f, +9.000753e-01f,
+		+2.993829e-01f, -1.269367e-01f, +7.922398e-02f, -5.647748e-02f, +4.295093e-02f, -3.385706e-02f, +2.724946e-02f, -2.218943e-02f,
+		+1.816976e-02f, -1.489313e-02f, +1.217411e-02f, -9.891211e-03f, +7.961470e-03f, -6.326144e-03f, +4.942202e-03f, -3.777065e-03f,
+		+2.805240e-03f, -2.006106e-03f, +1.362416e-03f, -8.592768e-04f, +4.834383e-04f, -2.228007e-04f, +6.607267e-05f, -2.537056e-06f
+	}, {
+		-1.450055e-05f, +1.359163e-04f, -3.928527e-04f, +8.006445e-04f, -1.375510e-03f, +2.134915e-03f, -3.098103e-03f, +4.286860e-03f,
+		-5.726614e-03f, +7.448018e-03f, -9.489286e-03f, +1.189966e-02f, -1.474471e-02f, +1.811472e-02f, -2.213828e-02f, +2.700557e-02f,
+		-3.301023e-02f, +4.062971e-02f, -5.069345e-02f, +6.477499e-02f, -8.625619e-02f, +1.239454e-01f, -2.101678e-01f, +6.359382e-01f,
+		+6.359382e-01f, -2.101678e-01f, +1.239454e-01f, -8.625619e-02f, +6.477499e-02f, -5.069345e-02f, +4.062971e-02f, -3.301023e-02f,
+		+2.700557e-02f, -2.213828e-02f, +1.811472e-02f, -1.474471e-02f, +1.189966e-02f, -9.489286e-03f, +7.448018e-03f, -5.726614e-03f,
+		+4.286860e-03f, -3.098103e-03f, +2.134915e-03f, -1.375510e-03f, +8.006445e-04f, -3.928527e-04f, +1.359163e-04f, -1.450055e-05f
+	}, {
+		-2.537056e-06f, +6.607267e-05f, -2.228007e-04f, +4.834383e-04f, -8.592768e-04f, +1.362416e-03f, -2.006106e-03f, +2.805240e-03f,
+		-3.777065e-03f, +4.942202e-03f, -6.326144e-03f, +7.961470e-03f, -9.891211e-03f, +1.217411e-02f, -1.489313e-02f, +1.816976e-02f,
+		-2.218943e-02f, +2.724946e-02f, -3.385706e-02f, +4.295093e-02f, -5.647748e-02f, +7.922398e-02f, -1.269367e-01f, +2.993829e-01f,
+		+9.000753e-01f, -1.788607e-01f, +9.788141e-02f, -6.616853e-02f, +4.896667e-02f, -3.800644e-02f, +3.031531e-02f, -2.456432e-02f,
+		+2.007155e-02f, -1.645206e-02f, +1.347264e-02f, -1.098403e-02f, +8.886314e-03f, -7.109989e-03f, +5.604985e-03f, -4.334012e-03f,
+		+3.268371e-03f, -2.385230e-03f, +1.665807e-03f, -1.094138e-03f, +6.562235e-04f, -3.394408e-04f, +1.321291e-04f, -2.330790e-05f
+	}
+};
+/* clang-format on */
+
+void
+default_kmeter_process (float const* const* bufs, uint32_t n_chn, pframes_t nframes, float omega, float* z1, float* z2)
+{
+	for (uint32_t c = 0; c < n_chn; ++c) {
+		float const* p = bufs[c];
+		float        s;
+		float        y1 = z1[c];
+		float        y2 = z2[c];
+
+		/* the second filter is evaluated only every 4th sample */
+		for (pframes_t n = nframes / 4; n > 0; --n) {
+			s = *p++;
+			s *= s;
+			y1 += omega * (s - y1);
+			s = *p++;
+			s *= s;
+			y1 += omega * (s - y1);
+			s = *p++;
+			s *= s;
+			y1 += omega * (s - y1);
+			s = *p++;
+			s *= s;
+			y1 += omega * (s - y1);
+			y2 += 4 * omega * (y1 - y2);
+		}
+
+		z1[c] = y1;
+		z2[c] = y2;
+	}
+}
+
+void
+default_ppm_process (float const* const* bufs, uint32_t n_chn, pframes_t nframes, float w1, float w2, float w3, float* z1, float* z2, float* m)
+{
+	for (uint32_t c = 0; c < n_chn; ++c) {
+		float const* p = bufs[c];
+		float        t;
+		float        y1 = z1[c];
+		float        y2 = z2[c];
+		float        mx = m[c];
+
+		for (pframes_t n = nframes / 4; n > 0; --n) {
+			y1 *= w3;
+			y2 *= w3;
+			for (int i = 0; i < 4; ++i) {
+				t = fabsf (*p++);
+				if (t > y1) y1 += w1 * (t - y1);
+				if (t > y2) y2 += w2 * (t - y2);
+			}
+			t = y1 + y2;
+			if (t > mx) mx = t;
+		}
+
+		z1[c] = y1;
+		z2[c] = y2;
+		m[c]  = mx;
+	}
+}
+
+void
+default_vumeter_process (float const* const* bufs, uint32_t n_chn, pframes_t nframes, float w, float* z1, float* z2, float* m)
+{
+	for (uint32_t c = 0; c < n_chn; ++c) {
+		float const* p = bufs[c];
+		float        t1, t2;
+		float        y1 = z1[c];
+		float        y2 = z2[c];
+		float        mx = m[c];
+
+		for (pframes_t n = nframes / 4; n > 0; --n) {
+			t2 = y2 / 2;
+			t1 = fabsf (*p++) - t2;
+			y1 += w * (t1 - y1);
+			t1 = fabsf (*p++) - t2;
+			y1 += w * (t1 - y1);
+			t1 = fabsf (*p++) - t2;
+			y1 += w * (t1 - y1);
+			t1 = fabsf (*p++) - t2;
+			y1 += w * (t1 - y1);
+			y2 += 4 * w * (y1 - y2);
+			if (y2 > mx) mx = y2;
+		}
+
+		z1[c] = y1;
+		z2[c] = y2;
+		m[c]  = mx;
+	}
+}
+
+void
+default_kweight_process (float const* const* bufs, uint32_t n_chn, pframes_t nframes, uint32_t offset, KWeightCoeff const& k, float* z1, float* z2, float* z3, float* z4, float* pwr)
+{
+	for (uint32_t c = 0; c < n_chn; ++c) {
+		float const* d  = bufs[c] + offset;
+		float        y1 = z1[c];
+		float        y2 = z2[c];
+		float        y3 = z3[c];
+		float        y4 = z4[c];
+		float        s  = 0;
+
+		for (pframes_t i = 0; i < nframes; ++i) {
+			float x = d[i] - k.b1 * y1 - k.b2 * y2 + 1e-15f;
+			float y = k.a0 * x + k.a1 * y1 + k.a2 * y2 - k.c3 * y3 - k.c4 * y4;
+			y2 = y1;
+			y1 = x;
+			y4 += y3;
+			y3 += y;
+			s += y * y;
+		}
+
+		z1[c]  = y1;
+		z2[c]  = y2;
+		z3[c]  = y3;
+		z4[c]  = y4;
+		pwr[c] = s;
+	}
+}
+
+static inline float
+fir48 (float const* r, float const* c)
+{
+	float u = r[0] * c[0];
+	for (int i = 1; i < 48; ++i) {
+		u += r[i] * c[i];
+	}
+	return u;
+}
+
+void
+default_true_peak_x2 (float const* const* bufs, uint32_t n_chn, pframes_t nframes, float* const* hist, float* peak)
+{
+	for (uint32_t c = 0; c < n_chn; ++c) {
+		float const* d = bufs[c];
+		float*       r = hist[c];
+
+		for (pframes_t i = 0; i < nframes; ++i) {
+			r[47] = d[i];
+
+			float const u0 = r[47];
+			float const u1 = fir48 (r, true_peak_fir[1]);
+
+			for (int j = 0; j < 47; ++j) {
+				r[j] = r[j + 1];
+			}
+
+			*peak = std::max (*peak, std::max (u0, u1));
+		}
+	}
+}
+
+void
+default_true_peak_x4 (float const* const* bufs, uint32_t n_chn, pframes_t nframes, float* const* hist, float* peak)
+{
+	for (uint32_t c = 0; c < n_chn; ++c) {
+		float const* d = bufs[c];
+		float*       r = hist[c];
+
+		for (pframes_t i = 0; i < nframes; ++i) {
+			r[47] = d[i];
+
+			/* This effectively introduces a latency of 23 samples */
+			float const u0 = r[47];
+			float const u1 = fir48 (r, true_peak_fir[0]);
+			float const u2 = fir48 (r, true_peak_fir[1]);
+			float const u3 = fir48 (r, true_peak_fir[2]);
+
+			for (int j = 0; j < 47; ++j) {
+				r[j] = r[j + 1];
+			}
+
+			float const p1 = std::max (fabsf (u0), fabsf (u1));
+			float const p2 = std::max (fabsf (u2), fabsf (u3));
+			*peak = std::max (*peak, std::max (p1, p2));
+		}
+	}
+}
@@ -308,13 +308,36 @@ MidiBuffer::silence (samplecnt_t nframes, samplecnt_t offset)
 		return;
 	}
 
-	for (MidiBuffer::iterator i = begin(); i != end();) {
-		const Evoral::Event<TimeType> ev(*i, false);
-		if (ev.time() >= offset && ev.time() < nframes + offset) {
-			i = erase (i);
-		} else {
-			++i;
+	/* compact the buffer in a single pass, rather than erasing events
+	 * one by one, which would move the tail of the buffer each time.
+	 */
+	size_t out = 0;
+	size_t in  = 0;
+
+	while (in < _size) {
+		const int n = event_bytes (_data + in);
+		if (n < 0) {
+			/* unknown size, sysex: keep the remainder as-is */
+			if (out != in) {
+				memmove (_data + out, _data + in, _size - in);
+			}
+			out += _size - in;
+			break;
+		}
+		const TimeType t = *(reinterpret_cast<TimeType const*>((uintptr_t)(_data + in)));
+		if (t < offset || t >= nframes + offset) {
+			if (out != in) {
+				memmove (_data + out, _data + in, n);
+			}
+			out += n;
 		}
+		in += n;
+	}
+
+	_size = out;
+
+	if (_size == 0) {
+		_silent = true;
 	}
 }
 
@@ -439,7 +462,12 @@ MidiBuffer::second_simultaneous_midi_byte_is_first (uint8_t a, uint8_t b)
 	return b_first;
 }
 
-/** Merge \a other into this buffer.  Realtime safe. */
+/** Merge \a other into this buffer.  Realtime safe.
+ *
+ * Our own events are first moved to the end of the buffer, then both
+ * sequences are merged front to back. This is a single linear pass,
+ * regardless of how the two sequences interleave.
+ */
 bool
 MidiBuffer::merge_in_place (const MidiBuffer &other)
 {
@@ -462,145 +490,83 @@ MidiBuffer::merge_in_place (const MidiBuffer &other)
 		return true;
 	}
 
-	const_iterator them = other.begin();
-	iterator us = begin();
-
-	while (them != other.end()) {
-
-		size_t bytes_to_merge;
-		ssize_t merge_offset;
+	/* keep events 4-byte aligned (see align32) */
+	const size_t gap = (_capacity - _size) & ~((size_t) 3);
 
-		/* gather up total size of events that are earlier than
-		   the event referenced by "us"
-		*/
-
-		merge_offset = -1;
-		bytes_to_merge = 0;
-
-		while (them != other.end() && (*them).time() < (*us).time()) {
-			if (merge_offset == -1) {
-				merge_offset = them.offset;
-			}
-			bytes_to_merge += align32 (header_size + (*them).size());
-			++them;
-		}
+	if (gap < other.size ()) {
+		return false;
+	}
 
-		/* "them" now points to either:
-		 *
-		 * 1) an event that has the same or later timestamp than the
-		 *        event pointed to by "us"
-		 *
-		 * OR
-		 *
-		 * 2) the end of the "other" buffer
-		 *
-		 * if "sz" is non-zero, there is data to be merged from "other"
-		 * into this buffer before we do anything else, corresponding
-		 * to the events from "other" that we skipped while advancing
-		 * "them".
-		 */
+	memmove (_data + gap, _data, _size);
 
-		if (bytes_to_merge) {
-			assert(merge_offset >= 0);
-			/* move existing */
-			memmove (_data + us.offset + bytes_to_merge, _data + us.offset, _size - us.offset);
-			/* increase _size */
-			_size += bytes_to_merge;
-			assert (_size <= _capacity);
-			/* insert new stuff */
-			memcpy  (_data + us.offset, other._data + merge_offset, bytes_to_merge);
-			/* update iterator to our own events. this is a miserable hack */
-			us.offset += bytes_to_merge;
-		}
+	/* The write position can never overtake the read position of our
+	 * own events: the distance between both is the gap minus the
+	 * number of bytes already merged from "other", which is >= 0.
+	 */
+	size_t       us       = gap;
+	const size_t us_end   = gap + _size;
+	size_t       them     = 0;
+	const size_t them_end = other._size;
+	size_t       out      = 0;
 
-		/* if we're at the end of the other buffer, we're done */
+	while (us < us_end && them < them_end) {
 
-		if (them == other.end()) {
-			break;
-		}
+		const TimeType t_us   = *(reinterpret_cast<TimeType const*>((uintptr_t)(_data + us)));
+		const TimeType t_them = *(reinterpret_cast<TimeType const*>((uintptr_t)(other._data + them)));
 
-		/* if we have two messages messages with the same timestamp. we
-		 * must order them correctly.
-		 */
+		bool them_first;
 
-		if ((*us).time() == (*them).time()) {
+		if (t_them != t_us) {
+			them_first = t_them < t_us;
+		} else {
+			/* if we have two messages messages with the same timestamp,
+			 * we must order them correctly.
+			 */
+			uint8_t our_midi_status_byte   = *(_data + us + header_size);
+			uint8_t their_midi_status_byte = *(other._data + them + header_size);
+			them_first = second_simultaneous_midi_byte_is_first (our_midi_status_byte, their_midi_status_byte);
 
 			DEBUG_TRACE (DEBUG::MidiIO,
-				     string_compose ("simultaneous MIDI events discovered during merge, times %1/%2 status %3/%4\n",
-						     (*us).time(), (*them).time(),
-						     (int) *(_data + us.offset + header_size),
-						     (int) *(other._data + them.offset + header_size)));
-
-			uint8_t our_midi_status_byte = *(_data + us.offset + header_size);
-			uint8_t their_midi_status_byte = *(other._data + them.offset + header_size);
-			bool them_first = second_simultaneous_midi_byte_is_first (our_midi_status_byte, their_midi_status_byte);
-
-			DEBUG_TRACE (DEBUG::MidiIO, string_compose ("other message came first ? %1\n", them_first));
-
-			if (!them_first) {
-				/* skip past our own event */
-				++us;
-			}
-
-			bytes_to_merge = align32 (header_size + (*them).size());
-
-			/* move our remaining events later in the buffer by
-			 * enough to fit the one message we're going to merge
-			 */
+			             string_compose ("simultaneous MIDI events discovered during merge, times %1/%2 status %3/%4 other first ? %5\n",
+			                             t_us, t_them, (int) our_midi_status_byte, (int) their_midi_status_byte, them_first));
+		}
 
-			memmove (_data + us.offset + bytes_to_merge, _data + us.offset, _size - us.offset);
-			/* increase _size */
-			_size += bytes_to_merge;
-			assert(_size <= _capacity);
-			/* insert new stuff */
-			memcpy  (_data + us.offset, other._data + them.offset, bytes_to_merge);
-			/* update iterator to our own events. this is a miserable hack */
-			us.offset += bytes_to_merge;
-			/* 'us' is now an iterator to the event right after the
-			   new ones that we merged
-			*/
-			if (them_first) {
-				/* need to skip the event pointed to by 'us'
-				   since its at the same time as 'them'
-				   (still), and we'll enter
-				*/
-
-				if (us != end()) {
-					++us;
-				}
+		if (them_first) {
+			const int n = event_bytes (other._data + them);
+			if (n < 0) {
+				break;
 			}
-
-			/* we merged one event from the other buffer, so
-			 * advance the iterator there.
-			 */
-
-			++them;
-
+			memcpy (_data + out, other._data + them, n);
+			them += n;
+			out  += n;
 		} else {
-
-			/* advance past our own events to get to the correct insertion
-			   point for the next event(s) from "other"
-			*/
-
-			while (us != end() && (*us).time() <= (*them).time()) {
-				++us;
+			const int n = event_bytes (_data + us);
+			if (n < 0) {
+				break;
 			}
+			if (out != us) {
+				memmove (_data + out, _data + us, n);
+			}
+			us  += n;
+			out += n;
 		}
+	}
 
-		/* check to see if we reached the end of this buffer while
-		 * looking for the insertion point.
-		 */
-
-		if (us == end()) {
+	/* append whatever remains */
 
-			/* just append the rest of other and we're done*/
+	if (them < them_end) {
+		memcpy (_data + out, other._data + them, them_end - them);
+		out += them_end - them;
+	}
 
-			memcpy (_data + us.offset, other._data + them.offset, other._size - them.offset);
-			_size += other._size - them.offset;
-			assert(_size <= _capacity);
-			break;
-		}
+	if (us < us_end) {
+		memmove (_data + out, _data + us, us_end - us);
+		out += us_end - us;
 	}
 
+	assert (out <= _capacity);
+	_size   = out;
+	_silent = false;
+
 	return true;
 }
@@ -168,6 +168,10 @@ PlugInsertBase::find_and_load_plugin (Session& s, XMLNode const& node, PluginTyp
 void
 PlugInsertBase::set_control_ids (const XMLNode& node, int version, bool by_value)
 {
+	static const XMLPropertyName prop_symbol ("symbol");
+	static const XMLPropertyName prop_parameter ("parameter");
+	static const XMLPropertyName prop_value ("value");
+
 	const XMLNodeList& nlist = node.children();
 	for (XMLNodeConstIterator iter = nlist.begin(); iter != nlist.end(); ++iter) {
 		if ((*iter)->name() != Controllable::xml_node_name) {
@@ -176,14 +180,14 @@ PlugInsertBase::set_control_ids (const XMLNode& node, int version, bool by_value
 
 		uint32_t p = (uint32_t)-1;
 		std::string str;
-		if ((*iter)->get_property (X_("symbol"), str)) {
+		if ((*iter)->get_property (prop_symbol, str)) {
 			std::shared_ptr<LV2Plugin> lv2plugin = std::dynamic_pointer_cast<LV2Plugin> (plugin ());
 			if (lv2plugin) {
 				p = lv2plugin->port_index(str.c_str());
 			}
 		}
 		if (p == (uint32_t)-1) {
-			(*iter)->get_property (X_("parameter"), p);
+			(*iter)->get_property (prop_parameter, p);
 		}
 
 		if (p == (uint32_t)-1) {
@@ -201,7 +205,7 @@ PlugInsertBase::set_control_ids (const XMLNode& node, int version, bool by_value
 
 		if (by_value) {
 			float val;
-			if ((*iter)->get_property (X_("value"), val)) {
+			if ((*iter)->get_property (prop_value, val)) {
 				ac->set_value (val, Controllable::NoGroup);
 			}
 		} else {
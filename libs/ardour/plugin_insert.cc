@@ -29,13 +29,22 @@
 #include <string>
 
 #include "pbd/assert.h"
+#include "pbd/cpus.h"
+#include "pbd/error.h"
 #include "pbd/failed_constructor.h"
+#include "pbd/mpmc_queue.h"
+#include "pbd/pthread_utils.h"
 #include "pbd/xml++.h"
 #include "pbd/types_convert.h"
 
+#include "temporal/tempo.h"
+
 #include "ardour/audio_buffer.h"
+#include "ardour/audioengine.h"
 #include "ardour/automation_list.h"
+#include "ardour/buffer_manager.h"
 #include "ardour/buffer_set.h"
+#include "ardour/dB.h"
 #include "ardour/debug.h"
 #include "ardour/event_type_map.h"
 #include "ardour/ladspa_plugin.h"
@@ -44,7 +53,11 @@
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
 #include "ardour/port.h"
+#include "ardour/process_thread.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/runtime_functions.h"
 #include "ardour/session.h"
+#include "ardour/session_event.h"
 #include "ardour/types.h"
 
 #include "pbd/i18n.h"
@@ -55,6 +68,173 @@ using namespace PBD;
 
 const string PluginInsert::port_automation_node_name = "PortAutomation";
 
+namespace {
+
+/** Worker threads that process replicated plugin instances
+ * of all plugin inserts, see PluginInsert::run_instances_parallel.
+ *
+ * Like the process-graph threads, workers are created by the
+ * engine's backend when it starts, and joined when it stops.
+ */
+class InstancePool
+{
+public:
+	struct Job {
+		void     (*run) (void*, uint32_t);
+		void*    arg;
+		uint32_t instance;
+	};
+
+	InstancePool ()
+		: _sem ("plugin instances", 0)
+	{
+		_queue.reserve (1024);
+		_terminate.store (false);
+		_available.store (false);
+
+		AudioEngine::instance ()->Running.connect_same_thread (_engine_connections, std::bind (&InstancePool::start, this));
+		AudioEngine::instance ()->Stopped.connect_same_thread (_engine_connections, std::bind (&InstancePool::stop, this));
+		AudioEngine::instance ()->Halted.connect_same_thread (_engine_connections, std::bind (&InstancePool::stop, this));
+
+		if (AudioEngine::instance ()->running ()) {
+			start ();
+		}
+	}
+
+	~InstancePool ()
+	{
+		_engine_connections.drop_connections ();
+		stop ();
+	}
+
+	bool available () const
+	{
+		return _available.load ();
+	}
+
+	void schedule (Job const& job)
+	{
+		if (!_queue.push_back (job)) {
+			/* queue overflow */
+			job.run (job.arg, job.instance);
+			return;
+		}
+		_sem.signal ();
+	}
+
+	/** run a queued job in the calling thread, if any */
+	bool run_one ()
+	{
+		Job job;
+		if (!_queue.pop_front (job)) {
+			return false;
+		}
+		job.run (job.arg, job.instance);
+		return true;
+	}
+
+private:
+	void start ()
+	{
+		/* see BufferManager::reserve_thread_buffers */
+		Glib::Threads::Mutex::Lock lm (AudioEngine::instance ()->process_lock ());
+
+		if (!_workers.empty ()) {
+			return;
+		}
+
+		_terminate.store (false);
+
+		uint32_t const n_threads = std::min<uint32_t> (8, std::max<uint32_t> (1, hardware_concurrency () / 2));
+
+		/* every worker keeps thread-buffers */
+		BufferManager::reserve_thread_buffers (n_threads);
+
+		/* Process threads wait for the workers, which must not have a lower
+		 * priority. Without realtime threads, instances are processed serially.
+		 */
+		for (uint32_t i = 0; i < n_threads; ++i) {
+			pthread_t t;
+			if (AudioEngine::instance ()->create_worker_thread (std::bind (&InstancePool::worker_thread, this), &t)) {
+				break;
+			}
+			_workers.push_back (t);
+		}
+
+		BufferManager::release_thread_buffers (n_threads - _workers.size ());
+
+		if (_workers.empty ()) {
+			PBD::warning << _("PluginInsert: cannot start worker threads, plugin instances are processed serially.") << endmsg;
+		}
+
+		_available.store (!_workers.empty ());
+	}
+
+	void stop ()
+	{
+		/* process threads run queued jobs themselves, see
+		 * PluginInsert::run_instances_parallel, so no job is lost.
+		 */
+		_available.store (false);
+		_terminate.store (true);
+
+		for (size_t i = 0; i < _workers.size (); ++i) {
+			_sem.signal ();
+		}
+		for (auto const& t : _workers) {
+			AudioEngine::instance ()->join_worker_thread (t);
+		}
+
+		BufferManager::release_thread_buffers (_workers.size ());
+		_workers.clear ();
+		_sem.reset ();
+	}
+
+	void worker_thread ()
+	{
+		char name[64];
+		snprintf (name, 64, "PluginInst-%p", (void*)DEBUG_THREAD_SELF);
+		pthread_set_name (name);
+
+		/* This is needed for ARDOUR::Session requests called from rt-processors
+		 * in particular Lua scripts may do cross-thread calls */
+		SessionEvent::create_per_thread_pool (name, 64);
+		PBD::notify_event_loops_about_thread_creation (pthread_self (), name, 64);
+
+		ProcessThread* pt = new ProcessThread ();
+		pt->get_buffers ();
+
+		run ();
+
+		pt->drop_buffers ();
+		delete pt;
+	}
+
+	void run ()
+	{
+		while (true) {
+			_sem.wait ();
+			if (_terminate.load ()) {
+				break;
+			}
+			Temporal::TempoMap::fetch ();
+			run_one ();
+		}
+	}
+
+	PBD::MPMCQueue<Job>       _queue;
+	PBD::Semaphore            _sem;
+	std::vector<pthread_t>    _workers;
+	std::atomic<bool>         _terminate;
+	std::atomic<bool>         _available;
+	PBD::ScopedConnectionList _engine_connections;
+};
+
+/* created on demand, see PluginInsert::start_instance_workers */
+std::atomic<InstancePool*> instance_pool (0);
+
+} // namespace
+
 PluginInsert::PluginInsert (Session& s, Temporal::TimeDomainProvider const & tdp, std::shared_ptr<Plugin> plug)
 	: Processor (s, (plug ? plug->name() : string ("toBeRenamed")), tdp)
 	, _sc_playback_latency (0)
@@ -70,9 +250,18 @@ PluginInsert::PluginInsert (Session& s, Temporal::TimeDomainProvider const & tdp
 	, _latency_changed (false)
 	, _bypass_port (UINT32_MAX)
 	, _inverted_bypass_enable (false)
+	, _instances_done ("plugin instances", 0)
+	, _instance_cost (0)
+	, _silent_samples (0)
 {
 	_stat_reset.store (0);
 	_flush.store (0);
+	_instance_dsp.store (0);
+	_instance_failed.store (false);
+	_instance_total.store (0);
+	_instance_cycles.store (0);
+	_parallel_cycles.store (0);
+	_asleep.store (false);
 
 	/* the first is the master */
 	if (plug) {
@@ -1118,10 +1307,16 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 		}
 	} else {
 		/* in-place processing */
-		uint32_t pc = 0;
-		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
-			if ((*i)->connect_and_run(bufs, start, end, speed, in_map.p(pc), out_map.p(pc), nframes, offset)) {
-				deactivate ();
+		if (!run_instances_parallel (bufs, start, end, speed, in_map, out_map, nframes, offset)) {
+			PBD::microseconds_t const t0 = _plugins.size () > 1 ? PBD::get_microseconds () : 0;
+			uint32_t pc = 0;
+			for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
+				if ((*i)->connect_and_run(bufs, start, end, speed, in_map.p(pc), out_map.p(pc), nframes, offset)) {
+					deactivate ();
+				}
+			}
+			if (_plugins.size () > 1) {
+				update_instance_stats (PBD::get_microseconds () - t0, false);
 			}
 		}
 		// now silence unconnected outputs
@@ -1280,6 +1475,10 @@ PluginInsert::silence (samplecnt_t nframes, samplepos_t start_sample)
 
 	_delaybuffers.flush ();
 
+	if (check_asleep (0, nframes)) {
+		return;
+	}
+
 	/* TODO use mapping, do not change I/O -- this can
 	 * cause VST3 to perform activateBus, setBusArrangements calls
 	 * which may cause causes a DSP spike (!)
@@ -1293,6 +1492,7 @@ PluginInsert::silence (samplecnt_t nframes, samplepos_t start_sample)
 	int canderef (1);
 	if (_stat_reset.compare_exchange_strong (canderef, 0)) {
 		_timing_stats.reset ();
+		reset_instance_stats ();
 	}
 
 #ifdef MIXBUS
@@ -1322,6 +1522,7 @@ PluginInsert::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sa
 	int canderef (1);
 	if (_stat_reset.compare_exchange_strong (canderef, 0)) {
 		_timing_stats.reset ();
+		reset_instance_stats ();
 	}
 
 	if (_active != _pending_active && !_pending_active) {
@@ -1338,7 +1539,16 @@ PluginInsert::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sa
 		}
 	}
 
-	if (_pending_active) {
+	if (_pending_active && check_asleep (&bufs, nframes)) {
+		/* input has been silent for long enough, the plugin would
+		 * only produce silence.
+		 */
+		automation_run (start_sample, nframes, true); // evaluate automation only
+		bufs.set_count (ChanCount::max (bufs.count (), _configured_internal));
+		bufs.set_count (ChanCount::max (bufs.count (), _configured_out));
+		bufs.silence (nframes, 0);
+
+	} else if (_pending_active) {
 #if defined MIXBUS && defined NDEBUG
 		if (!is_channelstrip ()) {
 			_timing_stats.start ();
@@ -1369,6 +1579,8 @@ PluginInsert::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sa
 		bypass (bufs, nframes);
 		automation_run (start_sample, nframes, true); // evaluate automation only
 		_delaybuffers.flush ();
+		_silent_samples = 0;
+		set_asleep (false);
 	}
 
 	/* we have no idea whether the plugin generated silence or not, so mark
@@ -2614,6 +2826,11 @@ PluginInsert::state () const
 	}
 	node.add_child_nocopy (* _thru_map.state ("ThruMap"));
 
+	if (Config->get_sleep_silent_plugins ()) {
+		/* the tail-time override is only used to put plugins to sleep */
+		TailTime::add_state (&node);
+	}
+
 	if (_sidechain) {
 		node.add_child_nocopy (_sidechain->get_state ());
 	}
@@ -2634,9 +2851,12 @@ PluginInsert::state () const
 int
 PluginInsert::set_state(const XMLNode& node, int version)
 {
-	XMLNodeList nlist = node.children();
-	XMLNodeIterator niter;
-	XMLPropertyList plist;
+	static const XMLPropertyName prop_count ("count");
+	static const XMLPropertyName prop_id ("id");
+	static const XMLPropertyName prop_custom ("custom");
+
+	XMLNodeList const& nlist = node.children();
+	XMLNodeConstIterator niter;
 	ARDOUR::PluginType type;
 	std::string unique_id;
 
@@ -2646,7 +2866,7 @@ PluginInsert::set_state(const XMLNode& node, int version)
 
 	bool any_vst = false;
 	uint32_t count = 1;
-	node.get_property ("count", count);
+	node.get_property (prop_count, count);
 
 	if (_plugins.empty()) {
 		std::shared_ptr<Plugin> plugin = find_and_load_plugin (_session, node, type, unique_id, any_vst);
@@ -2685,11 +2905,12 @@ PluginInsert::set_state(const XMLNode& node, int version)
 	}
 
 	Processor::set_state (node, version);
+	TailTime::set_state (node, version);
 
 	PBD::ID new_id = this->id();
 	PBD::ID old_id = this->id();
 
-	node.get_property ("id", old_id);
+	node.get_property (prop_id, old_id);
 
 	for (niter = nlist.begin(); niter != nlist.end(); ++niter) {
 		/* find the node with the type-specific node name ("lv2", "ladspa", etc)
@@ -2752,12 +2973,11 @@ PluginInsert::set_state(const XMLNode& node, int version)
 		set_parameter_state_2X (node, version);
 	}
 
-	node.get_property (X_("custom"), _custom_cfg);
+	node.get_property (prop_custom, _custom_cfg);
 
 	uint32_t in_maps = 0;
 	uint32_t out_maps = 0;
-	XMLNodeList kids = node.children ();
-	for (XMLNodeIterator i = kids.begin(); i != kids.end(); ++i) {
+	for (XMLNodeConstIterator i = nlist.begin(); i != nlist.end(); ++i) {
 		if ((*i)->name() == X_("ConfiguredInput")) {
 			_configured_in = ChanCount(**i);
 		}
@@ -2942,6 +3162,15 @@ PluginInsert::signal_latency() const
 	return plugin_latency ();
 }
 
+samplecnt_t
+PluginInsert::signal_tailtime () const
+{
+	if (_plugins.empty ()) {
+		return 0;
+	}
+	return _plugins.front ()->signal_tailtime ();
+}
+
 ARDOUR::PluginType
 PluginInsert::type () const
 {
@@ -3192,3 +3421,189 @@ PluginInsert::clear_stats ()
 {
 	_stat_reset.store (1);
 }
+
+bool
+PluginInsert::get_instance_stats (double& avg, double& parallel) const
+{
+	uint64_t const cycles = _instance_cycles.load ();
+	if (_plugins.size () < 2 || cycles == 0) {
+		return false;
+	}
+	avg      = _instance_total.load () / (double) cycles;
+	parallel = _parallel_cycles.load () / (double) cycles;
+	return true;
+}
+
+void
+PluginInsert::reset_instance_stats ()
+{
+	_instance_total.store (0);
+	_instance_cycles.store (0);
+	_parallel_cycles.store (0);
+}
+
+void
+PluginInsert::update_instance_stats (PBD::microseconds_t dsp, bool parallel)
+{
+	/* moving average, to decide if parallel processing is worth it */
+	_instance_cost += .05 * ((double) dsp - _instance_cost);
+
+	_instance_total.fetch_add (dsp);
+	_instance_cycles.fetch_add (1);
+	if (parallel) {
+		_parallel_cycles.fetch_add (1);
+	}
+}
+
+bool
+PluginInsert::may_sleep () const
+{
+	if (!Config->get_sleep_silent_plugins () || _plugins.empty ()) {
+		return false;
+	}
+#ifdef MIXBUS
+	if (is_channelstrip ()) {
+		return false;
+	}
+#endif
+	/* notes that were started before the input became silent
+	 * may still sound (instruments); active notes are not tracked.
+	 */
+	if (natural_input_streams ().n_midi () > 0) {
+		return false;
+	}
+	/* generators and MIDI processors may produce data without input */
+	return natural_input_streams ().n_total () > 0 && natural_output_streams ().n_midi () == 0;
+}
+
+bool
+PluginInsert::check_asleep (BufferSet const* bufs, pframes_t nframes)
+{
+	bool silent = may_sleep ();
+
+	/* bufs == 0: the plugin is fed silence, see ::silence */
+	if (silent && bufs) {
+		for (uint32_t i = 0; silent && i < bufs->count ().n_audio (); ++i) {
+			silent = compute_peak (bufs->get_audio (i).data (), nframes, 0) <= GAIN_COEFF_SMALL;
+		}
+		for (uint32_t i = 0; silent && i < bufs->count ().n_midi (); ++i) {
+			silent = bufs->get_midi (i).empty ();
+		}
+	}
+
+	if (!silent) {
+		_silent_samples = 0;
+		set_asleep (false);
+		return false;
+	}
+
+	/* The plugin's output is silent once all prior input has been
+	 * processed: latency + tail-time after the input became silent.
+	 * The first non-silent cycle wakes it up again.
+	 */
+	bool const asleep = _silent_samples >= effective_latency () + effective_tailtime ();
+	_silent_samples += nframes;
+	set_asleep (asleep);
+	return asleep;
+}
+
+void
+PluginInsert::set_asleep (bool yn)
+{
+	if (_asleep.load () == yn) {
+		return;
+	}
+	_asleep.store (yn);
+
+	/* A sleeping plugin does not update its control outputs (meters,
+	 * gain-reduction etc). Report their normal value instead of the
+	 * last one, until the plugin runs again.
+	 */
+	for (CtrlOutMap::const_iterator i = _control_outputs.begin (); i != _control_outputs.end (); ++i) {
+		i->second->set_resting (yn);
+	}
+}
+
+void
+PluginInsert::start_instance_workers ()
+{
+	if (instance_pool.load ()) {
+		return;
+	}
+	InstancePool* pool = new InstancePool ();
+	InstancePool* none = 0;
+	if (!instance_pool.compare_exchange_strong (none, pool)) {
+		/* cannot happen, this is only called from the GUI thread */
+		assert (0);
+	}
+}
+
+void
+PluginInsert::drop_instance_workers ()
+{
+	delete instance_pool.exchange (0);
+}
+
+bool
+PluginInsert::run_instances_parallel (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, PinMappings const& in_map, PinMappings const& out_map, pframes_t nframes, samplecnt_t offset)
+{
+	InstancePool* pool = instance_pool.load ();
+
+	if (_plugins.size () < 2 || !pool || !pool->available () || !Config->get_parallel_plugin_instances ()) {
+		return false;
+	}
+
+	/* cheap plugins are processed serially, dispatching would cost more than it saves.
+	 * MIDI is not thread-safe, since all instances share the same MIDI buffer.
+	 */
+	if (_instance_cost < Config->get_parallel_plugin_threshold () || bufs.count ().n_midi () > 0) {
+		return false;
+	}
+
+	_instance_args.bufs    = &bufs;
+	_instance_args.in_map  = &in_map;
+	_instance_args.out_map = &out_map;
+	_instance_args.start   = start;
+	_instance_args.end     = end;
+	_instance_args.speed   = speed;
+	_instance_args.nframes = nframes;
+	_instance_args.offset  = offset;
+
+	_instance_dsp.store (0);
+	_instance_failed.store (false);
+
+	for (uint32_t pc = 1; pc < _plugins.size (); ++pc) {
+		InstancePool::Job job = { &PluginInsert::run_instance, this, pc };
+		pool->schedule (job);
+	}
+
+	run_instance (this, 0);
+
+	/* help with queued jobs (of any plugin), then wait for the remaining instances */
+	while (pool->run_one ()) ;
+
+	for (uint32_t pc = 0; pc < _plugins.size (); ++pc) {
+		_instances_done.wait ();
+	}
+
+	if (_instance_failed.load ()) {
+		deactivate ();
+	}
+
+	update_instance_stats (_instance_dsp.load (), true);
+	return true;
+}
+
+void
+PluginInsert::run_instance (void* arg, uint32_t pc)
+{
+	PluginInsert*       self = static_cast<PluginInsert*> (arg);
+	InstanceArgs const& a    = self->_instance_args;
+
+	PBD::microseconds_t const t0 = PBD::get_microseconds ();
+	if (self->_plugins[pc]->connect_and_run (*a.bufs, a.start, a.end, a.speed, a.in_map->p (pc), a.out_map->p (pc), a.nframes, a.offset)) {
+		self->_instance_failed.store (true);
+	}
+	self->_instance_dsp.fetch_add (PBD::get_microseconds () - t0);
+	self->_instances_done.signal ();
+}
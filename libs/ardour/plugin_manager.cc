@@ -69,6 +69,7 @@
 #include <glibmm/fileutils.h>
 
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
 #include "pbd/file_utils.h"
 #include "pbd/tokenizer.h"
 #include "pbd/whitespace.h"
@@ -1544,6 +1545,28 @@ PluginManager::run_vst2_scanner_app (std::string path, PSLEPtr psle) const
 	return true;
 }
 
+void
+PluginManager::vst2_scan_outdated (std::vector<std::string> const& paths, ARDOUR::PluginType type, std::set<std::string>& failed)
+{
+	if (vst2_scanner_bin_path.empty ()) {
+		return;
+	}
+
+	std::vector<ScanJob> jobs;
+
+	for (std::vector<std::string>::const_iterator i = paths.begin (); i != paths.end (); ++i) {
+		if (vst2_is_blacklisted (*i) || !vst2_valid_cache_file (*i).empty ()) {
+			/* nothing to do, or handled by vst2_discover */
+			continue;
+		}
+		jobs.push_back (ScanJob (type, *i, *i, scan_log_entry (type, *i)));
+	}
+
+	if (jobs.size () > 1) {
+		run_scanner_apps (vst2_scanner_bin_path, jobs, failed);
+	}
+}
+
 bool
 PluginManager::vst2_plugin (string const& path, PluginType type, VST2Info const& nfo)
 {
@@ -1786,9 +1809,19 @@ PluginManager::windows_vst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	/* scan new and modified plugins in parallel, then read the cache */
+	std::set<std::string> failed;
+	if (!cache_only) {
+		vst2_scan_outdated (plugin_objects, Windows_VST, failed);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
+		if (failed.find (*x) != failed.end ()) {
+			/* scan-log has the details */
+			continue;
+		}
 		reset_scan_cancel_state (true);
 		ARDOUR::PluginScanMessage (string_compose (_("VST2 (%1 / %2)"), n, all_modules), *x, !cache_only && !cancelled());
 		vst2_discover (*x, Windows_VST, cache_only || cancelled());
@@ -1875,9 +1908,19 @@ PluginManager::mac_vst_discover_from_path (string path, std::set<std::string>& s
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	/* scan new and modified plugins in parallel, then read the cache */
+	std::set<std::string> failed;
+	if (!cache_only) {
+		vst2_scan_outdated (plugin_objects, MacVST, failed);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
+		if (failed.find (*x) != failed.end ()) {
+			/* scan-log has the details */
+			continue;
+		}
 		reset_scan_cancel_state (true);
 		ARDOUR::PluginScanMessage (string_compose (_("VST2 (%1 / %2)"), n, all_modules), *x, !cache_only && !cancelled());
 		vst2_discover (*x, MacVST, cache_only || cancelled());
@@ -1935,9 +1978,19 @@ PluginManager::lxvst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	/* scan new and modified plugins in parallel, then read the cache */
+	std::set<std::string> failed;
+	if (!cache_only) {
+		vst2_scan_outdated (plugin_objects, LXVST, failed);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
+		if (failed.find (*x) != failed.end ()) {
+			/* scan-log has the details */
+			continue;
+		}
 		reset_scan_cancel_state (true);
 		ARDOUR::PluginScanMessage (string_compose (_("VST2 (%1 / %2)"), n, all_modules), *x, !cache_only && !cancelled());
 		vst2_discover (*x, LXVST, cache_only || cancelled());
@@ -2085,9 +2138,19 @@ PluginManager::vst3_discover_from_path (string const& path, bool cache_only)
 
 	find_paths_matching_filter (plugin_objects, paths, vst3_filter, 0, false, true, true);
 
+	/* scan new and modified plugins in parallel, then read the cache */
+	std::set<std::string> failed;
+	if (!cache_only) {
+		vst3_scan_outdated (plugin_objects, failed);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (vector<string>::iterator i = plugin_objects.begin(); i != plugin_objects.end (); ++i, ++n) {
+		if (failed.find (*i) != failed.end ()) {
+			/* scan-log has the details */
+			continue;
+		}
 		DEBUG_TRACE (DEBUG::PluginManager, string_compose ("VST3: discover '%1'\n", *i));
 		reset_scan_cancel_state (true);
 		ARDOUR::PluginScanMessage (string_compose (_("VST3 (%1 / %2)"), n, all_modules), *i, !cache_only && !cancelled());
@@ -2240,6 +2303,32 @@ PluginManager::vst3_discover (string const& path, bool cache_only)
 	return 0;
 }
 
+void
+PluginManager::vst3_scan_outdated (std::vector<std::string> const& paths, std::set<std::string>& failed)
+{
+	if (vst3_scanner_bin_path.empty ()) {
+		return;
+	}
+
+	std::vector<ScanJob> jobs;
+
+	for (std::vector<std::string>::const_iterator i = paths.begin (); i != paths.end (); ++i) {
+		string module_path = module_path_vst3 (*i);
+		if (module_path.empty () || module_path == "-1") {
+			continue;
+		}
+		if (vst3_is_blacklisted (module_path) || !vst3_valid_cache_file (module_path).empty ()) {
+			/* nothing to do, or handled by vst3_discover */
+			continue;
+		}
+		jobs.push_back (ScanJob (VST3, *i, module_path, scan_log_entry (VST3, *i)));
+	}
+
+	if (jobs.size () > 1) {
+		run_scanner_apps (vst3_scanner_bin_path, jobs, failed);
+	}
+}
+
 static void vst3_scanner_log (std::string msg, std::stringstream* ss)
 {
 	*ss << msg;
@@ -2310,6 +2399,230 @@ PluginManager::run_vst3_scanner_app (std::string bundle_path, PSLEPtr psle) cons
 
 #endif // VST3_SUPPORT
 
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT || defined VST3_SUPPORT)
+
+uint32_t
+PluginManager::n_scan_jobs ()
+{
+	uint32_t n = Config->get_plugin_scan_jobs ();
+	if (n == 0) {
+		/* scanning is mostly I/O and dynamic-linker bound */
+		n = std::min<uint32_t> (8, std::max<uint32_t> (1, hardware_concurrency ()));
+	}
+	return n;
+}
+
+static void scan_job_log (std::string msg, std::stringstream* ss)
+{
+	*ss << msg;
+}
+
+static void
+scan_job_blacklist (ARDOUR::PluginType type, std::string const& module_path, bool yn)
+{
+	switch (type) {
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT)
+		case Windows_VST:
+		case LXVST:
+		case MacVST:
+			if (yn) {
+				vst2_blacklist (module_path);
+			} else {
+				vst2_whitelist (module_path);
+			}
+			break;
+#endif
+#ifdef VST3_SUPPORT
+		case VST3:
+			if (yn) {
+				vst3_blacklist (module_path);
+			} else {
+				vst3_whitelist (module_path);
+			}
+			break;
+#endif
+		default:
+			assert (0);
+			break;
+	}
+}
+
+static std::string
+scan_job_valid_cache_file (ARDOUR::PluginType type, std::string const& module_path)
+{
+	switch (type) {
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT)
+		case Windows_VST:
+		case LXVST:
+		case MacVST:
+			return vst2_valid_cache_file (module_path);
+#endif
+#ifdef VST3_SUPPORT
+		case VST3:
+			return vst3_valid_cache_file (module_path);
+#endif
+		default:
+			assert (0);
+			return "";
+	}
+}
+
+void
+PluginManager::run_scanner_apps (std::string const& scanner_bin, std::vector<ScanJob> const& jobs, std::set<std::string>& failed)
+{
+	struct RunningScan {
+		RunningScan (ScanJob const& j, size_t n) : job (j), index (n), scanner (0), timeout (0), notime (true) {}
+		~RunningScan () { delete scanner; }
+
+		ScanJob const&        job;
+		size_t                index;
+		ARDOUR::SystemExec*   scanner;
+		PBD::ScopedConnection connection;
+		std::stringstream     log;
+		int                   timeout; /* deciseconds */
+		bool                  notime;
+	};
+
+	typedef std::list<std::shared_ptr<RunningScan> > RunningScans;
+
+	RunningScans running;
+	size_t const max_running = n_scan_jobs ();
+	size_t       n           = 0;
+
+	/* the scan that is shown in the scan dialog, "skip" (cancel_scan_one) only terminates this one */
+	std::shared_ptr<RunningScan> shown;
+
+	std::vector<ScanJob>::const_iterator next = jobs.begin ();
+
+	DEBUG_TRACE (DEBUG::PluginManager, string_compose ("Scanning %1 plugins using %2 processes\n", jobs.size (), max_running));
+
+	while (next != jobs.end () || !running.empty ()) {
+
+		/* keep max_running scanners busy */
+		while (next != jobs.end () && running.size () < max_running && !cancelled ()) {
+			ScanJob const& job (*next++);
+
+			job.psle->reset ();
+			scan_job_blacklist (job.type, job.module_path, true);
+
+			if (job.type == VST3) {
+				job.psle->msg (PluginScanLogEntry::OK, string_compose ("VST3 module-path '%1'", job.module_path));
+			}
+
+			char **argp= (char**) calloc (5, sizeof (char*));
+			argp[0] = strdup (scanner_bin.c_str ());
+			argp[1] = strdup ("-f");
+			if (Config->get_verbose_plugin_scan()) {
+				argp[2] = strdup ("-v");
+			} else {
+				argp[2] = strdup ("-f");
+			}
+			argp[3] = strdup (job.path.c_str ());
+			argp[4] = 0;
+
+			std::shared_ptr<RunningScan> rs (new RunningScan (job, ++n));
+			rs->scanner = new ARDOUR::SystemExec (scanner_bin, argp);
+			rs->scanner->ReadStdout.connect_same_thread (rs->connection, std::bind (&scan_job_log, _1, &rs->log));
+
+			if (rs->scanner->start (ARDOUR::SystemExec::MergeWithStdin)) {
+				job.psle->msg (PluginScanLogEntry::Error, string_compose (_("Cannot launch VST scanner app '%1': %2"), scanner_bin, strerror (errno)));
+				scan_job_blacklist (job.type, job.module_path, false);
+				failed.insert (job.path);
+				continue;
+			}
+
+			rs->timeout = _enable_scan_timeout ? 1 + Config->get_plugin_scan_timeout() : 0;
+			rs->notime  = (rs->timeout <= 0);
+
+			running.push_back (rs);
+		}
+
+		if (running.empty ()) {
+			/* cancelled, remaining plugins are not scanned */
+			break;
+		}
+
+		Glib::usleep (100000);
+
+		int                          timeout = 0;
+		std::shared_ptr<RunningScan> show;
+
+		for (RunningScans::iterator i = running.begin (); i != running.end ();) {
+			RunningScan& rs (**i);
+
+			if (!rs.scanner->is_running ()) {
+				rs.job.psle->msg (PluginScanLogEntry::OK, rs.log.str());
+
+				if (scan_job_valid_cache_file (rs.job.type, rs.job.module_path).empty ()) {
+					/* scanner crashed or failed, keep it blacklisted */
+					rs.job.psle->msg (PluginScanLogEntry::Error, _("Scan Failed."));
+					rs.job.psle->msg (PluginScanLogEntry::Blacklisted);
+					failed.insert (rs.job.path);
+				} else {
+					/* vst2/3_discover will read the cache */
+					scan_job_blacklist (rs.job.type, rs.job.module_path, false);
+				}
+
+				i = running.erase (i);
+				continue;
+			}
+
+			if (!rs.notime && no_timeout ()) {
+				rs.notime  = true;
+				rs.timeout = -1;
+			} else if (rs.notime && !no_timeout() && _enable_scan_timeout) {
+				rs.notime  = false;
+				rs.timeout = 1 + Config->get_plugin_scan_timeout ();
+			}
+
+			if (rs.timeout > -864000) {
+				--rs.timeout;
+			}
+
+			bool const cancel = _cancel_scan_all || (_cancel_scan_one && *i == shown);
+
+			if (cancel || (!rs.notime && rs.timeout == 0)) {
+				rs.scanner->terminate ();
+				rs.job.psle->msg (PluginScanLogEntry::OK, rs.log.str());
+				if (cancel) {
+					rs.job.psle->msg (PluginScanLogEntry::New, "Scan was cancelled.");
+				} else {
+					rs.job.psle->msg (PluginScanLogEntry::TimeOut, "Scan Timed Out.");
+				}
+				/* may be partially written */
+				g_unlink (cache_file (rs.job.type, rs.job.module_path).c_str ());
+				scan_job_blacklist (rs.job.type, rs.job.module_path, false);
+				failed.insert (rs.job.path);
+
+				i = running.erase (i);
+				continue;
+			}
+
+			/* report the scan that is closest to time out,
+			 * or the longest running one if there is no timeout */
+			if (!show || (rs.timeout > 0 ? (timeout < 0 || rs.timeout < timeout) : (timeout < 0 && rs.timeout < timeout))) {
+				timeout = rs.timeout;
+				show    = *i;
+			}
+			++i;
+		}
+
+		if (show && show != shown) {
+			ARDOUR::PluginScanMessage (string_compose (_("%1 (%2 / %3)"), plugin_type_name (show->job.type), show->index, jobs.size ()), show->job.path, true);
+		}
+		shown = show;
+
+		ARDOUR::PluginScanTimeout (timeout);
+
+		if (_cancel_scan_one && !_cancel_scan_all) {
+			/* the shown scan was skipped, continue with the others */
+			reset_scan_cancel_state (true);
+		}
+	}
+}
+
+#endif // any VST
+
 PluginManager::PluginStatusType
 PluginManager::get_status (const PluginInfoPtr& pi) const
 {
@@ -335,23 +335,14 @@ Port::get_connections (std::vector<std::string>& c) const
 int
 Port::connect_internal (std::string const & other)
 {
-	std::string const other_name = AudioEngine::instance()->make_port_name_non_relative (other);
-	std::string const our_name = AudioEngine::instance()->make_port_name_non_relative (_name);
-
-	int r = 0;
-
 	if (_connecting_blocked) {
-		return r;
+		return 0;
 	}
 
-	if (sends_output ()) {
-		DEBUG_TRACE (DEBUG::Ports, string_compose ("Connect %1 to %2\n", our_name, other_name));
-		r = port_engine.connect (our_name, other_name);
-	} else {
-		DEBUG_TRACE (DEBUG::Ports, string_compose ("Connect %1 to %2\n", other_name, our_name));
-		r = port_engine.connect (other_name, our_name);
-	}
-	return r;
+	PortEngine::PortConnection const c (connection_to (other));
+
+	DEBUG_TRACE (DEBUG::Ports, string_compose ("Connect %1 to %2\n", c.first, c.second));
+	return port_engine.connect (c.first, c.second);
 }
 
 int
@@ -711,70 +702,95 @@ Port::has_ext_connection () const
 	return _ext_connections.find (bid) != _ext_connections.end ();
 }
 
-int
-Port::reconnect ()
+void
+Port::reconnect_targets (std::vector<std::string>& targets) const
 {
 	std::string const bid (AudioEngine::instance()->backend_id (receives_input ()));
 
-	std::vector <std::string> c_int, c_ext, f_int, f_ext;
-
 	Glib::Threads::RWLock::ReaderLock lm (_connections_lock);
 
-	if (_ext_connections.find (bid) != _ext_connections.end ()) {
-		if (_int_connections.empty () && _ext_connections[bid].empty ()) {
-			DEBUG_TRACE (DEBUG::Ports, string_compose ("Port::reconnect(%1) no internal or external connections for backend '%2'\n", name(), bid));
-			return 0; /* OK */
-		}
-		c_int.insert (c_int.end(), _int_connections.begin(), _int_connections.end());
-		c_ext.insert (c_ext.end(), _ext_connections.at(bid).begin(), _ext_connections.at(bid).end());
+	targets.insert (targets.end(), _int_connections.begin(), _int_connections.end());
+
+	std::map<std::string, ConnectionSet>::const_iterator e = _ext_connections.find (bid);
+	if (e != _ext_connections.end ()) {
+		targets.insert (targets.end(), e->second.begin(), e->second.end());
+	}
+}
+
+PortEngine::PortConnection
+Port::connection_to (std::string const & other) const
+{
+	std::string const other_name = AudioEngine::instance()->make_port_name_non_relative (other);
+	std::string const our_name = AudioEngine::instance()->make_port_name_non_relative (_name);
+
+	if (sends_output ()) {
+		return PortEngine::PortConnection (our_name, other_name);
 	} else {
-		if (_int_connections.empty ()) {
-			DEBUG_TRACE (DEBUG::Ports, string_compose ("Port::reconnect(%1) no internal connections\n", name()));
-			return 0; /* OK */
-		}
-		c_int.insert (c_int.end(), _int_connections.begin(), _int_connections.end());
+		return PortEngine::PortConnection (other_name, our_name);
 	}
+}
 
-	/* Must hold the lock while calling port_engine.connect. It could lead to deadlock:
-	 *
-	 * XXBackend::main_process_thread -> PortManager::connect_callback
-	 * -> Port::port_connected_or_disconnected -> Port::insert_connection -> take WriterLock
-	 */
-	lm.release ();
+int
+Port::reconnect_failed (std::vector<std::string> const& failed, size_t n_targets)
+{
+	if (failed.empty ()) {
+		return 0;
+	}
 
-	DEBUG_TRACE (DEBUG::Ports, string_compose ("Port::reconnect(%1) to %2 destinations for backend '%3'\n", name(), c_int.size () + c_ext.size (), bid));
+	std::string const bid (AudioEngine::instance()->backend_id (receives_input ()));
 
-	int count = 0;
+	Glib::Threads::RWLock::WriterLock lm (_connections_lock);
 
-	for (auto const& c : c_int) {
-		if (connect_internal (c)) {
-			DEBUG_TRACE (DEBUG::Ports, string_compose ("Port::reconnect() failed to connect %1 to %2\n", name(), (c)));
-			f_int.push_back (c);
-		} else {
-			++count;
+	for (auto const& c : failed) {
+		DEBUG_TRACE (DEBUG::Ports, string_compose ("Port::reconnect() failed to connect %1 to %2\n", name(), c));
+		_int_connections.erase (c);
+		std::map<std::string, ConnectionSet>::iterator e = _ext_connections.find (bid);
+		if (e != _ext_connections.end ()) {
+			e->second.erase (c);
 		}
 	}
 
-	for (auto const& c : c_ext) {
-		if (connect_internal (c)) {
-			DEBUG_TRACE (DEBUG::Ports, string_compose ("Port::reconnect() failed to connect %1 to %2\n", name(), (c)));
-			f_ext.push_back (c);
-		} else {
-			++count;
-		}
+	return failed.size () == n_targets ? -1 : 0;
+}
+
+int
+Port::reconnect ()
+{
+	std::vector<std::string> targets;
+	reconnect_targets (targets);
+
+	if (targets.empty ()) {
+		DEBUG_TRACE (DEBUG::Ports, string_compose ("Port::reconnect(%1) no connections\n", name()));
+		return 0; /* OK */
 	}
 
-	lm.acquire ();
+	if (_connecting_blocked) {
+		return 0;
+	}
 
-	for (auto const& c : f_int) {
-		_int_connections.erase (c);
+	DEBUG_TRACE (DEBUG::Ports, string_compose ("Port::reconnect(%1) to %2 destinations\n", name(), targets.size ()));
+
+	/* Must not hold the lock while calling port_engine.connect. It could lead to deadlock:
+	 *
+	 * XXBackend::main_process_thread -> PortManager::connect_callback
+	 * -> Port::port_connected_or_disconnected -> Port::insert_connection -> take WriterLock
+	 */
+	std::vector<PortEngine::PortConnection> connections;
+	for (auto const& c : targets) {
+		connections.push_back (connection_to (c));
 	}
 
-	for (auto const& c : f_ext) {
-		_ext_connections[bid].erase (c);
+	std::vector<int> status;
+	port_engine.connect_batch (connections, &status);
+
+	std::vector<std::string> failed;
+	for (size_t i = 0; i < targets.size (); ++i) {
+		if (status[i]) {
+			failed.push_back (targets[i]);
+		}
 	}
 
-	return count == 0 ? -1 : 0;
+	return reconnect_failed (failed, targets.size ());
 }
 
 /** @param n Short port name (no port-system client name) */
@@ -18,6 +18,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include <regex.h>
 
 #include "pbd/error.h"
@@ -29,10 +31,51 @@
 
 using namespace ARDOUR;
 
+/* Port name patterns are POSIX extended regular expressions. Most
+ * callers however pass literal names, optionally anchored, which can
+ * be matched without compiling and running a regex for every port.
+ */
+PortEngineSharedImpl::PortPattern
+PortEngineSharedImpl::classify_port_pattern (std::string const& pattern, std::string& literal)
+{
+	if (pattern.empty ()) {
+		return PatternAll;
+	}
+
+	std::string::size_type b = 0;
+	std::string::size_type e = pattern.size ();
+
+	bool const anchor_begin = pattern[0] == '^';
+	if (anchor_begin) {
+		++b;
+	}
+	bool const anchor_end = e > b && pattern[e - 1] == '$';
+	if (anchor_end) {
+		--e;
+	}
+
+	literal = pattern.substr (b, e - b);
+
+	if (literal.find_first_of (".[]()*+?{}|^$\\") != std::string::npos) {
+		return PatternRegex;
+	}
+	if (anchor_begin && anchor_end) {
+		return PatternExact;
+	}
+	if (anchor_begin) {
+		return PatternPrefix;
+	}
+	if (anchor_end) {
+		return PatternSuffix;
+	}
+	return PatternSubstring;
+}
+
 BackendPort::BackendPort (PortEngineSharedImpl &b, const std::string& name, PortFlags flags)
 	: _backend (b)
 	, _name  (name)
 	, _flags (flags)
+	, _connection_table (new ConnectionTable)
 {
 	_capture_latency_range.min = 0;
 	_capture_latency_range.max = 0;
@@ -49,7 +92,7 @@ BackendPort::~BackendPort ()
 }
 
 int
-BackendPort::connect (BackendPortHandle port, BackendPortHandle self)
+BackendPort::connect (BackendPortHandle port, BackendPortHandle self, bool update_table)
 {
 	if (!port) {
 		PBD::error << _("BackendPort::connect (): invalid (null) port") << endmsg;
@@ -85,8 +128,8 @@ BackendPort::connect (BackendPortHandle port, BackendPortHandle self)
 		return 0;
 	}
 
-	store_connection (port);
-	port->store_connection (self);
+	store_connection (port, update_table);
+	port->store_connection (self, update_table);
 
 	_backend.port_connect_callback (name(),  port->name(), true);
 
@@ -94,13 +137,16 @@ BackendPort::connect (BackendPortHandle port, BackendPortHandle self)
 }
 
 void
-BackendPort::store_connection (BackendPortHandle port)
+BackendPort::store_connection (BackendPortHandle port, bool update_table)
 {
 	_connections.insert (port);
+	if (update_table) {
+		update_connection_table ();
+	}
 }
 
 int
-BackendPort::disconnect (BackendPortHandle port, BackendPortHandle self)
+BackendPort::disconnect (BackendPortHandle port, BackendPortHandle self, bool update_table)
 {
 	if (!port) {
 		PBD::error << _("BackendPort::disconnect (): invalid (null) port") << endmsg;
@@ -114,29 +160,49 @@ BackendPort::disconnect (BackendPortHandle port, BackendPortHandle self)
 		return -1;
 	}
 
-	remove_connection (port);
-	port->remove_connection (self);
+	remove_connection (port, update_table);
+	port->remove_connection (self, update_table);
 	_backend.port_connect_callback (name(),  port->name(), false);
 
 	return 0;
 }
 
-void BackendPort::remove_connection (BackendPortHandle port)
+void BackendPort::remove_connection (BackendPortHandle port, bool update_table)
 {
 	std::set<BackendPortPtr>::iterator it = _connections.find (port);
 	assert (it != _connections.end ());
 	_connections.erase (it);
+	if (update_table) {
+		update_connection_table ();
+	}
 }
 
+void
+BackendPort::update_connection_table ()
+{
+	RCUWriter<ConnectionTable>       writer (_connection_table);
+	std::shared_ptr<ConnectionTable> ct = writer.get_copy ();
+	ct->assign (_connections.begin (), _connections.end ());
+}
 
 void BackendPort::disconnect_all (BackendPortHandle self)
 {
 	while (!_connections.empty ()) {
 		std::set<BackendPortPtr>::iterator it = _connections.begin ();
+		/* Previous tables of the peer still reference this port. They are
+		 * not flushed here: the process thread may hold one of them, and
+		 * releasing it there would free the port. The peer's RCU manager
+		 * drops them once they are unused, when its table is next written.
+		 */
 		(*it)->remove_connection (self);
 		_backend.port_connect_callback (name(), (*it)->name(), false);
 		_connections.erase (it);
 	}
+	update_connection_table ();
+	/* a second write drops the previous tables (and with them the
+	 * references to former peers) unless they are still in use.
+	 */
+	update_connection_table ();
 }
 
 bool
@@ -288,10 +354,39 @@ PortEngineSharedImpl::get_ports (
 	DataType type, PortFlags flags,
 	std::vector<std::string>& port_names) const
 {
+	std::string       literal;
+	PortPattern const kind = classify_port_pattern (port_name_pattern, literal);
+
+	if (kind == PatternExact || kind == PatternPrefix) {
+		/* look up the range of matching names in the name-sorted map */
+		std::shared_ptr<PortMap const> pm = _portmap.reader ();
+		std::vector<BackendPortPtr>    found;
+
+		for (PortMap::const_iterator i = pm->lower_bound (literal); i != pm->end (); ++i) {
+			if (i->first.compare (0, literal.size (), literal) != 0) {
+				break;
+			}
+			if (kind == PatternExact && i->first.size () != literal.size ()) {
+				break;
+			}
+			if ((i->second->type () == type) && flags == (i->second->flags () & flags)) {
+				found.push_back (i->second);
+			}
+		}
+
+		/* same order as the PortIndex */
+		std::sort (found.begin (), found.end (), SortByPortName ());
+
+		for (auto const& port : found) {
+			port_names.push_back (port->name ());
+		}
+		return found.size ();
+	}
+
 	int rv = 0;
 	regex_t port_regex;
 	bool use_regexp = false;
-	if (port_name_pattern.size () > 0) {
+	if (kind == PatternRegex) {
 		if (!regcomp (&port_regex, port_name_pattern.c_str (), REG_EXTENDED|REG_NOSUB)) {
 			use_regexp = true;
 		}
@@ -301,8 +396,21 @@ PortEngineSharedImpl::get_ports (
 
 	for (auto const& port : *p) {
 		if ((port->type () == type) && flags == (port->flags () & flags)) {
-			if (!use_regexp || !regexec (&port_regex, port->name ().c_str (), 0, NULL, 0)) {
-				port_names.push_back (port->name ());
+			std::string const& name = port->name ();
+			bool               match;
+			switch (kind) {
+				case PatternSubstring:
+					match = name.find (literal) != std::string::npos;
+					break;
+				case PatternSuffix:
+					match = name.size () >= literal.size () && name.compare (name.size () - literal.size (), literal.size (), literal) == 0;
+					break;
+				default:
+					match = !use_regexp || !regexec (&port_regex, name.c_str (), 0, NULL, 0);
+					break;
+			}
+			if (match) {
+				port_names.push_back (name);
 				++rv;
 			}
 		}
@@ -752,6 +860,68 @@ PortEngineSharedImpl::disconnect_all (PortEngine::PortHandle port_handle)
 	return 0;
 }
 
+int
+PortEngineSharedImpl::connect_batch (std::vector<PortEngine::PortConnection> const& connections, std::vector<int>* status)
+{
+	return apply_connection_batch (connections, status, true);
+}
+
+int
+PortEngineSharedImpl::disconnect_batch (std::vector<PortEngine::PortConnection> const& connections, std::vector<int>* status)
+{
+	return apply_connection_batch (connections, status, false);
+}
+
+int
+PortEngineSharedImpl::apply_connection_batch (std::vector<PortEngine::PortConnection> const& connections, std::vector<int>* status, bool yn)
+{
+	std::shared_ptr<PortMap const> pm = _portmap.reader ();
+	std::set<BackendPortPtr>       modified;
+	int                            rv = 0;
+
+	if (status) {
+		status->resize (connections.size ());
+	}
+
+	for (size_t i = 0; i < connections.size (); ++i) {
+		PortMap::const_iterator src = pm->find (connections[i].first);
+		PortMap::const_iterator dst = pm->find (connections[i].second);
+
+		int r;
+		if (src == pm->end () || dst == pm->end ()) {
+			PBD::warning << string_compose (_("%1::%2: invalid port: (%3) -> (%4)"), _instance_name, yn ? X_("connect") : X_("disconnect"), connections[i].first, connections[i].second) << endmsg;
+			r = -1;
+		} else if (yn) {
+			/* Same as ::connect (), only missing ports are reported.
+			 * Existing connections (each connection is usually saved
+			 * by both ports) are not an error, and neither are refused
+			 * ones, so that callers (Port::reconnect_failed) do not
+			 * drop saved connections that were kept in the past.
+			 */
+			src->second->connect (dst->second, src->second, false);
+			r = 0;
+		} else {
+			r = src->second->disconnect (dst->second, src->second, false);
+		}
+
+		if (r == 0) {
+			modified.insert (src->second);
+			modified.insert (dst->second);
+		}
+		if (status) {
+			(*status)[i] = r;
+		}
+		rv |= r;
+	}
+
+	/* publish the connection tables of every affected port once */
+	for (auto const& p : modified) {
+		p->update_connection_table ();
+	}
+
+	return rv ? -1 : 0;
+}
+
 bool
 PortEngineSharedImpl::connected (PortEngine::PortHandle port_handle, bool /* process_callback_safe*/)
 {
@@ -253,11 +253,14 @@ PortManager::PortManager ()
 	: _ports (new Ports)
 	, _port_remove_in_progress (false)
 	, _port_deletions_pending (8192) /* ick, arbitrary sizing */
+	, _shared_inputs (new SharedInputs)
+	, _share_resampled_inputs (true)
 	, _midi_info_dirty (true)
 	, _audio_input_ports (new AudioInputPorts)
 	, _midi_input_ports (new MIDIInputPorts)
 {
 	_reset_meters.store (1);
+	_shared_inputs_dirty.store (0);
 	load_port_info ();
 }
 
@@ -302,6 +305,8 @@ PortManager::remove_session_ports ()
 
 	_ports.flush ();
 
+	update_shared_inputs ();
+
 	/* clear out pending port deletion list. we know this is safe because
 	 * the auto connect thread in Session is already dead when this is
 	 * done. It doesn't use shared_ptr<Port> anyway.
@@ -713,6 +718,10 @@ PortManager::unregister_port (std::shared_ptr<Port> port)
 
 	_ports.flush ();
 
+	if (port->type () == DataType::AUDIO && port->receives_input ()) {
+		update_shared_inputs ();
+	}
+
 	return 0;
 }
 
@@ -937,10 +946,42 @@ PortManager::reconnect_ports ()
 	}
 
 
+	/* collect the connections of all ports, and make them at once */
+	std::vector<std::string>                targets;
+	std::vector<PortEngine::PortConnection> connections;
+	std::vector<size_t>                     offsets;
+
+	offsets.reserve (p->size () + 1);
+
+	for (auto const& i : *p) {
+		offsets.push_back (targets.size ());
+		if (Port::connecting_blocked ()) {
+			continue;
+		}
+		i.second->reconnect_targets (targets);
+		for (size_t t = offsets.back (); t < targets.size (); ++t) {
+			connections.push_back (i.second->connection_to (targets[t]));
+		}
+	}
+	offsets.push_back (targets.size ());
+
+	std::vector<int> status;
+	if (!connections.empty ()) {
+		port_engine ().connect_batch (connections, &status);
+	}
+
+	size_t n = 0;
 	for (auto const& i : *p) {
-		if (i.second->reconnect ()) {
+		std::vector<std::string> failed;
+		for (size_t t = offsets[n]; t < offsets[n + 1]; ++t) {
+			if (status[t]) {
+				failed.push_back (targets[t]);
+			}
+		}
+		if (i.second->reconnect_failed (failed, offsets[n + 1] - offsets[n])) {
 			PortConnectedOrDisconnected (i.second, i.first, std::weak_ptr<Port> (), "", false);
 		}
+		++n;
 	}
 
 	if (Config->get_work_around_jack_no_copy_optimization () && AudioEngine::instance ()->is_jack ()) {
@@ -1001,6 +1042,11 @@ PortManager::connect_callback (const string& a, const string& b, bool conn)
 		}
 	}
 
+	if ((port_a && port_a->type () == DataType::AUDIO) || (port_b && port_b->type () == DataType::AUDIO)) {
+		/* re-evaluated in graph_order_callback, after all pending connections were made */
+		_shared_inputs_dirty.store (1);
+	}
+
 	PortConnectedOrDisconnected (
 	    port_a, a,
 	    port_b, b,
@@ -1017,6 +1063,7 @@ PortManager::registration_callback ()
 	}
 
 	update_input_ports (false);
+	update_shared_inputs ();
 
 	PortRegisteredOrUnregistered (); /* EMIT SIGNAL */
 }
@@ -1251,6 +1298,11 @@ PortManager::graph_order_callback ()
 {
 	DEBUG_TRACE (DEBUG::BackendCallbacks, "graph order callback\n");
 
+	int canderef (1);
+	if (_shared_inputs_dirty.compare_exchange_strong (canderef, 0)) {
+		update_shared_inputs ();
+	}
+
 	if (!_port_remove_in_progress) {
 		GraphReordered (); /* EMIT SIGNAL */
 	}
@@ -1258,6 +1310,88 @@ PortManager::graph_order_callback ()
 	return 0;
 }
 
+/* Below this number of ports that need to be resampled, the semaphore
+ * synchronization of the RTTaskList costs more than it saves, and
+ * ports are processed in sequence.
+ */
+static const size_t parallel_resample_threshold = 8;
+
+void
+PortManager::update_shared_inputs ()
+{
+	/* not called from the process cycle, but may be called from the
+	 * backend's process thread in between cycles.
+	 */
+	{
+		RCUWriter<SharedInputs>       writer (_shared_inputs);
+		std::shared_ptr<SharedInputs> si = writer.get_copy ();
+
+		si->clear ();
+
+		if (_backend && _share_resampled_inputs) {
+			/* external source(s) -> first port that reads them */
+			std::map<std::vector<std::string>, std::shared_ptr<AudioPort> > sources;
+			std::shared_ptr<Ports const> p = _ports.reader ();
+
+			for (auto const& i : *p) {
+				std::shared_ptr<AudioPort> ap = std::dynamic_pointer_cast<AudioPort> (i.second);
+
+				if (!ap || !ap->receives_input () || (ap->flags () & TransportSyncPort) || !ap->port_handle ()) {
+					continue;
+				}
+
+				std::vector<std::string> c;
+				if (_backend->get_connections (ap->port_handle (), c) <= 0) {
+					continue;
+				}
+
+				bool internal = false;
+				for (auto const& n : c) {
+					if (port_is_mine (n)) {
+						internal = true;
+						break;
+					}
+				}
+
+				if (internal) {
+					/* data of other ardour ports is not available
+					 * until they have been processed */
+					continue;
+				}
+
+				std::sort (c.begin (), c.end ());
+
+				auto s = sources.find (c);
+				if (s == sources.end ()) {
+					sources[c] = ap;
+				} else {
+					(*si)[ap.get ()] = s->second;
+				}
+			}
+		}
+
+		DEBUG_TRACE (DEBUG::Ports, string_compose ("%1 audio input ports share the input of another port\n", si->size ()));
+	}
+
+	_shared_inputs.flush ();
+}
+
+void
+PortManager::set_share_resampled_inputs (bool yn)
+{
+	if (_share_resampled_inputs == yn) {
+		return;
+	}
+	_share_resampled_inputs = yn;
+	update_shared_inputs ();
+}
+
+size_t
+PortManager::n_shared_inputs () const
+{
+	return _shared_inputs.reader ()->size ();
+}
+
 void
 PortManager::cycle_start (pframes_t nframes, Session* s)
 {
@@ -1266,46 +1400,63 @@ PortManager::cycle_start (pframes_t nframes, Session* s)
 
 	_cycle_ports = _ports.reader ();
 
+	std::shared_ptr<SharedInputs const> si = _shared_inputs.reader ();
+
 	/* pre-calc/cache value */
 	falloff_cache.calc (nframes, s ? s->nominal_sample_rate () : 0);
 
 	/* TODO optimize
 	 *  - when speed == 1.0, the resampler copies data without processing
 	 *   it may (or may not) be more efficient to just run all in sequence.
-	 *
-	 *  - single sequential task for 'lightweight' tasks would make sense
-	 *    (run it in parallel with 'heavy' resampling.
-	 *    * output ports (sends_output()) only set a flag
-	 *    * midi-ports only scale event timestamps
-	 *
-	 *  - a threshold parallel vs searial processing may be appropriate.
-	 *    amount of work (how many connected ports are there, how
-	 *    many resamplers need to run) vs. available CPU cores and semaphore
-	 *    synchronization overhead.
-	 *
-	 *  - input ports: it would make sense to resample each input only once
-	 *    (rather than resample into each ardour-owned input port).
-	 *    A single external source-port may be connected to many ardour
-	 *    input-ports. Currently re-sampling is per input.
+	 */
+
+	/* Input ports that are connected to the same external port(s) are
+	 * resampled only once (see ::update_shared_inputs). Ports that share
+	 * their input, output ports (which only set a flag here), MIDI ports
+	 * (which only scale event timestamps) and ports that are not externally
+	 * connected are cheap and processed in sequence. Only if enough
+	 * resamplers need to run, the remaining ports are processed in parallel.
 	 */
 	std::shared_ptr<RTTaskList> tl;
-	if (s) {
+	if (s && fabs (Port::resample_ratio ()) != 1.0) {
 		tl = s->rt_tasklist ();
 	}
-	if (tl && fabs (Port::resample_ratio ()) != 1.0) {
+
+	size_t n_resample = 0;
+
+	if (tl) {
 		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				tl->push_back (std::bind (&Port::cycle_start, p.second, nframes));
+			Port const* port = p.second.get ();
+			if (port->receives_input () && port->type () == DataType::AUDIO && port->externally_connected () && !(port->flags () & TransportSyncPort) && si->find (port) == si->end ()) {
+				++n_resample;
 			}
 		}
+	}
+
+	bool const parallel = n_resample >= parallel_resample_threshold;
+
+	for (auto const& p : *_cycle_ports) {
+		Port* port = p.second.get ();
+
+		if (port->flags () & TransportSyncPort) {
+			continue;
+		}
+
+		SharedInputs::const_iterator shared = si->find (port);
+
+		if (shared != si->end ()) {
+			static_cast<AudioPort*> (port)->cycle_start_shared (nframes, shared->second.get ());
+		} else if (parallel && port->receives_input () && port->type () == DataType::AUDIO && port->externally_connected ()) {
+			tl->push_back (std::bind (&Port::cycle_start, p.second, nframes));
+		} else {
+			port->cycle_start (nframes);
+		}
+	}
+
+	if (parallel) {
 		tl->push_back (std::bind (&PortManager::run_input_meters, this, nframes, s ? s->nominal_sample_rate () : 0));
 		tl->process ();
 	} else {
-		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				p.second->cycle_start (nframes);
-			}
-		}
 		run_input_meters (nframes, s ? s->nominal_sample_rate () : 0);
 	}
 }
@@ -1315,13 +1466,31 @@ PortManager::cycle_end (pframes_t nframes, Session* s)
 {
 	// see optimzation note in ::cycle_start()
 	std::shared_ptr<RTTaskList> tl;
-	if (s) {
+	if (s && fabs (Port::resample_ratio ()) != 1.0) {
 		tl = s->rt_tasklist ();
 	}
-	if (tl && fabs (Port::resample_ratio ()) != 1.0) {
+
+	size_t n_resample = 0;
+
+	if (tl) {
 		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
+			Port const* port = p.second.get ();
+			if (port->sends_output () && port->type () == DataType::AUDIO && port->externally_connected () && !(port->flags () & TransportSyncPort)) {
+				++n_resample;
+			}
+		}
+	}
+
+	if (n_resample >= parallel_resample_threshold) {
+		for (auto const& p : *_cycle_ports) {
+			Port* port = p.second.get ();
+			if (port->flags () & TransportSyncPort) {
+				continue;
+			}
+			if (port->sends_output () && port->type () == DataType::AUDIO && port->externally_connected ()) {
 				tl->push_back (std::bind (&Port::cycle_end, p.second, nframes));
+			} else {
+				port->cycle_end (nframes);
 			}
 		}
 		tl->process ();
@@ -27,11 +27,15 @@ ReadOnlyControl::ReadOnlyControl (std::shared_ptr<Plugin> p, const ParameterDesc
 		: _plugin (std::weak_ptr<Plugin> (p))
 		, _desc (desc)
 		, _parameter_num (pnum)
+		, _resting (false)
 { }
 
 double
 ReadOnlyControl::get_parameter () const
 {
+	if (_resting.load ()) {
+		return _desc.normal;
+	}
 	std::shared_ptr<Plugin> p = _plugin.lock();
 	if (p) {
 		return p->get_parameter (_parameter_num);
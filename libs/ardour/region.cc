@@ -1487,6 +1487,8 @@ Region::set_state (const XMLNode& node, int version)
 int
 Region::_set_state (const XMLNode& node, int version, PropertyChange& what_changed, bool send)
 {
+	static const XMLPropertyName prop_flags ("flags");
+
 	Temporal::BBT_Time bbt_time;
 
 	Stateful::save_extra_xml (node);
@@ -1564,7 +1566,7 @@ Region::_set_state (const XMLNode& node, int version, PropertyChange& what_chang
 
 	/* Quick fix for 2.x sessions when region is muted */
 	std::string flags;
-	if (node.get_property (X_("flags"), flags)) {
+	if (node.get_property (prop_flags, flags)) {
 		if (string::npos != flags.find("Muted")){
 			set_muted (true);
 		}
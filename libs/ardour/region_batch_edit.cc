@@ -0,0 +1,220 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "pbd/property_list.h"
+#include "pbd/types_convert.h"
+#include "pbd/xml++.h"
+
+#include "ardour/playlist.h"
+#include "ardour/region.h"
+#include "ardour/region_batch_edit.h"
+#include "ardour/region_factory.h"
+
+#include "pbd/i18n.h"
+
+using namespace ARDOUR;
+using namespace PBD;
+
+RegionBatchDiffCommand::RegionBatchDiffCommand (RegionList const& regions)
+{
+	for (auto const& r : regions) {
+		PropertyList* pl = r->get_changes_as_properties (this);
+		if (pl->empty ()) {
+			delete pl;
+			continue;
+		}
+		add (r, pl);
+	}
+}
+
+RegionBatchDiffCommand::RegionBatchDiffCommand (XMLNode const& node)
+{
+	for (auto const& child : node.children ()) {
+		PBD::ID id;
+		if (child->name () != X_("Region") || !child->get_property ("obj-id", id)) {
+			continue;
+		}
+
+		std::shared_ptr<Region> r = RegionFactory::region_by_id (id);
+		XMLNode const*          changes = child->child (X_("Changes"));
+
+		if (!r || !changes) {
+			continue;
+		}
+
+		add (r, r->property_factory (*changes));
+	}
+}
+
+RegionBatchDiffCommand::~RegionBatchDiffCommand ()
+{
+	for (auto& c : _changes) {
+		delete c.changes;
+	}
+}
+
+void
+RegionBatchDiffCommand::add (std::shared_ptr<Region> r, PropertyList* changes)
+{
+	Change c;
+	c.region  = r;
+	c.changes = changes;
+	_changes.push_back (c);
+
+	/* forget the changes of a region that goes away, see StatefulDiffCommand */
+	r->DropReferences.connect_same_thread (*this, std::bind (&RegionBatchDiffCommand::region_going_away, this, std::weak_ptr<Region> (r)));
+}
+
+void
+RegionBatchDiffCommand::region_going_away (std::weak_ptr<Region> wr)
+{
+	for (auto i = _changes.begin (); i != _changes.end (); ++i) {
+		if (i->region.owner_before (wr) || wr.owner_before (i->region)) {
+			continue;
+		}
+		delete i->changes;
+		_changes.erase (i);
+		break;
+	}
+
+	if (_changes.empty ()) {
+		/* notify owners of this command, this may delete it */
+		drop_references ();
+	}
+}
+
+void
+RegionBatchDiffCommand::operator() ()
+{
+	apply (false);
+}
+
+void
+RegionBatchDiffCommand::undo ()
+{
+	apply (true);
+}
+
+void
+RegionBatchDiffCommand::apply (bool invert)
+{
+	RegionBatchEdit edit;
+
+	for (auto const& c : _changes) {
+		std::shared_ptr<Region> r (c.region.lock ());
+		if (!r) {
+			continue;
+		}
+		edit.add (r);
+		if (invert) {
+			PropertyList p = *c.changes;
+			p.invert ();
+			r->apply_changes (p);
+		} else {
+			r->apply_changes (*c.changes);
+		}
+	}
+
+	/* notify, the changes are already recorded in this command */
+	delete edit.commit ();
+}
+
+XMLNode&
+RegionBatchDiffCommand::get_state () const
+{
+	XMLNode* node = new XMLNode (X_("RegionBatchDiffCommand"));
+
+	for (auto const& c : _changes) {
+		std::shared_ptr<Region> r (c.region.lock ());
+		if (!r) {
+			continue;
+		}
+
+		XMLNode* child = new XMLNode (X_("Region"));
+		child->set_property ("obj-id", r->id ());
+
+		XMLNode* changes = new XMLNode (X_("Changes"));
+		c.changes->get_changes_as_xml (changes);
+
+		child->add_child_nocopy (*changes);
+		node->add_child_nocopy (*child);
+	}
+
+	return *node;
+}
+
+bool
+RegionBatchDiffCommand::empty () const
+{
+	return _changes.empty ();
+}
+
+RegionBatchEdit::RegionBatchEdit ()
+{
+}
+
+RegionBatchEdit::~RegionBatchEdit ()
+{
+	release ();
+}
+
+void
+RegionBatchEdit::add (std::shared_ptr<Region> r)
+{
+	if (!_regions.insert (r).second) {
+		return;
+	}
+
+	std::shared_ptr<Playlist> pl = r->playlist ();
+
+	if (pl && _playlists.insert (pl).second) {
+		pl->freeze ();
+	}
+
+	r->clear_changes ();
+	_thawlist.add (r);
+}
+
+RegionBatchDiffCommand*
+RegionBatchEdit::commit ()
+{
+	RegionList regions (_thawlist);
+
+	release ();
+
+	RegionBatchDiffCommand* cmd = new RegionBatchDiffCommand (regions);
+
+	if (cmd->empty ()) {
+		delete cmd;
+		return 0;
+	}
+
+	return cmd;
+}
+
+void
+RegionBatchEdit::release ()
+{
+	/* regions first, so that their changes are collected by the frozen playlists */
+	_thawlist.release ();
+
+	for (auto const& pl : _playlists) {
+		pl->thaw ();
+	}
+
+	_playlists.clear ();
+	_regions.clear ();
+}
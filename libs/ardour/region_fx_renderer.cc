@@ -0,0 +1,235 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "pbd/compose.h"
+#include "pbd/event_loop.h"
+#include "pbd/file_utils.h"
+#include "pbd/gstdio_compat.h"
+
+#include "ardour/audioregion.h"
+#include "ardour/debug.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/region_factory.h"
+#include "ardour/region_fx_renderer.h"
+#include "ardour/session.h"
+#include "ardour/session_event.h"
+
+using namespace ARDOUR;
+using namespace PBD;
+
+RegionFxRenderer::RegionFxRenderer (Session& s)
+	: SessionHandleRef (s)
+	, _event_loop (PBD::EventLoop::get_event_loop_for_thread ())
+	, _thread (0)
+	, _quit (false)
+	, _disk_usage (0)
+{
+}
+
+RegionFxRenderer::~RegionFxRenderer ()
+{
+	terminate_thread ();
+}
+
+int
+RegionFxRenderer::start_thread ()
+{
+	if (_thread) {
+		return 0;
+	}
+	_quit   = false;
+	_thread = PBD::Thread::create (std::bind (&RegionFxRenderer::thread_work, this), "RegionFxRender");
+	return _thread ? 0 : -1;
+}
+
+void
+RegionFxRenderer::terminate_thread ()
+{
+	if (!_thread) {
+		return;
+	}
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		_quit = true;
+		_wakeup.signal ();
+	}
+	_thread->join ();
+	delete _thread;
+	_thread = 0;
+}
+
+size_t
+RegionFxRenderer::disk_usage () const
+{
+	return _disk_usage.load ();
+}
+
+void
+RegionFxRenderer::remove_stale_renders ()
+{
+	/* renders are never re-used, see AudioRegion::render_fx */
+	std::vector<std::string> files;
+	find_files_matching_pattern (files, _session.analysis_dir (), "*.fxrender*");
+	for (auto const& f : files) {
+		::g_unlink (f.c_str ());
+	}
+}
+
+void
+RegionFxRenderer::thread_work ()
+{
+	SessionEvent::create_per_thread_pool ("RegionFxRender", 64);
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+	while (!_quit) {
+		_wakeup.wait_until (_lock, g_get_monotonic_time () + G_TIME_SPAN_SECOND);
+		if (_quit) {
+			break;
+		}
+		lm.release ();
+		if (!_session.loading () && !_session.deletion_in_progress () && !_session.exporting ()) {
+			run_once ();
+		}
+		lm.acquire ();
+	}
+}
+
+void
+RegionFxRenderer::run_once ()
+{
+	size_t const limit = (size_t) Config->get_region_fx_render_cache_size () * 1048576;
+
+	std::vector<std::shared_ptr<AudioRegion> > regions;
+	RegionFactory::foreach_region ([&regions] (std::shared_ptr<Region> r) {
+		std::shared_ptr<AudioRegion> ar = std::dynamic_pointer_cast<AudioRegion> (r);
+		if (ar) {
+			regions.push_back (ar);
+		}
+	});
+
+	int64_t const now  = g_get_monotonic_time ();
+	size_t        used = 0;
+
+	std::vector<std::shared_ptr<AudioRegion> > rendered;
+	std::vector<std::shared_ptr<AudioRegion> > pending;
+	std::set<PBD::ID>                          live;
+
+	for (auto const& ar : regions) {
+		if (ar->fx_render_bytes () > 0) {
+			if (limit > 0 && ar->playlist () && ar->fx_render_valid ()) {
+				used += ar->fx_render_bytes ();
+				rendered.push_back (ar);
+				continue;
+			}
+			/* stale, unused or disabled */
+			ar->drop_fx_render ();
+		}
+
+		if (limit == 0 || !ar->playlist () || !ar->has_region_fx () || ar->fx_render_valid ()) {
+			continue;
+		}
+
+		live.insert (ar->id ());
+
+		if (now - ar->fx_changed_at () < settle_time) {
+			continue;
+		}
+
+		std::map<PBD::ID, uint64_t>::const_iterator s = _failed.find (ar->id ());
+		if (s != _failed.end () && s->second == ar->fx_generation ()) {
+			continue;
+		}
+
+		pending.push_back (ar);
+	}
+
+	/* forget about regions that were modified or removed since */
+	for (std::map<PBD::ID, uint64_t>::iterator i = _failed.begin (); i != _failed.end ();) {
+		if (live.find (i->first) == live.end ()) {
+			i = _failed.erase (i);
+		} else {
+			++i;
+		}
+	}
+	for (std::map<PBD::ID, uint64_t>::iterator i = _requested.begin (); i != _requested.end ();) {
+		if (live.find (i->first) == live.end ()) {
+			i = _requested.erase (i);
+		} else {
+			++i;
+		}
+	}
+
+	/* least recently played first */
+	std::sort (rendered.begin (), rendered.end (), [] (std::shared_ptr<AudioRegion> const& a, std::shared_ptr<AudioRegion> const& b) {
+		return a->fx_render_used () < b->fx_render_used ();
+	});
+
+	for (auto const& ar : pending) {
+		if (_quit) {
+			break;
+		}
+
+		uint64_t const gen      = ar->fx_generation ();
+		size_t const   estimate = (ar->length_samples () + ar->tail ().samples ()) * ar->n_channels () * sizeof (Sample);
+
+		if (estimate > limit) {
+			_failed[ar->id ()] = gen;
+			continue;
+		}
+
+		if (!ar->fx_render_prepared ()) {
+			/* instantiate plugins in the GUI thread, render at the next iteration */
+			std::map<PBD::ID, uint64_t>::const_iterator r = _requested.find (ar->id ());
+			if (_event_loop && (r == _requested.end () || r->second != gen)) {
+				std::weak_ptr<AudioRegion> wr (ar);
+				bool const queued = _event_loop->call_slot (MISSING_INVALIDATOR, [wr] () {
+					std::shared_ptr<AudioRegion> r (wr.lock ());
+					if (r) {
+						r->prepare_fx_render ();
+					}
+				});
+				if (queued) {
+					_requested[ar->id ()] = gen;
+				}
+			}
+			continue;
+		}
+
+		while (used + estimate > limit && !rendered.empty ()) {
+			std::shared_ptr<AudioRegion> lru (rendered.front ());
+			rendered.erase (rendered.begin ());
+			used -= std::min (used, lru->fx_render_bytes ());
+			/* do not re-render until the region is modified */
+			_failed[lru->id ()] = lru->fx_generation ();
+			lru->drop_fx_render ();
+			DEBUG_TRACE (DEBUG::RegionFx, string_compose ("RegionFxRenderer: evicted render of '%1'\n", lru->name ()));
+		}
+
+		if (ar->render_fx (_quit)) {
+			used += ar->fx_render_bytes ();
+			rendered.push_back (ar);
+			DEBUG_TRACE (DEBUG::RegionFx, string_compose ("RegionFxRenderer: rendered '%1', cache size: %2 bytes\n", ar->name (), used));
+		} else if (!_quit && gen == ar->fx_generation ()) {
+			_failed[ar->id ()] = gen;
+		}
+	}
+
+	_disk_usage = used;
+}
@@ -91,6 +91,7 @@
 #include "ardour/revision.h"
 #include "ardour/route.h"
 #include "ardour/route_group.h"
+#include "ardour/route_pipeline.h"
 #include "ardour/send.h"
 #include "ardour/session.h"
 #include "ardour/solo_control.h"
@@ -135,6 +136,8 @@ Route::Route (Session& sess, string name, PresentationInfo::Flag flag, DataType
 	, _track_number (0)
 	, _strict_io (false)
 	, _in_configure_processors (false)
+	, _pipeline_stages (0)
+	, _asleep (false)
 	, _initial_io_setup (false)
 	, _in_sidechain_setup (false)
 	, _monitor_gain (0)
@@ -347,6 +350,7 @@ Route::~Route ()
 	*/
 
 	Glib::Threads::RWLock::WriterLock lm (_processor_lock);
+	_pipeline.reset ();
 	for (ProcessorList::iterator i = _processors.begin(); i != _processors.end(); ++i) {
 		(*i)->drop_references ();
 	}
@@ -530,6 +534,17 @@ Route::process_output_buffers (BufferSet& bufs,
 
 	for (ProcessorList::const_iterator i = _processors.begin(); i != _processors.end(); ++i) {
 
+		if (_pipeline && (*i) == _pipeline->front ()) {
+			/* run all plugins of the pipeline, continue after the last one */
+			_pipeline->run (bufs, start_sample, end_sample, speed, nframes, latency);
+			i = std::find (i, _processors.end (), _pipeline->back ());
+			if (i == _processors.end ()) {
+				assert (0);
+				break;
+			}
+			continue;
+		}
+
 		bool re_inject_oob_data = false;
 		if ((*i) == _disk_reader) {
 			/* ignore port-count from prior plugins, use DR's count.
@@ -599,6 +614,32 @@ Route::process_output_buffers (BufferSet& bufs,
 		}
 #endif
 	}
+
+	update_asleep ();
+}
+
+void
+Route::update_asleep ()
+{
+	/* Must be called with the processor lock held */
+	if (!Config->get_sleep_silent_plugins ()) {
+		_asleep.store (false);
+		return;
+	}
+
+	bool asleep = false;
+	for (ProcessorList::const_iterator i = _processors.begin(); i != _processors.end(); ++i) {
+		PluginInsert const* pi = dynamic_cast<PluginInsert const*> (i->get ());
+		if (!pi || !pi->active ()) {
+			continue;
+		}
+		if (!pi->asleep ()) {
+			asleep = false;
+			break;
+		}
+		asleep = true;
+	}
+	_asleep.store (asleep);
 }
 
 void
@@ -2073,6 +2114,8 @@ Route::configure_processors_unlocked (ProcessorStreams* err, Glib::Threads::RWLo
 	*/
 	_session.ensure_buffers (n_process_buffers ());
 
+	setup_pipeline ();
+
 	DEBUG_TRACE (DEBUG::Processors, string_compose ("%1: configuration complete\n", _name));
 
 	_in_configure_processors = false;
@@ -2576,6 +2619,61 @@ Route::set_strict_io (const bool enable)
 	return true;
 }
 
+void
+Route::set_pipeline_stages (uint32_t n)
+{
+	if (_pipeline_stages == n) {
+		return;
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lx (AudioEngine::instance()->process_lock ());
+		Glib::Threads::RWLock::WriterLock lm (_processor_lock);
+		_pipeline_stages = n;
+		setup_pipeline ();
+	}
+
+	processor_latency_changed (); /* EMIT SIGNAL */
+	_session.set_dirty ();
+}
+
+void
+Route::setup_pipeline ()
+{
+	/* called with process-lock and processor WriterLock held */
+	_pipeline.reset ();
+
+	if (_pipeline_stages < 2) {
+		return;
+	}
+
+	RoutePipeline::Processors best;
+	RoutePipeline::Processors cur;
+
+	for (auto const& p : _processors) {
+		if (!RoutePipeline::can_pipeline (p)) {
+			cur.clear ();
+			continue;
+		}
+		cur.push_back (p);
+		if (cur.size () > best.size ()) {
+			best = cur;
+		}
+	}
+
+	if (best.size () < 2) {
+		return;
+	}
+
+	try {
+		_pipeline.reset (new RoutePipeline (_session, best, std::min<size_t> (_pipeline_stages, best.size ()), _session.get_block_size ()));
+	} catch (failed_constructor&) {
+		warning << string_compose (_("%1: cannot start pipeline threads, plugins are processed serially."), _name) << endmsg;
+	}
+
+	DEBUG_TRACE (DEBUG::Processors, string_compose ("%1: pipeline with %2 stages for %3 plugins\n", _name, _pipeline ? _pipeline->n_stages () : 0, best.size ()));
+}
+
 XMLNode&
 Route::get_state() const
 {
@@ -2616,6 +2714,7 @@ Route::state (bool save_template) const
 	node->set_property (X_("name"), name());
 	node->set_property (X_("default-type"), _default_type);
 	node->set_property (X_("strict-io"), _strict_io);
+	node->set_property (X_("pipeline-stages"), _pipeline_stages);
 
 	if (is_master ()) {
 		node->set_property (X_("volume-applies-to-output"), _volume_applies_to_output);
@@ -2718,7 +2817,19 @@ Route::set_state (const XMLNode& node, int version)
 		return set_state_2X (node, version);
 	}
 
-	XMLNodeList nlist;
+	static const XMLPropertyName prop_name ("name");
+	static const XMLPropertyName prop_strict_io ("strict-io");
+	static const XMLPropertyName prop_pipeline_stages ("pipeline-stages");
+	static const XMLPropertyName prop_direction ("direction");
+	static const XMLPropertyName prop_disk_io_point ("disk-io-point");
+	static const XMLPropertyName prop_meter_type ("meter-type");
+	static const XMLPropertyName prop_volume_applies_to_output ("volume-applies-to-output");
+	static const XMLPropertyName prop_meter_point ("meter-point");
+	static const XMLPropertyName prop_denormal_protection ("denormal-protection");
+	static const XMLPropertyName prop_phase_invert ("phase-invert");
+	static const XMLPropertyName prop_active ("active");
+	static const XMLPropertyName prop_processor_after_last_custom_meter ("processor-after-last-custom-meter");
+
 	XMLNodeConstIterator niter;
 	XMLNode *child;
 
@@ -2728,7 +2839,7 @@ Route::set_state (const XMLNode& node, int version)
 	}
 
 	std::string route_name;
-	if (node.get_property (X_("name"), route_name)) {
+	if (node.get_property (prop_name, route_name)) {
 		set_name (route_name);
 	}
 
@@ -2755,7 +2866,8 @@ Route::set_state (const XMLNode& node, int version)
 		}
 	}
 
-	node.get_property (X_("strict-io"), _strict_io);
+	node.get_property (prop_strict_io, _strict_io);
+	node.get_property (prop_pipeline_stages, _pipeline_stages);
 
 	if (is_monitor()) {
 		/* monitor bus does not get a panner, but if (re)created
@@ -2767,8 +2879,8 @@ Route::set_state (const XMLNode& node, int version)
 
 	/* add all processors (except amp, which is always present) */
 
-	nlist = node.children();
-	XMLNode processor_state (X_("processor_state"));
+	XMLNodeList const& nlist = node.children();
+	XMLNodeList processor_state;
 
 	Stateful::save_extra_xml (node);
 
@@ -2778,7 +2890,7 @@ Route::set_state (const XMLNode& node, int version)
 
 		if (child->name() == IO::state_node_name) {
 			std::string direction;
-			if (!child->get_property (X_("direction"), direction)) {
+			if (!child->get_property (prop_direction, direction)) {
 				continue;
 			}
 
@@ -2789,7 +2901,7 @@ Route::set_state (const XMLNode& node, int version)
 			}
 
 		} else if (child->name() == X_("Processor")) {
-			processor_state.add_child_copy (*child);
+			processor_state.push_back (child);
 		} else if (child->name() == X_("Pannable")) {
 			if (_pannable) {
 				_pannable->set_state (*child, version);
@@ -2802,7 +2914,7 @@ Route::set_state (const XMLNode& node, int version)
 	}
 
 	DiskIOPoint diop;
-	if (node.get_property (X_("disk-io-point"), diop)) {
+	if (node.get_property (prop_disk_io_point, diop)) {
 		if (_disk_writer) {
 			_disk_writer->set_display_to_user (diop == DiskIOCustom);
 		}
@@ -2816,14 +2928,14 @@ Route::set_state (const XMLNode& node, int version)
 	}
 
 	MeterType meter_type;
-	if (node.get_property (X_("meter-type"), meter_type)) {
+	if (node.get_property (prop_meter_type, meter_type)) {
 		set_meter_type (meter_type);
 	}
 
 	_initial_io_setup = false;
 
 	if (is_master ()) {
-		node.get_property (X_("volume-applies-to-output"), _volume_applies_to_output);
+		node.get_property (prop_volume_applies_to_output, _volume_applies_to_output);
 		if (_volume_applies_to_output) {
 			_volume->deactivate ();
 			_volume->set_display_to_user (false);
@@ -2841,7 +2953,7 @@ Route::set_state (const XMLNode& node, int version)
 	reset_instrument_info();
 
 	MeterPoint mp;
-	if (node.get_property (X_("meter-point"), mp)) {
+	if (node.get_property (prop_meter_point, mp)) {
 		set_meter_point (mp);
 		if (_meter) {
 			_meter->set_display_to_user (_meter_point == MeterCustom);
@@ -2849,23 +2961,23 @@ Route::set_state (const XMLNode& node, int version)
 	}
 
 	bool denormal_protection;
-	if (node.get_property (X_("denormal-protection"), denormal_protection)) {
+	if (node.get_property (prop_denormal_protection, denormal_protection)) {
 		set_denormal_protection (denormal_protection);
 	}
 
 	/* convert old 3001 state */
 	std::string phase_invert_str;
-	if (node.get_property (X_("phase-invert"), phase_invert_str)) {
+	if (node.get_property (prop_phase_invert, phase_invert_str)) {
 		_phase_control->set_phase_invert (boost::dynamic_bitset<> (phase_invert_str));
 	}
 
 	bool is_active;
-	if (node.get_property (X_("active"), is_active)) {
+	if (node.get_property (prop_active, is_active)) {
 		set_active (is_active, this);
 	}
 
 	std::string id_string;
-	if (node.get_property (X_("processor-after-last-custom-meter"), id_string)) {
+	if (node.get_property (prop_processor_after_last_custom_meter, id_string)) {
 		PBD::ID id (id_string);
 		Glib::Threads::RWLock::ReaderLock lm (_processor_lock);
 		ProcessorList::const_iterator i = _processors.begin ();
@@ -2891,7 +3003,7 @@ Route::set_state (const XMLNode& node, int version)
 
 		}  else if (child->name() == Controllable::xml_node_name) {
 			std::string control_name;
-			if (!child->get_property (X_("name"), control_name)) {
+			if (!child->get_property (prop_name, control_name)) {
 				continue;
 			}
 
@@ -3158,14 +3270,14 @@ Route::set_processor_state_2X (XMLNodeList const & nList, int version)
 }
 
 void
-Route::set_processor_state (const XMLNode& node, int version)
+Route::set_processor_state (XMLNodeList const& nlist, int version)
 {
-	const XMLNodeList &nlist = node.children();
-
 	if (nlist.empty()) {
 		return;
 	}
 
+	static const XMLPropertyName prop_type ("type");
+
 	XMLNodeConstIterator niter;
 	ProcessorList new_order;
 	bool must_configure = false;
@@ -3173,7 +3285,7 @@ Route::set_processor_state (const XMLNode& node, int version)
 
 	for (niter = nlist.begin(); niter != nlist.end(); ++niter) {
 
-		XMLProperty* prop = (*niter)->property ("type");
+		XMLProperty* prop = (*niter)->property (prop_type);
 
 		if (prop->value() == "amp") {
 			_amp->set_state (**niter, version);
@@ -3448,6 +3560,8 @@ Route::silence_unlocked (pframes_t nframes)
 
 		(*i)->silence (nframes, now);
 	}
+
+	update_asleep ();
 }
 
 void
@@ -4023,6 +4137,10 @@ Route::flush_processors ()
 	for (ProcessorList::iterator i = _processors.begin(); i != _processors.end(); ++i) {
 		(*i)->flush ();
 	}
+
+	if (_pipeline) {
+		_pipeline->flush ();
+	}
 }
 
 samplecnt_t
@@ -4502,6 +4620,9 @@ Route::update_signal_latency (bool apply_to_delayline, bool* delayline_update_ne
 		if ((*i)->active ()) { // XXX
 			l_out += (*i)->effective_latency ();
 		}
+		if (_pipeline) {
+			l_out += _pipeline->input_delay (*i);
+		}
 	}
 
 	DEBUG_TRACE (DEBUG::LatencyRoute, string_compose ("%1: internal signal latency = %2\n", _name, l_out));
@@ -4604,6 +4725,9 @@ Route::set_block_size (pframes_t nframes)
 	for (ProcessorList::iterator i = _processors.begin(); i != _processors.end(); ++i) {
 		(*i)->set_block_size (nframes);
 	}
+	if (_pipeline) {
+		_pipeline->set_block_size (nframes);
+	}
 	lm.release ();
 
 	_session.ensure_buffers (n_process_buffers ());
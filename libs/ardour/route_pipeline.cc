@@ -0,0 +1,326 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstdio>
+
+#include "pbd/debug.h"
+#include "pbd/failed_constructor.h"
+#include "pbd/pthread_utils.h"
+
+#include "temporal/tempo.h"
+
+#include "ardour/audio_buffer.h"
+#include "ardour/audioengine.h"
+#include "ardour/buffer_manager.h"
+#include "ardour/buffer_set.h"
+#include "ardour/plugin_insert.h"
+#include "ardour/process_thread.h"
+#include "ardour/route_pipeline.h"
+#include "ardour/runtime_functions.h"
+#include "ardour/session.h"
+#include "ardour/session_event.h"
+
+using namespace ARDOUR;
+
+namespace {
+
+void
+fifo_write (Sample* fifo, samplecnt_t size, samplecnt_t pos, Sample const* src, pframes_t n)
+{
+	pframes_t const n0 = std::min<samplecnt_t> (n, size - pos);
+	copy_vector (fifo + pos, src, n0);
+	if (n0 < n) {
+		copy_vector (fifo, src + n0, n - n0);
+	}
+}
+
+void
+fifo_read (Sample const* fifo, samplecnt_t size, samplecnt_t pos, Sample* dst, pframes_t n)
+{
+	pframes_t const n0 = std::min<samplecnt_t> (n, size - pos);
+	copy_vector (dst, fifo + pos, n0);
+	if (n0 < n) {
+		copy_vector (dst + n0, fifo, n - n0);
+	}
+}
+
+} // namespace
+
+RoutePipeline::RoutePipeline (Session& s, Processors const& procs, uint32_t n_stages, pframes_t block_size)
+	: _session (s)
+	, _block_size (block_size)
+	, _fifo_pos (0)
+	, _flush (false)
+	, _start_sample (0)
+	, _end_sample (0)
+	, _speed (0)
+	, _nframes (0)
+	, _n_reserved (0)
+	, _n_workers (0)
+	, _terminate (false)
+	, _done_sem ("pipeline done", 0)
+{
+	assert (n_stages > 1 && n_stages <= procs.size ());
+
+	/* distribute processors evenly, each stage has at least one */
+	_stages.resize (n_stages);
+	for (size_t i = 0; i < procs.size (); ++i) {
+		std::shared_ptr<PluginInsert> pi = std::dynamic_pointer_cast<PluginInsert> (procs[i]);
+		assert (pi);
+		_stages[i * n_stages / procs.size ()].procs.push_back (procs[i]);
+		_max_streams = ChanCount::max (_max_streams, pi->input_streams ());
+		_max_streams = ChanCount::max (_max_streams, pi->output_streams ());
+		_max_streams = ChanCount::max (_max_streams, pi->required_buffers ());
+	}
+
+	for (auto& st : _stages) {
+		st.offset.resize (st.procs.size ());
+		st.in  = st.procs.front ()->input_streams ();
+		st.out = st.procs.back ()->output_streams ();
+		st.sem = new PBD::Semaphore ("pipeline stage", 0);
+	}
+
+	allocate_fifos ();
+
+	/* every worker keeps thread-buffers while the pipeline exists */
+	_n_reserved = n_stages - 1;
+	BufferManager::reserve_thread_buffers (_n_reserved);
+
+	for (size_t i = 0; i < n_stages - 1; ++i) {
+		pthread_t t;
+		if (AudioEngine::instance ()->create_worker_thread (std::bind (&RoutePipeline::worker_thread, this), &t)) {
+			terminate ();
+			throw failed_constructor ();
+		}
+		_workers.push_back (t);
+	}
+}
+
+RoutePipeline::~RoutePipeline ()
+{
+	terminate ();
+}
+
+void
+RoutePipeline::terminate ()
+{
+	_terminate.store (true);
+	for (auto const& st : _stages) {
+		st.sem->signal ();
+	}
+	for (auto const& t : _workers) {
+		AudioEngine::instance ()->join_worker_thread (t);
+	}
+	_workers.clear ();
+
+	BufferManager::release_thread_buffers (_n_reserved);
+	_n_reserved = 0;
+
+	for (auto& st : _stages) {
+		delete st.sem;
+		st.sem = 0;
+	}
+}
+
+bool
+RoutePipeline::can_pipeline (std::shared_ptr<Processor> const& p)
+{
+	std::shared_ptr<PluginInsert> pi = std::dynamic_pointer_cast<PluginInsert> (p);
+	if (!pi || pi->sidechain_input ()) {
+		/* side-chain data would not be aligned with later stages */
+		return false;
+	}
+	/* only audio is passed between stages */
+	return pi->input_streams ().n_midi () == 0 && pi->output_streams ().n_midi () == 0;
+}
+
+samplecnt_t
+RoutePipeline::input_delay (std::shared_ptr<Processor> const& p) const
+{
+	for (size_t s = 1; s < _stages.size (); ++s) {
+		if (_stages[s].procs.front () == p) {
+			return _block_size;
+		}
+	}
+	return 0;
+}
+
+void
+RoutePipeline::set_block_size (pframes_t nframes)
+{
+	/* called while the engine is not processing */
+	_block_size = nframes;
+	allocate_fifos ();
+}
+
+void
+RoutePipeline::flush ()
+{
+	_flush.store (true);
+}
+
+void
+RoutePipeline::allocate_fifos ()
+{
+	_fifo_pos = 0;
+	_fifo.resize (_stages.size () - 1);
+
+	for (size_t s = 0; s < _fifo.size (); ++s) {
+		_fifo[s].assign (_stages[s].out.n_audio (), std::vector<Sample> (2 * _block_size, 0));
+	}
+	_out.assign (_stages.back ().out.n_audio (), std::vector<Sample> (_block_size, 0));
+}
+
+void
+RoutePipeline::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sample, int speed, pframes_t nframes, samplecnt_t& latency)
+{
+	assert (nframes <= _block_size);
+
+	if (_flush.exchange (false)) {
+		/* the workers are idle until they are signalled below */
+		for (auto& f : _fifo) {
+			for (auto& c : f) {
+				std::fill (c.begin (), c.end (), 0.f);
+			}
+		}
+		for (auto& c : _out) {
+			std::fill (c.begin (), c.end (), 0.f);
+		}
+		_fifo_pos = 0;
+	}
+
+	/* compare to Route::process_output_buffers, except that every
+	 * stage processes data of the previous block
+	 */
+	for (size_t s = 0; s < _stages.size (); ++s) {
+		Stage& st (_stages[s]);
+		if (s > 0) {
+			latency += speed < 0 ? -(samplecnt_t)_block_size : (samplecnt_t)_block_size;
+		}
+		for (size_t p = 0; p < st.procs.size (); ++p) {
+			if (st.procs[p]->active ()) {
+				if (speed < 0) {
+					latency -= st.procs[p]->effective_latency ();
+				} else {
+					latency += st.procs[p]->effective_latency ();
+				}
+			}
+			st.offset[p] = latency;
+		}
+	}
+
+	_start_sample = start_sample;
+	_end_sample   = end_sample;
+	_speed        = speed;
+	_nframes      = nframes;
+
+	for (size_t s = 1; s < _stages.size (); ++s) {
+		_stages[s].sem->signal ();
+	}
+
+	run_stage (0, bufs);
+
+	for (size_t s = 1; s < _stages.size (); ++s) {
+		_done_sem.wait ();
+	}
+
+	bufs.set_count (_stages.back ().out);
+	for (uint32_t c = 0; c < _out.size (); ++c) {
+		copy_vector (bufs.get_audio (c).data (), &_out[c][0], nframes);
+	}
+
+	_fifo_pos = (_fifo_pos + nframes) % (2 * _block_size);
+}
+
+void
+RoutePipeline::run_stage (size_t s, BufferSet& bufs)
+{
+	Stage&            st   (_stages[s]);
+	samplecnt_t const size = 2 * _block_size;
+
+	if (s > 0) {
+		/* the previous stage wrote this data one block ago,
+		 * it is currently writing the next block at _fifo_pos.
+		 */
+		samplecnt_t const pos = (_fifo_pos + _block_size) % size;
+		bufs.set_count (st.in);
+		for (uint32_t c = 0; c < _fifo[s - 1].size () && c < st.in.n_audio (); ++c) {
+			fifo_read (&_fifo[s - 1][c][0], size, pos, bufs.get_audio (c).data (), _nframes);
+		}
+	}
+
+	for (size_t p = 0; p < st.procs.size (); ++p) {
+		if (_speed < 0) {
+			st.procs[p]->run (bufs, _start_sample + st.offset[p], _end_sample + st.offset[p], _speed, _nframes, true);
+		} else {
+			st.procs[p]->run (bufs, _start_sample - st.offset[p], _end_sample - st.offset[p], _speed, _nframes, true);
+		}
+		bufs.set_count (st.procs[p]->output_streams ());
+	}
+
+	if (s + 1 < _stages.size ()) {
+		for (uint32_t c = 0; c < _fifo[s].size (); ++c) {
+			fifo_write (&_fifo[s][c][0], size, _fifo_pos, bufs.get_audio (c).data (), _nframes);
+		}
+	} else {
+		for (uint32_t c = 0; c < _out.size (); ++c) {
+			copy_vector (&_out[c][0], bufs.get_audio (c).data (), _nframes);
+		}
+	}
+}
+
+void
+RoutePipeline::worker_thread ()
+{
+	/* stage zero runs in the process thread */
+	size_t const stage = _n_workers.fetch_add (1) + 1;
+
+	char name[64];
+	snprintf (name, 64, "Pipeline-%u-%p", (unsigned int) stage, (void*)DEBUG_THREAD_SELF);
+	pthread_set_name (name);
+
+	/* This is needed for ARDOUR::Session requests called from rt-processors
+	 * in particular Lua scripts may do cross-thread calls */
+	SessionEvent::create_per_thread_pool (name, 64);
+	PBD::notify_event_loops_about_thread_creation (pthread_self (), name, 64);
+
+	ProcessThread* pt = new ProcessThread ();
+	pt->get_buffers ();
+
+	stage_thread (stage);
+
+	pt->drop_buffers ();
+	delete pt;
+}
+
+void
+RoutePipeline::stage_thread (size_t s)
+{
+	while (true) {
+		_stages[s].sem->wait ();
+		if (_terminate.load ()) {
+			break;
+		}
+
+		Temporal::TempoMap::fetch ();
+
+		BufferSet& bufs (_session.get_route_buffers (_max_streams, true));
+		run_stage (s, bufs);
+
+		_done_sem.signal ();
+	}
+}
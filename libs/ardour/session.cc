@@ -77,6 +77,7 @@
 #include "ardour/control_protocol_manager.h"
 #include "ardour/data_type.h"
 #include "ardour/debug.h"
+#include "ardour/delay_arena.h"
 #include "ardour/disk_reader.h"
 #include "ardour/directory_names.h"
 #include "ardour/filename_extensions.h"
@@ -106,6 +107,7 @@
 #include "ardour/recent_sessions.h"
 #include "ardour/region.h"
 #include "ardour/region_factory.h"
+#include "ardour/region_fx_renderer.h"
 #include "ardour/revision.h"
 #include "ardour/route_group.h"
 #include "ardour/rt_tasklist.h"
@@ -277,6 +279,7 @@ Session::Session (AudioEngine &eng,
 	, _n_lua_scripts (0)
 	, _io_plugins (new IOPlugList)
 	, _butler (new Butler (*this))
+	, _region_fx_renderer (new RegionFxRenderer (*this))
 	, _transport_fsm (new TransportFSM (*this))
 	, _locations (new Locations (*this))
 	, _ignore_skips_updates (false)
@@ -355,6 +358,9 @@ Session::Session (AudioEngine &eng,
 	, tb_with_filled_slots (0)
 	, _global_quantization (Config->get_default_quantization())
 {
+	/* before any route (and its delay-lines) is created */
+	_delay_arena.reset (new DelayArena ());
+
 	_suspend_save.store (0);
 	_playback_load.store (0);
 	_capture_load.store (0);
@@ -660,6 +666,10 @@ Session::destroy ()
 
 	_state_of_the_state = StateOfTheState (CannotSave | Deletion);
 
+	/* stop rendering Region FX, before regions are dropped */
+	delete _region_fx_renderer;
+	_region_fx_renderer = 0;
+
 	{
 		Glib::Threads::Mutex::Lock lm (AudioEngine::instance()->process_lock ());
 		ltc_tx_cleanup();
@@ -6644,6 +6654,21 @@ Session::nbusses () const
 	return n;
 }
 
+uint32_t
+Session::n_sleeping_routes () const
+{
+	uint32_t n = 0;
+	std::shared_ptr<RouteList const> r = routes.reader ();
+
+	for (auto const& i : *r) {
+		if (i->asleep ()) {
+			++n;
+		}
+	}
+
+	return n;
+}
+
 uint32_t
 Session::nstripables (bool with_monitor) const
 {
@@ -7472,7 +7497,8 @@ Session::update_latency_compensation (bool force_whole_graph, bool called_from_b
 			i->apply_latency_compensation ();
 		}
 	}
-	DEBUG_TRACE (DEBUG::LatencyCompensation, "update_latency_compensation: complete\n");
+	DEBUG_TRACE (DEBUG::LatencyCompensation, string_compose ("update_latency_compensation: complete, delay-lines use %1 of %2 bytes\n",
+				_delay_arena->used_bytes (), _delay_arena->reserved_bytes ()));
 }
 
 const std::string
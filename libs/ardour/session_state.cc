@@ -35,6 +35,9 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
+#include <list>
+#include <set>
 #include <string>
 #include <cerrno>
 #include <cstdio> /* snprintf(3) ... grrr */
@@ -78,6 +81,7 @@
 #include "evoral/SMF.h"
 
 #include "pbd/basename.h"
+#include "pbd/cpus.h"
 #include "pbd/debug.h"
 #include "pbd/enumwriter.h"
 #include "pbd/error.h"
@@ -98,6 +102,7 @@
 #include "ardour/audioregion.h"
 #include "ardour/auditioner.h"
 #include "ardour/automation_control.h"
+#include "ardour/automation_event_store.h"
 #include "ardour/boost_debug.h"
 #include "ardour/butler.h"
 #include "ardour/control_protocol_manager.h"
@@ -117,12 +122,15 @@
 #include "ardour/mixer_scene.h"
 #include "ardour/playlist_factory.h"
 #include "ardour/playlist_source.h"
+#include "ardour/plugin_insert.h"
 #include "ardour/port.h"
 #include "ardour/processor.h"
 #include "ardour/profile.h"
 #include "ardour/proxy_controllable.h"
 #include "ardour/recent_sessions.h"
+#include "ardour/region_batch_edit.h"
 #include "ardour/region_factory.h"
+#include "ardour/region_fx_renderer.h"
 #include "ardour/revision.h"
 #include "ardour/route_group.h"
 #include "ardour/send.h"
@@ -250,6 +258,13 @@ Session::post_engine_init ()
 		return -1;
 	}
 
+	_region_fx_renderer->remove_stale_renders ();
+
+	if (_region_fx_renderer->start_thread ()) {
+		error << _("Region FX renderer did not start") << endmsg;
+		return -1;
+	}
+
 	if (start_midi_thread ()) {
 		error << _("MIDI I/O thread did not start") << endmsg;
 		return -1;
@@ -835,6 +850,9 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 		mark_as_clean = false;
 		tree.set_root (&get_template());
 	} else {
+		/* archives are self-contained and use text */
+		AutomationEventStore store (automation_dir ());
+		AutomationEventStore::Scope as (config.get_binary_automation_events () && !for_archive ? &store : 0);
 		tree.set_root (&state (false, fork_state, for_archive, only_used_assets));
 	}
 
@@ -940,11 +958,36 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 
 	if (!pending && !for_archive && ! template_only) {
 		remove_pending_capture_state ();
+		remove_unused_automation_events ();
 	}
 
 	return 0;
 }
 
+/** Remove automation blobs (see AutomationEventStore) that are no longer
+ * referenced by any snapshot, backup or pending state of this session.
+ */
+void
+Session::remove_unused_automation_events ()
+{
+	if (!Glib::file_test (automation_dir (), Glib::FILE_TEST_IS_DIR)) {
+		return;
+	}
+
+	Searchpath const root (_session_dir->root_path ());
+
+	vector<string> state_files;
+	find_files_matching_pattern (state_files, root, string ("*") + statefile_suffix);
+	find_files_matching_pattern (state_files, root, string ("*") + pending_suffix);
+	find_files_matching_pattern (state_files, root, string ("*") + backup_suffix);
+	find_files_matching_pattern (state_files, Searchpath (_session_dir->backup_path ()), string ("*") + statefile_suffix);
+
+	AutomationEventStore store (automation_dir ());
+	size_t const n = store.remove_unreferenced (state_files);
+
+	DEBUG_TRACE (DEBUG::SaveState, string_compose ("removed %1 unused automation event file(s)\n", n));
+}
+
 int
 Session::restore_state (string snapshot_name)
 {
@@ -1703,6 +1746,9 @@ Session::set_state (const XMLNode& node, int version)
 	XMLNode* child;
 	int ret = -1;
 
+	AutomationEventStore        store (automation_dir ());
+	AutomationEventStore::Scope as (&store);
+
 	_state_of_the_state = StateOfTheState (_state_of_the_state | CannotSave);
 
 	if (node.name() != X_("Session")) {
@@ -3765,6 +3811,11 @@ Session::cleanup_sources (CleanupReport& rep)
 	cerr << "Dead Sources: " << dead_sources.size() << endl;
 
 	for (auto const& i : dead_sources) {
+		/* the peakfile is removed below, with the audio file */
+		std::shared_ptr<AudioSource> as = std::dynamic_pointer_cast<AudioSource> (i);
+		if (as) {
+			as->remove_block_stats ();
+		}
 		/* The following triggers Region::source_deleted (), which
 		 * causes regions to drop the given source */
 		i->drop_references ();
@@ -4204,6 +4255,14 @@ Session::restore_history (string snapshot_name)
 					if ((c = stateful_diff_command_factory (n))) {
 						ut->add_command (c);
 					}
+				} else if (n->name() == "RegionBatchDiffCommand") {
+					RegionBatchDiffCommand* bc = new RegionBatchDiffCommand (*n);
+					if (bc->empty ()) {
+						/* none of the regions exist anymore */
+						delete bc;
+					} else {
+						ut->add_command (bc);
+					}
 				} else {
 					error << string_compose(_("Couldn't figure out how to make a Command out of a %1 XMLNode."), n->name()) << endmsg;
 				}
@@ -4501,6 +4560,10 @@ Session::config_changed (std::string p, bool ours)
 		if (follow && !transport_state_rolling() && !loading()) {
 			request_locate (transport_sample(), true);
 		}
+	} else if (p == "parallel-plugin-instances") {
+		if (Config->get_parallel_plugin_instances ()) {
+			PluginInsert::start_instance_workers ();
+		}
 	} else if (p == "default-time-domain") {
 		Temporal::TimeDomain td = config.get_default_time_domain ();
 		set_time_domain (td);
@@ -5515,6 +5578,162 @@ Session::save_as (SaveAs& saveas)
 	return 0;
 }
 
+namespace {
+
+/** A source to transcode for Session::archive_session () */
+struct ArchiveEncodeJob : public PBD::Progress
+{
+	ArchiveEncodeJob (std::shared_ptr<AudioFileSource> s, std::string const& p)
+		: afs (s)
+		, path (p)
+		, length (s->readable_length_samples ())
+		, ns (0)
+		, done (0)
+	{}
+
+	std::shared_ptr<AudioFileSource> afs;
+	std::string                      path;
+	samplecnt_t                      length;
+	SndFileSource*                   ns;   ///< set by the encoder thread, NULL if encoding failed
+	std::atomic<float>               done;
+
+private:
+	void set_overall_progress (float p) { done = p; }
+};
+
+/** Transcode sources to FLAC using a pool of threads.
+ * Completed files are handed back to the thread that writes the archive,
+ * at most \c max_pending encoded files wait to be archived.
+ */
+class ArchiveEncoder
+{
+public:
+	ArchiveEncoder (Session& s, bool use16bits, std::list<ArchiveEncodeJob>& jobs)
+		: _session (s)
+		, _use16bits (use16bits)
+		, _next (0)
+		, _abort (false)
+		, _max_pending (1)
+		, _total (0)
+	{
+		for (auto& j : jobs) {
+			_jobs.push_back (&j);
+			_total += j.length;
+		}
+	}
+
+	~ArchiveEncoder ()
+	{
+		stop ();
+	}
+
+	/** @return 0 on success, -1 if the encoder threads could not be started */
+	int start (uint32_t n_threads)
+	{
+		n_threads    = std::max<uint32_t> (1, std::min<uint32_t> (n_threads, _jobs.size ()));
+		_max_pending = n_threads;
+		for (uint32_t i = 0; i < n_threads; ++i) {
+			PBD::Thread* t = PBD::Thread::create (std::bind (&ArchiveEncoder::encode, this), string_compose ("ArchiveEnc %1", i));
+			if (!t) {
+				stop ();
+				return -1;
+			}
+			_threads.push_back (t);
+		}
+		return 0;
+	}
+
+	/** @return next encoded file, or NULL if none was completed within 100ms */
+	ArchiveEncodeJob* next_finished ()
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		if (_finished.empty ()) {
+			_cond.wait_until (_lock, g_get_monotonic_time () + 100000);
+		}
+		if (_finished.empty ()) {
+			return 0;
+		}
+		ArchiveEncodeJob* j = _finished.front ();
+		_finished.pop_front ();
+		_cond.broadcast ();
+		return j;
+	}
+
+	void stop ()
+	{
+		{
+			Glib::Threads::Mutex::Lock lm (_lock);
+			_abort = true;
+			_cond.broadcast ();
+		}
+		for (auto const& t : _threads) {
+			t->join ();
+			delete t;
+		}
+		_threads.clear ();
+		for (auto const& j : _jobs) {
+			delete j->ns;
+			j->ns = 0;
+		}
+	}
+
+	float progress () const
+	{
+		if (_total == 0) {
+			return 0;
+		}
+		double p = 0;
+		for (auto const& j : _jobs) {
+			p += j->length * j->done.load ();
+		}
+		return p / _total;
+	}
+
+private:
+	void encode ()
+	{
+		while (true) {
+			{
+				Glib::Threads::Mutex::Lock lm (_lock);
+				while (!_abort && _finished.size () >= _max_pending) {
+					_cond.wait (_lock);
+				}
+			}
+
+			size_t const i = _next++;
+			if (_abort || i >= _jobs.size ()) {
+				break;
+			}
+
+			ArchiveEncodeJob* j = _jobs[i];
+			try {
+				j->ns = new SndFileSource (_session, *(j->afs.get ()), j->path, _use16bits, j);
+			} catch (...) {
+				j->ns = 0;
+			}
+			j->done = 1.f;
+
+			Glib::Threads::Mutex::Lock lm (_lock);
+			_finished.push_back (j);
+			_cond.broadcast ();
+		}
+	}
+
+	Session&                       _session;
+	bool                           _use16bits;
+	std::vector<ArchiveEncodeJob*> _jobs;
+	std::atomic<size_t>            _next;
+	std::atomic<bool>              _abort;
+	size_t                         _max_pending;
+	samplecnt_t                    _total;
+	Glib::Threads::Mutex           _lock;
+	Glib::Threads::Cond            _cond;
+	std::list<ArchiveEncodeJob*>   _finished;
+	std::vector<PBD::Thread*>      _threads;
+};
+
+} // anonymous namespace
+
 int
 Session::archive_session (const std::string& dest,
                           const std::string& name,
@@ -5579,6 +5798,7 @@ Session::archive_session (const std::string& dest,
 
 	/* prepare archive */
 	string archive = Glib::build_filename (dest, name + session_archive_suffix);
+	int64_t const archive_start = g_get_monotonic_time ();
 
 	PBD::ScopedConnectionList progress_connection;
 	PBD::FileArchive ar (archive, progress);
@@ -5612,10 +5832,9 @@ Session::archive_session (const std::string& dest,
 		collect_sources_of_this_snapshot (sources_used_by_this_snapshot, false);
 	}
 
-	/* collect audio sources for this session, calc total size for encoding
+	/* collect audio sources for this session
 	 * add option to only include *used* sources (see Session::cleanup_sources)
 	 */
-	size_t total_size = 0;
 	{
 		Glib::Threads::Mutex::Lock lm (source_lock);
 
@@ -5661,7 +5880,7 @@ Session::archive_session (const std::string& dest,
 			std::string from = afs->path();
 
 			if (compress_audio != NO_ENCODE) {
-				total_size += afs->readable_length_samples ();
+				; // encoded and archived below
 			} else {
 				/* copy files as-is */
 				if (!afs->within_session()) {
@@ -5704,77 +5923,126 @@ Session::archive_session (const std::string& dest,
 		goto out;
 	}
 
-	/* encode audio */
+	/* encode audio, and stream encoded files into the archive as they
+	 * become available. Encoded files are removed once archived.
+	 */
 	if (compress_audio != NO_ENCODE) {
 		if (progress) {
 			progress->set_progress (2); // set to "encoding"
 			progress->set_progress (0);
 		}
 
-		Glib::Threads::Mutex::Lock lm (source_lock);
-		for (SourceMap::const_iterator i = sources.begin(); i != sources.end(); ++i) {
-			if (std::dynamic_pointer_cast<SilentFileSource> (i->second)) {
-				continue;
-			}
-			std::shared_ptr<AudioFileSource> afs = std::dynamic_pointer_cast<AudioFileSource> (i->second);
-			if (!afs || afs->length ().is_zero ()) {
-				continue;
-			}
+		std::list<ArchiveEncodeJob> jobs;
+		std::set<std::string>       new_paths;
 
-			if (only_used_sources) {
-				if (!afs->used()) {
+		{
+			Glib::Threads::Mutex::Lock lm (source_lock);
+			for (SourceMap::const_iterator i = sources.begin(); i != sources.end(); ++i) {
+				if (std::dynamic_pointer_cast<SilentFileSource> (i->second)) {
 					continue;
 				}
-				if (sources_used_by_this_snapshot.find (afs) == sources_used_by_this_snapshot.end ()) {
+				std::shared_ptr<AudioFileSource> afs = std::dynamic_pointer_cast<AudioFileSource> (i->second);
+				if (!afs || afs->length ().is_zero ()) {
 					continue;
 				}
-			}
 
-			orig_sources[afs] = afs->path();
-			orig_gain[afs]    = afs->gain();
-			orig_channel[afs] = afs->channel();
+				if (only_used_sources) {
+					if (!afs->used()) {
+						continue;
+					}
+					if (sources_used_by_this_snapshot.find (afs) == sources_used_by_this_snapshot.end ()) {
+						continue;
+					}
+				}
 
-			std::string new_path = make_new_media_path (afs->path (), to_dir, name);
+				orig_sources[afs] = afs->path();
+				orig_gain[afs]    = afs->gain();
+				orig_channel[afs] = afs->channel();
 
-			std::string channelsuffix = "";
-			if (afs->channel() > 0) {  /* n_channels() is /wrongly/ 1. */
-				/* embedded external multi-channel files are converted to multiple-mono */
-				channelsuffix = string_compose ("-c%1", afs->channel ());
-			}
-			new_path = Glib::build_filename (Glib::path_get_dirname (new_path), PBD::basename_nosuffix (new_path) + channelsuffix + ".flac");
-			g_mkdir_with_parents (Glib::path_get_dirname (new_path).c_str (), 0755);
+				std::string new_path = make_new_media_path (afs->path (), to_dir, name);
 
-			/* avoid name collisions of external files with same name */
-			if (Glib::file_test (new_path, Glib::FILE_TEST_EXISTS)) {
-				new_path = Glib::build_filename (Glib::path_get_dirname (new_path), PBD::basename_nosuffix (new_path) + channelsuffix + "-1.flac");
-			}
-			while (Glib::file_test (new_path, Glib::FILE_TEST_EXISTS)) {
-				new_path = bump_name_once (new_path, '-');
+				std::string channelsuffix = "";
+				if (afs->channel() > 0) {  /* n_channels() is /wrongly/ 1. */
+					/* embedded external multi-channel files are converted to multiple-mono */
+					channelsuffix = string_compose ("-c%1", afs->channel ());
+				}
+				new_path = Glib::build_filename (Glib::path_get_dirname (new_path), PBD::basename_nosuffix (new_path) + channelsuffix + ".flac");
+				g_mkdir_with_parents (Glib::path_get_dirname (new_path).c_str (), 0755);
+
+				/* avoid name collisions of external files with same name,
+				 * files are encoded later, and removed once archived */
+				if (new_paths.find (new_path) != new_paths.end () || Glib::file_test (new_path, Glib::FILE_TEST_EXISTS)) {
+					new_path = Glib::build_filename (Glib::path_get_dirname (new_path), PBD::basename_nosuffix (new_path) + channelsuffix + "-1.flac");
+				}
+				while (new_paths.find (new_path) != new_paths.end () || Glib::file_test (new_path, Glib::FILE_TEST_EXISTS)) {
+					new_path = bump_name_once (new_path, '-');
+				}
+
+				new_paths.insert (new_path);
+				jobs.emplace_back (afs, new_path);
 			}
+		}
+
+		if (ar.open_write (compression_level)) {
+			error << string_compose(_("Session archive failed write output: `%1'"), archive) << endmsg;
+			rv = -1;
+			goto out;
+		}
+
+		uint32_t const n_threads = std::max<uint32_t> (1, PBD::hardware_concurrency ());
+		size_t const   to_dir_len = to_dir.size () + 1;
+		size_t         n_done     = 0;
+
+		ArchiveEncoder enc (*this, compress_audio == FLAC_16BIT, jobs);
+		if (enc.start (n_threads)) {
+			error << _("Session archive: cannot start encoder threads") << endmsg;
+			rv = -1;
+		}
+
+		while (rv == 0 && n_done < jobs.size ()) {
+			ArchiveEncodeJob* j = enc.next_finished ();
 
 			if (progress) {
-				progress->descend ((float)afs->readable_length_samples () / total_size);
+				progress->set_progress (enc.progress ());
+				if (progress->cancelled ()) {
+					break;
+				}
 			}
 
-			try {
-				SndFileSource* ns = new SndFileSource (*this, *(afs.get()), new_path, compress_audio == FLAC_16BIT, progress);
-				afs->replace_file (new_path);
-				afs->set_gain (ns->gain(), true);
-				afs->set_channel (0);
-				delete ns;
-			} catch (...) {
-				error << "failed to encode " << afs->path() << " to " << new_path << endmsg;
+			if (!j) {
+				continue;
+			}
+
+			++n_done;
+
+			if (!j->ns) {
+				error << "failed to encode " << j->afs->path() << " to " << j->path << endmsg;
 				rv = -1;
 				break;
 			}
 
-			if (progress) {
-				progress->ascend ();
-				if (progress->cancelled ()) {
-					break;
+			j->afs->replace_file (j->path);
+			j->afs->set_gain (j->ns->gain(), true);
+			j->afs->set_channel (0);
+			delete j->ns;
+			j->ns = 0;
+
+			if (ar.add_file (j->path, name + G_DIR_SEPARATOR + j->path.substr (to_dir_len))) {
+				if (!(progress && progress->cancelled ())) {
+					error << string_compose(_("Session archive failed write output: `%1'"), archive) << endmsg;
 				}
+				rv = -1;
+				break;
 			}
+			::g_unlink (j->path.c_str ());
 		}
+
+		enc.stop ();
+
+		double const elapsed = (g_get_monotonic_time () - archive_start) / 1e6;
+		info << string_compose (_("Session archive: encoded %1 sources using %2 threads in %3 sec, archived %4 MB (%5 MB/s)"),
+		                        n_done, n_threads, elapsed, ar.bytes_added () / 1048576, elapsed > 0 ? ar.bytes_added () / (1048576 * elapsed) : 0)
+		     << endmsg;
 	}
 
 	if (rv) {
@@ -5909,7 +6177,25 @@ out:
 		i->first->set_channel (i->second);
 	}
 
-	if (0 == rv && !(progress && progress->cancelled ())) {
+	if (compress_audio != NO_ENCODE) {
+		/* archive was opened while encoding, add remaining files */
+		size_t n = 0;
+		for (std::map<string,string>::const_iterator f = filemap.begin (); f != filemap.end () && 0 == rv; ++f, ++n) {
+			if (progress) {
+				progress->set_progress ((float) n / filemap.size ());
+				if (progress->cancelled ()) {
+					break;
+				}
+			}
+			if (ar.add_file (f->first, f->second)) {
+				if (!(progress && progress->cancelled ())) {
+					error << string_compose(_("Session archive failed write output: `%1'"), archive) << endmsg;
+				}
+				rv = -1;
+			}
+		}
+		ar.close_write (rv != 0 || (progress && progress->cancelled ()));
+	} else if (0 == rv && !(progress && progress->cancelled ())) {
 		rv = ar.create (filemap, compression_level);
 		if (rv) {
 			error << string_compose(_("Session archive failed write output: `%1'"), archive) << endmsg;
@@ -0,0 +1,147 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
+
+#include "pbd/gstdio_compat.h"
+#include "pbd/xml++.h"
+
+#include "ardour/automation_event_store.h"
+#include "ardour/automation_list.h"
+
+#include "automation_event_store_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (AutomationEventStoreTest);
+
+using namespace ARDOUR;
+using namespace Temporal;
+
+static std::shared_ptr<AutomationList>
+make_list (size_t n_events)
+{
+	std::shared_ptr<AutomationList> al (new AutomationList (Evoral::Parameter (GainAutomation), TimeDomainProvider (AudioTime)));
+	for (size_t i = 0; i < n_events; ++i) {
+		al->fast_simple_add (timepos_t::from_superclock (i * 1000), (i % 100) / 100.0);
+	}
+	return al;
+}
+
+void
+AutomationEventStoreTest::roundTripTest ()
+{
+	AutomationEventStore store (new_test_output_dir ("automation_event_store"));
+
+	std::shared_ptr<AutomationList> al = make_list (AutomationEventStore::min_events * 2);
+
+	XMLNode* state;
+	{
+		AutomationEventStore::Scope as (&store);
+		state = &al->get_state ();
+	}
+
+	XMLNode* events = state->child ("events");
+	CPPUNIT_ASSERT (events);
+	CPPUNIT_ASSERT (events->property ("blob"));
+	CPPUNIT_ASSERT (events->children ().empty ());
+
+	/* unmodified lists are stored once */
+	std::string blob;
+	events->get_property ("blob", blob);
+	{
+		AutomationEventStore::Scope as (&store);
+		XMLNode* again = &al->get_state ();
+		std::string blob2;
+		again->child ("events")->get_property ("blob", blob2);
+		CPPUNIT_ASSERT_EQUAL (blob, blob2);
+		delete again;
+	}
+
+	std::shared_ptr<AutomationList> copy = make_list (0);
+	{
+		AutomationEventStore::Scope as (&store);
+		CPPUNIT_ASSERT_EQUAL (0, copy->set_state (*state, 7000));
+	}
+
+	CPPUNIT_ASSERT_EQUAL (al->size (), copy->size ());
+
+	AutomationList::const_iterator a = al->begin ();
+	AutomationList::const_iterator b = copy->begin ();
+	for (; a != al->end (); ++a, ++b) {
+		CPPUNIT_ASSERT ((*a)->when == (*b)->when);
+		CPPUNIT_ASSERT_EQUAL ((*a)->value, (*b)->value);
+	}
+
+	delete state;
+}
+
+void
+AutomationEventStoreTest::textFallbackTest ()
+{
+	AutomationEventStore store (new_test_output_dir ("automation_event_store"));
+
+	/* small lists */
+	std::shared_ptr<AutomationList> al = make_list (16);
+	{
+		AutomationEventStore::Scope as (&store);
+		XMLNode* state = &al->get_state ();
+		CPPUNIT_ASSERT (!state->child ("events")->property ("blob"));
+		delete state;
+	}
+
+	/* no store in scope */
+	al = make_list (AutomationEventStore::min_events * 2);
+	XMLNode* state = &al->get_state ();
+	CPPUNIT_ASSERT (!state->child ("events")->property ("blob"));
+
+	std::shared_ptr<AutomationList> copy = make_list (0);
+	CPPUNIT_ASSERT_EQUAL (0, copy->set_state (*state, 7000));
+	CPPUNIT_ASSERT_EQUAL (al->size (), copy->size ());
+	delete state;
+}
+
+void
+AutomationEventStoreTest::removeUnreferencedTest ()
+{
+	std::string const dir = new_test_output_dir ("automation_event_store_gc");
+	AutomationEventStore store (dir);
+
+	std::string const used   = store.write (make_list (AutomationEventStore::min_events * 2)->events (), AudioTime);
+	std::string const unused = store.write (make_list (AutomationEventStore::min_events * 3)->events (), AudioTime);
+	CPPUNIT_ASSERT (!used.empty ());
+	CPPUNIT_ASSERT (!unused.empty ());
+	CPPUNIT_ASSERT (used != unused);
+
+	std::string const state_file = Glib::build_filename (dir, "session.ardour");
+	Glib::file_set_contents (state_file, "<Session><events blob=\"" + used + "\" count=\"1\"/></Session>\n");
+
+	std::vector<std::string> state_files;
+	state_files.push_back (state_file);
+
+	/* nothing is removed if a state file cannot be read */
+	std::vector<std::string> missing (state_files);
+	missing.push_back (Glib::build_filename (dir, "missing.ardour"));
+	CPPUNIT_ASSERT_EQUAL (size_t (0), store.remove_unreferenced (missing));
+	CPPUNIT_ASSERT (Glib::file_test (store.blob_path (unused), Glib::FILE_TEST_EXISTS));
+
+	CPPUNIT_ASSERT_EQUAL (size_t (1), store.remove_unreferenced (state_files));
+	CPPUNIT_ASSERT (Glib::file_test (store.blob_path (used), Glib::FILE_TEST_EXISTS));
+	CPPUNIT_ASSERT (!Glib::file_test (store.blob_path (unused), Glib::FILE_TEST_EXISTS));
+	CPPUNIT_ASSERT (store.map (used));
+
+	::g_unlink (state_file.c_str ());
+}
@@ -0,0 +1,82 @@
+#include "ardour/delay_arena.h"
+
+#include "delay_arena_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (DelayArenaTest);
+
+using namespace ARDOUR;
+
+static bool
+is_silent (Sample const* buf, samplecnt_t n)
+{
+	for (samplecnt_t i = 0; i < n; ++i) {
+		if (buf[i] != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void
+DelayArenaTest::allocTest ()
+{
+	DelayArena arena (65536);
+
+	Sample* a = arena.alloc (16384);
+	Sample* b = arena.alloc (16384);
+	Sample* c = arena.alloc (16384);
+
+	CPPUNIT_ASSERT (is_silent (a, 16384));
+
+	/* buffers of the same size are packed into the same slab */
+	CPPUNIT_ASSERT_EQUAL (a + 16384, b);
+	CPPUNIT_ASSERT_EQUAL (b + 16384, c);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 65536 * sizeof (Sample), arena.reserved_bytes ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3 * 16384 * sizeof (Sample), arena.used_bytes ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3, arena.n_buffers ());
+
+	/* larger than a slab */
+	Sample* d = arena.alloc (131072);
+	CPPUNIT_ASSERT (is_silent (d, 131072));
+	CPPUNIT_ASSERT_EQUAL ((size_t) (65536 + 131072) * sizeof (Sample), arena.reserved_bytes ());
+
+	arena.free (a, 16384);
+	arena.free (b, 16384);
+	arena.free (c, 16384);
+	arena.free (d, 131072);
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, arena.used_bytes ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, arena.n_buffers ());
+}
+
+void
+DelayArenaTest::reuseTest ()
+{
+	DelayArena arena (65536);
+
+	Sample* a = arena.alloc (32768);
+	for (samplecnt_t i = 0; i < 32768; ++i) {
+		a[i] = 1.f;
+	}
+	arena.free (a, 32768);
+
+	/* a freed buffer is re-used for the same size, and cleared */
+	Sample* b = arena.alloc (32768);
+	CPPUNIT_ASSERT_EQUAL (a, b);
+	CPPUNIT_ASSERT (is_silent (b, 32768));
+
+	/* growing a delay-line: allocate new, then release the old buffer */
+	Sample* c = arena.alloc (65536);
+	arena.free (b, 32768);
+	CPPUNIT_ASSERT (c != b);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 65536 * sizeof (Sample), arena.used_bytes ());
+
+	/* no new memory is reserved for another buffer of the old size */
+	size_t const reserved = arena.reserved_bytes ();
+	Sample* d = arena.alloc (32768);
+	CPPUNIT_ASSERT_EQUAL (b, d);
+	CPPUNIT_ASSERT_EQUAL (reserved, arena.reserved_bytes ());
+
+	arena.free (c, 65536);
+	arena.free (d, 32768);
+}
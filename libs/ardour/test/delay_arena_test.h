@@ -0,0 +1,14 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class DelayArenaTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (DelayArenaTest);
+	CPPUNIT_TEST (allocTest);
+	CPPUNIT_TEST (reuseTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void allocTest ();
+	void reuseTest ();
+};
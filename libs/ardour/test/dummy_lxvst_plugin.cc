@@ -0,0 +1,193 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/* A minimal Linux VST (stereo pass-through) that is scanned by
+ * PluginsTest::scanTest using the real ardour-vst-scanner.
+ *
+ * The plugin has no name, so it is named after its file. When a
+ * "running" folder exists next to the plugin, instantiating it logs
+ * to that folder's parent (see plugins_test.cc):
+ *  - "scanned.log": the name of the plugin,
+ *  - "concurrency.log": the number of plugins being scanned concurrently,
+ * and takes 1 second to complete. Copies named "hang*" never complete.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include <dirent.h>
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ardour/vestige/vestige.h"
+
+static std::string
+module_path ()
+{
+	Dl_info info;
+	if (dladdr ((void*) &module_path, &info) && info.dli_fname) {
+		return info.dli_fname;
+	}
+	return "";
+}
+
+static void
+append (std::string const& path, std::string const& line)
+{
+	FILE* f = fopen (path.c_str (), "a");
+	if (f) {
+		fprintf (f, "%s\n", line.c_str ());
+		fclose (f);
+	}
+}
+
+static size_t
+count_files (std::string const& dir)
+{
+	size_t n = 0;
+	DIR*   d = opendir (dir.c_str ());
+	if (!d) {
+		return 0;
+	}
+	struct dirent* e;
+	while ((e = readdir (d))) {
+		if (e->d_name[0] != '.') {
+			++n;
+		}
+	}
+	closedir (d);
+	return n;
+}
+
+static void
+scan_test_hook (std::string const& path)
+{
+	size_t const sep = path.rfind ('/');
+	if (sep == std::string::npos) {
+		return;
+	}
+
+	std::string const dir     = path.substr (0, sep);
+	std::string const name    = path.substr (sep + 1, path.rfind ('.') - sep - 1);
+	std::string const running = dir + "/running";
+
+	struct stat st;
+	if (stat (running.c_str (), &st) || !S_ISDIR (st.st_mode)) {
+		return;
+	}
+
+	append (dir + "/scanned.log", name);
+
+	if (name.find ("hang") == 0) {
+		sleep (60);
+		return;
+	}
+
+	char pid[32];
+	snprintf (pid, sizeof (pid), "/%d", (int) getpid ());
+	std::string const me = running + pid;
+
+	append (me, name);
+	char n[32];
+	snprintf (n, sizeof (n), "%zu", count_files (running));
+	append (dir + "/concurrency.log", n);
+	sleep (1);
+	unlink (me.c_str ());
+}
+
+static intptr_t
+dispatcher (AEffect* effect, int opcode, int index, intptr_t value, void* ptr, float opt)
+{
+	switch (opcode) {
+		case effClose:
+			delete effect;
+			return 1;
+		case effGetVendorString:
+			strcpy ((char*) ptr, "Ardour Test");
+			return 1;
+		case effGetPlugCategory:
+			return kPlugCategEffect;
+		case effGetVstVersion:
+			return 2400;
+		default:
+			break;
+	}
+	return 0;
+}
+
+static void
+process_replacing (AEffect* effect, float** in, float** out, int n_samples)
+{
+	for (int c = 0; c < 2; ++c) {
+		if (in[c] != out[c]) {
+			memcpy (out[c], in[c], n_samples * sizeof (float));
+		}
+	}
+}
+
+static void
+process (AEffect* effect, float** in, float** out, int n_samples)
+{
+	for (int c = 0; c < 2; ++c) {
+		for (int i = 0; i < n_samples; ++i) {
+			out[c][i] += in[c][i];
+		}
+	}
+}
+
+static void
+set_parameter (AEffect*, int, float)
+{
+}
+
+static float
+get_parameter (AEffect*, int)
+{
+	return 0;
+}
+
+extern "C" __attribute__ ((visibility ("default"))) AEffect*
+VSTPluginMain (audioMasterCallback)
+{
+	std::string const path = module_path ();
+
+	scan_test_hook (path);
+
+	AEffect* effect = new AEffect;
+	memset (effect, 0, sizeof (AEffect));
+
+	effect->magic            = kEffectMagic;
+	effect->dispatcher       = dispatcher;
+	effect->process          = process;
+	effect->processReplacing = process_replacing;
+	effect->setParameter     = set_parameter;
+	effect->getParameter     = get_parameter;
+	effect->numInputs        = 2;
+	effect->numOutputs       = 2;
+	effect->flags            = effFlagsCanReplacing;
+	effect->version          = 1;
+
+	/* copies of the plugin need distinct IDs */
+	int32_t id = CCONST ('A', 'd', 'T', 0);
+	for (std::string::const_iterator i = path.begin (); i != path.end (); ++i) {
+		id = id * 31 + *i;
+	}
+	effect->uniqueID = id;
+
+	return effect;
+}
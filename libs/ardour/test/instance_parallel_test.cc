@@ -0,0 +1,158 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "ardour/audio_buffer.h"
+#include "ardour/audioengine.h"
+#include "ardour/buffer_manager.h"
+#include "ardour/buffer_set.h"
+#include "ardour/plugin_insert.h"
+#include "ardour/plugin_manager.h"
+#include "ardour/process_thread.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/runtime_functions.h"
+#include "ardour/session.h"
+
+#include "instance_parallel_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (InstanceParallelTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+void
+InstanceParallelTest::setUp ()
+{
+	TestNeedingSession::setUp ();
+	/* process instances in parallel regardless of their DSP load */
+	Config->set_parallel_plugin_threshold (0);
+	PluginInsert::start_instance_workers ();
+}
+
+void
+InstanceParallelTest::tearDown ()
+{
+	Config->set_parallel_plugin_instances (false);
+	Config->set_parallel_plugin_threshold (100);
+	TestNeedingSession::tearDown ();
+}
+
+/* a mono FIR, replicated for two channels */
+static std::shared_ptr<PluginInsert>
+stereo_fir (Session& s)
+{
+	PluginPtr p;
+	PluginInfoList const& plugs = PluginManager::instance ().lua_plugin_info ();
+	for (PluginInfoList::const_iterator i = plugs.begin (); i != plugs.end (); ++i) {
+		if ((*i)->name == "Lua FIR Convolver") {
+			p = (*i)->load (s);
+			break;
+		}
+	}
+	CPPUNIT_ASSERT (p);
+
+	std::shared_ptr<PluginInsert> pi (new PluginInsert (s, s, p));
+	ChanCount in (DataType::AUDIO, 2);
+	ChanCount out;
+	CPPUNIT_ASSERT (pi->can_support_io_configuration (in, out));
+	CPPUNIT_ASSERT (pi->configure_io (in, out));
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 2, pi->get_count ());
+	pi->activate ();
+	return pi;
+}
+
+static void
+run (std::shared_ptr<PluginInsert> pi, Session& s, std::vector<Sample>* data, samplepos_t start, pframes_t n)
+{
+	BufferSet& bufs (s.get_route_buffers (ChanCount (DataType::AUDIO, 2), true));
+	bufs.set_count (ChanCount (DataType::AUDIO, 2));
+	for (uint32_t c = 0; c < 2; ++c) {
+		copy_vector (bufs.get_audio (c).data (), &data[c][0], n);
+	}
+	pi->run (bufs, start, start + n, 1, n, true);
+	for (uint32_t c = 0; c < 2; ++c) {
+		copy_vector (&data[c][0], bufs.get_audio (c).data (), n);
+	}
+}
+
+/** Replicated instances processed by the instance workers produce the
+ * same output as instances processed serially, also after the engine
+ * was restarted (which re-creates the workers).
+ */
+void
+InstanceParallelTest::compareTest ()
+{
+	pframes_t const block = _session->get_block_size ();
+
+	std::shared_ptr<PluginInsert> par = stereo_fir (*_session);
+	std::shared_ptr<PluginInsert> ser = stereo_fir (*_session);
+
+	BufferManager::reserve_thread_buffers (1);
+	ProcessThread* pt = new ProcessThread ();
+	pt->get_buffers ();
+
+	for (int cycle = 0; cycle < 32; ++cycle) {
+		if (cycle == 16) {
+			/* workers are joined when the engine stops, and re-created when it starts */
+			pt->drop_buffers ();
+			CPPUNIT_ASSERT_EQUAL (0, AudioEngine::instance ()->stop ());
+			CPPUNIT_ASSERT_EQUAL (0, AudioEngine::instance ()->start ());
+			pt->get_buffers ();
+		}
+
+		std::vector<Sample> in[2];
+		for (uint32_t c = 0; c < 2; ++c) {
+			in[c].resize (block);
+			for (pframes_t i = 0; i < block; ++i) {
+				in[c][i] = .5f * sinf ((cycle * block + i) * (.01f + c * .02f));
+			}
+		}
+
+		std::vector<Sample> out_par[2] = { in[0], in[1] };
+		std::vector<Sample> out_ser[2] = { in[0], in[1] };
+
+		Config->set_parallel_plugin_instances (true);
+		run (par, *_session, out_par, cycle * block, block);
+
+		Config->set_parallel_plugin_instances (false);
+		run (ser, *_session, out_ser, cycle * block, block);
+
+		for (uint32_t c = 0; c < 2; ++c) {
+			for (pframes_t i = 0; i < block; ++i) {
+				CPPUNIT_ASSERT_EQUAL (out_ser[c][i], out_par[c][i]);
+			}
+		}
+	}
+
+	pt->drop_buffers ();
+	delete pt;
+	BufferManager::release_thread_buffers (1);
+
+	double avg, parallel;
+	CPPUNIT_ASSERT (ser->get_instance_stats (avg, parallel));
+	CPPUNIT_ASSERT_EQUAL (0.0, parallel);
+
+	CPPUNIT_ASSERT (par->get_instance_stats (avg, parallel));
+	if (parallel == 0) {
+		/* without realtime privileges there are no workers */
+		cout << "InstanceParallelTest: no instance workers, parallel processing was not tested." << endl;
+	} else {
+		CPPUNIT_ASSERT_EQUAL (1.0, parallel);
+	}
+}
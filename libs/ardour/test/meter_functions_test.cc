@@ -0,0 +1,157 @@
+#include <cmath>
+#include <cstring>
+
+#include "pbd/compose.h"
+#include "pbd/fpu.h"
+#include "pbd/malign.h"
+#include "libs/ardour/ardour/mix.h"
+#include "meter_functions_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MeterFunctionsTest);
+
+using namespace ARDOUR;
+
+void
+MeterFunctionsTest::setUp ()
+{
+	for (uint32_t c = 0; c < max_chn; ++c) {
+		cache_aligned_malloc ((void**) &_buf[c], sizeof (float) * size);
+		for (uint32_t i = 0; i < size; ++i) {
+			_buf[c][i] = sinf (i * (c + 1) * .031f) * (1.f - i / (float) size) + ((i * 7 + c) % 13) * .01f;
+		}
+	}
+}
+
+void
+MeterFunctionsTest::tearDown ()
+{
+	for (uint32_t c = 0; c < max_chn; ++c) {
+		cache_aligned_free (_buf[c]);
+	}
+}
+
+static void
+compare (std::string const& what, float const* a, float const* b, uint32_t n_chn)
+{
+	for (uint32_t c = 0; c < n_chn; ++c) {
+#ifdef __FAST_MATH__
+		/* -ffast-math allows the compiler to reassociate the reference implementation */
+		float const max_diff = 1e-5f * std::max (1.f, fabsf (b[c]));
+		CPPUNIT_ASSERT_MESSAGE (string_compose ("%1 chn: %2 (%3 != %4)", what, c, a[c], b[c]), fabsf (a[c] - b[c]) <= max_diff);
+#else
+		CPPUNIT_ASSERT_MESSAGE (string_compose ("%1 chn: %2 (%3 != %4)", what, c, a[c], b[c]), 0 == memcmp (&a[c], &b[c], sizeof (float)));
+#endif
+	}
+}
+
+void
+MeterFunctionsTest::run (uint32_t n_chn, pframes_t nframes)
+{
+	std::string const ctx = string_compose ("n_chn: %1 nframes: %2", n_chn, nframes);
+
+	float const* bufs[max_chn];
+	for (uint32_t c = 0; c < n_chn; ++c) {
+		bufs[c] = _buf[c];
+	}
+
+	float z1[max_chn], z2[max_chn], z3[max_chn], z4[max_chn], m[max_chn], p[max_chn];
+	float r1[max_chn], r2[max_chn], r3[max_chn], r4[max_chn], rm[max_chn], rp[max_chn];
+
+	for (uint32_t c = 0; c < n_chn; ++c) {
+		z1[c] = r1[c] = .01f * c;
+		z2[c] = r2[c] = .02f * c;
+		z3[c] = r3[c] = 0;
+		z4[c] = r4[c] = 0;
+		m[c]  = rm[c] = 0;
+	}
+
+	kmeter_process (bufs, n_chn, nframes, .002f, z1, z2);
+	default_kmeter_process (bufs, n_chn, nframes, .002f, r1, r2);
+	compare ("K-meter z1 " + ctx, z1, r1, n_chn);
+	compare ("K-meter z2 " + ctx, z2, r2, n_chn);
+
+	ppm_process (bufs, n_chn, nframes, .2f, .05f, .999f, z1, z2, m);
+	default_ppm_process (bufs, n_chn, nframes, .2f, .05f, .999f, r1, r2, rm);
+	compare ("PPM z1 " + ctx, z1, r1, n_chn);
+	compare ("PPM z2 " + ctx, z2, r2, n_chn);
+	compare ("PPM max " + ctx, m, rm, n_chn);
+
+	vumeter_process (bufs, n_chn, nframes, .0002f, z1, z2, m);
+	default_vumeter_process (bufs, n_chn, nframes, .0002f, r1, r2, rm);
+	compare ("VU z1 " + ctx, z1, r1, n_chn);
+	compare ("VU z2 " + ctx, z2, r2, n_chn);
+	compare ("VU max " + ctx, m, rm, n_chn);
+
+	KWeightCoeff const kw = { 1.53f, -2.69f, 1.19f, -1.69f, .73f, .0059f, .0000087f };
+	kweight_process (bufs, n_chn, nframes > 3 ? nframes - 3 : 0, nframes > 3 ? 3 : 0, kw, z1, z2, z3, z4, p);
+	default_kweight_process (bufs, n_chn, nframes > 3 ? nframes - 3 : 0, nframes > 3 ? 3 : 0, kw, r1, r2, r3, r4, rp);
+	compare ("K-weight z1 " + ctx, z1, r1, n_chn);
+	compare ("K-weight z4 " + ctx, z4, r4, n_chn);
+	compare ("K-weight power " + ctx, p, rp, n_chn);
+
+	for (int x4 = 0; x4 < 2; ++x4) {
+		float* hist[max_chn];
+		float* ref[max_chn];
+		for (uint32_t c = 0; c < n_chn; ++c) {
+			hist[c] = new float[48];
+			ref[c]  = new float[48];
+			for (int i = 0; i < 48; ++i) {
+				hist[c][i] = ref[c][i] = _buf[c][size - 48 + i];
+			}
+		}
+
+		float pk = 0;
+		float rk = 0;
+		if (x4) {
+			true_peak_x4 (bufs, n_chn, nframes, hist, &pk);
+			default_true_peak_x4 (bufs, n_chn, nframes, ref, &rk);
+		} else {
+			true_peak_x2 (bufs, n_chn, nframes, hist, &pk);
+			default_true_peak_x2 (bufs, n_chn, nframes, ref, &rk);
+		}
+		compare (string_compose ("True peak x%1 %2", x4 ? 4 : 2, ctx), &pk, &rk, 1);
+
+		for (uint32_t c = 0; c < n_chn; ++c) {
+			CPPUNIT_ASSERT_MESSAGE ("True peak history " + ctx, 0 == memcmp (hist[c], ref[c], 48 * sizeof (float)));
+			delete[] hist[c];
+			delete[] ref[c];
+		}
+	}
+}
+
+#if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
+
+void
+MeterFunctionsTest::sseTest ()
+{
+	PBD::FPU* fpu = PBD::FPU::instance ();
+	if (!fpu->has_sse ()) {
+		printf ("SSE is not available at run-time\n");
+		return;
+	}
+
+	kmeter_process  = x86_sse_kmeter_process;
+	ppm_process     = x86_sse_ppm_process;
+	vumeter_process = x86_sse_vumeter_process;
+	kweight_process = x86_sse_kweight_process;
+	true_peak_x2    = x86_sse_true_peak_x2;
+	true_peak_x4    = x86_sse_true_peak_x4;
+
+	pframes_t const nframes[] = { 0, 1, 3, 4, 17, 64, 1023 };
+
+	for (uint32_t n_chn = 1; n_chn <= max_chn; ++n_chn) {
+		for (size_t i = 0; i < sizeof (nframes) / sizeof (pframes_t); ++i) {
+			run (n_chn, nframes[i]);
+		}
+	}
+}
+
+#else
+
+void
+MeterFunctionsTest::noTest ()
+{
+	printf ("HW optimized meter kernels are not available for this architecture\n");
+}
+
+#endif
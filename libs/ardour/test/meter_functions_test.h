@@ -0,0 +1,40 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "ardour/runtime_functions.h"
+
+class MeterFunctionsTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (MeterFunctionsTest);
+#if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
+	CPPUNIT_TEST (sseTest);
+#else
+	CPPUNIT_TEST (noTest);
+#endif
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+#if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
+	void sseTest ();
+#else
+	void noTest ();
+#endif
+
+private:
+	void run (uint32_t n_chn, ARDOUR::pframes_t nframes);
+
+	ARDOUR::kmeter_process_t  kmeter_process;
+	ARDOUR::ppm_process_t     ppm_process;
+	ARDOUR::vumeter_process_t vumeter_process;
+	ARDOUR::kweight_process_t kweight_process;
+	ARDOUR::true_peak_t       true_peak_x2;
+	ARDOUR::true_peak_t       true_peak_x4;
+
+	static const uint32_t max_chn = 9;
+	static const uint32_t size    = 1024;
+
+	float* _buf[max_chn];
+};
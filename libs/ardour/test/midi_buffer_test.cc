@@ -0,0 +1,109 @@
+#include "ardour/midi_buffer.h"
+
+#include "midi_buffer_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MidiBufferTest);
+
+using namespace ARDOUR;
+
+static void
+add_cc (MidiBuffer& buf, samplepos_t when, uint8_t value)
+{
+	uint8_t cc[3] = { 0xb0, 0x01, value };
+	buf.push_back (when, Evoral::MIDI_EVENT, 3, cc);
+}
+
+static size_t
+n_events (MidiBuffer const& buf)
+{
+	size_t n = 0;
+	for (MidiBuffer::const_iterator i = buf.begin (); i != buf.end (); ++i) {
+		++n;
+	}
+	return n;
+}
+
+static bool
+is_sorted (MidiBuffer const& buf)
+{
+	samplepos_t last = 0;
+	for (MidiBuffer::const_iterator i = buf.begin (); i != buf.end (); ++i) {
+		if ((*i).time () < last) {
+			return false;
+		}
+		last = (*i).time ();
+	}
+	return true;
+}
+
+void
+MidiBufferTest::mergeTest ()
+{
+	MidiBuffer a (4096);
+	MidiBuffer b (4096);
+
+	for (samplepos_t t = 0; t < 100; t += 2) {
+		add_cc (a, t, 0);
+		add_cc (b, t + 1, 1);
+	}
+	/* trailing block that is later than anything in a */
+	for (samplepos_t t = 200; t < 210; ++t) {
+		add_cc (b, t, 2);
+	}
+
+	CPPUNIT_ASSERT (a.merge_in_place (b));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 110, n_events (a));
+	CPPUNIT_ASSERT (is_sorted (a));
+
+	/* merging into an empty buffer is a copy */
+	MidiBuffer c (4096);
+	CPPUNIT_ASSERT (c.merge_in_place (b));
+	CPPUNIT_ASSERT_EQUAL (b.size (), c.size ());
+
+	/* merge that exceeds capacity fails and leaves the buffer intact */
+	MidiBuffer d (64);
+	add_cc (d, 0, 0);
+	size_t sz = d.size ();
+	CPPUNIT_ASSERT (!d.merge_in_place (b));
+	CPPUNIT_ASSERT_EQUAL (sz, d.size ());
+}
+
+void
+MidiBufferTest::simultaneousTest ()
+{
+	MidiBuffer a (1024);
+	MidiBuffer b (1024);
+
+	uint8_t note_on[3] = { 0x90, 60, 100 };
+	a.push_back (10, Evoral::MIDI_EVENT, 3, note_on);
+	add_cc (b, 10, 64);
+
+	CPPUNIT_ASSERT (a.merge_in_place (b));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 2, n_events (a));
+
+	/* controller messages precede notes on the same channel */
+	MidiBuffer::const_iterator i = a.begin ();
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0xb0, (*i).buffer ()[0]);
+	++i;
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0x90, (*i).buffer ()[0]);
+}
+
+void
+MidiBufferTest::silenceTest ()
+{
+	MidiBuffer a (4096);
+
+	for (samplepos_t t = 0; t < 100; ++t) {
+		add_cc (a, t, (uint8_t) t);
+	}
+
+	a.silence (50, 25);
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 50, n_events (a));
+	CPPUNIT_ASSERT (is_sorted (a));
+
+	for (MidiBuffer::const_iterator i = a.begin (); i != a.end (); ++i) {
+		CPPUNIT_ASSERT ((*i).time () < 25 || (*i).time () >= 75);
+		CPPUNIT_ASSERT_EQUAL ((uint8_t) (*i).time (), (*i).buffer ()[2]);
+	}
+}
@@ -0,0 +1,16 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MidiBufferTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (MidiBufferTest);
+	CPPUNIT_TEST (mergeTest);
+	CPPUNIT_TEST (simultaneousTest);
+	CPPUNIT_TEST (silenceTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void mergeTest ();
+	void simultaneousTest ();
+	void silenceTest ();
+};
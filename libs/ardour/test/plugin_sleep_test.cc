@@ -0,0 +1,160 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "ardour/audio_buffer.h"
+#include "ardour/buffer_manager.h"
+#include "ardour/buffer_set.h"
+#include "ardour/plugin_insert.h"
+#include "ardour/plugin_manager.h"
+#include "ardour/process_thread.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/runtime_functions.h"
+#include "ardour/session.h"
+
+#include "plugin_sleep_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PluginSleepTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+void
+PluginSleepTest::setUp ()
+{
+	TestNeedingSession::setUp ();
+	Config->set_sleep_silent_plugins (true);
+}
+
+void
+PluginSleepTest::tearDown ()
+{
+	Config->set_sleep_silent_plugins (false);
+	TestNeedingSession::tearDown ();
+}
+
+/* FIR with impulse-response { 1.5, -0.5 }: a tail of one sample */
+static std::shared_ptr<PluginInsert>
+fir_plugin (Session& s)
+{
+	PluginPtr p;
+	PluginInfoList const& plugs = PluginManager::instance ().lua_plugin_info ();
+	for (PluginInfoList::const_iterator i = plugs.begin (); i != plugs.end (); ++i) {
+		if ((*i)->name == "Lua FIR Convolver") {
+			p = (*i)->load (s);
+			break;
+		}
+	}
+	CPPUNIT_ASSERT (p);
+
+	std::shared_ptr<PluginInsert> pi (new PluginInsert (s, s, p));
+	ChanCount in (DataType::AUDIO, 1);
+	ChanCount out;
+	CPPUNIT_ASSERT (pi->can_support_io_configuration (in, out));
+	CPPUNIT_ASSERT (pi->configure_io (in, out));
+	pi->activate ();
+	return pi;
+}
+
+static void
+run (std::shared_ptr<PluginInsert> pi, Session& s, std::vector<Sample>& data, samplepos_t start, pframes_t n)
+{
+	BufferSet& bufs (s.get_route_buffers (ChanCount (DataType::AUDIO, 1), true));
+	bufs.set_count (ChanCount (DataType::AUDIO, 1));
+	copy_vector (bufs.get_audio (0).data (), &data[0], n);
+	pi->run (bufs, start, start + n, 1, n, true);
+	copy_vector (&data[0], bufs.get_audio (0).data (), n);
+}
+
+/** A plugin goes to sleep only after its tail was rendered, and wakes up
+ * in the first cycle with input. The output is the same as that of a
+ * plugin which never sleeps.
+ */
+void
+PluginSleepTest::sleepWakeTest ()
+{
+	pframes_t const block = _session->get_block_size ();
+
+	std::shared_ptr<PluginInsert> pi  = fir_plugin (*_session);
+	std::shared_ptr<PluginInsert> ref = fir_plugin (*_session);
+
+	pi->set_user_tailtime (block);
+	ref->set_user_tailtime (1 << 30);
+
+	samplecnt_t const settle = pi->effective_latency () + pi->effective_tailtime ();
+
+	BufferManager::reserve_thread_buffers (1);
+	ProcessThread* pt = new ProcessThread ();
+	pt->get_buffers ();
+
+	/* signal, silence until asleep, signal (onset), silence */
+	std::vector<bool> has_input;
+	has_input.push_back (true);
+	for (samplecnt_t n = 0; n <= settle + block; n += block) {
+		has_input.push_back (false);
+	}
+	has_input.push_back (true);
+	has_input.push_back (false);
+
+	samplecnt_t silent   = 0;
+	bool        did_tail = false;
+	bool        did_wake = false;
+
+	for (size_t c = 0; c < has_input.size (); ++c) {
+		std::vector<Sample> in (block, 0.f);
+		if (has_input[c]) {
+			for (pframes_t i = 0; i < block; ++i) {
+				in[i] = .5f * sinf ((c * block + i) * .05f) + .1f;
+			}
+		}
+
+		std::vector<Sample> out (in);
+		std::vector<Sample> out_ref (in);
+
+		bool const was_asleep = pi->asleep ();
+
+		run (pi, *_session, out, c * block, block);
+		run (ref, *_session, out_ref, c * block, block);
+
+		/* the plugin sleeps once latency + tail-time of silence were processed */
+		bool const asleep = !has_input[c] && silent >= settle;
+		silent = has_input[c] ? 0 : silent + block;
+
+		CPPUNIT_ASSERT_EQUAL (asleep, pi->asleep ());
+		CPPUNIT_ASSERT (!ref->asleep ());
+
+		/* until then the output, including the tail, is fully rendered */
+		for (pframes_t i = 0; i < block; ++i) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (out_ref[i], out[i], 1e-6);
+			did_tail |= !has_input[c] && !asleep && fabsf (out[i]) > 1e-6;
+		}
+
+		/* the onset wakes the plugin up */
+		if (was_asleep && has_input[c]) {
+			CPPUNIT_ASSERT (!pi->asleep ());
+			did_wake = true;
+		}
+	}
+
+	CPPUNIT_ASSERT (did_tail);
+	CPPUNIT_ASSERT (did_wake);
+
+	pt->drop_buffers ();
+	delete pt;
+	BufferManager::release_thread_buffers (1);
+}
@@ -1,7 +1,27 @@
+#include <algorithm>
+#include <ctime>
 #include <iostream>
+#include <set>
+#include <sstream>
 
+#include <utime.h>
+
+#include <glib.h>
+#include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
+
+#include "pbd/compose.h"
+#include "pbd/file_utils.h"
+#include "pbd/gstdio_compat.h"
+
+#include "libardour-config.h"
+
+#include "ardour/ardour.h"
+#include "ardour/filesystem_paths.h"
 #include "ardour/plugin_manager.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/search_paths.h"
+#include "ardour/vst2_scan.h"
 
 #include "plugins_test.h"
 #include "test_util.h"
@@ -54,3 +74,164 @@ PluginsTest::test ()
 
 	stop_and_destroy_backend ();
 }
+
+#if defined LXVST_SUPPORT && !defined PLATFORM_WINDOWS
+
+/* The dummy_lxvst plugin (see dummy_lxvst_plugin.cc) is scanned by
+ * ardour-vst-scanner. Since a folder "running/" exists next to it,
+ * each instantiation takes 1 second, and is logged to "scanned.log"
+ * and "concurrency.log". Copies named "hang*.so" never finish.
+ */
+static std::string
+add_plugin (std::string const& fixture, std::string const& dir, std::string const& name)
+{
+	std::string const path = Glib::build_filename (dir, name + ".so");
+	copy_file (fixture, path);
+
+	/* pretend the plugin was installed a while ago */
+	struct utimbuf tb;
+	tb.actime = tb.modtime = time (NULL) - 3600;
+	g_utime (path.c_str (), &tb);
+	return path;
+}
+
+/** @return the number of plugins that were scanned */
+static size_t
+count_scans (std::string const& dir)
+{
+	std::string const log = Glib::build_filename (dir, "scanned.log");
+	if (!Glib::file_test (log, Glib::FILE_TEST_EXISTS)) {
+		return 0;
+	}
+	std::stringstream ss (Glib::file_get_contents (log));
+	::g_unlink (log.c_str ());
+
+	std::set<std::string> scanned;
+	std::string           name;
+	while (ss >> name) {
+		scanned.insert (name);
+	}
+	return scanned.size ();
+}
+
+/** @return the maximum number of scanners that ran concurrently */
+static size_t
+max_concurrent_scans (std::string const& dir)
+{
+	std::string const log = Glib::build_filename (dir, "concurrency.log");
+	if (!Glib::file_test (log, Glib::FILE_TEST_EXISTS)) {
+		return 0;
+	}
+	std::stringstream ss (Glib::file_get_contents (log));
+	::g_unlink (log.c_str ());
+
+	size_t n;
+	size_t rv = 0;
+	while (ss >> n) {
+		rv = std::max (rv, n);
+	}
+	return rv;
+}
+
+static void
+enable_timeout (std::string, std::string, bool)
+{
+	PluginManager::instance ().enable_scan_timeout ();
+}
+
+static PluginInfoPtr
+find_plugin (std::string const& path)
+{
+	PluginInfoList const& plugins = PluginManager::instance ().lxvst_plugin_info ();
+	for (PluginInfoList::const_iterator i = plugins.begin (); i != plugins.end (); ++i) {
+		if ((*i)->path == path) {
+			return *i;
+		}
+	}
+	return PluginInfoPtr ();
+}
+
+void
+PluginsTest::scanTest ()
+{
+	std::string const fixture = Glib::build_filename (ardour_dll_directory (), "ardour", "test", "dummy_lxvst.so");
+
+	if (PluginManager::vst2_scanner_bin_path.empty () || !Glib::file_test (fixture, Glib::FILE_TEST_EXISTS)) {
+		cout << "ardour-vst-scanner or the dummy_lxvst plugin was not found, skipping the scan test" << endl;
+		return;
+	}
+
+	std::string const dir = new_test_output_dir ("plugin_scan");
+	std::string const running = Glib::build_filename (dir, "running");
+	g_mkdir_with_parents (running.c_str (), 0755);
+
+	Config->set_use_lxvst (true);
+	Config->set_plugin_path_lxvst (dir);
+	Config->set_plugin_scan_timeout (20);
+
+	std::vector<std::string> plugins;
+	for (int i = 0; i < 6; ++i) {
+		plugins.push_back (add_plugin (fixture, dir, string_compose ("plugin%1", i)));
+	}
+	std::string const hang = add_plugin (fixture, dir, "hang");
+
+	PluginManager& pm = PluginManager::instance ();
+
+	PBD::ScopedConnection c;
+	PluginScanMessage.connect_same_thread (c, std::bind (&enable_timeout, _1, _2, _3));
+
+	/* one scanner at a time */
+	Config->set_plugin_scan_jobs (1);
+	pm.refresh (false);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 7, count_scans (dir));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1, max_concurrent_scans (dir));
+
+	pm.clear_vst_cache ();
+
+	/* up to 4 at once, the hanging plugin must not block the others */
+	Config->set_plugin_scan_jobs (4);
+	pm.refresh (false);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 7, count_scans (dir));
+
+	size_t const concurrent = max_concurrent_scans (dir);
+	CPPUNIT_ASSERT (concurrent > 1);
+	CPPUNIT_ASSERT (concurrent <= 4);
+
+	/* the scan results */
+	for (std::vector<std::string>::const_iterator i = plugins.begin (); i != plugins.end (); ++i) {
+		CPPUNIT_ASSERT (!vst2_valid_cache_file (*i).empty ());
+
+		PluginInfoPtr pi = find_plugin (*i);
+		CPPUNIT_ASSERT (pi);
+		CPPUNIT_ASSERT_EQUAL (Glib::path_get_basename (*i).substr (0, 7), pi->name);
+		CPPUNIT_ASSERT_EQUAL (std::string ("Ardour Test"), pi->creator);
+		CPPUNIT_ASSERT_EQUAL ((uint32_t) 2, pi->n_inputs.n_audio ());
+		CPPUNIT_ASSERT_EQUAL ((uint32_t) 2, pi->n_outputs.n_audio ());
+	}
+	CPPUNIT_ASSERT (vst2_valid_cache_file (hang).empty ());
+	CPPUNIT_ASSERT (!find_plugin (hang));
+
+	::g_unlink (hang.c_str ());
+
+	/* nothing changed, nothing to scan */
+	pm.refresh (false);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, count_scans (dir));
+
+	/* only re-scan modified plugins */
+	g_utime (plugins[2].c_str (), NULL);
+	g_utime (plugins[4].c_str (), NULL);
+	pm.refresh (false);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 2, count_scans (dir));
+
+	pm.clear_vst_cache ();
+	Config->set_plugin_path_lxvst ("");
+}
+
+#else
+
+void
+PluginsTest::scanTest ()
+{
+}
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <regex.h>
+
+#include "ardour/audioengine.h"
+#include "ardour/port_engine_shared.h"
+
+#include "port_pattern_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PortPatternTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+void
+PortPatternTest::classifyTest ()
+{
+	std::string lit;
+
+	CPPUNIT_ASSERT_EQUAL (PortEngineSharedImpl::PatternAll, PortEngineSharedImpl::classify_port_pattern ("", lit));
+
+	CPPUNIT_ASSERT_EQUAL (PortEngineSharedImpl::PatternExact, PortEngineSharedImpl::classify_port_pattern ("^system:capture_1$", lit));
+	CPPUNIT_ASSERT_EQUAL (std::string ("system:capture_1"), lit);
+
+	CPPUNIT_ASSERT_EQUAL (PortEngineSharedImpl::PatternPrefix, PortEngineSharedImpl::classify_port_pattern ("^system:", lit));
+	CPPUNIT_ASSERT_EQUAL (std::string ("system:"), lit);
+
+	CPPUNIT_ASSERT_EQUAL (PortEngineSharedImpl::PatternSuffix, PortEngineSharedImpl::classify_port_pattern ("audio_out 1$", lit));
+	CPPUNIT_ASSERT_EQUAL (std::string ("audio_out 1"), lit);
+
+	CPPUNIT_ASSERT_EQUAL (PortEngineSharedImpl::PatternSubstring, PortEngineSharedImpl::classify_port_pattern ("capture", lit));
+	CPPUNIT_ASSERT_EQUAL (std::string ("capture"), lit);
+
+	/* any regex meta-character requires a regex */
+	CPPUNIT_ASSERT_EQUAL (PortEngineSharedImpl::PatternRegex, PortEngineSharedImpl::classify_port_pattern ("^system:capture_.$", lit));
+	CPPUNIT_ASSERT_EQUAL (PortEngineSharedImpl::PatternRegex, PortEngineSharedImpl::classify_port_pattern ("^(a|b)", lit));
+	CPPUNIT_ASSERT_EQUAL (PortEngineSharedImpl::PatternRegex, PortEngineSharedImpl::classify_port_pattern ("capture_[0-9]+", lit));
+	CPPUNIT_ASSERT_EQUAL (PortEngineSharedImpl::PatternRegex, PortEngineSharedImpl::classify_port_pattern ("a\\.b", lit));
+	CPPUNIT_ASSERT_EQUAL (PortEngineSharedImpl::PatternRegex, PortEngineSharedImpl::classify_port_pattern ("^^a", lit));
+	CPPUNIT_ASSERT_EQUAL (PortEngineSharedImpl::PatternRegex, PortEngineSharedImpl::classify_port_pattern ("a$$", lit));
+	CPPUNIT_ASSERT_EQUAL (PortEngineSharedImpl::PatternRegex, PortEngineSharedImpl::classify_port_pattern ("^$", lit));
+}
+
+/* what get_ports() returned before, when every pattern was a regex */
+static std::vector<std::string>
+regex_ports (std::vector<std::string> const& all, std::string const& pattern)
+{
+	std::vector<std::string> rv;
+	regex_t re;
+	CPPUNIT_ASSERT_EQUAL (0, regcomp (&re, pattern.c_str (), REG_EXTENDED|REG_NOSUB));
+	for (auto const& n : all) {
+		if (!regexec (&re, n.c_str (), 0, NULL, 0)) {
+			rv.push_back (n);
+		}
+	}
+	regfree (&re);
+	return rv;
+}
+
+void
+PortPatternTest::getPortsTest ()
+{
+	PortEngine& pe (AudioEngine::instance ()->port_engine ());
+
+	DataType const  types[] = { DataType::AUDIO, DataType::MIDI };
+	PortFlags const flags[] = { PortFlags (0), IsOutput, IsInput, PortFlags (IsOutput | IsPhysical) };
+
+	for (size_t t = 0; t < 2; ++t) {
+		for (size_t f = 0; f < 4; ++f) {
+			std::vector<std::string> all;
+			pe.get_ports ("", types[t], flags[f], all);
+
+			std::vector<std::string> patterns;
+			patterns.push_back ("capture");
+			patterns.push_back ("^system:");
+			patterns.push_back ("^system:capture_1");
+			patterns.push_back ("^system:capture_1$");
+			patterns.push_back ("_1$");
+			patterns.push_back ("^system:(capture|playback)_[0-9]+$");
+			patterns.push_back ("^no such port$");
+			/* patterns derived from existing names */
+			for (auto const& n : all) {
+				if (n.find_first_of (".[]()*+?{}|^$\\") != std::string::npos) {
+					continue;
+				}
+				patterns.push_back ("^" + n + "$");
+				patterns.push_back ("^" + n.substr (0, n.size () / 2));
+				patterns.push_back (n.substr (n.size () / 2) + "$");
+				patterns.push_back (n.substr (1, n.size () / 2));
+			}
+
+			for (auto const& p : patterns) {
+				std::vector<std::string> ports;
+				int n = pe.get_ports (p, types[t], flags[f], ports);
+
+				std::vector<std::string> expected = regex_ports (all, p);
+				CPPUNIT_ASSERT_EQUAL ((int) expected.size (), n);
+				CPPUNIT_ASSERT (expected == ports);
+			}
+		}
+	}
+}
@@ -0,0 +1,144 @@
+/* Measure the DSP load and garbage-collection time of many Lua DSP
+ * instances, with the default per-cycle GC step and with a GC budget.
+ *
+ *   lua_dsp_gc [instances] [seconds] [budget-us]
+ */
+
+#include <cstdlib>
+#include <iostream>
+
+#include <glibmm/miscutils.h>
+#include <glibmm/timer.h>
+
+#include "test_ui.h"
+#include "test_util.h"
+
+#include "pbd/compose.h"
+
+#include "ardour/ardour.h"
+#include "ardour/audio_track.h"
+#include "ardour/audioengine.h"
+#include "ardour/luaproc.h"
+#include "ardour/plugin_insert.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/session.h"
+
+using namespace std;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/* copies audio to a Lua table and back, allocating memory every cycle */
+static const char* script = "\
+ardour { ['type'] = 'dsp', name = 'GC Benchmark' }\n\
+function dsp_ioconfig () return { [1] = { audio_in = -1, audio_out = -1 }, } end\n\
+function dsp_configure (ins, outs) audio_ins = ins:n_audio () end\n\
+function dsp_runmap (bufs, in_map, out_map, n_samples, offset)\n\
+	for c = 1, audio_ins do\n\
+		local ib = in_map:get (ARDOUR.DataType ('audio'), c - 1)\n\
+		local ob = out_map:get (ARDOUR.DataType ('audio'), c - 1)\n\
+		local a = bufs:get_audio (ib):data (offset):get_table (n_samples)\n\
+		for s = 1, n_samples do a[s] = a[s] * 0.5 end\n\
+		bufs:get_audio (ob):data (offset):set_table (a, n_samples)\n\
+	end\n\
+end\n\
+";
+
+static void
+measure (int seconds, float& avg, float& max)
+{
+	AudioEngine* engine = AudioEngine::instance ();
+
+	/* settle */
+	Glib::usleep (500000);
+
+	int   n   = 0;
+	float sum = 0;
+	max = 0;
+
+	for (int i = 0; i < seconds * 100; ++i) {
+		Glib::usleep (10000);
+		float const load = engine->get_dsp_load ();
+		sum += load;
+		max = std::max (max, load);
+		++n;
+	}
+
+	avg = n > 0 ? sum / n : 0;
+}
+
+int
+main (int argc, char* argv[])
+{
+	int const      instances = argc > 1 ? atoi (argv[1]) : 64;
+	int const      seconds   = argc > 2 ? atoi (argv[2]) : 5;
+	uint32_t const budget    = argc > 3 ? atoi (argv[3]) : 50;
+
+	ARDOUR::init (true, localedir);
+	TestUI* test_ui = new TestUI();
+	create_and_start_dummy_backend ();
+
+	AudioEngine* engine = AudioEngine::instance ();
+
+	std::string const dir = Glib::build_filename (new_test_output_dir ("lua_dsp_gc"), "lua_dsp_gc");
+	Session* session = new Session (*engine, dir, "lua_dsp_gc");
+	engine->set_session (session);
+
+	LuaScriptInfoPtr lsi (new LuaScriptInfo (LuaScriptInfo::DSP, "GC Benchmark", "", "urn:ardour:lua-dsp-gc"));
+	PluginInfoPtr    pi (new LuaPluginInfo (lsi));
+
+	list<std::shared_ptr<AudioTrack> > tracks = session->new_audio_track (2, 2, 0, instances, "lua", PresentationInfo::max_order, Normal, false);
+	vector<std::shared_ptr<LuaProc> >  procs;
+
+	for (list<std::shared_ptr<AudioTrack> >::const_iterator t = tracks.begin (); t != tracks.end (); ++t) {
+		std::shared_ptr<LuaProc> lp (new LuaProc (*engine, *session, script));
+		lp->set_info (pi);
+		(*t)->add_processor (std::shared_ptr<Processor> (new PluginInsert (*session, **t, lp)), PreFader);
+		procs.push_back (lp);
+	}
+
+	cout << string_compose ("%1 Lua DSP instances, %2 samples/cycle\n", procs.size (), engine->samples_per_cycle ());
+
+	session->request_roll ();
+
+	for (int pass = 0; pass < 2; ++pass) {
+		Config->set_lua_dsp_gc_budget (pass ? budget : 0);
+
+		for (vector<std::shared_ptr<LuaProc> >::const_iterator p = procs.begin (); p != procs.end (); ++p) {
+			(*p)->reset_gc_stats ();
+		}
+
+		float avg, max;
+		measure (seconds, avg, max);
+
+		int64_t  gc_avg   = 0;
+		int64_t  gc_max   = 0;
+		uint64_t spread   = 0;
+		size_t   peak     = 0;
+		size_t   pool     = 0;
+
+		for (vector<std::shared_ptr<LuaProc> >::const_iterator p = procs.begin (); p != procs.end (); ++p) {
+			LuaProc::GCStats const s = (*p)->gc_stats ();
+			gc_avg += s.avg_us;
+			gc_max  = std::max (gc_max, s.max_us);
+			spread += s.spread;
+			peak = std::max (peak, s.mem_peak);
+			pool = s.pool_size;
+		}
+
+		cout << string_compose ("budget %1 us: DSP load avg: %2%% max: %3%%\n", pass ? budget : 0, avg, max);
+		cout << string_compose ("  GC per cycle, all instances avg: %1 us, single instance max: %2 us, spread GC cycles: %3\n", gc_avg, gc_max, spread);
+		cout << string_compose ("  peak memory per instance: %1 of %2 bytes\n", peak, pool);
+	}
+
+	session->request_stop ();
+	Glib::usleep (100000);
+
+	procs.clear ();
+	engine->remove_session ();
+	delete session;
+	stop_and_destroy_backend ();
+	delete test_ui;
+	ARDOUR::cleanup ();
+	return 0;
+}
@@ -0,0 +1,87 @@
+#include <cstdio>
+#include <cstdlib>
+#include <inttypes.h>
+#include <vector>
+
+#include "pbd/timing.h"
+
+#include "ardour/ardour.h"
+#include "ardour/midi_buffer.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+static const char* localedir = LOCALEDIR;
+
+/* merge 16 dense MIDI streams (10k events per cycle in total) into a
+ * single buffer, as done when several MIDI tracks feed a bus.
+ */
+int
+main (int argc, char* argv[])
+{
+	const size_t n_inputs   = 16;
+	const size_t n_events   = 10000;
+	const size_t n_cycles   = argc > 1 ? atoi (argv[1]) : 1000;
+	const samplecnt_t block = 1024;
+	const size_t capacity   = n_events * 16;
+
+	ARDOUR::init (true, localedir);
+
+	vector<MidiBuffer*> inputs;
+	for (size_t i = 0; i < n_inputs; ++i) {
+		MidiBuffer* mb = new MidiBuffer (capacity);
+		for (size_t e = 0; e < n_events / n_inputs; ++e) {
+			/* high resolution CC, each stream with a different phase */
+			uint8_t cc[3] = { (uint8_t) (0xb0 | (i & 0xf)), 1, (uint8_t) (e & 0x7f) };
+			mb->push_back ((e * block + i * 7) * n_inputs / n_events, Evoral::MIDI_EVENT, 3, cc);
+		}
+		inputs.push_back (mb);
+	}
+
+	MidiBuffer out (capacity);
+	TimingStats merge_stats;
+
+	for (size_t c = 0; c < n_cycles; ++c) {
+		out.clear ();
+		merge_stats.start ();
+		for (vector<MidiBuffer*>::const_iterator i = inputs.begin (); i != inputs.end (); ++i) {
+			out.merge_from (**i, block);
+		}
+		merge_stats.update ();
+	}
+
+	microseconds_t min, max;
+	double avg, dev;
+
+	if (merge_stats.get_stats (min, max, avg, dev)) {
+		printf ("merge %zu x %zu events: min %" PRId64 " max %" PRId64 " avg %.1f dev %.1f [usec]\n",
+		        n_inputs, n_events / n_inputs, min, max, avg, dev);
+	}
+
+	/* same data, inserting event by event (e.g. DelayLine, EventSink::write) */
+	TimingStats insert_stats;
+
+	for (size_t c = 0; c < n_cycles / 10; ++c) {
+		out.clear ();
+		insert_stats.start ();
+		for (vector<MidiBuffer*>::const_iterator i = inputs.begin (); i != inputs.end (); ++i) {
+			for (MidiBuffer::const_iterator e = (*i)->begin (); e != (*i)->end (); ++e) {
+				out.insert_event (*e);
+			}
+		}
+		insert_stats.update ();
+	}
+
+	if (insert_stats.get_stats (min, max, avg, dev)) {
+		printf ("insert %zu x %zu events: min %" PRId64 " max %" PRId64 " avg %.1f dev %.1f [usec]\n",
+		        n_inputs, n_events / n_inputs, min, max, avg, dev);
+	}
+
+	for (vector<MidiBuffer*>::iterator i = inputs.begin (); i != inputs.end (); ++i) {
+		delete *i;
+	}
+
+	ARDOUR::cleanup ();
+	return 0;
+}
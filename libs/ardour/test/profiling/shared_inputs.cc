@@ -0,0 +1,115 @@
+/* Measure the DSP load of resampling input ports in vari-speed mode, with
+ * and without sharing the resampled data of ports that are connected to
+ * the same physical input.
+ *
+ *   shared_inputs [tracks-per-input] [seconds]
+ */
+
+#include <cstdlib>
+#include <iostream>
+
+#include <glibmm/miscutils.h>
+#include <glibmm/timer.h>
+
+#include "test_ui.h"
+#include "test_util.h"
+
+#include "pbd/compose.h"
+
+#include "ardour/ardour.h"
+#include "ardour/audio_port.h"
+#include "ardour/audio_track.h"
+#include "ardour/audioengine.h"
+#include "ardour/io.h"
+#include "ardour/session.h"
+
+using namespace std;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+static void
+measure (int seconds, float& avg, float& max)
+{
+	AudioEngine* engine = AudioEngine::instance ();
+
+	/* settle */
+	Glib::usleep (500000);
+
+	int   n   = 0;
+	float sum = 0;
+	max = 0;
+
+	for (int i = 0; i < seconds * 100; ++i) {
+		Glib::usleep (10000);
+		float const load = engine->get_dsp_load ();
+		sum += load;
+		max = std::max (max, load);
+		++n;
+	}
+
+	avg = n > 0 ? sum / n : 0;
+}
+
+int
+main (int argc, char* argv[])
+{
+	int const per_input = argc > 1 ? atoi (argv[1]) : 4;
+	int const seconds   = argc > 2 ? atoi (argv[2]) : 5;
+
+	ARDOUR::init (true, localedir);
+	TestUI* test_ui = new TestUI();
+	create_and_start_dummy_backend ();
+
+	AudioEngine* engine = AudioEngine::instance ();
+
+	std::string const dir = Glib::build_filename (new_test_output_dir ("shared_inputs"), "shared_inputs");
+	Session* session = new Session (*engine, dir, "shared_inputs");
+	engine->set_session (session);
+
+	vector<string> physical;
+	engine->get_physical_inputs (DataType::AUDIO, physical);
+
+	if (physical.empty ()) {
+		cerr << "No physical inputs\n";
+		exit (EXIT_FAILURE);
+	}
+
+	list<std::shared_ptr<AudioTrack> > tracks = session->new_audio_track (1, 2, 0, physical.size () * per_input, "in", PresentationInfo::max_order, Normal, false);
+
+	int n = 0;
+	for (list<std::shared_ptr<AudioTrack> >::const_iterator t = tracks.begin (); t != tracks.end (); ++t, ++n) {
+		if ((*t)->input ()->audio (0)->connect (physical[n % physical.size ()])) {
+			cerr << string_compose ("Cannot connect track '%1' to '%2'\n", (*t)->name (), physical[n % physical.size ()]);
+			exit (EXIT_FAILURE);
+		}
+	}
+
+	cout << string_compose ("%1 physical inputs, %2 tracks, %3 samples/cycle\n", physical.size (), tracks.size (), engine->samples_per_cycle ());
+
+	/* vari-speed: resample all ports */
+	session->request_transport_speed (1.05);
+	session->request_roll ();
+
+	float avg[2];
+	float max[2];
+
+	for (int share = 0; share < 2; ++share) {
+		engine->set_share_resampled_inputs (share);
+		measure (seconds, avg[share], max[share]);
+		cout << string_compose ("%1: %2 shared ports, DSP load avg: %3%% max: %4%%\n",
+		                        share ? "shared  " : "separate", engine->n_shared_inputs (), avg[share], max[share]);
+	}
+
+	cout << string_compose ("saved DSP load: %1%%\n", avg[0] - avg[1]);
+
+	session->request_stop ();
+	Glib::usleep (100000);
+
+	engine->remove_session ();
+	delete session;
+	stop_and_destroy_backend ();
+	delete test_ui;
+	ARDOUR::cleanup ();
+	return 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
+
+#include "ardour/audioregion.h"
+#include "ardour/audiosource.h"
+#include "ardour/region_factory.h"
+#include "ardour/session.h"
+#include "ardour/source_factory.h"
+
+#include "region_analysis_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (RegionAnalysisTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+/* The fast paths of the analysis (peakfiles, cached block statistics)
+ * must give the same result as reading every sample. The source has
+ * peaks just inside both ends, so that ranges which are not aligned to
+ * peaks or blocks find them only in the partial first or last block.
+ */
+void
+RegionAnalysisTest::setUp ()
+{
+	TestNeedingSession::setUp ();
+
+	std::string const path = Glib::build_filename (new_test_output_dir ("region_analysis"), "analysis.wav");
+	_source = std::dynamic_pointer_cast<AudioSource> (SourceFactory::createWritable (DataType::AUDIO, *_session, path, get_test_sample_rate ()));
+	CPPUNIT_ASSERT (_source);
+
+	_length = 3 * get_test_sample_rate () + 123;
+
+	std::vector<Sample> data (_length);
+	for (samplecnt_t i = 0; i < _length; ++i) {
+		data[i] = .25f * sinf (i * .013f) + .125f * sinf (i * .7f);
+	}
+	data[101]          = .9f;
+	data[_length - 37]  = -.95f;
+
+	CPPUNIT_ASSERT_EQUAL (_length, _source->write (&data[0], _length));
+
+	AudioSource::set_build_peakfiles (true);
+	AudioSource::set_build_missing_peakfiles (true);
+	CPPUNIT_ASSERT_EQUAL (0, SourceFactory::setup_peakfile (_source, false));
+}
+
+void
+RegionAnalysisTest::tearDown ()
+{
+	AudioSource::set_build_peakfiles (false);
+	AudioSource::set_build_missing_peakfiles (false);
+	_source.reset ();
+	TestNeedingSession::tearDown ();
+}
+
+/** reference: read every sample */
+void
+RegionAnalysisTest::scan (samplepos_t start, samplecnt_t cnt, double& peak, double& sumsq) const
+{
+	std::vector<Sample> buf (cnt);
+	CPPUNIT_ASSERT_EQUAL (cnt, _source->read (&buf[0], start, cnt));
+
+	peak  = 0;
+	sumsq = 0;
+	for (samplecnt_t i = 0; i < cnt; ++i) {
+		peak   = std::max<double> (peak, fabsf (buf[i]));
+		sumsq += buf[i] * buf[i];
+	}
+}
+
+void
+RegionAnalysisTest::peakAmplitudeTest ()
+{
+	/* whole source, partial peaks at both ends, short ranges */
+	samplepos_t const ranges[][2] = {
+		{ 0, _length },
+		{ 1, _length - 1 },
+		{ 100, _length - 136 },
+		{ 255, 3 * 256 + 17 },
+		{ _length - 1000, 1000 },
+	};
+
+	for (size_t r = 0; r < sizeof (ranges) / sizeof (ranges[0]); ++r) {
+		double ref, sumsq;
+		scan (ranges[r][0], ranges[r][1], ref, sumsq);
+
+		double peak = 0;
+		CPPUNIT_ASSERT (_source->peak_amplitude (ranges[r][0], ranges[r][1], peak));
+		CPPUNIT_ASSERT_EQUAL (ref, peak);
+	}
+
+	/* the peaks at the edges are excluded */
+	double peak = 0;
+	CPPUNIT_ASSERT (_source->peak_amplitude (102, _length - 140, peak));
+	CPPUNIT_ASSERT (peak < .9);
+
+	/* less than a whole peak, or out of range */
+	CPPUNIT_ASSERT (!_source->peak_amplitude (10, 100, peak));
+	CPPUNIT_ASSERT (!_source->peak_amplitude (_length - 100, 200, peak));
+}
+
+void
+RegionAnalysisTest::blockStatsTest ()
+{
+	samplecnt_t const bs = _source->block_stats_size ();
+
+	std::shared_ptr<AudioSource::BlockStatsList const> stats = _source->block_stats ();
+	CPPUNIT_ASSERT (stats);
+	CPPUNIT_ASSERT_EQUAL ((size_t) ((_length + bs - 1) / bs), stats->size ());
+
+	/* the last block is partial */
+	for (size_t b = 0; b < stats->size (); ++b) {
+		double peak, sumsq;
+		scan (b * bs, std::min (bs, _length - (samplecnt_t) (b * bs)), peak, sumsq);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (sumsq, (*stats)[b].sumsq, sumsq * 1e-12);
+		/* true-peak is at least the sample peak */
+		CPPUNIT_ASSERT ((*stats)[b].true_peak >= peak - 1e-6);
+	}
+
+	/* the result is cached, and saved */
+	CPPUNIT_ASSERT (stats == _source->block_stats ());
+
+	std::string const path = Glib::build_filename (_session->analysis_dir (), _source->id ().to_s () + ".blockstats");
+	CPPUNIT_ASSERT (Glib::file_test (path, Glib::FILE_TEST_EXISTS));
+
+	/* removed with the peakfile */
+	_source->close_peakfile ();
+	CPPUNIT_ASSERT (!Glib::file_test (path, Glib::FILE_TEST_EXISTS));
+	CPPUNIT_ASSERT (stats != _source->block_stats ());
+}
+
+void
+RegionAnalysisTest::regionTest ()
+{
+	samplecnt_t const bs = _source->block_stats_size ();
+
+	/* aligned to blocks, partial first and last block, inside a single block */
+	samplepos_t const ranges[][2] = {
+		{ 0, _length },
+		{ bs, 2 * bs },
+		{ 100, _length - 136 },
+		{ 7, 2 * bs + 3 },
+		{ bs + 10, bs / 2 },
+	};
+
+	for (size_t r = 0; r < sizeof (ranges) / sizeof (ranges[0]); ++r) {
+		PBD::PropertyList plist;
+		plist.add (Properties::start, timepos_t (ranges[r][0]));
+		plist.add (Properties::length, timecnt_t (ranges[r][1]));
+
+		std::shared_ptr<AudioRegion> ar = std::dynamic_pointer_cast<AudioRegion> (RegionFactory::create (std::shared_ptr<Source> (_source), plist));
+		CPPUNIT_ASSERT (ar);
+
+		double peak, sumsq;
+		scan (ranges[r][0], ranges[r][1], peak, sumsq);
+
+		CPPUNIT_ASSERT_EQUAL (peak, ar->maximum_amplitude ());
+
+		double const rms = sqrt (2. * sumsq / ranges[r][1]);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (rms, ar->rms (), rms * 1e-9);
+	}
+}
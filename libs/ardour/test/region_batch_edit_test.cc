@@ -0,0 +1,178 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <memory>
+
+#include "pbd/xml++.h"
+
+#include "ardour/playlist.h"
+#include "ardour/region.h"
+#include "ardour/region_batch_edit.h"
+
+#include "region_batch_edit_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (RegionBatchEditTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+static int                   regions_changed_calls;
+static RegionList::size_type regions_changed_count;
+
+static void
+regions_changed (std::shared_ptr<RegionList> rl, PBD::PropertyChange const& what_changed)
+{
+	/* region moves are signalled as a change of length */
+	if (what_changed.contains (Properties::length)) {
+		++regions_changed_calls;
+		regions_changed_count += rl->size ();
+	}
+}
+
+static bool command_dropped;
+
+static void
+command_going_away ()
+{
+	command_dropped = true;
+}
+
+void
+RegionBatchEditTest::notifyTest ()
+{
+	_playlist->add_region (_r[0], timepos_t (0));
+	_playlist->add_region (_r[1], timepos_t (100));
+	_playlist->add_region (_r[2], timepos_t (200));
+
+	PBD::ScopedConnection c;
+	Region::RegionsPropertyChanged.connect_same_thread (c, std::bind (&regions_changed, _1, _2));
+
+	regions_changed_calls = 0;
+	regions_changed_count = 0;
+
+	RegionBatchEdit edit;
+	for (int i = 0; i < 3; ++i) {
+		edit.add (_r[i]);
+		_r[i]->set_position (timepos_t (1000 + i * 100));
+	}
+
+	/* nothing is sent until the edit is committed */
+	CPPUNIT_ASSERT_EQUAL (0, regions_changed_calls);
+
+	delete edit.commit ();
+
+	/* one notification for all regions */
+	CPPUNIT_ASSERT_EQUAL (1, regions_changed_calls);
+	CPPUNIT_ASSERT_EQUAL (RegionList::size_type (3), regions_changed_count);
+
+	CPPUNIT_ASSERT_EQUAL (timepos_t (1000), _r[0]->position ());
+	CPPUNIT_ASSERT_EQUAL (timepos_t (1100), _r[1]->position ());
+	CPPUNIT_ASSERT_EQUAL (timepos_t (1200), _r[2]->position ());
+}
+
+void
+RegionBatchEditTest::undoTest ()
+{
+	_playlist->add_region (_r[0], timepos_t (0));
+	_playlist->add_region (_r[1], timepos_t (100));
+
+	RegionBatchEdit edit;
+	edit.add (_r[0]);
+	edit.add (_r[1]);
+	/* adding a region twice is harmless */
+	edit.add (_r[0]);
+
+	_r[0]->set_position (timepos_t (500));
+	_r[1]->set_muted (true);
+
+	std::unique_ptr<RegionBatchDiffCommand> cmd (edit.commit ());
+	CPPUNIT_ASSERT (!cmd->empty ());
+
+	cmd->undo ();
+	CPPUNIT_ASSERT_EQUAL (timepos_t (0), _r[0]->position ());
+	CPPUNIT_ASSERT_EQUAL (false, _r[1]->muted ());
+
+	cmd->redo ();
+	CPPUNIT_ASSERT_EQUAL (timepos_t (500), _r[0]->position ());
+	CPPUNIT_ASSERT_EQUAL (true, _r[1]->muted ());
+}
+
+void
+RegionBatchEditTest::stateTest ()
+{
+	_playlist->add_region (_r[0], timepos_t (0));
+	_playlist->add_region (_r[1], timepos_t (100));
+
+	RegionBatchEdit edit;
+	edit.add (_r[0]);
+	edit.add (_r[1]);
+	_r[1]->set_position (timepos_t (300));
+
+	std::unique_ptr<RegionBatchDiffCommand> cmd (edit.commit ());
+
+	/* only regions which changed are stored */
+	XMLNode& node (cmd->get_state ());
+	CPPUNIT_ASSERT_EQUAL (string ("RegionBatchDiffCommand"), node.name ());
+	CPPUNIT_ASSERT_EQUAL (XMLNodeList::size_type (1), node.children ().size ());
+
+	RegionBatchDiffCommand restored (node);
+	delete &node;
+
+	restored.undo ();
+	CPPUNIT_ASSERT_EQUAL (timepos_t (100), _r[1]->position ());
+	restored.redo ();
+	CPPUNIT_ASSERT_EQUAL (timepos_t (300), _r[1]->position ());
+}
+
+void
+RegionBatchEditTest::dropTest ()
+{
+	_playlist->add_region (_r[0], timepos_t (0));
+	_playlist->add_region (_r[1], timepos_t (100));
+
+	/* an edit that changes nothing has no command */
+	RegionBatchEdit unchanged;
+	unchanged.add (_r[0]);
+	CPPUNIT_ASSERT (!unchanged.commit ());
+
+	RegionBatchEdit edit;
+	edit.add (_r[0]);
+	edit.add (_r[1]);
+	_r[0]->set_position (timepos_t (500));
+	_r[1]->set_position (timepos_t (600));
+
+	std::unique_ptr<RegionBatchDiffCommand> cmd (edit.commit ());
+	CPPUNIT_ASSERT (cmd);
+
+	command_dropped = false;
+
+	PBD::ScopedConnection c;
+	cmd->DropReferences.connect_same_thread (c, std::bind (&command_going_away));
+
+	/* the changes of a region that goes away are forgotten */
+	_r[0]->drop_references ();
+	CPPUNIT_ASSERT (!cmd->empty ());
+	CPPUNIT_ASSERT (!command_dropped);
+
+	XMLNode& node (cmd->get_state ());
+	CPPUNIT_ASSERT_EQUAL (XMLNodeList::size_type (1), node.children ().size ());
+	delete &node;
+
+	/* the command goes away with its last region */
+	_r[1]->drop_references ();
+	CPPUNIT_ASSERT (cmd->empty ());
+	CPPUNIT_ASSERT (command_dropped);
+}
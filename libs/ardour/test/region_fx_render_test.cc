@@ -0,0 +1,167 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <atomic>
+#include <vector>
+
+#include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
+
+#include "pbd/controllable.h"
+#include "pbd/file_utils.h"
+
+#include "ardour/audioplaylist.h"
+#include "ardour/audioregion.h"
+#include "ardour/automation_control.h"
+#include "ardour/plugin_manager.h"
+#include "ardour/region_fx_plugin.h"
+#include "ardour/region_fx_renderer.h"
+#include "ardour/session.h"
+
+#include "region_fx_render_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (RegionFxRenderTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+void
+RegionFxRenderTest::setUp ()
+{
+	AudioRegionTest::setUp ();
+
+	/* a plain gain (numerator / denominator) without de-clicking */
+	PluginPtr p;
+	PluginInfoList const& plugs = PluginManager::instance ().lua_plugin_info ();
+	for (PluginInfoList::const_iterator i = plugs.begin (); i != plugs.end (); ++i) {
+		if ((*i)->name == "ACE Gain Ratio") {
+			p = (*i)->load (*_session);
+			break;
+		}
+	}
+	CPPUNIT_ASSERT (p);
+
+	_ar[0]->set_position (timepos_t (0));
+	_ar[0]->set_length (timecnt_t (1024));
+	_ar[0]->set_fade_in_active (false);
+	_ar[0]->set_fade_out_active (false);
+	_playlist->add_region (_ar[0], timepos_t (0));
+
+	std::shared_ptr<RegionFxPlugin> fx (new RegionFxPlugin (*_session, Temporal::AudioTime, p));
+	fx->automation_control (Evoral::Parameter (PluginAutomation, 0, 0))->set_value (3, PBD::Controllable::NoGroup);
+	fx->automation_control (Evoral::Parameter (PluginAutomation, 0, 1))->set_value (2, PBD::Controllable::NoGroup);
+
+	CPPUNIT_ASSERT (_ar[0]->add_plugin (fx));
+	CPPUNIT_ASSERT (_ar[0]->has_region_fx ());
+}
+
+size_t
+RegionFxRenderTest::n_render_files () const
+{
+	vector<string> files;
+	PBD::find_files_matching_pattern (files, _session->analysis_dir (), "*.fxrender*");
+	return files.size ();
+}
+
+/** A render replaces the plugins, and produces the same output.
+ * The source is a staircase (sample i == i), the FX apply a gain of 1.5
+ */
+void
+RegionFxRenderTest::renderTest ()
+{
+	int const N = 1024;
+
+	Sample live[N];
+	Sample buf[N];
+	Sample mbuf[N];
+	float  gbuf[N];
+
+	for (int i = 0; i < N; ++i) {
+		live[i] = buf[i] = 0;
+	}
+
+	_ar[0]->read_at (live, mbuf, gbuf, 0, N, 0);
+
+	for (int i = 1; i < N; ++i) {
+		CPPUNIT_ASSERT_EQUAL (Sample (i * 1.5), live[i]);
+		CPPUNIT_ASSERT (live[i] != Sample (i));
+	}
+
+	std::atomic<bool> abort (false);
+
+	/* plugins are instantiated by prepare_fx_render () */
+	CPPUNIT_ASSERT (!_ar[0]->fx_render_prepared ());
+	CPPUNIT_ASSERT (!_ar[0]->render_fx (abort));
+	CPPUNIT_ASSERT (!_ar[0]->fx_render_valid ());
+
+	_ar[0]->prepare_fx_render ();
+	CPPUNIT_ASSERT (_ar[0]->fx_render_prepared ());
+	CPPUNIT_ASSERT (_ar[0]->render_fx (abort));
+	CPPUNIT_ASSERT (!_ar[0]->fx_render_prepared ());
+
+	CPPUNIT_ASSERT (_ar[0]->fx_render_valid ());
+	CPPUNIT_ASSERT (_ar[0]->fx_render_bytes () > 0);
+	CPPUNIT_ASSERT (n_render_files () > 0);
+
+	_ar[0]->read_at (buf, mbuf, gbuf, 0, N, 0);
+	for (int i = 1; i < N; ++i) {
+		CPPUNIT_ASSERT_EQUAL (Sample (i * 1.5), buf[i]);
+		CPPUNIT_ASSERT (buf[i] != Sample (i));
+	}
+
+	_ar[0]->drop_fx_render ();
+	CPPUNIT_ASSERT (!_ar[0]->fx_render_valid ());
+	CPPUNIT_ASSERT_EQUAL (size_t (0), _ar[0]->fx_render_bytes ());
+}
+
+/** Changes that affect the FX output make a render stale */
+void
+RegionFxRenderTest::invalidateTest ()
+{
+	std::atomic<bool> abort (false);
+
+	_ar[0]->prepare_fx_render ();
+	CPPUNIT_ASSERT (_ar[0]->render_fx (abort));
+	CPPUNIT_ASSERT (_ar[0]->fx_render_valid ());
+
+	uint64_t const gen = _ar[0]->fx_generation ();
+
+	_ar[0]->set_length (timecnt_t (512));
+
+	CPPUNIT_ASSERT (_ar[0]->fx_generation () != gen);
+	CPPUNIT_ASSERT (!_ar[0]->fx_render_valid ());
+
+	/* a copy prepared before a change is not rendered */
+	_ar[0]->prepare_fx_render ();
+	_ar[0]->set_fade_before_fx (!_ar[0]->fade_before_fx ());
+	CPPUNIT_ASSERT (!_ar[0]->fx_render_prepared ());
+	CPPUNIT_ASSERT (!_ar[0]->render_fx (abort));
+	CPPUNIT_ASSERT (!_ar[0]->fx_render_valid ());
+}
+
+/** Renders left over from a previous session are removed */
+void
+RegionFxRenderTest::staleRenderTest ()
+{
+	string const path = Glib::build_filename (_session->analysis_dir (), "stale.0.fxrender.wav");
+	Glib::file_set_contents (path, "RIFF");
+	CPPUNIT_ASSERT (Glib::file_test (path, Glib::FILE_TEST_EXISTS));
+
+	_session->region_fx_renderer ()->remove_stale_renders ();
+
+	CPPUNIT_ASSERT (!Glib::file_test (path, Glib::FILE_TEST_EXISTS));
+	CPPUNIT_ASSERT_EQUAL (size_t (0), n_render_files ());
+}
@@ -0,0 +1,174 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "pbd/controllable.h"
+#include "pbd/failed_constructor.h"
+
+#include "ardour/audio_buffer.h"
+#include "ardour/automation_control.h"
+#include "ardour/buffer_manager.h"
+#include "ardour/buffer_set.h"
+#include "ardour/plugin_insert.h"
+#include "ardour/plugin_manager.h"
+#include "ardour/process_thread.h"
+#include "ardour/route_pipeline.h"
+#include "ardour/runtime_functions.h"
+#include "ardour/session.h"
+
+#include "route_pipeline_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (RoutePipelineTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+static std::shared_ptr<PluginInsert>
+mono_plugin (Session& s, std::string const& name)
+{
+	PluginPtr p;
+	PluginInfoList const& plugs = PluginManager::instance ().lua_plugin_info ();
+	for (PluginInfoList::const_iterator i = plugs.begin (); i != plugs.end (); ++i) {
+		if ((*i)->name == name) {
+			p = (*i)->load (s);
+			break;
+		}
+	}
+	CPPUNIT_ASSERT (p);
+
+	std::shared_ptr<PluginInsert> pi (new PluginInsert (s, s, p));
+	ChanCount in (DataType::AUDIO, 1);
+	ChanCount out;
+	CPPUNIT_ASSERT (pi->can_support_io_configuration (in, out));
+	CPPUNIT_ASSERT (pi->configure_io (in, out));
+	pi->activate ();
+	return pi;
+}
+
+/* FIR (with state across blocks), gain 3/2, FIR.
+ * None of these change state when processing silence, so a pipeline
+ * that first processes a few blocks of silence produces the same result.
+ */
+static RoutePipeline::Processors
+make_chain (Session& s)
+{
+	RoutePipeline::Processors procs;
+	procs.push_back (mono_plugin (s, "Lua FIR Convolver"));
+	procs.push_back (mono_plugin (s, "ACE Gain Ratio"));
+	procs.push_back (mono_plugin (s, "Lua FIR Convolver"));
+
+	procs[1]->automation_control (Evoral::Parameter (PluginAutomation, 0, 0))->set_value (3, PBD::Controllable::NoGroup);
+	procs[1]->automation_control (Evoral::Parameter (PluginAutomation, 0, 1))->set_value (2, PBD::Controllable::NoGroup);
+	return procs;
+}
+
+/** A pipelined chain produces the same output as the serial chain,
+ * delayed by the latency that the pipeline reports.
+ */
+void
+RoutePipelineTest::compareTest ()
+{
+	pframes_t const block    = _session->get_block_size ();
+	size_t const    n_blocks = 16;
+	size_t const    len      = n_blocks * block;
+
+	RoutePipeline::Processors serial = make_chain (*_session);
+	RoutePipeline::Processors staged = make_chain (*_session);
+
+	std::shared_ptr<RoutePipeline> pipeline;
+	try {
+		pipeline.reset (new RoutePipeline (*_session, staged, 3, block));
+	} catch (failed_constructor&) {
+		cout << "Cannot create pipeline worker threads, skipping the pipeline test" << endl;
+		return;
+	}
+
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 3, pipeline->n_stages ());
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t) 2 * block, pipeline->latency ());
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t) block, pipeline->input_delay (staged[1]));
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t) 0, pipeline->input_delay (staged[0]));
+
+	/* this thread acts as the route's process thread */
+	BufferManager::reserve_thread_buffers (1);
+	ProcessThread* pt = new ProcessThread ();
+	pt->get_buffers ();
+
+	std::vector<Sample> input (len);
+	for (size_t i = 0; i < len; ++i) {
+		input[i] = .5f * sinf (i * .01f) + .25f * sinf (i * .37f);
+	}
+
+	std::vector<Sample> out_serial (len);
+	std::vector<Sample> out_staged (len);
+
+	for (size_t b = 0; b < n_blocks; ++b) {
+		samplepos_t const start = b * block;
+		samplepos_t const end   = start + block;
+
+		BufferSet& bufs (_session->get_route_buffers (ChanCount (DataType::AUDIO, 1), true));
+
+		bufs.set_count (ChanCount (DataType::AUDIO, 1));
+		copy_vector (bufs.get_audio (0).data (), &input[start], block);
+		for (auto const& p : serial) {
+			p->run (bufs, start, end, 1, block, true);
+		}
+		copy_vector (&out_serial[start], bufs.get_audio (0).data (), block);
+
+		bufs.set_count (ChanCount (DataType::AUDIO, 1));
+		copy_vector (bufs.get_audio (0).data (), &input[start], block);
+		samplecnt_t latency = 0;
+		pipeline->run (bufs, start, end, 1, block, latency);
+		copy_vector (&out_staged[start], bufs.get_audio (0).data (), block);
+
+		CPPUNIT_ASSERT_EQUAL (pipeline->latency (), latency);
+	}
+
+	samplecnt_t const delay = pipeline->latency ();
+
+	bool differs = false;
+	for (size_t i = 0; i < len; ++i) {
+		if (i < (size_t) delay) {
+			CPPUNIT_ASSERT_EQUAL (0.f, out_staged[i]);
+		} else {
+			/* worker threads may use different denormal handling */
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (out_serial[i - delay], out_staged[i], 1e-6);
+		}
+		differs |= out_serial[i] != input[i];
+	}
+	/* the chain does process the signal */
+	CPPUNIT_ASSERT (differs);
+
+	/* after a flush, no stale data is left between the stages.
+	 * Only the last FIR's own tail (less than 4 samples) remains.
+	 */
+	pipeline->flush ();
+	BufferSet& bufs (_session->get_route_buffers (ChanCount (DataType::AUDIO, 1), true));
+	bufs.set_count (ChanCount (DataType::AUDIO, 1));
+	samplecnt_t latency = 0;
+	pipeline->run (bufs, len, len + block, 1, block, latency);
+	for (pframes_t i = 4; i < block; ++i) {
+		CPPUNIT_ASSERT_EQUAL (0.f, bufs.get_audio (0).data ()[i]);
+	}
+
+	pipeline.reset ();
+
+	pt->drop_buffers ();
+	delete pt;
+	BufferManager::release_thread_buffers (1);
+}
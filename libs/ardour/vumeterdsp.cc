@@ -17,8 +17,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <math.h>
+
 #include "ardour/vumeterdsp.h"
+#include "ardour/runtime_functions.h"
 
 
 float Vumeterdsp::_w;
@@ -41,34 +44,40 @@ Vumeterdsp::~Vumeterdsp (void)
 
 void Vumeterdsp::process (float const *p, int n)
 {
-    float z1, z2, m, t1, t2;
+    Vumeterdsp* self = this;
+    process (&self, &p, 1, n);
+}
 
-    z1 = _z1 > 20 ? 20 : (_z1 < -20 ? -20 : _z1);
-    z2 = _z2 > 20 ? 20 : (_z2 < -20 ? -20 : _z2);
-    m = _res ? 0: _m;
-    _res = false;
 
-    n /= 4;
-    while (n--)
+void Vumeterdsp::process (Vumeterdsp* const* v, float const* const* p, uint32_t n_chn, int n)
+{
+    float z1 [8], z2 [8], m [8];
+
+    for (uint32_t c0 = 0; c0 < n_chn; c0 += 8)
     {
-	t2 = z2 / 2;
-	t1 = fabsf (*p++) - t2;
-	z1 += _w * (t1 - z1);
-	t1 = fabsf (*p++) - t2;
-	z1 += _w * (t1 - z1);
-	t1 = fabsf (*p++) - t2;
-	z1 += _w * (t1 - z1);
-	t1 = fabsf (*p++) - t2;
-	z1 += _w * (t1 - z1);
-	z2 += 4 * _w * (z1 - z2);
-	if (z2 > m) m = z2;
+	uint32_t const nc = std::min<uint32_t> (8, n_chn - c0);
+
+	for (uint32_t c = 0; c < nc; ++c)
+	{
+	    Vumeterdsp* d = v [c0 + c];
+	    z1 [c] = d->_z1 > 20 ? 20 : (d->_z1 < -20 ? -20 : d->_z1);
+	    z2 [c] = d->_z2 > 20 ? 20 : (d->_z2 < -20 ? -20 : d->_z2);
+	    m [c] = d->_res ? 0: d->_m;
+	    d->_res = false;
+	}
+
+	ARDOUR::vumeter_process (&p [c0], nc, n, _w, z1, z2, m);
+
+	for (uint32_t c = 0; c < nc; ++c)
+	{
+	    Vumeterdsp* d = v [c0 + c];
+	    if (isnan(z1 [c])) z1 [c] = 0;
+	    if (isnan(z2 [c])) z2 [c] = 0;
+	    d->_z1 = z1 [c];
+	    d->_z2 = z2 [c] + 1e-10f;
+	    d->_m = m [c];
+	}
     }
-
-    if (isnan(z1)) z1 = 0;
-    if (isnan(z2)) z2 = 0;
-    _z1 = z1;
-    _z2 = z2 + 1e-10f;
-    _m = m;
 }
 
 
@@ -0,0 +1,371 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/* SSE meter kernels, processing four channels at a time.
+ *
+ * Every lane performs the same operations in the same order as the
+ * reference implementation in meter_functions.cc, the results are
+ * bit-identical (unless built with -ffast-math, which allows the compiler
+ * to reassociate the reference implementation). Unused lanes of the last group repeat the first
+ * channel of the group, and their results are discarded.
+ */
+
+#include <algorithm>
+#include <xmmintrin.h>
+
+#include "ardour/mix.h"
+#include "ardour/runtime_functions.h"
+
+using namespace ARDOUR;
+
+/* std::max (a, b), including its NaN and signed zero semantics */
+static inline __m128
+std_max_ps (__m128 a, __m128 b)
+{
+	__m128 const lt = _mm_cmplt_ps (a, b);
+	return _mm_or_ps (_mm_and_ps (lt, b), _mm_andnot_ps (lt, a));
+}
+
+/* (t > a) ? b : a */
+static inline __m128
+select_gt_ps (__m128 t, __m128 a, __m128 b)
+{
+	__m128 const gt = _mm_cmpgt_ps (t, a);
+	return _mm_or_ps (_mm_and_ps (gt, b), _mm_andnot_ps (gt, a));
+}
+
+static inline __m128
+abs_ps (__m128 x)
+{
+	return _mm_andnot_ps (_mm_set1_ps (-0.f), x);
+}
+
+static inline __m128
+load_lanes (float const* s, uint32_t nc)
+{
+	float v[4];
+	for (uint32_t l = 0; l < 4; ++l) {
+		v[l] = l < nc ? s[l] : s[0];
+	}
+	return _mm_loadu_ps (v);
+}
+
+static inline void
+store_lanes (float* d, __m128 x, uint32_t nc)
+{
+	float v[4];
+	_mm_storeu_ps (v, x);
+	for (uint32_t l = 0; l < nc; ++l) {
+		d[l] = v[l];
+	}
+}
+
+/** Input data of up to four channels. Buffers of unused lanes
+ * point to the first channel's data.
+ */
+struct Lanes {
+	Lanes (float const* const* bufs, uint32_t nc, uint32_t offset = 0)
+	{
+		for (uint32_t l = 0; l < 4; ++l) {
+			p[l] = (l < nc ? bufs[l] : bufs[0]) + offset;
+		}
+	}
+
+	/* sample i of all lanes */
+	__m128 sample (pframes_t i) const
+	{
+		return _mm_set_ps (p[3][i], p[2][i], p[1][i], p[0][i]);
+	}
+
+	/* four consecutive samples [i, i + 4) of all lanes, transposed */
+	void block (pframes_t i, __m128 x[4]) const
+	{
+		x[0] = _mm_loadu_ps (&p[0][i]);
+		x[1] = _mm_loadu_ps (&p[1][i]);
+		x[2] = _mm_loadu_ps (&p[2][i]);
+		x[3] = _mm_loadu_ps (&p[3][i]);
+		_MM_TRANSPOSE4_PS (x[0], x[1], x[2], x[3]);
+	}
+
+	float const* p[4];
+};
+
+void
+x86_sse_kmeter_process (float const* const* bufs, uint32_t n_chn, pframes_t nframes, float omega, float* z1, float* z2)
+{
+	__m128 const w  = _mm_set1_ps (omega);
+	__m128 const w4 = _mm_set1_ps (4 * omega);
+
+	for (uint32_t c = 0; c < n_chn; c += 4) {
+		uint32_t const nc = std::min<uint32_t> (4, n_chn - c);
+		Lanes const    in (&bufs[c], nc);
+
+		__m128 y1 = load_lanes (&z1[c], nc);
+		__m128 y2 = load_lanes (&z2[c], nc);
+
+		for (pframes_t i = 0; i + 4 <= nframes; i += 4) {
+			__m128 x[4];
+			in.block (i, x);
+			for (int k = 0; k < 4; ++k) {
+				__m128 const s = _mm_mul_ps (x[k], x[k]);
+				y1 = _mm_add_ps (y1, _mm_mul_ps (w, _mm_sub_ps (s, y1)));
+			}
+			y2 = _mm_add_ps (y2, _mm_mul_ps (w4, _mm_sub_ps (y1, y2)));
+		}
+
+		store_lanes (&z1[c], y1, nc);
+		store_lanes (&z2[c], y2, nc);
+	}
+}
+
+void
+x86_sse_ppm_process (float const* const* bufs, uint32_t n_chn, pframes_t nframes, float w1, float w2, float w3, float* z1, float* z2, float* m)
+{
+	__m128 const v1 = _mm_set1_ps (w1);
+	__m128 const v2 = _mm_set1_ps (w2);
+	__m128 const v3 = _mm_set1_ps (w3);
+
+	for (uint32_t c = 0; c < n_chn; c += 4) {
+		uint32_t const nc = std::min<uint32_t> (4, n_chn - c);
+		Lanes const    in (&bufs[c], nc);
+
+		__m128 y1 = load_lanes (&z1[c], nc);
+		__m128 y2 = load_lanes (&z2[c], nc);
+		__m128 mx = load_lanes (&m[c], nc);
+
+		for (pframes_t i = 0; i + 4 <= nframes; i += 4) {
+			__m128 x[4];
+			in.block (i, x);
+			y1 = _mm_mul_ps (y1, v3);
+			y2 = _mm_mul_ps (y2, v3);
+			for (int k = 0; k < 4; ++k) {
+				__m128 const t = abs_ps (x[k]);
+				y1 = select_gt_ps (t, y1, _mm_add_ps (y1, _mm_mul_ps (v1, _mm_sub_ps (t, y1))));
+				y2 = select_gt_ps (t, y2, _mm_add_ps (y2, _mm_mul_ps (v2, _mm_sub_ps (t, y2))));
+			}
+			__m128 const t = _mm_add_ps (y1, y2);
+			mx = select_gt_ps (t, mx, t);
+		}
+
+		store_lanes (&z1[c], y1, nc);
+		store_lanes (&z2[c], y2, nc);
+		store_lanes (&m[c], mx, nc);
+	}
+}
+
+void
+x86_sse_vumeter_process (float const* const* bufs, uint32_t n_chn, pframes_t nframes, float w, float* z1, float* z2, float* m)
+{
+	__m128 const v  = _mm_set1_ps (w);
+	__m128 const v4 = _mm_set1_ps (4 * w);
+	__m128 const h  = _mm_set1_ps (.5f);
+
+	for (uint32_t c = 0; c < n_chn; c += 4) {
+		uint32_t const nc = std::min<uint32_t> (4, n_chn - c);
+		Lanes const    in (&bufs[c], nc);
+
+		__m128 y1 = load_lanes (&z1[c], nc);
+		__m128 y2 = load_lanes (&z2[c], nc);
+		__m128 mx = load_lanes (&m[c], nc);
+
+		for (pframes_t i = 0; i + 4 <= nframes; i += 4) {
+			__m128 x[4];
+			in.block (i, x);
+			/* y2 / 2 == y2 * .5, both are exact */
+			__m128 const t2 = _mm_mul_ps (y2, h);
+			for (int k = 0; k < 4; ++k) {
+				__m128 const t1 = _mm_sub_ps (abs_ps (x[k]), t2);
+				y1 = _mm_add_ps (y1, _mm_mul_ps (v, _mm_sub_ps (t1, y1)));
+			}
+			y2 = _mm_add_ps (y2, _mm_mul_ps (v4, _mm_sub_ps (y1, y2)));
+			mx = select_gt_ps (y2, mx, y2);
+		}
+
+		store_lanes (&z1[c], y1, nc);
+		store_lanes (&z2[c], y2, nc);
+		store_lanes (&m[c], mx, nc);
+	}
+}
+
+void
+x86_sse_kweight_process (float const* const* bufs, uint32_t n_chn, pframes_t nframes, uint32_t offset, KWeightCoeff const& k, float* z1, float* z2, float* z3, float* z4, float* pwr)
+{
+	__m128 const a0  = _mm_set1_ps (k.a0);
+	__m128 const a1  = _mm_set1_ps (k.a1);
+	__m128 const a2  = _mm_set1_ps (k.a2);
+	__m128 const b1  = _mm_set1_ps (k.b1);
+	__m128 const b2  = _mm_set1_ps (k.b2);
+	__m128 const c3  = _mm_set1_ps (k.c3);
+	__m128 const c4  = _mm_set1_ps (k.c4);
+	__m128 const dnm = _mm_set1_ps (1e-15f);
+
+	for (uint32_t c = 0; c < n_chn; c += 4) {
+		uint32_t const nc = std::min<uint32_t> (4, n_chn - c);
+		Lanes const    in (&bufs[c], nc, offset);
+
+		__m128 y1 = load_lanes (&z1[c], nc);
+		__m128 y2 = load_lanes (&z2[c], nc);
+		__m128 y3 = load_lanes (&z3[c], nc);
+		__m128 y4 = load_lanes (&z4[c], nc);
+		__m128 s  = _mm_setzero_ps ();
+
+		pframes_t i = 0;
+
+		for (; i + 4 <= nframes; i += 4) {
+			__m128 d[4];
+			in.block (i, d);
+			for (int j = 0; j < 4; ++j) {
+				__m128 x = _mm_add_ps (_mm_sub_ps (_mm_sub_ps (d[j], _mm_mul_ps (b1, y1)), _mm_mul_ps (b2, y2)), dnm);
+				__m128 y = _mm_sub_ps (_mm_sub_ps (_mm_add_ps (_mm_add_ps (_mm_mul_ps (a0, x), _mm_mul_ps (a1, y1)), _mm_mul_ps (a2, y2)), _mm_mul_ps (c3, y3)), _mm_mul_ps (c4, y4));
+				y2 = y1;
+				y1 = x;
+				y4 = _mm_add_ps (y4, y3);
+				y3 = _mm_add_ps (y3, y);
+				s  = _mm_add_ps (s, _mm_mul_ps (y, y));
+			}
+		}
+
+		for (; i < nframes; ++i) {
+			__m128 x = _mm_add_ps (_mm_sub_ps (_mm_sub_ps (in.sample (i), _mm_mul_ps (b1, y1)), _mm_mul_ps (b2, y2)), dnm);
+			__m128 y = _mm_sub_ps (_mm_sub_ps (_mm_add_ps (_mm_add_ps (_mm_mul_ps (a0, x), _mm_mul_ps (a1, y1)), _mm_mul_ps (a2, y2)), _mm_mul_ps (c3, y3)), _mm_mul_ps (c4, y4));
+			y2 = y1;
+			y1 = x;
+			y4 = _mm_add_ps (y4, y3);
+			y3 = _mm_add_ps (y3, y);
+			s  = _mm_add_ps (s, _mm_mul_ps (y, y));
+		}
+
+		store_lanes (&z1[c], y1, nc);
+		store_lanes (&z2[c], y2, nc);
+		store_lanes (&z3[c], y3, nc);
+		store_lanes (&z4[c], y4, nc);
+		store_lanes (&pwr[c], s, nc);
+	}
+}
+
+/** History of four channels, interleaved: r[tap] holds one sample of each lane */
+struct TruePeakHistory {
+	TruePeakHistory (float* const* hist, uint32_t nc)
+		: _hist (hist)
+		, _nc (nc)
+	{
+		for (int j = 0; j < 48; ++j) {
+			float v[4];
+			for (uint32_t l = 0; l < 4; ++l) {
+				v[l] = hist[l < nc ? l : 0][j];
+			}
+			r[j] = _mm_loadu_ps (v);
+		}
+	}
+
+	~TruePeakHistory ()
+	{
+		for (int j = 0; j < 48; ++j) {
+			float v[4];
+			_mm_storeu_ps (v, r[j]);
+			for (uint32_t l = 0; l < _nc; ++l) {
+				_hist[l][j] = v[l];
+			}
+		}
+	}
+
+	__m128 fir48 (float const* c) const
+	{
+		__m128 u = _mm_mul_ps (r[0], _mm_set1_ps (c[0]));
+		for (int i = 1; i < 48; ++i) {
+			u = _mm_add_ps (u, _mm_mul_ps (r[i], _mm_set1_ps (c[i])));
+		}
+		return u;
+	}
+
+	void shift ()
+	{
+		for (int j = 0; j < 47; ++j) {
+			r[j] = r[j + 1];
+		}
+	}
+
+	__m128 r[48];
+
+private:
+	float* const* _hist;
+	uint32_t      _nc;
+};
+
+static inline float
+reduce_peak (__m128 pk, uint32_t nc, float peak)
+{
+	float v[4];
+	_mm_storeu_ps (v, pk);
+	for (uint32_t l = 0; l < nc; ++l) {
+		peak = std::max (peak, v[l]);
+	}
+	return peak;
+}
+
+void
+x86_sse_true_peak_x2 (float const* const* bufs, uint32_t n_chn, pframes_t nframes, float* const* hist, float* peak)
+{
+	for (uint32_t c = 0; c < n_chn; c += 4) {
+		uint32_t const  nc = std::min<uint32_t> (4, n_chn - c);
+		Lanes const     in (&bufs[c], nc);
+		TruePeakHistory h (&hist[c], nc);
+
+		__m128 pk = _mm_set1_ps (*peak);
+
+		for (pframes_t i = 0; i < nframes; ++i) {
+			h.r[47] = in.sample (i);
+
+			__m128 const u0 = h.r[47];
+			__m128 const u1 = h.fir48 (true_peak_fir[1]);
+
+			h.shift ();
+
+			pk = std_max_ps (pk, std_max_ps (u0, u1));
+		}
+
+		*peak = reduce_peak (pk, nc, *peak);
+	}
+}
+
+void
+x86_sse_true_peak_x4 (float const* const* bufs, uint32_t n_chn, pframes_t nframes, float* const* hist, float* peak)
+{
+	for (uint32_t c = 0; c < n_chn; c += 4) {
+		uint32_t const  nc = std::min<uint32_t> (4, n_chn - c);
+		Lanes const     in (&bufs[c], nc);
+		TruePeakHistory h (&hist[c], nc);
+
+		__m128 pk = _mm_set1_ps (*peak);
+
+		for (pframes_t i = 0; i < nframes; ++i) {
+			h.r[47] = in.sample (i);
+
+			__m128 const u0 = h.r[47];
+			__m128 const u1 = h.fir48 (true_peak_fir[0]);
+			__m128 const u2 = h.fir48 (true_peak_fir[1]);
+			__m128 const u3 = h.fir48 (true_peak_fir[2]);
+
+			h.shift ();
+
+			__m128 const p1 = std_max_ps (abs_ps (u0), abs_ps (u1));
+			__m128 const p2 = std_max_ps (abs_ps (u2), abs_ps (u3));
+			pk = std_max_ps (pk, std_max_ps (p1, p2));
+		}
+
+		*peak = reduce_peak (pk, nc, *peak);
+	}
+}
@@ -37,6 +37,7 @@
 #include "ardour/debug.h"
 #include "ardour/filesystem_paths.h"
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 #include "ardouralsautil/devicelist.h"
 #include "pbd/i18n.h"
 
@@ -1890,10 +1891,6 @@ AlsaAudioBackend::main_process_thread ()
 				}
 				pthread_mutex_unlock (&_device_port_mutex);
 
-				for (std::vector<BackendPortPtr>::const_iterator it = _system_outputs.begin (); it != _system_outputs.end (); ++it) {
-					memset ((*it)->get_buffer (_samples_per_period), 0, _samples_per_period * sizeof (Sample));
-				}
-
 				/* call engine process callback */
 				_last_process_start = g_get_monotonic_time ();
 				if (engine.process_callback (_samples_per_period)) {
@@ -2259,22 +2256,23 @@ void*
 AlsaAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
+		std::shared_ptr<const ConnectionTable> ct = connection_table ();
+		ConnectionTable::const_iterator        it = ct->begin ();
+		if (it == ct->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
+		} else if (ct->size () == 1) {
+			/* single connection, use the source's buffer */
+			AlsaAudioPort* source = static_cast<AlsaAudioPort*> (it->get ());
+			assert (source && source->is_output ());
+			return source->buffer ();
 		} else {
-			std::shared_ptr<const AlsaAudioPort> source = std::dynamic_pointer_cast<const AlsaAudioPort> (*it);
+			const AlsaAudioPort* source = static_cast<const AlsaAudioPort*> (it->get ());
 			assert (source && source->is_output ());
 			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<const AlsaAudioPort> (*it);
+			while (++it != ct->end ()) {
+				source = static_cast<const AlsaAudioPort*> (it->get ());
 				assert (source && source->is_output ());
-				Sample*       dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
+				mix_buffers_no_gain (_buffer, source->const_buffer (), n_samples);
 			}
 		}
 	}
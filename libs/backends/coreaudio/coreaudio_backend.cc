@@ -842,6 +842,28 @@ CoreAudioBackend::create_process_thread (std::function<void()> func)
 	return 0;
 }
 
+int
+CoreAudioBackend::create_worker_thread (std::function<void()> func, pthread_t* thread)
+{
+	/* like process threads, join the device's workgroup */
+	ThreadData* td = new ThreadData (this, func, PBD_RT_STACKSIZE_PROC, 1e9 * _samples_per_period / _samplerate);
+
+#if MAC_OS_X_VERSION_MAX_ALLOWED >= 110000
+	if (_pcmio->workgroup (td->_workgroup)) {
+		td->_joined_workgroup = true;
+	} else {
+		td->_joined_workgroup = false;
+	}
+#endif
+
+	if (pbd_realtime_pthread_create ("CoreAudio Worker", PBD_SCHED_FIFO, PBD_RT_PRI_PROC, PBD_RT_STACKSIZE_PROC,
+	                                 thread, coreaudio_process_thread, td)) {
+		delete td;
+		return -1;
+	}
+	return 0;
+}
+
 int
 CoreAudioBackend::join_process_threads ()
 {
@@ -247,6 +247,7 @@ class CoreAudioBackend : public AudioBackend, public PortEngineSharedImpl {
 
 	int create_process_thread (std::function<void()> func);
 	int join_process_threads ();
+	int create_worker_thread (std::function<void()> func, pthread_t* thread);
 	bool in_process_thread ();
 	uint32_t process_thread_count ();
 
@@ -280,6 +281,8 @@ class CoreAudioBackend : public AudioBackend, public PortEngineSharedImpl {
 	int         connect (PortEngine::PortHandle ph, const std::string& other) { return PortEngineSharedImpl::connect (ph, other); }
 	int         disconnect (PortEngine::PortHandle ph, const std::string& other) { return PortEngineSharedImpl::disconnect (ph, other); }
 	int         disconnect_all (PortEngine::PortHandle ph) { return PortEngineSharedImpl::disconnect_all (ph); }
+	int         connect_batch (std::vector<PortConnection> const& c, std::vector<int>* status = 0) { return PortEngineSharedImpl::connect_batch (c, status); }
+	int         disconnect_batch (std::vector<PortConnection> const& c, std::vector<int>* status = 0) { return PortEngineSharedImpl::disconnect_batch (c, status); }
 	bool        connected (PortEngine::PortHandle ph, bool process_callback_safe) { return PortEngineSharedImpl::connected (ph, process_callback_safe); }
 	bool        connected_to (PortEngine::PortHandle ph, const std::string& other, bool process_callback_safe) { return PortEngineSharedImpl::connected_to (ph, other, process_callback_safe); }
 	bool        physically_connected (PortEngine::PortHandle ph, bool process_callback_safe) { return PortEngineSharedImpl::physically_connected (ph, process_callback_safe); }
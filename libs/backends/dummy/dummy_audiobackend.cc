@@ -40,6 +40,7 @@
 
 #include "ardour/debug.h"
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 
 #include "pbd/i18n.h"
 
@@ -1591,28 +1592,23 @@ void*
 DummyAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
+		std::shared_ptr<const ConnectionTable> ct = connection_table ();
+		ConnectionTable::const_iterator it = ct->begin ();
+		if (it == ct->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
+		} else if (ct->size () == 1) {
+			/* single connection, use the source's buffer */
+			DummyAudioPort* source = static_cast<DummyAudioPort*> (it->get ());
+			assert (source && source->is_output ());
+			return source->get_buffer (n_samples); // generate signal, if needed
 		} else {
-			std::shared_ptr<DummyAudioPort> source = std::dynamic_pointer_cast<DummyAudioPort>(*it);
+			DummyAudioPort* source = static_cast<DummyAudioPort*> (it->get ());
 			assert (source && source->is_output ());
-			if (source->is_physical() && source->is_terminal()) {
-				source->get_buffer(n_samples); // generate signal.
-			}
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<DummyAudioPort>(*it);
+			memcpy (_buffer, source->get_buffer (n_samples), n_samples * sizeof (Sample));
+			while (++it != ct->end ()) {
+				source = static_cast<DummyAudioPort*> (it->get ());
 				assert (source && source->is_output ());
-				Sample* dst = buffer ();
-				if (source->is_physical() && source->is_terminal()) {
-					source->get_buffer(n_samples); // generate signal.
-				}
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
+				mix_buffers_no_gain (_buffer, (const Sample*)source->get_buffer (n_samples), n_samples);
 			}
 		}
 	} else if (is_output () && is_physical () && is_terminal()) {
@@ -301,6 +301,8 @@ class DummyAudioBackend : public AudioBackend, public PortEngineSharedImpl
 	int         connect (PortEngine::PortHandle ph, const std::string& other) { return PortEngineSharedImpl::connect (ph, other); }
 	int         disconnect (PortEngine::PortHandle ph, const std::string& other) { return PortEngineSharedImpl::disconnect (ph, other); }
 	int         disconnect_all (PortEngine::PortHandle ph) { return PortEngineSharedImpl::disconnect_all (ph); }
+	int         connect_batch (std::vector<PortConnection> const& c, std::vector<int>* status = 0) { return PortEngineSharedImpl::connect_batch (c, status); }
+	int         disconnect_batch (std::vector<PortConnection> const& c, std::vector<int>* status = 0) { return PortEngineSharedImpl::disconnect_batch (c, status); }
 	bool        connected (PortEngine::PortHandle ph, bool process_callback_safe) { return PortEngineSharedImpl::connected (ph, process_callback_safe); }
 	bool        connected_to (PortEngine::PortHandle ph, const std::string& other, bool process_callback_safe) { return PortEngineSharedImpl::connected_to (ph, other, process_callback_safe); }
 	bool        physically_connected (PortEngine::PortHandle ph, bool process_callback_safe) { return PortEngineSharedImpl::physically_connected (ph, process_callback_safe); }
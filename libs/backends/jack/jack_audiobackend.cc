@@ -26,6 +26,7 @@
 #include <glibmm/spawn.h>
 
 #include "pbd/error.h"
+#include "pbd/pthread_utils.h"
 
 #include "ardour/audioengine.h"
 #include "ardour/debug.h"
@@ -843,6 +844,48 @@ JACKAudioBackend::join_process_threads ()
 	return ret;
 }
 
+int
+JACKAudioBackend::create_worker_thread (std::function<void()> f, pthread_t* thread)
+{
+	GET_PRIVATE_JACK_POINTER_RET (_priv_jack, -1);
+
+	if (!jack_is_realtime (_priv_jack)) {
+		return -1;
+	}
+
+#if defined COMPILER_MINGW && (!defined PTW32_VERSION || defined __jack_systemdeps_h__)
+	/* jack_native_thread_t is not a pthread_t */
+	return AudioBackend::create_worker_thread (f, thread);
+#else
+	/* same as create_process_thread, let JACK set up scheduling */
+	ThreadData* td = new ThreadData (this, f, thread_stack_size ());
+
+	if (jack_client_create_thread (_priv_jack, thread, jack_client_real_time_priority (_priv_jack),
+	                               jack_is_realtime (_priv_jack), _start_process_thread, td)) {
+		delete td;
+		return -1;
+	}
+	return 0;
+#endif
+}
+
+int
+JACKAudioBackend::join_worker_thread (pthread_t thread)
+{
+#if defined COMPILER_MINGW && (!defined PTW32_VERSION || defined __jack_systemdeps_h__)
+	return AudioBackend::join_worker_thread (thread);
+#else
+	GET_PRIVATE_JACK_POINTER_RET (_priv_jack, -1);
+# if defined(USING_JACK2_EXPANSION_OF_JACK_API) || defined __jack_systemdeps_h__
+	/* see join_process_threads */
+	return jack_client_stop_thread (_priv_jack, thread);
+# else
+	void* status;
+	return pthread_join (thread, &status);
+# endif
+#endif
+}
+
 bool
 JACKAudioBackend::in_process_thread ()
 {
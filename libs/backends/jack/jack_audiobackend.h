@@ -114,6 +114,8 @@ class JACKAudioBackend : public AudioBackend {
 
 	int create_process_thread (std::function<void()> func);
 	int join_process_threads ();
+	int create_worker_thread (std::function<void()> func, pthread_t* thread);
+	int join_worker_thread (pthread_t thread);
 	bool in_process_thread ();
 	uint32_t process_thread_count ();
 	int client_real_time_priority ();
@@ -32,6 +32,7 @@
 #include "pbd/pthread_utils.h"
 
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 
 #include "pulseaudio_backend.h"
 
@@ -1163,23 +1164,24 @@ void*
 PulseAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>&          connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it          = connections.begin ();
+		std::shared_ptr<const ConnectionTable> ct = connection_table ();
+		ConnectionTable::const_iterator        it = ct->begin ();
 
-		if (it == connections.end ()) {
+		if (it == ct->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
+		} else if (ct->size () == 1) {
+			/* single connection, use the source's buffer */
+			const PulseAudioPort* source = static_cast<const PulseAudioPort*> (it->get ());
+			assert (source && source->is_output ());
+			return const_cast<Sample*> (source->const_buffer ());
 		} else {
-			std::shared_ptr<PulseAudioPort> source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
+			const PulseAudioPort* source = static_cast<const PulseAudioPort*> (it->get ());
 			assert (source && source->is_output ());
 			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
+			while (++it != ct->end ()) {
+				source = static_cast<const PulseAudioPort*> (it->get ());
 				assert (source && source->is_output ());
-				Sample*       dst = _buffer;
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
+				mix_buffers_no_gain (_buffer, source->const_buffer (), n_samples);
 			}
 		}
 	}
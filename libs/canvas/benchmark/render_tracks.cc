@@ -0,0 +1,204 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/* Headless benchmark: render a synthetic editor-like scene with 500 tracks
+ * into a 4K image surface, simulating playhead-follow and horizontal
+ * scrolling, with and without the CachedContainer tile cache.
+ *
+ *   render_tracks [n_tracks] [n_frames]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <glib.h>
+#include <pango/pangocairo.h>
+#include <pangomm/init.h>
+#include <cairomm/context.h>
+#include <cairomm/surface.h>
+
+#include "canvas/cached_container.h"
+#include "canvas/canvas.h"
+#include "canvas/line.h"
+#include "canvas/poly_line.h"
+#include "canvas/rectangle.h"
+#include "canvas/scroll_group.h"
+
+using namespace std;
+using namespace ArdourCanvas;
+
+/** A canvas without a window, which records the area it is asked to
+ * redraw, so that the benchmark can "expose" exactly that area.
+ */
+class HeadlessCanvas : public Canvas
+{
+public:
+	HeadlessCanvas (Coord w, Coord h) : _width (w), _height (h) {}
+
+	void request_redraw (Rect const & r) {
+		Rect const v = r.intersection (visible_area ());
+		if (v) {
+			_dirty = _dirty ? _dirty.extend (v) : v;
+		}
+	}
+
+	void request_size (Duple) {}
+	void grab (Item*) {}
+	void ungrab () {}
+	void queue_resize () {}
+	void focus (Item*) {}
+	void unfocus (Item*) {}
+	void re_enter () {}
+
+	Rect  visible_area () const { return Rect (0, 0, _width, _height); }
+	Coord width () const { return _width; }
+	Coord height () const { return _height; }
+
+	bool get_mouse_position (Duple&) const { return false; }
+
+	Glib::RefPtr<Pango::Context> get_pango_context () {
+		return Glib::wrap (pango_font_map_create_context (pango_cairo_font_map_get_default ()));
+	}
+
+	Rect take_dirty () {
+		Rect r = _dirty;
+		_dirty = Rect ();
+		return r;
+	}
+
+protected:
+	void pick_current_item (int) {}
+	void pick_current_item (Duple const &, int) {}
+
+private:
+	Coord _width;
+	Coord _height;
+	Rect  _dirty;
+};
+
+static void
+build_scene (CachedContainer* tracks, int n_tracks)
+{
+	const double track_height = 64;
+	const double region_width = 600;
+
+	for (int t = 0; t < n_tracks; ++t) {
+		Container* tv = new Container (tracks, Duple (0, t * track_height));
+
+		Rectangle* bg = new Rectangle (tv, Rect (0, 0, COORD_MAX, track_height));
+		bg->set_fill_color (t % 2 ? 0x303030ff : 0x282828ff);
+		bg->set_outline (false);
+
+		for (int r = 0; r < 40; ++r) {
+			Container* rv = new Container (tv, Duple (r * (region_width + 50) + (t % 7) * 20, 2));
+
+			Rectangle* frame = new Rectangle (rv, Rect (0, 0, region_width, track_height - 4));
+			frame->set_fill_color (0x4c6e8aff);
+			frame->set_outline_color (0x000000ff);
+
+			/* something resembling a waveform */
+			Points wave;
+			for (int x = 0; x < region_width; x += 2) {
+				double const a = (track_height - 8) * .5 * ((rand () % 1000) / 1000.0);
+				wave.push_back (Duple (x, (track_height - 4) * .5 + ((x / 2) % 2 ? a : -a)));
+			}
+			PolyLine* wv = new PolyLine (rv);
+			wv->set (wave);
+			wv->set_outline_color (0xd0d0d0ff);
+		}
+
+		/* automation line across the whole track */
+		Points autom;
+		for (int x = 0; x < 40 * (region_width + 50); x += 25) {
+			autom.push_back (Duple (x, 8 + (rand () % (int) (track_height - 16))));
+		}
+		PolyLine* al = new PolyLine (tv);
+		al->set (autom);
+		al->set_outline_color (0xff8020ff);
+	}
+}
+
+static double
+run (HeadlessCanvas& canvas, CachedContainer* tracks, Line* playhead, Cairo::RefPtr<Cairo::Context> context, int n_frames, bool cached, const char* what)
+{
+	tracks->set_cache_enabled (cached);
+	tracks->reset_stats ();
+
+	canvas.scroll_to (0, 0);
+	canvas.take_dirty ();
+	canvas.render (canvas.visible_area (), context);
+
+	gint64 const start = g_get_monotonic_time ();
+
+	for (int f = 0; f < n_frames; ++f) {
+		if (playhead) {
+			/* playhead follow: move a line that is not part of the cached layer */
+			playhead->set_x (f * 3, f * 3);
+		} else {
+			/* horizontal scroll back and forth, by 1/16th of the screen width */
+			int const step = (f / 32) % 2 ? 32 - (f % 32) : f % 32;
+			canvas.scroll_to (step * canvas.width () / 16, 0);
+		}
+
+		Rect const dirty = canvas.take_dirty ();
+		if (dirty) {
+			canvas.render (dirty, context);
+		}
+	}
+
+	double const elapsed = (g_get_monotonic_time () - start) / 1e3;
+
+	CachedContainer::Stats const & s (tracks->stats ());
+	printf ("%-10s %-8s %8.1f ms total, %6.2f ms/frame, tiles: %zu hits: %" G_GUINT64_FORMAT " misses: %" G_GUINT64_FORMAT " evictions: %" G_GUINT64_FORMAT "\n",
+	        what, cached ? "cached" : "direct", elapsed, elapsed / n_frames,
+	        tracks->n_tiles (), s.hits, s.misses, s.evictions);
+
+	return elapsed;
+}
+
+int
+main (int argc, char* argv[])
+{
+	int const n_tracks = argc > 1 ? atoi (argv[1]) : 500;
+	int const n_frames = argc > 2 ? atoi (argv[2]) : 200;
+
+	Pango::init ();
+
+	HeadlessCanvas canvas (3840, 2160);
+
+	ScrollGroup* hv_scroll_group = new ScrollGroup (canvas.root (), ScrollGroup::ScrollSensitivity (ScrollGroup::ScrollsVertically | ScrollGroup::ScrollsHorizontally));
+	canvas.add_scroller (*hv_scroll_group);
+
+	CachedContainer* tracks = new CachedContainer (hv_scroll_group);
+	build_scene (tracks, n_tracks);
+
+	/* the playhead lives outside of the cached layer, like the editor's cursor group */
+	Line* playhead = new Line (canvas.root ());
+	playhead->set (Duple (0, 0), Duple (0, canvas.height ()));
+	playhead->set_outline_color (0xff0000ff);
+
+	Cairo::RefPtr<Cairo::ImageSurface> surface = Cairo::ImageSurface::create (Cairo::FORMAT_ARGB32, canvas.width (), canvas.height ());
+	Cairo::RefPtr<Cairo::Context> context = Cairo::Context::create (surface);
+
+	printf ("%d tracks, %d frames, %.0fx%.0f\n", n_tracks, n_frames, canvas.width (), canvas.height ());
+
+	run (canvas, tracks, playhead, context, n_frames, false, "playhead");
+	run (canvas, tracks, playhead, context, n_frames, true,  "playhead");
+	run (canvas, tracks, 0, context, n_frames, false, "scroll");
+	run (canvas, tracks, 0, context, n_frames, true,  "scroll");
+
+	return 0;
+}
@@ -0,0 +1,257 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <cairomm/context.h>
+
+#include "canvas/cached_container.h"
+#include "canvas/canvas.h"
+
+using namespace std;
+using namespace ArdourCanvas;
+
+CachedContainer::CachedContainer (Canvas* canvas)
+	: Container (canvas)
+	, _render_cycle (0)
+	, _cache_enabled (true)
+	, _max_tiles (256)
+{
+}
+
+CachedContainer::CachedContainer (Item* parent)
+	: Container (parent)
+	, _render_cycle (0)
+	, _cache_enabled (true)
+	, _max_tiles (256)
+{
+}
+
+CachedContainer::CachedContainer (Item* parent, Duple const & p)
+	: Container (parent, p)
+	, _render_cycle (0)
+	, _cache_enabled (true)
+	, _max_tiles (256)
+{
+}
+
+CachedContainer::~CachedContainer ()
+{
+}
+
+void
+CachedContainer::set_cache_enabled (bool yn)
+{
+	if (_cache_enabled == yn) {
+		return;
+	}
+	_cache_enabled = yn;
+	drop_tiles ();
+	redraw ();
+}
+
+void
+CachedContainer::set_max_tiles (size_t n)
+{
+	_max_tiles = max<size_t> (n, 1);
+	evict_tiles ();
+}
+
+void
+CachedContainer::drop_tiles ()
+{
+	_tiles.clear ();
+}
+
+void
+CachedContainer::render_invalidated (Rect const & area) const
+{
+	if (_tiles.empty ()) {
+		return;
+	}
+
+	if (!area) {
+		/* item tree changed, keep the surfaces for re-use */
+		for (Tiles::iterator t = _tiles.begin (); t != _tiles.end (); ++t) {
+			t->second.valid = false;
+		}
+		return;
+	}
+
+	Rect const r = canvas_to_item (area);
+
+	for (Tiles::iterator t = _tiles.begin (); t != _tiles.end (); ++t) {
+		if (!t->second.valid) {
+			continue;
+		}
+		Rect const tile (t->first.first * tile_size, t->first.second * tile_size,
+		                 (t->first.first + 1) * tile_size, (t->first.second + 1) * tile_size);
+		if (tile.intersection (r)) {
+			t->second.valid = false;
+		}
+	}
+}
+
+void
+CachedContainer::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) const
+{
+	if (!_cache_enabled || render_with_alpha () >= 0) {
+		Container::render (area, context);
+		return;
+	}
+
+	Rect const bbox = bounding_box ();
+
+	if (!bbox) {
+		return;
+	}
+
+	Rect const draw = item_to_window (bbox, false).intersection (area);
+
+	if (!draw) {
+		return;
+	}
+
+	/* find the tiles (in item coordinates) that cover the area to draw */
+
+	Rect const self    = window_to_item (draw);
+	Rect const visible = _canvas->visible_area ();
+	double const scale = window_scale (context);
+
+	int64_t const tx0 = (int64_t) floor (self.x0 / tile_size);
+	int64_t const ty0 = (int64_t) floor (self.y0 / tile_size);
+	int64_t const tx1 = (int64_t) ceil (self.x1 / tile_size);
+	int64_t const ty1 = (int64_t) ceil (self.y1 / tile_size);
+
+	++_render_cycle;
+
+	context->save ();
+
+	for (int64_t ty = ty0; ty < ty1; ++ty) {
+		for (int64_t tx = tx0; tx < tx1; ++tx) {
+
+			TileIndex const idx (tx, ty);
+			Tile& tile (_tiles[idx]);
+
+			Duple const origin = item_to_window (Duple (tx * tile_size, ty * tile_size));
+			Rect const  window (origin.x, origin.y, origin.x + tile_size, origin.y + tile_size);
+
+			if (tile.valid && tile.scale == scale) {
+				++_stats.hits;
+			} else {
+				++_stats.misses;
+				render_tile (idx, tile, scale);
+				/* content of partially visible tiles may depend on the visible area */
+				tile.valid = window.x0 >= visible.x0 && window.y0 >= visible.y0 && window.x1 <= visible.x1 && window.y1 <= visible.y1;
+			}
+
+			tile.last_used = _render_cycle;
+
+			Rect const clip = window.intersection (draw);
+
+			if (!clip) {
+				continue;
+			}
+
+			context->save ();
+			context->rectangle (clip.x0, clip.y0, clip.width (), clip.height ());
+			context->clip ();
+			context->translate (origin.x, origin.y);
+			context->scale (1.0 / scale, 1.0 / scale);
+			context->set_source (tile.surface, 0, 0);
+			context->paint ();
+			context->restore ();
+		}
+	}
+
+	context->restore ();
+
+	evict_tiles ();
+}
+
+double
+CachedContainer::window_scale (Cairo::RefPtr<Cairo::Context> const & context)
+{
+	double scale = 1.0;
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE (1, 14, 0)
+	double sx, sy;
+	cairo_surface_get_device_scale (cairo_get_target (context->cobj ()), &sx, &sy);
+	scale = max (sx, sy);
+#endif
+#ifdef __APPLE__
+	/* retina, see Text::_redraw */
+	scale = max (scale, 2.0);
+#endif
+	return scale;
+}
+
+void
+CachedContainer::render_tile (TileIndex const & idx, Tile& tile, double scale) const
+{
+	if (!tile.surface || tile.scale != scale) {
+		int const size = (int) ceil (tile_size * scale);
+		tile.surface = Cairo::ImageSurface::create (Cairo::FORMAT_ARGB32, size, size);
+		tile.scale   = scale;
+	}
+
+	Cairo::RefPtr<Cairo::Context> context = Cairo::Context::create (tile.surface);
+
+	context->set_operator (Cairo::OPERATOR_CLEAR);
+	context->paint ();
+	context->set_operator (Cairo::OPERATOR_OVER);
+
+	/* Items render in window coordinates, so render the tile at the
+	 * current window position of its origin.
+	 */
+	Duple const origin = item_to_window (Duple (idx.first * tile_size, idx.second * tile_size));
+	Rect const  area (origin.x, origin.y, origin.x + tile_size, origin.y + tile_size);
+
+	context->scale (scale, scale);
+	context->translate (-origin.x, -origin.y);
+
+	Item::prepare_for_render_children (area);
+	Item::render_children (area, context);
+
+	tile.surface->flush ();
+}
+
+void
+CachedContainer::evict_tiles () const
+{
+	if (_tiles.size () <= _max_tiles) {
+		return;
+	}
+
+	vector<pair<uint64_t, TileIndex> > lru;
+	lru.reserve (_tiles.size ());
+
+	for (Tiles::const_iterator t = _tiles.begin (); t != _tiles.end (); ++t) {
+		lru.push_back (make_pair (t->second.last_used, t->first));
+	}
+
+	sort (lru.begin (), lru.end ());
+
+	for (vector<pair<uint64_t, TileIndex> >::const_iterator i = lru.begin (); i != lru.end () && _tiles.size () > _max_tiles; ++i) {
+		if (i->first == _render_cycle) {
+			/* never drop tiles that are currently on screen */
+			break;
+		}
+		_tiles.erase (i->second);
+		++_stats.evictions;
+	}
+}
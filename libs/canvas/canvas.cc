@@ -282,6 +282,8 @@ Canvas::item_shown_or_hidden (Item* item)
 {
 	Rect bbox = item->bounding_box ();
 	if (bbox) {
+		item->invalidate_render_caches (bbox);
+
 		if (_queue_draw_frozen) {
 			frozen_area = frozen_area.extend (compute_draw_item_area (item, bbox));
 			return;
@@ -302,6 +304,8 @@ Canvas::item_visual_property_changed (Item* item)
 {
 	Rect bbox = item->bounding_box ();
 	if (bbox) {
+		item->invalidate_render_caches (bbox);
+
 		if (item->item_to_window (bbox).intersection (visible_area ())) {
 			queue_draw_item_area (item, bbox);
 		}
@@ -319,6 +323,8 @@ Canvas::item_changed (Item* item, Rect pre_change_bounding_box)
 	Rect window_bbox = visible_area ();
 
 	if (pre_change_bounding_box) {
+		item->invalidate_render_caches (pre_change_bounding_box);
+
 		if (item->item_to_window (pre_change_bounding_box).intersection (window_bbox)) {
 			/* request a redraw of the item's old bounding box */
 			queue_draw_item_area (item, pre_change_bounding_box);
@@ -328,6 +334,8 @@ Canvas::item_changed (Item* item, Rect pre_change_bounding_box)
 	Rect post_change_bounding_box = item->bounding_box ();
 
 	if (post_change_bounding_box) {
+		item->invalidate_render_caches (post_change_bounding_box);
+
 		Rect const window_intersection =
 		    item->item_to_window (post_change_bounding_box).intersection (window_bbox);
 
@@ -448,12 +456,14 @@ Canvas::item_moved (Item* item, Rect pre_change_parent_bounding_box)
 		 * invalidation area. If we use the parent (which has not
 		 * moved, then this will work.
 		 */
+		item->parent()->invalidate_render_caches (pre_change_parent_bounding_box);
 		queue_draw_item_area (item->parent(), pre_change_parent_bounding_box);
 	}
 
 	Rect post_change_bounding_box = item->bounding_box ();
 	if (post_change_bounding_box) {
 		/* request a redraw of where the item now is */
+		item->invalidate_render_caches (post_change_bounding_box);
 		queue_draw_item_area (item, post_change_bounding_box);
 	}
 }
@@ -952,6 +962,7 @@ void
 GtkCanvas::item_going_away (Item* item, Rect bounding_box)
 {
 	if (bounding_box) {
+		item->invalidate_render_caches (bounding_box);
 		queue_draw_item_area (item, bounding_box);
 	}
 
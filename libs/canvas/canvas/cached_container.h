@@ -0,0 +1,115 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __CANVAS_CACHED_CONTAINER_H__
+#define __CANVAS_CACHED_CONTAINER_H__
+
+#include <map>
+
+#include <cairomm/surface.h>
+
+#include "canvas/container.h"
+
+namespace ArdourCanvas
+{
+
+/** A Container that retains the rendered result of its children in a set of
+ * fixed-size image tiles.
+ *
+ * Tiles are aligned to the container's own coordinate system, so scrolling
+ * the container (or one of its ancestors) re-uses the tiles that were
+ * rendered before. A tile is re-rendered only after an item below this
+ * container reports a change (see Item::invalidate_render_caches()) in the
+ * area covered by the tile, or when the tree of items changes.
+ *
+ * Some items render differently depending on the visible area of the canvas
+ * (e.g. a filled PolyLine extends its fill to the edges of the viewport).
+ * Tiles that are only partially visible are therefore rendered but not
+ * retained, only tiles that are completely inside the visible area are.
+ *
+ * Tiles are rendered at the scale factor of the window they are drawn to.
+ *
+ * This is intended for "static" layers, whose content changes rarely
+ * compared to how often the area is exposed (e.g. by a moving playhead or
+ * while scrolling).
+ */
+class LIBCANVAS_API CachedContainer : public Container
+{
+public:
+	CachedContainer (Canvas *);
+	CachedContainer (Item *);
+	CachedContainer (Item *, Duple const & position);
+	~CachedContainer ();
+
+	void render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) const;
+	void render_invalidated (Rect const & area) const;
+
+	/** enable or disable caching. When disabled this behaves exactly like
+	 * a Container and all tiles are dropped.
+	 */
+	void set_cache_enabled (bool);
+	bool cache_enabled () const { return _cache_enabled; }
+
+	/** Set the maximum number of tiles to retain. Least recently used tiles
+	 * are dropped first.
+	 */
+	void set_max_tiles (size_t);
+	size_t max_tiles () const { return _max_tiles; }
+
+	/** Drop all retained tiles */
+	void drop_tiles ();
+
+	struct Stats {
+		Stats () : hits (0), misses (0), evictions (0) {}
+		uint64_t hits;
+		uint64_t misses;
+		uint64_t evictions;
+	};
+
+	Stats const & stats () const { return _stats; }
+	void reset_stats () { _stats = Stats (); }
+
+	size_t n_tiles () const { return _tiles.size (); }
+
+	static const int tile_size = 256;
+
+private:
+	struct Tile {
+		Tile () : scale (1.0), valid (false), last_used (0) {}
+		Cairo::RefPtr<Cairo::ImageSurface> surface;
+		double   scale;
+		bool     valid;
+		uint64_t last_used;
+	};
+
+	typedef std::pair<int64_t, int64_t> TileIndex;
+	typedef std::map<TileIndex, Tile> Tiles;
+
+	mutable Tiles    _tiles;
+	mutable uint64_t _render_cycle;
+	mutable Stats    _stats;
+	bool             _cache_enabled;
+	size_t           _max_tiles;
+
+	void render_tile (TileIndex const &, Tile &, double scale) const;
+
+	static double window_scale (Cairo::RefPtr<Cairo::Context> const &);
+	void evict_tiles () const;
+};
+
+}
+
+#endif
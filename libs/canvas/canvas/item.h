@@ -83,6 +83,21 @@ public:
 	 */
 	virtual void prepare_for_render (Rect const & area) const { }
 
+	/** The rendered content of an area of this item or of one of its
+	 * descendants has changed. Only items that retain rendered content
+	 * (see CachedContainer) need to implement this.
+	 *
+	 * @param area Area that changed, in **canvas** coordinates. An empty
+	 * rect means that everything may have changed.
+	 */
+	virtual void render_invalidated (Rect const & area) const { }
+
+	/** Notify this item and all of its ancestors that the rendered content
+	 * of @param area (in item coordinates) has changed. An empty area
+	 * invalidates all retained content.
+	 */
+	void invalidate_render_caches (Rect const & area) const;
+
 	/** Adds one or more items to the vector \p items based on their
 	 * covering \p point which is in window coordinates
 	 *
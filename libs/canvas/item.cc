@@ -745,11 +745,26 @@ void
 Item::redraw () const
 {
 	if (visible() && _bounding_box && _canvas) {
+		invalidate_render_caches (_bounding_box);
 		_canvas->request_redraw (item_to_window (_bounding_box, false));
 	}
 
 }
 
+void
+Item::invalidate_render_caches (Rect const & area) const
+{
+	Rect canvas_area;
+
+	if (area) {
+		canvas_area = item_to_canvas (area);
+	}
+
+	for (Item const * i = this; i; i = i->parent ()) {
+		i->render_invalidated (canvas_area);
+	}
+}
+
 void
 Item::begin_change ()
 {
@@ -1066,6 +1081,7 @@ Item::add (Item* i)
 	i->reparent (this, true);
 	invalidate_lut ();
 	set_bbox_dirty ();
+	invalidate_render_caches (Rect ());
 }
 
 void
@@ -1077,6 +1093,7 @@ Item::add_front (Item* i)
 	i->reparent (this, true);
 	invalidate_lut ();
 	set_bbox_dirty();
+	invalidate_render_caches (Rect ());
 }
 
 void
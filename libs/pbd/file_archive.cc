@@ -159,6 +159,11 @@ FileArchive::FileArchive (const std::string& url, Progress* p)
 	, _progress (p)
 	, _current_entry (0)
 	, _archive (0)
+	, _write_archive (0)
+	, _write_entry (0)
+	, _write_bytes (0)
+	, _write_total (0)
+	, _write_cancelled (false)
 {
 	if (!_req.url) {
 		fprintf (stderr, "Invalid Archive URL/filename\n");
@@ -178,6 +183,9 @@ FileArchive::~FileArchive ()
 		archive_read_close (_archive);
 		archive_read_free (_archive);
 	}
+	if (_write_archive) {
+		close_write (true);
+	}
 }
 
 std::string
@@ -492,11 +500,7 @@ FileArchive::create (const std::map<std::string, std::string>& filemap, Compress
 		return -1;
 	}
 
-	struct archive *a;
-	struct archive_entry *entry;
-
-	size_t read_bytes = 0;
-	size_t total_bytes = 0;
+	uint64_t total_bytes = 0;
 
 	for (std::map<std::string, std::string>::const_iterator f = filemap.begin (); f != filemap.end (); ++f) {
 		GStatBuf statbuf;
@@ -514,81 +518,29 @@ FileArchive::create (const std::map<std::string, std::string>& filemap, Compress
 		_progress->set_progress (0);
 	}
 
-	a = archive_write_new ();
-	archive_write_set_format_pax_restricted (a);
-
-	if (compression_level != CompressNone) {
-		archive_write_add_filter_lzma (a);
-		char buf[64];
-		snprintf (buf, sizeof (buf), "lzma:compression-level=%u,lzma:threads=0", (uint32_t) compression_level);
-		archive_write_set_options (a, buf);
+	if (open_write (compression_level)) {
+		return -1;
 	}
 
-	archive_write_open_filename (a, _req.url);
-	entry = archive_entry_new ();
+	_write_total = total_bytes;
 
 #ifndef NDEBUG
 	  const int64_t archive_start_time = g_get_monotonic_time();
 #endif
 
 	for (std::map<std::string, std::string>::const_iterator f = filemap.begin (); f != filemap.end (); ++f) {
-		char buf[8192];
-		const char* filepath = f->first.c_str ();
-		const char* filename = f->second.c_str ();
-
-		GStatBuf statbuf;
-		if (g_stat (filepath, &statbuf)) {
-			continue;
-		}
-
-		archive_entry_clear (entry);
-
-#ifdef PLATFORM_WINDOWS
-		archive_entry_set_size (entry, statbuf.st_size);
-		archive_entry_set_atime (entry, statbuf.st_atime, 0);
-		archive_entry_set_ctime (entry, statbuf.st_ctime, 0);
-		archive_entry_set_mtime (entry, statbuf.st_mtime, 0);
-#else
-		archive_entry_copy_stat (entry, &statbuf);
-#endif
-
-		archive_entry_set_pathname (entry, filename);
-		archive_entry_set_filetype (entry, AE_IFREG);
-		archive_entry_set_perm (entry, 0644);
-
-		archive_write_header (a, entry);
-
-		int fd = g_open (filepath, O_RDONLY, 0444);
-		assert (fd >= 0);
-
-		ssize_t len = read (fd, buf, sizeof (buf));
-		while (len > 0) {
-			read_bytes += len;
-			archive_write_data (a, buf, len);
-			if (_progress) {
-				_progress->set_progress ((float)read_bytes / total_bytes);
-				if (_progress->cancelled ()) {
-					break;
-				}
-			}
-			len = read (fd, buf, sizeof (buf));
-		}
-		close (fd);
+		add_file (f->first, f->second);
 		if (_progress && _progress->cancelled ()) {
 			break;
 		}
 	}
 
-	archive_entry_free (entry);
-	archive_write_close (a);
-	archive_write_free (a);
+	bool const cancelled = _progress && _progress->cancelled ();
 
-	if (_progress) {
-		if (_progress->cancelled ()) {
-			g_unlink (_req.url);
-		} else {
-			_progress->set_progress (1.f);
-		}
+	close_write (cancelled);
+
+	if (_progress && !cancelled) {
+		_progress->set_progress (1.f);
 	}
 
 #ifndef NDEBUG
@@ -616,3 +568,111 @@ FileArchive::setup_file_archive ()
 
 	return a;
 }
+
+int
+FileArchive::open_write (CompressionLevel compression_level)
+{
+	if (_req.is_remote () || _write_archive) {
+		return -1;
+	}
+
+	_write_archive = archive_write_new ();
+	archive_write_set_format_pax_restricted (_write_archive);
+
+	if (compression_level != CompressNone) {
+		archive_write_add_filter_lzma (_write_archive);
+		char buf[64];
+		snprintf (buf, sizeof (buf), "lzma:compression-level=%u,lzma:threads=0", (uint32_t) compression_level);
+		archive_write_set_options (_write_archive, buf);
+	}
+
+	if (archive_write_open_filename (_write_archive, _req.url) != ARCHIVE_OK) {
+		fprintf (stderr, "Archive: cannot write '%s': %s\n", _req.url, archive_error_string (_write_archive));
+		archive_write_free (_write_archive);
+		_write_archive = 0;
+		return -1;
+	}
+
+	_write_entry     = archive_entry_new ();
+	_write_bytes     = 0;
+	_write_total     = 0;
+	_write_cancelled = false;
+	return 0;
+}
+
+int
+FileArchive::add_file (const std::string& filepath, const std::string& filename)
+{
+	if (!_write_archive || _write_cancelled) {
+		return -1;
+	}
+
+	char buf[8192];
+
+	GStatBuf statbuf;
+	if (g_stat (filepath.c_str (), &statbuf)) {
+		return -1;
+	}
+
+	archive_entry_clear (_write_entry);
+
+#ifdef PLATFORM_WINDOWS
+	archive_entry_set_size (_write_entry, statbuf.st_size);
+	archive_entry_set_atime (_write_entry, statbuf.st_atime, 0);
+	archive_entry_set_ctime (_write_entry, statbuf.st_ctime, 0);
+	archive_entry_set_mtime (_write_entry, statbuf.st_mtime, 0);
+#else
+	archive_entry_copy_stat (_write_entry, &statbuf);
+#endif
+
+	archive_entry_set_pathname (_write_entry, filename.c_str ());
+	archive_entry_set_filetype (_write_entry, AE_IFREG);
+	archive_entry_set_perm (_write_entry, 0644);
+
+	archive_write_header (_write_archive, _write_entry);
+
+	int fd = g_open (filepath.c_str (), O_RDONLY, 0444);
+	if (fd < 0) {
+		return -1;
+	}
+
+	ssize_t len = read (fd, buf, sizeof (buf));
+	while (len > 0) {
+		_write_bytes += len;
+		archive_write_data (_write_archive, buf, len);
+		if (_progress) {
+			if (_write_total > 0) {
+				_progress->set_progress ((float)_write_bytes / _write_total);
+			}
+			if (_progress->cancelled ()) {
+				/* the entry's header has the complete size, libarchive
+				 * would pad the rest with zeros. Do not keep the archive.
+				 */
+				_write_cancelled = true;
+				break;
+			}
+		}
+		len = read (fd, buf, sizeof (buf));
+	}
+	close (fd);
+
+	return (len < 0 || _write_cancelled) ? -1 : 0;
+}
+
+void
+FileArchive::close_write (bool discard)
+{
+	if (!_write_archive) {
+		return;
+	}
+
+	archive_entry_free (_write_entry);
+	archive_write_close (_write_archive);
+	archive_write_free (_write_archive);
+	_write_entry   = 0;
+	_write_archive = 0;
+
+	if (discard || _write_cancelled) {
+		g_unlink (_req.url);
+	}
+}
@@ -58,6 +58,22 @@ class LIBPBD_API FileArchive
 		int create (const std::string& srcdir, CompressionLevel compression_level = CompressGood);
 		int create (const std::map <std::string, std::string>& filemap, CompressionLevel compression_level = CompressGood);
 
+		/* Write an archive one file at a time, for files that become
+		 * available while the archive is being written.
+		 * add_file () reports progress only when the total size is known
+		 * (see create ()). It honors cancellation: the file that is being
+		 * added is not completed, and the archive is discarded when it is
+		 * closed.
+		 */
+		int  open_write (CompressionLevel compression_level = CompressGood);
+		int  add_file (const std::string& filepath, const std::string& filename);
+		/** @param discard remove the incomplete archive file, this is implied
+		 * when add_file () was cancelled.
+		 */
+		void close_write (bool discard = false);
+		/** number of (uncompressed) bytes added by add_file () */
+		uint64_t bytes_added () const { return _write_bytes; }
+
 		struct MemPipe {
 			public:
 				MemPipe (Progress* p)
@@ -168,6 +184,12 @@ class LIBPBD_API FileArchive
 
 		struct archive_entry* _current_entry;
 		struct archive* _archive;
+
+		struct archive*       _write_archive;
+		struct archive_entry* _write_entry;
+		uint64_t              _write_bytes;
+		uint64_t              _write_total;
+		bool                  _write_cancelled;
 };
 
 } /* namespace */
@@ -118,7 +118,7 @@ public:
 
 	bool set_value (XMLNode const & node) {
 
-		XMLProperty const* p = node.property (property_name());
+		XMLProperty const* p = node.property (XMLPropertyName (property_id ()));
 
 		if (p) {
 			T const v = from_string (p->value ());
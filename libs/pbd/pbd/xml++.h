@@ -41,6 +41,7 @@
 #include <libxml/parser.h>
 #include <libxml/tree.h>
 
+#include <glib.h>
 #include <glibmm/ustring.h>
 
 #include "pbd/string_convert.h"
@@ -58,9 +59,34 @@ public:
 	const std::string& value() const { return _value; }
 	const std::string& set_value(const std::string& v) { return _value = v; }
 
+	GQuark quark() const { return _quark; }
+
 private:
 	std::string _name;
 	std::string _value;
+	GQuark      _quark;
+};
+
+/** Interned property name.
+ *
+ * Looking up a property by its interned name compares integers instead of
+ * strings. Use a static instance for properties that are read repeatedly,
+ * e.g. in set_state():
+ *
+ *   static const XMLPropertyName prop_gain ("gain");
+ *   node.get_property (prop_gain, gain);
+ */
+class LIBPBD_API XMLPropertyName {
+public:
+	/** @param name a string literal, it is not copied */
+	explicit XMLPropertyName (const char* name) : _quark (g_quark_from_static_string (name)) {}
+	explicit XMLPropertyName (GQuark q) : _quark (q) {}
+
+	GQuark      quark() const { return _quark; }
+	const char* name() const { return g_quark_to_string (_quark); }
+
+private:
+	GQuark _quark;
 };
 
 typedef std::vector<XMLNode *>                   XMLNodeList;
@@ -145,6 +171,8 @@ public:
 	XMLProperty const *    property(const std::string&) const;
 	XMLProperty *    property(const char*);
 	XMLProperty *    property(const std::string&);
+	XMLProperty const *    property(XMLPropertyName const&) const;
+	XMLProperty *    property(XMLPropertyName const&);
 
 	bool has_property_with_value (const std::string&, const std::string&) const;
 
@@ -182,6 +210,19 @@ public:
 		return PBD::string_to<T> (prop->value (), value);
 	}
 
+	bool get_property (XMLPropertyName const& name, std::string& value) const;
+
+	template <class T>
+	bool get_property (XMLPropertyName const& name, T& value) const
+	{
+		XMLProperty const* const prop = property (name);
+		if (!prop) {
+			return false;
+		}
+
+		return PBD::string_to<T> (prop->value (), value);
+	}
+
 	void remove_property(const std::string&);
 	void remove_property_recursively(const std::string&);
 
@@ -202,9 +243,12 @@ private:
 	std::string         _content;
 	XMLNodeList         _children;
 	XMLPropertyList     _proplist;
+	std::vector<GQuark> _propindex; // property name quarks, same order as _proplist
 	mutable XMLNodeList _selected_children;
 
 	void clear_lists ();
+	int  find_property (GQuark) const;
+	int  find_property (const char*) const;
 };
 
 class LIBPBD_API XMLException: public std::exception {
@@ -392,7 +392,9 @@ Stateful::set_id (const XMLNode& node)
 		return true;
 	}
 
-	if (node.get_property ("id", _id)) {
+	static const XMLPropertyName prop_id ("id");
+
+	if (node.get_property (prop_id, _id)) {
 		return true;
 	}
 
@@ -24,6 +24,7 @@
 #include <inttypes.h>
 #include <cerrno>
 #include <cstdio>
+#include <cstdlib>
 #include <limits>
 
 #include <glib.h>
@@ -83,9 +84,38 @@ bool string_to_bool (const std::string& str, bool& val)
 	return false;
 }
 
+/* strtoll()/strtoull() parse like sscanf's "%i" and "%u" conversions,
+ * without scanning the format string.
+ */
+template <class IntType>
+static bool
+_string_to_signed (const char* str, IntType& val)
+{
+	char* end;
+	long long const v = strtoll (str, &end, 0);
+	if (end == str) {
+		return false;
+	}
+	val = (IntType)v;
+	return true;
+}
+
+template <class IntType>
+static bool
+_string_to_unsigned (const char* str, IntType& val)
+{
+	char* end;
+	unsigned long long const v = strtoull (str, &end, 10);
+	if (end == str) {
+		return false;
+	}
+	val = (IntType)v;
+	return true;
+}
+
 bool string_to_int16 (const std::string& str, int16_t& val)
 {
-	if (sscanf (str.c_str (), "%" SCNi16, &val) != 1) {
+	if (!_string_to_signed (str.c_str (), val)) {
 		DEBUG_SCONVERT (
 		    string_compose ("string_to_int16 conversion failed for %1", str));
 		return false;
@@ -95,7 +125,7 @@ bool string_to_int16 (const std::string& str, int16_t& val)
 
 bool string_to_uint16 (const std::string& str, uint16_t& val)
 {
-	if (sscanf (str.c_str (), "%" SCNu16, &val) != 1) {
+	if (!_string_to_unsigned (str.c_str (), val)) {
 		DEBUG_SCONVERT (
 		    string_compose ("string_to_uint16 conversion failed for %1", str));
 		return false;
@@ -105,7 +135,7 @@ bool string_to_uint16 (const std::string& str, uint16_t& val)
 
 bool string_to_int32 (const std::string& str, int32_t& val)
 {
-	if (sscanf (str.c_str (), "%" SCNi32, &val) != 1) {
+	if (!_string_to_signed (str.c_str (), val)) {
 		DEBUG_SCONVERT (
 		    string_compose ("string_to_int32 conversion failed for %1", str));
 		return false;
@@ -115,7 +145,7 @@ bool string_to_int32 (const std::string& str, int32_t& val)
 
 bool string_to_uint32 (const std::string& str, uint32_t& val)
 {
-	if (sscanf (str.c_str (), "%" SCNu32, &val) != 1) {
+	if (!_string_to_unsigned (str.c_str (), val)) {
 		DEBUG_SCONVERT (
 		    string_compose ("string_to_uint32 conversion failed for %1", str));
 		return false;
@@ -125,7 +155,7 @@ bool string_to_uint32 (const std::string& str, uint32_t& val)
 
 bool string_to_int64 (const std::string& str, int64_t& val)
 {
-	if (sscanf (str.c_str (), "%" SCNi64, &val) != 1) {
+	if (!_string_to_signed (str.c_str (), val)) {
 		DEBUG_SCONVERT (
 		    string_compose ("string_to_int64 conversion failed for %1", str));
 		return false;
@@ -135,7 +165,7 @@ bool string_to_int64 (const std::string& str, int64_t& val)
 
 bool string_to_uint64 (const std::string& str, uint64_t& val)
 {
-	if (sscanf (str.c_str (), "%" SCNu64, &val) != 1) {
+	if (!_string_to_unsigned (str.c_str (), val)) {
 		DEBUG_SCONVERT (
 		    string_compose ("string_to_uint64 conversion failed for %1", str));
 		return false;
@@ -84,6 +84,48 @@ XMLTest::testXMLFilenameEncoding ()
 }
 
 
+void
+XMLTest::testInternedPropertyNames ()
+{
+	static const XMLPropertyName prop_gain ("gain");
+	static const XMLPropertyName prop_name ("name");
+
+	XMLNode node ("Node");
+	node.set_property ("name", "foo");
+	node.set_property ("gain", 0.5);
+	node.set_property ("count", 3);
+
+	double gain = 0;
+	CPPUNIT_ASSERT (node.get_property (prop_gain, gain));
+	CPPUNIT_ASSERT_EQUAL (0.5, gain);
+
+	std::string name;
+	CPPUNIT_ASSERT (node.get_property (prop_name, name));
+	CPPUNIT_ASSERT_EQUAL (std::string ("foo"), name);
+
+	/* replacing a value keeps a single property */
+	node.set_property ("gain", 0.25);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3, node.properties ().size ());
+	CPPUNIT_ASSERT (node.get_property (prop_gain, gain));
+	CPPUNIT_ASSERT_EQUAL (0.25, gain);
+
+	/* the index follows removal and copies */
+	node.remove_property ("gain");
+	CPPUNIT_ASSERT (!node.property (prop_gain));
+	CPPUNIT_ASSERT (!node.property ("gain"));
+
+	XMLNode copy (node);
+	int count = 0;
+	CPPUNIT_ASSERT (copy.get_property ("count", count));
+	CPPUNIT_ASSERT_EQUAL (3, count);
+	CPPUNIT_ASSERT (copy.property (prop_name));
+	CPPUNIT_ASSERT (copy == node);
+
+	/* names that were never used by any property */
+	CPPUNIT_ASSERT (!node.property ("xml-test-never-used"));
+	CPPUNIT_ASSERT (!node.property (XMLPropertyName ("xml-test-never-used-either")));
+}
+
 static const char * const root_node_name = "Session";
 static const char * const child_node_name = "Child";
 static const char * const grandchild_node_name = "GrandChild";
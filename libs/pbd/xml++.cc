@@ -237,6 +237,7 @@ XMLNode::XMLNode(const string& n)
 	, _is_content(false)
 {
 	_proplist.reserve (PROPERTY_RESERVE_COUNT);
+	_propindex.reserve (PROPERTY_RESERVE_COUNT);
 }
 
 XMLNode::XMLNode(const string& n, const string& c)
@@ -245,11 +246,13 @@ XMLNode::XMLNode(const string& n, const string& c)
 	, _content(c)
 {
 	_proplist.reserve (PROPERTY_RESERVE_COUNT);
+	_propindex.reserve (PROPERTY_RESERVE_COUNT);
 }
 
 XMLNode::XMLNode(const XMLNode& from)
 {
 	_proplist.reserve (PROPERTY_RESERVE_COUNT);
+	_propindex.reserve (PROPERTY_RESERVE_COUNT);
 	*this = from;
 }
 
@@ -277,6 +280,35 @@ XMLNode::clear_lists ()
 	}
 
 	_proplist.clear ();
+	_propindex.clear ();
+}
+
+int
+XMLNode::find_property (GQuark q) const
+{
+	if (q == 0) {
+		return -1;
+	}
+	for (size_t i = 0; i < _propindex.size (); ++i) {
+		if (_propindex[i] == q) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/* Looking up a name's quark takes glib's global quark lock, so plain
+ * names are compared as strings. Use XMLPropertyName for frequent lookups.
+ */
+int
+XMLNode::find_property (const char* name) const
+{
+	for (size_t i = 0; i < _proplist.size (); ++i) {
+		if (_proplist[i]->name () == name) {
+			return i;
+		}
+	}
+	return -1;
 }
 
 XMLNode&
@@ -522,88 +554,61 @@ XMLNode::add_content(const string& c)
 XMLProperty const *
 XMLNode::property(const char* name) const
 {
-	XMLPropertyConstIterator iter = _proplist.begin();
-
-	while (iter != _proplist.end()) {
-		if ((*iter)->name() == name) {
-			return *iter;
-		}
-		++iter;
-	}
-
-	return 0;
+	int const i = find_property (name);
+	return i < 0 ? 0 : _proplist[i];
 }
 
 XMLProperty const *
 XMLNode::property(const string& name) const
 {
-	XMLPropertyConstIterator iter = _proplist.begin();
+	int const i = find_property (name.c_str ());
+	return i < 0 ? 0 : _proplist[i];
+}
 
-	while (iter != _proplist.end()) {
-		if ((*iter)->name() == name) {
-			return *iter;
-		}
-		++iter;
-	}
-	return 0;
+XMLProperty const *
+XMLNode::property(XMLPropertyName const& name) const
+{
+	int const i = find_property (name.quark ());
+	return i < 0 ? 0 : _proplist[i];
 }
 
 XMLProperty *
 XMLNode::property(const char* name)
 {
-	XMLPropertyIterator iter = _proplist.begin();
-
-	while (iter != _proplist.end()) {
-		if ((*iter)->name() == name) {
-			return *iter;
-		}
-		++iter;
-	}
-	return 0;
+	int const i = find_property (name);
+	return i < 0 ? 0 : _proplist[i];
 }
 
 XMLProperty *
 XMLNode::property(const string& name)
 {
-	XMLPropertyIterator iter = _proplist.begin();
-
-	while (iter != _proplist.end()) {
-		if ((*iter)->name() == name) {
-			return *iter;
-		}
-		++iter;
-	}
+	int const i = find_property (name.c_str ());
+	return i < 0 ? 0 : _proplist[i];
+}
 
-	return 0;
+XMLProperty *
+XMLNode::property(XMLPropertyName const& name)
+{
+	int const i = find_property (name.quark ());
+	return i < 0 ? 0 : _proplist[i];
 }
 
 bool
 XMLNode::has_property_with_value (const string& name, const string& value) const
 {
-	XMLPropertyConstIterator iter = _proplist.begin();
-
-	while (iter != _proplist.end()) {
-		if ((*iter)->name() == name && (*iter)->value() == value) {
-			return true;
-		}
-		++iter;
-	}
-	return false;
+	XMLProperty const* const prop = property (name);
+	return prop && prop->value () == value;
 }
 
 bool
 XMLNode::set_property(const char* name, const string& value)
 {
-	XMLPropertyIterator iter = _proplist.begin();
-
 	std::string const v = PBD::sanitize_utf8 (value);
 
-	while (iter != _proplist.end()) {
-		if ((*iter)->name() == name) {
-			(*iter)->set_value (v);
-			return *iter;
-		}
-		++iter;
+	int const i = find_property (name);
+	if (i >= 0) {
+		_proplist[i]->set_value (v);
+		return true;
 	}
 
 	XMLProperty* new_property = new XMLProperty(name, v);
@@ -612,7 +617,8 @@ XMLNode::set_property(const char* name, const string& value)
 		return 0;
 	}
 
-	_proplist.insert(_proplist.end(), new_property);
+	_proplist.push_back (new_property);
+	_propindex.push_back (new_property->quark ());
 
 	return new_property;
 }
@@ -629,19 +635,27 @@ XMLNode::get_property(const char* name, std::string& value) const
 	return true;
 }
 
+bool
+XMLNode::get_property(XMLPropertyName const& name, std::string& value) const
+{
+	XMLProperty const* const prop = property (name);
+	if (!prop)
+		return false;
+
+	value = prop->value ();
+
+	return true;
+}
+
 void
 XMLNode::remove_property(const string& name)
 {
-	XMLPropertyIterator iter = _proplist.begin();
-
-	while (iter != _proplist.end()) {
-		if ((*iter)->name() == name) {
-			XMLProperty* property = *iter;
-			_proplist.erase (iter);
-			delete property;
-			break;
-		}
-		++iter;
+	int const i = find_property (name.c_str ());
+	if (i >= 0) {
+		XMLProperty* property = _proplist[i];
+		_proplist.erase (_proplist.begin () + i);
+		_propindex.erase (_propindex.begin () + i);
+		delete property;
 	}
 }
 
@@ -718,6 +732,7 @@ XMLNode::remove_node_and_delete(const string& n, const string& propname, const s
 XMLProperty::XMLProperty(const string& n, const string& v)
 	: _name(n)
 	, _value(v)
+	, _quark(g_quark_from_string (n.c_str ()))
 {
 }
 
@@ -27,6 +27,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cerrno>
+#include <cmath>
 #include <algorithm>
 
 #include <unistd.h>
@@ -328,6 +329,10 @@ OSC::stop ()
 	}
 	_surface.clear();
 
+	/* send what the observers queued when they were destroyed */
+	_feedback.flush (std::bind (&OSC::bundle_feedback, this, _1));
+	_feedback.clear ();
+
 	/* stop main loop */
 	if (local_server) {
 		g_source_destroy (local_server);
@@ -420,6 +425,9 @@ OSC::register_callbacks()
 
 		serv = srvs[i];
 
+		/* must be first, it is called for every message and passes it on */
+		lo_server_add_method (serv, 0, 0, _request_source, this);
+
 
 #define REGISTER_CALLBACK(serv,path,types, function) lo_server_add_method (serv, path, types, OSC::_ ## function, this)
 
@@ -639,6 +647,7 @@ OSC::osc_input_handler (IOCondition ioc, lo_server srv)
 {
 	if (ioc & IO_IN) {
 		lo_server_recv (srv);
+		_requester.clear ();
 	}
 
 	if (ioc & ~(IO_IN|IO_PRI)) {
@@ -763,6 +772,14 @@ OSC::_catchall (const char *path, const char *types, lo_arg **argv, int argc, lo
 	return ((OSC*)user_data)->catchall (path, types, argv, argc, msg);
 }
 
+int
+OSC::_request_source (const char *path, const char *types, lo_arg **argv, int argc, lo_message msg, void *user_data)
+{
+	OSC* osc = (OSC*) user_data;
+	osc->_requester = OSCFeedback::destination (osc->get_address (msg));
+	return 1; /* not handled, continue with the matching handler */
+}
+
 int
 OSC::catchall (const char *path, const char* types, lo_arg **argv, int argc, lo_message msg)
 {
@@ -1187,6 +1204,8 @@ OSC::get_surfaces ()
 		PBD::info << string_compose ("	Linkset: %1   Device Id: %2\n", sur->linkset, sur->linkid);
 
 		PBD::info << string_compose ("	Global Observer: %1\n", sur->global_obs != NULL ? "yes" : "NO");
+		OSCFeedback::Stats fs = _feedback.stats (sur->remote_url);
+		PBD::info << string_compose ("	Feedback messages sent: %1   coalesced: %2   packets: %3   bundles: %4\n", fs.sent, fs.coalesced, fs.packets, sur->feedback[17] ? "yes" : "no");
 	}
 	PBD::info << string_compose ("\nList of LinkSets (%1):\n", link_sets.size());
 	std::map<uint32_t, LinkSet>::iterator it;
@@ -5990,9 +6009,20 @@ OSC::sel_eq_shape (int id, float val, lo_message msg)
 // timer callbacks
 bool
 OSC::periodic (void)
+{
+	periodic_observers ();
+
+	/* send feedback collected during this tick */
+	_feedback.flush (std::bind (&OSC::bundle_feedback, this, _1));
+
+	return true;
+}
+
+void
+OSC::periodic_observers ()
 {
 	if (observer_busy) {
-		return true;
+		return;
 	}
 	if (!tick) {
 		Glib::usleep(100); // let flurry of signals subside
@@ -6009,7 +6039,7 @@ OSC::periodic (void)
 			bank_dirty = false;
 			tick = true;
 		}
-		return true;
+		return;
 	}
 
 	if (scrub_speed != 0) {
@@ -6053,7 +6083,6 @@ OSC::periodic (void)
 			x++;
 		}
 	}
-	return true;
 }
 
 XMLNode&
@@ -6609,20 +6638,28 @@ OSC::cue_send_enable (uint32_t id, float state, lo_message msg)
 	return -1;
 }
 
+/* Replies to the surface whose message is being handled are sent right away,
+ * all other feedback is queued and sent by OSC::periodic.
+ */
+void
+OSC::send_feedback (lo_address addr, std::string const& path, std::string const& key, lo_message msg)
+{
+	if (!_requester.empty () && OSCFeedback::destination (addr) == _requester) {
+		_feedback.send_now (addr, path, key, msg);
+	} else {
+		_feedback.queue (addr, path, key, msg);
+	}
+}
+
 // generic send message
 int
 OSC::float_message (string path, float val, lo_address addr)
 {
-	_lo_lock.lock ();
-
 	lo_message reply;
 	reply = lo_message_new ();
 	lo_message_add_float (reply, (float) val);
 
-	lo_send_message (addr, path.c_str(), reply);
-	Glib::usleep(1);
-	lo_message_free (reply);
-	_lo_lock.unlock ();
+	send_feedback (addr, path, path, reply);
 
 	return 0;
 }
@@ -6630,35 +6667,29 @@ OSC::float_message (string path, float val, lo_address addr)
 int
 OSC::float_message_with_id (std::string path, uint32_t ssid, float value, bool in_line, lo_address addr)
 {
-	_lo_lock.lock ();
+	std::string key;
 	lo_message msg = lo_message_new ();
 	if (in_line) {
 		path = string_compose ("%1/%2", path, ssid);
+		key = path;
 	} else {
 		lo_message_add_int32 (msg, ssid);
+		key = string_compose ("%1 %2", path, ssid);
 	}
 	lo_message_add_float (msg, value);
 
-	lo_send_message (addr, path.c_str(), msg);
-	Glib::usleep(1);
-	lo_message_free (msg);
-	_lo_lock.unlock ();
+	send_feedback (addr, path, key, msg);
 	return 0;
 }
 
 int
 OSC::int_message (string path, int val, lo_address addr)
 {
-	_lo_lock.lock ();
-
 	lo_message reply;
 	reply = lo_message_new ();
 	lo_message_add_int32 (reply, (float) val);
 
-	lo_send_message (addr, path.c_str(), reply);
-	Glib::usleep(1);
-	lo_message_free (reply);
-	_lo_lock.unlock ();
+	send_feedback (addr, path, path, reply);
 
 	return 0;
 }
@@ -6666,35 +6697,29 @@ OSC::int_message (string path, int val, lo_address addr)
 int
 OSC::int_message_with_id (std::string path, uint32_t ssid, int value, bool in_line, lo_address addr)
 {
-	_lo_lock.lock ();
+	std::string key;
 	lo_message msg = lo_message_new ();
 	if (in_line) {
 		path = string_compose ("%1/%2", path, ssid);
+		key = path;
 	} else {
 		lo_message_add_int32 (msg, ssid);
+		key = string_compose ("%1 %2", path, ssid);
 	}
 	lo_message_add_int32 (msg, value);
 
-	lo_send_message (addr, path.c_str(), msg);
-	Glib::usleep(1);
-	lo_message_free (msg);
-	_lo_lock.unlock ();
+	send_feedback (addr, path, key, msg);
 	return 0;
 }
 
 int
 OSC::text_message (string path, string val, lo_address addr)
 {
-	_lo_lock.lock ();
-
 	lo_message reply;
 	reply = lo_message_new ();
 	lo_message_add_string (reply, val.c_str());
 
-	lo_send_message (addr, path.c_str(), reply);
-	Glib::usleep(1);
-	lo_message_free (reply);
-	_lo_lock.unlock ();
+	send_feedback (addr, path, path, reply);
 
 	return 0;
 }
@@ -6702,23 +6727,33 @@ OSC::text_message (string path, string val, lo_address addr)
 int
 OSC::text_message_with_id (std::string path, uint32_t ssid, std::string val, bool in_line, lo_address addr)
 {
-	_lo_lock.lock ();
+	std::string key;
 	lo_message msg = lo_message_new ();
 	if (in_line) {
 		path = string_compose ("%1/%2", path, ssid);
+		key = path;
 	} else {
 		lo_message_add_int32 (msg, ssid);
+		key = string_compose ("%1 %2", path, ssid);
 	}
 
 	lo_message_add_string (msg, val.c_str());
 
-	lo_send_message (addr, path.c_str(), msg);
-	Glib::usleep(1);
-	lo_message_free (msg);
-	_lo_lock.unlock ();
+	send_feedback (addr, path, key, msg);
 	return 0;
 }
 
+bool
+OSC::bundle_feedback (std::string const& url) const
+{
+	for (uint32_t it = 0; it < _surface.size(); ++it) {
+		if (!_surface[it].remote_url.find (url)) {
+			return _surface[it].feedback[17];
+		}
+	}
+	return false;
+}
+
 // we have to have a sorted list of stripables that have sends pointed at our aux
 // we can use the one in osc.cc to get an aux list
 OSC::Sorted
@@ -48,6 +48,7 @@
 
 #include "pbd/i18n.h"
 
+#include "osc_feedback.h"
 
 class OSCControllable;
 class OSCRouteObserver;
@@ -191,6 +192,7 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 		 * [14] - use OSC 1.0 only (#reply -> /reply)
 		 * [15] - report 8x8 trigger grid status
 		 * [16] - report mixer scene status
+		 * [17] - Send feedback as OSC bundles
 		 *
 		 * Strip_type bits:
 		 * [0] - Audio Tracks
@@ -338,6 +340,8 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 
 	int catchall (const char *path, const char *types, lo_arg **argv, int argc, lo_message msg);
 	static int _catchall (const char *path, const char *types, lo_arg **argv, int argc, lo_message msg, void *user_data);
+	/* records the sender of every incoming message, see OSC::send_feedback */
+	static int _request_source (const char *path, const char *types, lo_arg **argv, int argc, lo_message msg, void *user_data);
 
 	int set_automation (const char *path, const char* types, lo_arg **argv, int argc, lo_message msg);
 	int touch_detect (const char *path, const char* types, lo_arg **argv, int argc, lo_message msg);
@@ -762,7 +766,13 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	int cancel_all_solos ();
 	int osc_toggle_roll (bool ret2strt);
 	bool periodic (void);
+	void periodic_observers ();
 	sigc::connection periodic_connection;
+
+	OSCFeedback _feedback;
+	std::string _requester; // destination of the message that is being handled
+	bool bundle_feedback (std::string const& url) const;
+	void send_feedback (lo_address addr, std::string const& path, std::string const& key, lo_message msg);
 	PBD::ScopedConnectionList session_connections;
 
 	void debugmsg (const char *prefix, const char *path, const char* types, lo_arg **argv, int argc);
@@ -0,0 +1,237 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "osc_feedback.h"
+
+/* packets per destination and tick (OSC::periodic runs every 100ms) */
+#define MAX_PACKETS_PER_TICK 100
+
+/* keep bundles below a typical network MTU */
+#define MAX_BUNDLE_SIZE 1400
+
+using namespace ArdourSurface;
+
+OSCFeedback::OSCFeedback ()
+{
+}
+
+OSCFeedback::~OSCFeedback ()
+{
+	clear ();
+}
+
+std::string
+OSCFeedback::destination (lo_address addr)
+{
+	return std::string (lo_address_get_hostname (addr)) + ":" + lo_address_get_port (addr);
+}
+
+OSCFeedback::Destination&
+OSCFeedback::get_destination (lo_address addr)
+{
+	std::string const dest = destination (addr);
+
+	Destinations::iterator d = _destinations.find (dest);
+
+	if (d == _destinations.end ()) {
+		char* url = lo_address_get_url (addr);
+
+		Destination dst;
+		dst.addr = lo_address_new_from_url (url);
+		dst.url  = url;
+		free (url);
+
+		d = _destinations.insert (std::make_pair (dest, dst)).first;
+	}
+
+	return d->second;
+}
+
+void
+OSCFeedback::queue (lo_address addr, std::string const& path, std::string const& key, lo_message msg)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	Destination& dst (get_destination (addr));
+
+	QueueIndex::iterator i = dst.index.find (key);
+
+	if (i != dst.index.end ()) {
+		/* replace the pending value, keep its position */
+		lo_message_free (i->second->msg);
+		i->second->path = path;
+		i->second->msg  = msg;
+		++dst.stats.coalesced;
+		return;
+	}
+
+	Pending p;
+	p.key  = key;
+	p.path = path;
+	p.msg  = msg;
+
+	dst.index[key] = dst.queue.insert (dst.queue.end (), p);
+}
+
+void
+OSCFeedback::send_now (lo_address addr, std::string const& path, std::string const& key, lo_message msg)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	Destination& dst (get_destination (addr));
+
+	QueueIndex::iterator i = dst.index.find (key);
+
+	if (i != dst.index.end ()) {
+		lo_message_free (i->second->msg);
+		dst.queue.erase (i->second);
+		dst.index.erase (i);
+		++dst.stats.coalesced;
+	}
+
+	lo_send_message (dst.addr, path.c_str (), msg);
+	lo_message_free (msg);
+
+	++dst.stats.sent;
+	++dst.stats.packets;
+}
+
+void
+OSCFeedback::flush (UseBundles const& use_bundles)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	for (Destinations::iterator d = _destinations.begin (); d != _destinations.end (); ++d) {
+		if (!d->second.queue.empty ()) {
+			send (d->second, use_bundles (d->second.url));
+		}
+	}
+}
+
+void
+OSCFeedback::send (Destination& dst, bool bundle)
+{
+	for (uint32_t packets = 0; packets < MAX_PACKETS_PER_TICK && !dst.queue.empty (); ++packets) {
+
+		if (!bundle || dst.queue.size () == 1) {
+			Pending& p (dst.queue.front ());
+			lo_send_message (dst.addr, p.path.c_str (), p.msg);
+			++dst.stats.sent;
+			++dst.stats.packets;
+			pop_front (dst);
+			continue;
+		}
+
+		/* "#bundle\0" and time tag */
+		size_t    size = 16;
+		lo_bundle b    = lo_bundle_new (LO_TT_IMMEDIATE);
+
+		std::vector<lo_message> added;
+
+		for (Queue::iterator i = dst.queue.begin (); i != dst.queue.end (); ++i) {
+			/* element size, followed by the message */
+			size_t const len = 4 + lo_message_length (i->msg, i->path.c_str ());
+			if (!added.empty () && size + len > MAX_BUNDLE_SIZE) {
+				break;
+			}
+			lo_bundle_add_message (b, i->path.c_str (), i->msg);
+			added.push_back (i->msg);
+			size += len;
+		}
+
+		lo_send_bundle (dst.addr, b);
+		lo_bundle_free (b);
+
+		dst.stats.sent += added.size ();
+		++dst.stats.packets;
+
+		for (size_t n = 0; n < added.size (); ++n) {
+			pop_front (dst);
+		}
+	}
+}
+
+void
+OSCFeedback::pop_front (Destination& dst)
+{
+	Pending& p (dst.queue.front ());
+	/* newer liblo reference count messages added to a bundle,
+	 * this releases our reference in either case.
+	 */
+	lo_message_free (p.msg);
+	dst.index.erase (p.key);
+	dst.queue.pop_front ();
+}
+
+void
+OSCFeedback::clear ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	for (Destinations::iterator d = _destinations.begin (); d != _destinations.end (); ++d) {
+		while (!d->second.queue.empty ()) {
+			pop_front (d->second);
+		}
+		lo_address_free (d->second.addr);
+	}
+
+	_destinations.clear ();
+}
+
+OSCFeedback::Stats
+OSCFeedback::stats (std::string const& url) const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	for (Destinations::const_iterator d = _destinations.begin (); d != _destinations.end (); ++d) {
+		if (!url.find (d->second.url)) {
+			return d->second.stats;
+		}
+	}
+
+	return Stats ();
+}
+
+bool
+OSCFeedback::meter_changed (float last, float now)
+{
+	/* always report changes from and to silence */
+	if ((last < -120) != (now < -120)) {
+		return true;
+	}
+	/* signal feedback threshold */
+	if ((last < -40) != (now < -40)) {
+		return true;
+	}
+	/* LED feedback, one LED per 3.75 dB above -54 dB */
+	if (meter_led_level (last) != meter_led_level (now)) {
+		return true;
+	}
+	return fabsf (now - last) >= OSC_METER_DEADBAND;
+}
+
+int
+OSCFeedback::meter_led_level (float db)
+{
+	if (db < -54) {
+		return -1;
+	}
+	return (int) (((db + 54) / 3.75) - 1);
+}
@@ -0,0 +1,121 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __osc_oscfeedback_h__
+#define __osc_oscfeedback_h__
+
+#include <functional>
+#include <list>
+#include <map>
+#include <string>
+
+#include <stdint.h>
+
+#include <glibmm/threads.h>
+#include <lo/lo.h>
+
+/* meter feedback is only sent when the level changed by at least this much [dB] */
+#define OSC_METER_DEADBAND 0.5f
+
+namespace ArdourSurface {
+
+/** Scheduler for feedback sent to OSC surfaces.
+ *
+ * Messages are queued per destination and sent once per tick
+ * (OSC::periodic). Only the most recent message for every path (and
+ * strip) is kept, intermediate values are dropped. Surfaces that accept
+ * bundles get all pending messages packed into as few bundles as
+ * possible. The number of packets per destination and tick is limited,
+ * messages that exceed the limit are sent in the following tick.
+ *
+ * Replies to a surface's explicit query are not delayed, see send_now().
+ */
+class OSCFeedback
+{
+public:
+	OSCFeedback ();
+	~OSCFeedback ();
+
+	/** Queue a message, takes ownership of @a msg.
+	 * A pending message with the same @a key to the same destination is replaced.
+	 */
+	void queue (lo_address addr, std::string const& path, std::string const& key, lo_message msg);
+
+	/** Send a message right away, takes ownership of @a msg.
+	 * A pending message with the same @a key to the same destination is
+	 * dropped, it would be older than this one.
+	 */
+	void send_now (lo_address addr, std::string const& path, std::string const& key, lo_message msg);
+
+	/** identifies a destination, "host:port" */
+	static std::string destination (lo_address);
+
+	/** return true if the surface with the given URL accepts bundles */
+	typedef std::function<bool (std::string const&)> UseBundles;
+
+	/** send pending messages, called once per tick */
+	void flush (UseBundles const&);
+
+	/** drop all pending messages and destinations */
+	void clear ();
+
+	struct Stats {
+		Stats () : sent (0), coalesced (0), packets (0) {}
+		uint64_t sent;      ///< messages sent
+		uint64_t coalesced; ///< messages replaced by a newer value before they were sent
+		uint64_t packets;   ///< UDP packets, single messages or bundles
+	};
+
+	/** statistics of the destination whose URL is a prefix of @a url */
+	Stats stats (std::string const& url) const;
+
+	/** true if a meter level change is large enough to be sent, see OSC_METER_DEADBAND,
+	 * or if it changes the derived signal or LED state */
+	static bool meter_changed (float last, float now);
+	static int  meter_led_level (float db);
+
+private:
+	struct Pending {
+		std::string key;
+		std::string path;
+		lo_message  msg;
+	};
+
+	typedef std::list<Pending>                     Queue;
+	typedef std::map<std::string, Queue::iterator> QueueIndex;
+
+	struct Destination {
+		lo_address  addr;
+		std::string url;
+		Queue       queue;
+		QueueIndex  index;
+		Stats       stats;
+	};
+
+	typedef std::map<std::string, Destination> Destinations;
+
+	mutable Glib::Threads::Mutex _lock;
+	Destinations                 _destinations;
+
+	Destination& get_destination (lo_address);
+
+	void send (Destination&, bool bundle);
+	void pop_front (Destination&);
+};
+
+} // namespace ArdourSurface
+
+#endif /* __osc_oscfeedback_h__ */
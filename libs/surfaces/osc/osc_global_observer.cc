@@ -331,7 +331,7 @@ OSCGlobalObserver::tick ()
 		// the only meter here is master
 		float now_meter = session->master_out()->peak_meter()->meter_level(0, MeterMCP);
 		if (now_meter < -94) now_meter = -193;
-		if (_last_meter != now_meter) {
+		if (OSCFeedback::meter_changed (_last_meter, now_meter)) {
 			if (feedback[7] || feedback[8]) {
 				if (gainmode && feedback[7]) {
 					// change from db to 0-1
@@ -353,8 +353,8 @@ OSCGlobalObserver::tick ()
 				}
 				_osc.float_message (X_("/master/signal"), signal, addr);
 			}
+			_last_meter = now_meter;
 		}
-		_last_meter = now_meter;
 
 	}
 	if (feedback[4]) {
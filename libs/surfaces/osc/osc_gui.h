@@ -119,6 +119,7 @@ private:
 	Gtk::CheckButton use_osc10;
 	Gtk::CheckButton trigger_status;
 	Gtk::CheckButton scene_status;
+	Gtk::CheckButton use_bundles;
 	int fbvalue;
 	void set_bitsets ();
 
@@ -392,7 +392,7 @@ OSCRouteObserver::tick ()
 			now_meter = -193;
 		}
 		if (now_meter < -120) now_meter = -193;
-		if (_last_meter != now_meter) {
+		if (OSCFeedback::meter_changed (_last_meter, now_meter)) {
 			if (feedback[7] || feedback[8]) {
 				if (gainmode && feedback[7]) {
 					_osc.float_message_with_id (X_("/strip/meter"), ssid, ((now_meter + 94) / 100), in_line, addr);
@@ -413,8 +413,8 @@ OSCRouteObserver::tick ()
 				}
 				_osc.float_message_with_id (X_("/strip/signal"), ssid, signal, in_line, addr);
 			}
+			_last_meter = now_meter;
 		}
-		_last_meter = now_meter;
 
 	}
 	if (feedback[1]) {
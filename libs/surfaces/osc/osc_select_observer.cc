@@ -590,7 +590,7 @@ OSCSelectObserver::tick ()
 			now_meter = -193;
 		}
 		if (now_meter < -120) now_meter = -193;
-		if (_last_meter != now_meter) {
+		if (OSCFeedback::meter_changed (_last_meter, now_meter)) {
 			if (feedback[7] || feedback[8]) {
 				string path = X_("/select/meter");
 				if (gainmode && feedback[7]) {
@@ -613,8 +613,8 @@ OSCSelectObserver::tick ()
 				}
 				_osc.float_message (path, signal, addr);
 			}
+			_last_meter = now_meter;
 		}
-		_last_meter = now_meter;
 
 	}
 	if (gain_timeout) {
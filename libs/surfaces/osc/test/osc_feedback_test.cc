@@ -0,0 +1,246 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <lo/lo.h>
+
+#include "osc_feedback.h"
+#include "osc_feedback_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (OSCFeedbackTest);
+
+using namespace ArdourSurface;
+
+namespace {
+
+struct Received {
+	std::string path;
+	float       value;
+};
+
+lo_server             server = 0;
+lo_address            addr   = 0;
+std::string           url;
+std::vector<Received> received;
+
+int
+receive (const char* path, const char* types, lo_arg** argv, int argc, lo_message, void*)
+{
+	Received r;
+	r.path  = path;
+	r.value = (argc > 0 && types[0] == 'f') ? argv[0]->f : 0;
+	received.push_back (r);
+	return 0;
+}
+
+/* receive everything that was sent so far */
+void
+drain ()
+{
+	while (lo_server_recv_noblock (server, 100) > 0) ;
+}
+
+lo_message
+float_msg (float v)
+{
+	lo_message m = lo_message_new ();
+	lo_message_add_float (m, v);
+	return m;
+}
+
+bool
+no_bundles (std::string const&)
+{
+	return false;
+}
+
+bool
+bundles (std::string const&)
+{
+	return true;
+}
+
+} // namespace
+
+void
+OSCFeedbackTest::setUp ()
+{
+	server = lo_server_new_with_proto (NULL, LO_UDP, NULL);
+	CPPUNIT_ASSERT (server);
+	lo_server_add_method (server, NULL, NULL, receive, NULL);
+
+	addr = lo_address_new ("127.0.0.1", std::to_string (lo_server_get_port (server)).c_str ());
+
+	char* u = lo_address_get_url (addr);
+	url = u;
+	free (u);
+
+	received.clear ();
+}
+
+void
+OSCFeedbackTest::tearDown ()
+{
+	lo_address_free (addr);
+	lo_server_free (server);
+	addr   = 0;
+	server = 0;
+}
+
+void
+OSCFeedbackTest::coalesceTest ()
+{
+	OSCFeedback fb;
+
+	fb.queue (addr, "/a", "/a", float_msg (1));
+	fb.queue (addr, "/b", "/b", float_msg (2));
+	fb.queue (addr, "/a", "/a", float_msg (3));
+	/* same path, different strip */
+	fb.queue (addr, "/c", "/c 1", float_msg (4));
+	fb.queue (addr, "/c", "/c 2", float_msg (5));
+
+	/* nothing is sent until flushed */
+	drain ();
+	CPPUNIT_ASSERT (received.empty ());
+
+	fb.flush (no_bundles);
+	drain ();
+
+	/* the latest value, at the position of the first */
+	CPPUNIT_ASSERT_EQUAL ((size_t) 4, received.size ());
+	CPPUNIT_ASSERT_EQUAL (std::string ("/a"), received[0].path);
+	CPPUNIT_ASSERT_EQUAL (3.f, received[0].value);
+	CPPUNIT_ASSERT_EQUAL (std::string ("/b"), received[1].path);
+	CPPUNIT_ASSERT_EQUAL (2.f, received[1].value);
+	CPPUNIT_ASSERT_EQUAL (4.f, received[2].value);
+	CPPUNIT_ASSERT_EQUAL (5.f, received[3].value);
+
+	OSCFeedback::Stats s = fb.stats (url);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 4, s.sent);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 1, s.coalesced);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 4, s.packets);
+
+	/* the queue is empty now */
+	fb.flush (no_bundles);
+	drain ();
+	CPPUNIT_ASSERT_EQUAL ((size_t) 4, received.size ());
+}
+
+void
+OSCFeedbackTest::sendNowTest ()
+{
+	OSCFeedback fb;
+
+	fb.queue (addr, "/a", "/a", float_msg (1));
+	fb.queue (addr, "/b", "/b", float_msg (2));
+
+	/* a reply replaces the older pending value */
+	fb.send_now (addr, "/a", "/a", float_msg (3));
+	drain ();
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1, received.size ());
+	CPPUNIT_ASSERT_EQUAL (std::string ("/a"), received[0].path);
+	CPPUNIT_ASSERT_EQUAL (3.f, received[0].value);
+
+	fb.flush (no_bundles);
+	drain ();
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 2, received.size ());
+	CPPUNIT_ASSERT_EQUAL (std::string ("/b"), received[1].path);
+}
+
+void
+OSCFeedbackTest::packetLimitTest ()
+{
+	OSCFeedback fb;
+
+	for (int i = 0; i < 250; ++i) {
+		std::string const path = "/strip/gain/" + std::to_string (i);
+		fb.queue (addr, path, path, float_msg (i));
+	}
+
+	/* 100 packets per tick */
+	fb.flush (no_bundles);
+	drain ();
+	CPPUNIT_ASSERT_EQUAL ((size_t) 100, received.size ());
+
+	fb.flush (no_bundles);
+	fb.flush (no_bundles);
+	drain ();
+	CPPUNIT_ASSERT_EQUAL ((size_t) 250, received.size ());
+
+	for (int i = 0; i < 250; ++i) {
+		CPPUNIT_ASSERT_EQUAL ((float) i, received[i].value);
+	}
+}
+
+void
+OSCFeedbackTest::bundleTest ()
+{
+	OSCFeedback fb;
+
+	std::string const name (40, 'x');
+	size_t            bytes = 0;
+
+	for (int i = 0; i < 200; ++i) {
+		std::string const path = "/strip/name/" + std::to_string (i);
+		lo_message        m    = lo_message_new ();
+		lo_message_add_string (m, name.c_str ());
+		bytes += 4 + lo_message_length (m, path.c_str ());
+		fb.queue (addr, path, path, m);
+	}
+
+	fb.flush (bundles);
+	drain ();
+
+	/* all messages arrive in order */
+	CPPUNIT_ASSERT_EQUAL ((size_t) 200, received.size ());
+	for (int i = 0; i < 200; ++i) {
+		CPPUNIT_ASSERT_EQUAL ("/strip/name/" + std::to_string (i), received[i].path);
+	}
+
+	/* split into bundles below the MTU (1400 bytes, including the 16 byte
+	 * bundle header), each filled as much as possible.
+	 */
+	OSCFeedback::Stats s = fb.stats (url);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 200, s.sent);
+	CPPUNIT_ASSERT (s.packets >= (bytes + 1383) / 1384);
+	CPPUNIT_ASSERT (s.packets <= 2 * (bytes + 1383) / 1384);
+}
+
+void
+OSCFeedbackTest::deadbandTest ()
+{
+	/* small changes are not sent */
+	CPPUNIT_ASSERT (!OSCFeedback::meter_changed (-30.f, -30.f));
+	CPPUNIT_ASSERT (!OSCFeedback::meter_changed (-30.f, -30.4f));
+	CPPUNIT_ASSERT (!OSCFeedback::meter_changed (-30.f, -29.6f));
+	CPPUNIT_ASSERT (OSCFeedback::meter_changed (-30.f, -30.5f));
+	CPPUNIT_ASSERT (OSCFeedback::meter_changed (-30.f, -10.f));
+
+	/* unless they cross the silence, signal or LED thresholds */
+	CPPUNIT_ASSERT (OSCFeedback::meter_changed (-120.2f, -119.9f));
+	CPPUNIT_ASSERT (OSCFeedback::meter_changed (-40.2f, -39.9f));
+	CPPUNIT_ASSERT (OSCFeedback::meter_changed (-24.1f, -23.9f));
+	CPPUNIT_ASSERT (!OSCFeedback::meter_changed (-23.9f, -23.6f));
+
+	CPPUNIT_ASSERT_EQUAL (-1, OSCFeedback::meter_led_level (-60.f));
+	CPPUNIT_ASSERT_EQUAL (7, OSCFeedback::meter_led_level (-23.9f));
+	CPPUNIT_ASSERT_EQUAL (6, OSCFeedback::meter_led_level (-24.1f));
+}
@@ -16,12 +16,77 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <sstream>
 
 #include "client.h"
 
+// maximum number of feedback ticks between frames
+#define MAX_FRAME_INTERVAL 16
+
 using namespace ArdourSurface;
 
+ClientOutputBuffer::ClientOutputBuffer (const ClientOutputBuffer& other)
+    : _queue (other._queue)
+{
+	reindex ();
+}
+
+ClientOutputBuffer&
+ClientOutputBuffer::operator= (const ClientOutputBuffer& other)
+{
+	if (this != &other) {
+		_queue = other._queue;
+		reindex ();
+	}
+	return *this;
+}
+
+void
+ClientOutputBuffer::reindex ()
+{
+	/* the index refers to elements of this queue */
+	_index.clear ();
+	for (Queue::iterator it = _queue.begin (); it != _queue.end (); ++it) {
+		_index[it->node_addr_hash ()] = it;
+	}
+}
+
+void
+ClientOutputBuffer::push (const NodeState& state)
+{
+	std::size_t          key = state.node_addr_hash ();
+	QueueIndex::iterator it  = _index.find (key);
+
+	if (it != _index.end ()) {
+		/* replace the queued value, keep its position */
+		*it->second = state;
+	} else {
+		_index[key] = _queue.insert (_queue.end (), state);
+	}
+}
+
+void
+ClientOutputBuffer::pop_front ()
+{
+	_index.erase (_queue.front ().node_addr_hash ());
+	_queue.pop_front ();
+}
+
+void
+ClientOutputBuffer::take (const std::string& node, std::vector<NodeState>& states, size_t max)
+{
+	for (Queue::iterator it = _queue.begin (); it != _queue.end () && states.size () < max;) {
+		if (it->node () == node) {
+			states.push_back (*it);
+			_index.erase (it->node_addr_hash ());
+			it = _queue.erase (it);
+		} else {
+			++it;
+		}
+	}
+}
+
 bool
 ClientContext::has_state (const NodeState& node_state)
 {
@@ -58,6 +123,42 @@ ClientContext::update_state (const NodeState& node_state)
 	_state.insert (node_state);
 }
 
+bool
+ClientContext::frame_due ()
+{
+	if (--_frame_countdown > 0) {
+		return false;
+	}
+
+	if (_frame_pending) {
+		/* the previous frame was not written when the next one became
+		 * due, back off once per missed frame, up to MAX_FRAME_INTERVAL
+		 */
+		_frame_interval  = std::min<uint32_t> (_frame_interval * 2, MAX_FRAME_INTERVAL);
+		_frame_countdown = _frame_interval;
+		return false;
+	}
+
+	_frame_countdown = _frame_interval;
+	return true;
+}
+
+void
+ClientContext::frame_requested ()
+{
+	_frame_pending = true;
+}
+
+void
+ClientContext::frame_sent ()
+{
+	if (_frame_pending && _frame_interval > 1) {
+		/* client keeps up, recover gradually */
+		--_frame_interval;
+	}
+	_frame_pending = false;
+}
+
 std::string
 ClientContext::debug_str ()
 {
@@ -19,8 +19,10 @@
 #ifndef _ardour_surface_websockets_client_h_
 #define _ardour_surface_websockets_client_h_
 
-#include <set>
 #include <list>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 #include "message.h"
 #include "state.h"
@@ -29,13 +31,54 @@ typedef struct lws* Client;
 
 namespace ArdourSurface {
 
-typedef std::list<NodeStateMessage> ClientOutputBuffer;
+/* Pending output of a client. Only the latest value of every
+ * node and address is kept, a new value replaces a queued one.
+ */
+class ClientOutputBuffer
+{
+public:
+	ClientOutputBuffer () {}
+	ClientOutputBuffer (const ClientOutputBuffer&);
+	ClientOutputBuffer& operator= (const ClientOutputBuffer&);
+
+	void push (const NodeState&);
+
+	bool empty () const
+	{
+		return _queue.empty ();
+	}
+
+	const NodeState& front () const
+	{
+		return _queue.front ();
+	}
+
+	void pop_front ();
+
+	/* move up to max queued states of the given node to the vector,
+	 * in queue order */
+	void take (const std::string& node, std::vector<NodeState>&, size_t max);
+
+private:
+	void reindex ();
+
+	typedef std::list<NodeState> Queue;
+	Queue                        _queue;
+
+	typedef std::unordered_map<std::size_t, Queue::iterator> QueueIndex;
+	QueueIndex                                               _index;
+};
 
 class ClientContext
 {
 public:
 	ClientContext (Client wsi)
-	    : _wsi (wsi){};
+	    : _wsi (wsi)
+	    , _batch (false)
+	    , _binary_meter (false)
+	    , _frame_pending (false)
+	    , _frame_interval (1)
+	    , _frame_countdown (1){};
 	virtual ~ClientContext (){};
 
 	Client wsi () const
@@ -51,11 +94,43 @@ public:
 		return _output_buf;
 	}
 
+	/* client understands multiple messages per frame */
+	bool batch () const
+	{
+		return _batch;
+	}
+
+	/* client understands binary meter frames */
+	bool binary_meter () const
+	{
+		return _binary_meter;
+	}
+
+	void set_features (bool batch, bool binary_meter)
+	{
+		_batch        = batch;
+		_binary_meter = binary_meter;
+	}
+
+	/* Frame pacing, called once per feedback tick. Returns true if
+	 * pending output should be written now. A client that has not
+	 * consumed the previous frame yet is sent frames less often.
+	 */
+	bool frame_due ();
+	void frame_requested ();
+	void frame_sent ();
+
 	std::string debug_str ();
 
 private:
 	Client _wsi;
 
+	bool     _batch;
+	bool     _binary_meter;
+	bool     _frame_pending;
+	uint32_t _frame_interval;
+	uint32_t _frame_countdown;
+
 	typedef std::set<NodeState> ClientState;
 	ClientState                 _state;
 
@@ -36,7 +36,8 @@ WebsocketsDispatcher::NodeMethodMap
 		NODE_METHOD_PAIR (strip_pan),
 		NODE_METHOD_PAIR (strip_mute),
 		NODE_METHOD_PAIR (strip_plugin_enable),
-		NODE_METHOD_PAIR (strip_plugin_param_value)
+		NODE_METHOD_PAIR (strip_plugin_param_value),
+		NODE_METHOD_PAIR (client_features)
 	};
 
 void
@@ -170,6 +171,27 @@ WebsocketsDispatcher::transport_record_handler (Client client, const NodeStateMe
 	}
 }
 
+void
+WebsocketsDispatcher::client_features_handler (Client client, const NodeStateMessage& msg)
+{
+	const NodeState& state = msg.state ();
+
+	bool batch        = false;
+	bool binary_meter = false;
+
+	for (int i = 0; i < state.n_val (); ++i) {
+		std::string feature = state.nth_val (i);
+
+		if (feature == "batch") {
+			batch = true;
+		} else if (feature == "binary_meter") {
+			binary_meter = true;
+		}
+	}
+
+	server ().set_client_features (client, batch, binary_meter);
+}
+
 void
 WebsocketsDispatcher::strip_gain_handler (Client client, const NodeStateMessage& msg)
 {
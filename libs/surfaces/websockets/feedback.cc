@@ -30,6 +30,9 @@
 // TO DO: make this configurable
 #define POLL_INTERVAL_MS 100
 
+// pending feedback is sent to clients once per tick
+#define TICK_INTERVAL_MS 25
+
 using namespace ARDOUR;
 using namespace ArdourSurface;
 
@@ -124,9 +127,10 @@ ArdourFeedback::start ()
 	observe_mixer ();
 
 	// some values need polling like the strip meters
-	Glib::RefPtr<Glib::TimeoutSource> periodic_timeout = Glib::TimeoutSource::create (POLL_INTERVAL_MS);
+	Glib::RefPtr<Glib::TimeoutSource> periodic_timeout = Glib::TimeoutSource::create (TICK_INTERVAL_MS);
 	_periodic_connection                               = periodic_timeout->connect (sigc::mem_fun (*this,
-                                                                         &ArdourFeedback::poll));
+                                                                         &ArdourFeedback::tick));
+	_tick_count = 0;
 
 	// server must be started before feedback otherwise
 	// read_blocks_event_loop() will always return false
@@ -207,6 +211,20 @@ ArdourFeedback::event_loop () const
 }
 
 bool
+ArdourFeedback::tick ()
+{
+	// changes observed since the last tick are coalesced and sent as one frame
+	if (++_tick_count >= POLL_INTERVAL_MS / TICK_INTERVAL_MS) {
+		_tick_count = 0;
+		poll ();
+	}
+
+	server ().flush_clients ();
+
+	return true;
+}
+
+void
 ArdourFeedback::poll () const
 {
 	update_all (Node::transport_time, transport ().time ());
@@ -218,8 +236,6 @@ ArdourFeedback::poll () const
 		double db = it->second->meter_level_db ();
 		update_all (Node::strip_meter, it->first, db);
 	}
-
-	return true;
 }
 
 void
@@ -45,7 +45,8 @@ class ArdourFeedback : public SurfaceComponent
 {
 public:
 	ArdourFeedback (ArdourSurface::ArdourWebsockets& surface)
-	    : SurfaceComponent (surface){};
+	    : SurfaceComponent (surface)
+	    , _tick_count (0){};
 	virtual ~ArdourFeedback (){};
 
 	int start ();
@@ -66,7 +67,10 @@ private:
 
 	PBD::EventLoop* event_loop () const;
 
-	bool poll () const;
+	uint32_t _tick_count;
+
+	bool tick ();
+	void poll () const;
 
 	void observe_transport ();
 	void observe_mixer ();
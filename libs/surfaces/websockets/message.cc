@@ -194,3 +194,39 @@ NodeStateMessage::serialize (void* buf, size_t len) const
 
 	return cs_sz;
 }
+
+static void
+write_u32_le (unsigned char* p, uint32_t v)
+{
+	p[0] = v & 0xff;
+	p[1] = (v >> 8) & 0xff;
+	p[2] = (v >> 16) & 0xff;
+	p[3] = (v >> 24) & 0xff;
+}
+
+size_t
+NodeStateMessage::serialize_meters (const std::vector<NodeState>& states, void* buf, size_t len)
+{
+	size_t size = 4 + 8 * states.size ();
+
+	if (len < size) {
+		return -1;
+	}
+
+	unsigned char* p = static_cast<unsigned char*> (buf);
+
+	write_u32_le (p, 1);
+	p += 4;
+
+	for (std::vector<NodeState>::const_iterator it = states.begin (); it != states.end (); ++it) {
+		float    db = it->n_val () > 0 ? static_cast<double> (it->nth_val (0)) : -std::numeric_limits<float>::infinity ();
+		uint32_t u;
+		memcpy (&u, &db, sizeof (u));
+
+		write_u32_le (p, it->n_addr () > 0 ? it->nth_addr (0) : ADDR_NONE);
+		write_u32_le (p + 4, u);
+		p += 8;
+	}
+
+	return size;
+}
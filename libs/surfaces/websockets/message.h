@@ -19,6 +19,8 @@
 #ifndef _ardour_surface_websockets_message_h_
 #define _ardour_surface_websockets_message_h_
 
+#include <vector>
+
 #include "state.h"
 
 namespace ArdourSurface {
@@ -31,6 +33,12 @@ public:
 
 	size_t serialize (void*, size_t) const;
 
+	/* Compact binary encoding of strip meter states, little endian:
+	 * uint32 frame type (1), followed by uint32 strip id and float32 dB
+	 * for every strip.
+	 */
+	static size_t serialize_meters (const std::vector<NodeState>&, void*, size_t);
+
 	bool is_valid () const
 	{
 		return _valid;
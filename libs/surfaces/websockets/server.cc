@@ -45,6 +45,7 @@
 								(LWS_LIBRARY_VERSION_MINOR * 1000)
 
 #define MAX_INDEX_SIZE	65536
+#define MAX_FRAME_SIZE	65536
 
 using namespace Glib;
 using namespace ArdourSurface;
@@ -55,6 +56,8 @@ WebsocketsServer::WebsocketsServer (ArdourSurface::ArdourWebsockets& surface)
     , _fd_callbacks (false)
     , _g_source (0)
 {
+	_out_buf.resize (LWS_PRE + MAX_FRAME_SIZE);
+
 	/* keep references to all config for libwebsockets 2 */
 	lws_protocols proto;
 	memset (&proto, 0, sizeof (lws_protocols));
@@ -216,8 +219,11 @@ WebsocketsServer::update_client (Client wsi, const NodeState& state, bool force)
 	if (force || !it->second.has_state (state)) {
 		/* write to client only if state was updated */
 		it->second.update_state (state);
-		it->second.output_buf ().push_back (NodeStateMessage (state));
-		request_write (wsi);
+		it->second.output_buf ().push (state);
+		if (force) {
+			/* reply to a request, do not wait for the next tick */
+			request_write (wsi);
+		}
 	}
 }
 
@@ -229,6 +235,31 @@ WebsocketsServer::update_all_clients (const NodeState& state, bool force)
 	}
 }
 
+void
+WebsocketsServer::flush_clients ()
+{
+	for (ClientContextMap::iterator it = _client_ctx.begin (); it != _client_ctx.end (); ++it) {
+		ClientContext& ctx = it->second;
+
+		if (ctx.output_buf ().empty () || !ctx.frame_due ()) {
+			continue;
+		}
+
+		ctx.frame_requested ();
+		request_write (ctx.wsi ());
+	}
+}
+
+void
+WebsocketsServer::set_client_features (Client wsi, bool batch, bool binary_meter)
+{
+	ClientContextMap::iterator it = _client_ctx.find (wsi);
+
+	if (it != _client_ctx.end ()) {
+		it->second.set_features (batch, binary_meter);
+	}
+}
+
 int
 WebsocketsServer::add_client (Client wsi)
 {
@@ -282,37 +313,127 @@ WebsocketsServer::write_client (Client wsi)
 		return 1;
 	}
 
-	ClientOutputBuffer& pending = it->second.output_buf ();
+	ClientContext&      ctx     = it->second;
+	ClientOutputBuffer& pending = ctx.output_buf ();
+
 	if (pending.empty ()) {
+		ctx.frame_sent ();
+		return 0;
+	}
+
+	if (lws_send_pipe_choked (wsi)) {
+		/* previous frame is still being sent, retry when writable */
+		request_write (wsi);
 		return 0;
 	}
 
 	/* one lws_write() call per LWS_CALLBACK_SERVER_WRITEABLE callback */
 
-	NodeStateMessage msg = pending.front ();
-	pending.pop_front ();
+	int rc;
+	std::vector<NodeState> meters;
+
+	if (ctx.binary_meter ()) {
+		/* as many as fit in a frame (4 byte header, 8 bytes per meter),
+		 * the others remain queued for the next frame.
+		 */
+		pending.take (Node::strip_meter, meters, (MAX_FRAME_SIZE - 4) / 8);
+	}
+
+	if (!meters.empty ()) {
+		rc = write_meters (wsi, meters);
+	} else if (ctx.batch ()) {
+		rc = write_batch (wsi, pending);
+	} else {
+		NodeStateMessage msg (pending.front ());
+		pending.pop_front ();
 
-	unsigned char out_buf[1024];
-	int len = msg.serialize (out_buf + LWS_PRE, 1024 - LWS_PRE);
+		unsigned char* out_buf = &_out_buf[LWS_PRE];
+		int len = msg.serialize (out_buf, MAX_FRAME_SIZE);
 
-	if (len > 0) {
+		if (len > 0) {
 #ifdef PRINT_TRAFFIC
-		std::cerr << "TX " << msg.state ().debug_str () << std::endl;
+			std::cerr << "TX " << msg.state ().debug_str () << std::endl;
 #endif
-		if (lws_write (wsi, out_buf + LWS_PRE, len, LWS_WRITE_TEXT) != len) {
-			return 1;
+			rc = lws_write (wsi, out_buf, len, LWS_WRITE_TEXT) != len ? 1 : 0;
+		} else {
+			PBD::error << "ArdourWebsockets: cannot serialize message" << endmsg;
+			rc = 0;
 		}
-	} else {
-		PBD::error << "ArdourWebsockets: cannot serialize message" << endmsg;
+	}
+
+	if (rc != 0) {
+		return rc;
 	}
 
 	if (!pending.empty ()) {
 		request_write (wsi);
+	} else {
+		ctx.frame_sent ();
 	}
 
 	return 0;
 }
 
+int
+WebsocketsServer::write_batch (Client wsi, ClientOutputBuffer& pending)
+{
+	/* as many messages as fit in a frame, as JSON array */
+	unsigned char* out_buf = &_out_buf[LWS_PRE];
+	int            len     = 1;
+
+	out_buf[0] = '[';
+
+	while (!pending.empty ()) {
+		NodeStateMessage msg (pending.front ());
+
+		/* reserve space for separator and closing bracket */
+		int sep  = len > 1 ? 1 : 0;
+		int room = MAX_FRAME_SIZE - len - sep - 1;
+		int n    = room > 0 ? msg.serialize (out_buf + len + sep, room) : -1;
+
+		if (n <= 0) {
+			if (len == 1) {
+				/* does not fit into an empty frame */
+				PBD::error << "ArdourWebsockets: cannot serialize message" << endmsg;
+				pending.pop_front ();
+				continue;
+			}
+			break;
+		}
+
+#ifdef PRINT_TRAFFIC
+		std::cerr << "TX " << msg.state ().debug_str () << std::endl;
+#endif
+		if (sep) {
+			out_buf[len] = ',';
+		}
+		len += sep + n;
+		pending.pop_front ();
+	}
+
+	if (len == 1) {
+		return 0;
+	}
+
+	out_buf[len++] = ']';
+
+	return lws_write (wsi, out_buf, len, LWS_WRITE_TEXT) != len ? 1 : 0;
+}
+
+int
+WebsocketsServer::write_meters (Client wsi, const std::vector<NodeState>& meters)
+{
+	unsigned char* out_buf = &_out_buf[LWS_PRE];
+	int            len     = NodeStateMessage::serialize_meters (meters, out_buf, MAX_FRAME_SIZE);
+
+	if (len <= 0) {
+		PBD::error << "ArdourWebsockets: cannot serialize meters" << endmsg;
+		return 0;
+	}
+
+	return lws_write (wsi, out_buf, len, LWS_WRITE_BINARY) != len ? 1 : 0;
+}
+
 int
 WebsocketsServer::send_availsurf_hdr (Client wsi)
 {
@@ -53,6 +53,11 @@ public:
 	void update_client (Client, const NodeState&, bool);
 	void update_all_clients (const NodeState&, bool);
 
+	/* write pending feedback, called once per feedback tick */
+	void flush_clients ();
+
+	void set_client_features (Client, bool batch, bool binary_meter);
+
 private:
 #if LWS_LIBRARY_VERSION_MAJOR < 3
 	struct lws_protocol_vhost_options _lws_vhost_opt;
@@ -68,10 +73,14 @@ private:
 
 	ServerResources _resources;
 
+	std::vector<unsigned char> _out_buf;
+
 	int add_client (Client);
 	int del_client (Client);
 	int recv_client (Client, void*, size_t);
 	int write_client (Client);
+	int write_batch (Client, ClientOutputBuffer&);
+	int write_meters (Client, const std::vector<NodeState>&);
 	int send_availsurf_hdr (Client);
 	int send_availsurf_body (Client);
 
@@ -47,6 +47,7 @@ namespace Node
 	const std::string transport_bbt                  = "transport_bbt";
 	const std::string transport_roll                 = "transport_roll";
 	const std::string transport_record               = "transport_record";
+	const std::string client_features                = "client_features";
 } // namespace Node
 
 typedef std::vector<uint32_t>   AddressVector;
@@ -1052,8 +1052,16 @@ WaveView::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) cons
 		}
 	}
 
+	WaveViewCache::Stats& stats (WaveViewCache::get_instance ()->stats ());
+
 	if (!image_to_draw) {
 		// No existing image to draw
+		if (!current_request) {
+			/* a pending request (it is for the same image, see above)
+			 * was counted when it was made, not on every redraw.
+			 */
+			++stats.misses;
+		}
 
 		std::shared_ptr<WaveViewDrawRequest> const request = create_draw_request (required_props);
 
@@ -1084,6 +1092,7 @@ WaveView::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) cons
 				image_to_draw = request->image;
 			} else {
 				// Waiting for current request to finish
+				draw_scaled_image (context, self, draw, required_props);
 				redraw ();
 				return;
 			}
@@ -1091,9 +1100,14 @@ WaveView::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) cons
 			// Defer the rendering to another thread or perhaps render pass if
 			// a thread cannot generate it in time.
 			queue_draw_request (request);
+			if (draw_scaled_image (context, self, draw, required_props)) {
+				++stats.scaled_hits;
+			}
 			redraw ();
 			return;
 		}
+	} else {
+		++stats.hits;
 	}
 
 	/* reset this so that future missing images can be generated in a worker thread. */
@@ -1162,6 +1176,44 @@ WaveView::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) cons
 	context->fill ();
 }
 
+bool
+WaveView::draw_scaled_image (Cairo::RefPtr<Cairo::Context> context, Rect const& self, Rect const& draw,
+                             WaveViewProperties const& required_props) const
+{
+	std::shared_ptr<WaveViewImage> image = get_cache_group ()->lookup_scaled_image (required_props);
+
+	if (!image) {
+		return false;
+	}
+
+	double const      samples_per_pixel = _props->samples_per_pixel;
+	samplepos_t const region_position   = _region->position().samples();
+	samplepos_t const region_view_x     = round (round (region_position / samples_per_pixel) * samples_per_pixel);
+	ARDOUR::sampleoffset_t region_view_dx = region_position - region_view_x;
+
+	/* position and width of the image at the current zoom level */
+	double const scale  = image->props.samples_per_pixel / samples_per_pixel;
+	double const origin = self.x0 + (image->props.get_sample_start () - _props->region_start + region_view_dx) / samples_per_pixel;
+	double const width  = image->cairo_image->get_width () * scale;
+
+	Rect const area = draw.intersection (Rect (origin, draw.y0, origin + width, draw.y1));
+
+	if (!area) {
+		return false;
+	}
+
+	context->save ();
+	context->rectangle (area.x0, area.y0, area.width (), area.height ());
+	context->clip ();
+	context->translate (origin, self.y0);
+	context->scale (scale, 1.0);
+	context->set_source (image->cairo_image, 0, 0);
+	context->paint ();
+	context->restore ();
+
+	return true;
+}
+
 void
 WaveView::compute_bounding_box () const
 {
@@ -1405,6 +1457,25 @@ WaveView::set_image_cache_size (uint64_t sz)
 	WaveViewCache::get_instance()->set_image_cache_threshold (sz);
 }
 
+void
+WaveView::image_cache_stats (uint64_t& size, uint64_t& hits, uint64_t& scaled_hits, uint64_t& misses, uint64_t& evictions)
+{
+	WaveViewCache* cache = WaveViewCache::get_instance ();
+	WaveViewCache::Stats const& stats (cache->stats ());
+
+	size        = cache->size ();
+	hits        = stats.hits;
+	scaled_hits = stats.scaled_hits;
+	misses      = stats.misses;
+	evictions   = stats.evictions;
+}
+
+void
+WaveView::reset_image_cache_stats ()
+{
+	WaveViewCache::get_instance()->reset_stats ();
+}
+
 std::shared_ptr<WaveViewCacheGroup>
 WaveView::get_cache_group () const
 {
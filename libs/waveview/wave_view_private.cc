@@ -18,6 +18,7 @@
  */
 
 #include <cmath>
+#include <limits>
 #include "ardour/lmath.h"
 
 #include "pbd/assert.h"
@@ -91,9 +92,6 @@ WaveViewCacheGroup::add_image (std::shared_ptr<WaveViewImage> image)
 		return;
 	}
 
-	ImageCache::iterator oldest_image_it = _cached_images.begin();
-	ImageCache::iterator second_oldest_image_it = _cached_images.end();
-
 	for (ImageCache::iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
 		if ((*it) == image) {
 			// Must never be more than one instance of the image in the cache
@@ -104,41 +102,64 @@ WaveViewCacheGroup::add_image (std::shared_ptr<WaveViewImage> image)
 			(*it)->timestamp = g_get_monotonic_time ();
 			return;
 		}
-
-		if ((*it)->timestamp < (*oldest_image_it)->timestamp) {
-			second_oldest_image_it = oldest_image_it;
-			oldest_image_it = it;
-		}
 	}
 
 	// no duplicate or equivalent image so we are definitely adding it to cache
 	image->timestamp = g_get_monotonic_time ();
 
-	if (_parent_cache.full () || full ()) {
-		if (oldest_image_it != _cached_images.end()) {
-			// Replacing oldest Image in cache
-			_parent_cache.decrease_size ((*oldest_image_it)->size_in_bytes ());
-			*oldest_image_it = image;
-			_parent_cache.increase_size (image->size_in_bytes ());
-
-			if (second_oldest_image_it != _cached_images.end ()) {
-				// Removing second oldest Image in cache
-				_parent_cache.decrease_size ((*second_oldest_image_it)->size_in_bytes ());
-				_cached_images.erase (second_oldest_image_it);
-			}
-			return;
-		} else {
-			/**
-			 * Add the image to the cache even if the threshold is exceeded so that
-			 * new WaveViews can still cache images with a full cache, the size of
-			 * the cache will quickly equalize back to the threshold as new images
-			 * are added and the size of the cache is reduced.
-			 */
+	/**
+	 * Add the image to the cache even if the threshold is exceeded so that
+	 * new WaveViews can still cache images with a full cache, the size of
+	 * the cache is then reduced by dropping the least recently used images,
+	 * images that are not currently displayed first.
+	 */
+	_cached_images.push_back (image);
+	_parent_cache.increase_size (image->size_in_bytes ());
+
+	if (full () && !evict_one (false)) {
+		evict_one (true);
+	}
+
+	_parent_cache.evict ();
+}
+
+bool
+WaveViewCacheGroup::evict_one (bool in_use_too)
+{
+	ImageCache::iterator oldest = _cached_images.end ();
+
+	for (ImageCache::iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
+		if (!in_use_too && it->use_count () > 1) {
+			// displayed by a WaveView or still being drawn
+			continue;
+		}
+		if (oldest == _cached_images.end () || (*it)->timestamp < (*oldest)->timestamp) {
+			oldest = it;
 		}
 	}
 
-	_cached_images.push_back (image);
-	_parent_cache.increase_size (image->size_in_bytes ());
+	if (oldest == _cached_images.end ()) {
+		return false;
+	}
+
+	_parent_cache.decrease_size ((*oldest)->size_in_bytes ());
+	_cached_images.erase (oldest);
+	++_parent_cache.stats ().evictions;
+	return true;
+}
+
+uint64_t
+WaveViewCacheGroup::oldest_unused () const
+{
+	uint64_t oldest = std::numeric_limits<uint64_t>::max ();
+
+	for (ImageCache::const_iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
+		if (it->use_count () == 1) {
+			oldest = std::min (oldest, (*it)->timestamp);
+		}
+	}
+
+	return oldest;
 }
 
 std::shared_ptr<WaveViewImage>
@@ -146,12 +167,56 @@ WaveViewCacheGroup::lookup_image (WaveViewProperties const& props)
 {
 	for (ImageCache::iterator i = _cached_images.begin (); i != _cached_images.end (); ++i) {
 		if ((*i)->props.is_equivalent (props)) {
+			(*i)->timestamp = g_get_monotonic_time ();
 			return (*i);
 		}
 	}
 	return std::shared_ptr<WaveViewImage>();
 }
 
+std::shared_ptr<WaveViewImage>
+WaveViewCacheGroup::lookup_scaled_image (WaveViewProperties const& props)
+{
+	std::shared_ptr<WaveViewImage> best;
+	ARDOUR::samplecnt_t            best_overlap = 0;
+	double                         best_distance = 0;
+
+	double const max_distance = log2 (max_zoom_ratio ());
+
+	for (ImageCache::iterator i = _cached_images.begin (); i != _cached_images.end (); ++i) {
+		WaveViewProperties const& p ((*i)->props);
+
+		if (!(*i)->finished () || !p.looks_like (props)) {
+			continue;
+		}
+
+		/* zoom distance in octaves */
+		double const distance = fabs (log2 (p.samples_per_pixel / props.samples_per_pixel));
+
+		if (distance > max_distance) {
+			continue;
+		}
+
+		ARDOUR::samplecnt_t const overlap = p.overlap (props.get_sample_start (), props.get_sample_end ());
+
+		if (overlap <= 0) {
+			continue;
+		}
+
+		if (!best || overlap > best_overlap || (overlap == best_overlap && distance < best_distance)) {
+			best          = *i;
+			best_overlap  = overlap;
+			best_distance = distance;
+		}
+	}
+
+	if (best) {
+		best->timestamp = g_get_monotonic_time ();
+	}
+
+	return best;
+}
+
 void
 WaveViewCacheGroup::clear_cache ()
 {
@@ -251,6 +316,36 @@ void
 WaveViewCache::set_image_cache_threshold (uint64_t sz)
 {
 	_image_cache_threshold = sz;
+	evict ();
+}
+
+void
+WaveViewCache::evict ()
+{
+	while (full ()) {
+		/* find the group with the least recently used image that is not
+		 * displayed anywhere.
+		 */
+		std::shared_ptr<WaveViewCacheGroup> victim;
+		uint64_t                            oldest = std::numeric_limits<uint64_t>::max ();
+
+		for (CacheGroups::iterator it = cache_group_map.begin (); it != cache_group_map.end (); ++it) {
+			uint64_t const t = it->second->oldest_unused ();
+			if (t < oldest) {
+				oldest = t;
+				victim = it->second;
+			}
+		}
+
+		if (!victim) {
+			/* everything that is left is on screen (or being drawn),
+			 * dropping those would not free any memory.
+			 */
+			break;
+		}
+
+		victim->evict_one (false);
+	}
 }
 
 /*-------------------------------------------------*/
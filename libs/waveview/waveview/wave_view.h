@@ -144,6 +144,16 @@ public:
 
 	static void set_image_cache_size (uint64_t);
 
+	/** Retrieve usage statistics of the (global) image cache.
+	 * @param size current size of all cached images in bytes
+	 * @param hits renders that found an image at the exact zoom level
+	 * @param scaled_hits misses that displayed an image of a nearby zoom level meanwhile
+	 * @param misses images that had to be rendered (once per request)
+	 * @param evictions images that were dropped to stay below the size limit
+	 */
+	static void image_cache_stats (uint64_t& size, uint64_t& hits, uint64_t& scaled_hits, uint64_t& misses, uint64_t& evictions);
+	static void reset_image_cache_stats ();
+
 private:
 	friend class WaveViewThreadClient;
 	friend class WaveViewThreads;
@@ -238,6 +248,16 @@ private:
 
 	void queue_draw_request (std::shared_ptr<WaveViewDrawRequest> const&) const;
 
+	/**
+	 * Paint a cached image of a nearby zoom level, re-scaled to the current
+	 * zoom level, as a stand-in while the exact image is drawn by a
+	 * WaveViewThread.
+	 *
+	 * @return true if an image was painted
+	 */
+	bool draw_scaled_image (Cairo::RefPtr<Cairo::Context>, ArdourCanvas::Rect const& self,
+	                        ArdourCanvas::Rect const& draw, WaveViewProperties const&) const;
+
 	static void process_draw_request (std::shared_ptr<WaveViewDrawRequest>);
 
 	std::shared_ptr<WaveViewCacheGroup> get_cache_group () const;
@@ -145,23 +145,37 @@ public: // methods
 		return sample_start + (get_length_samples() / 2);
 	}
 
-	bool is_equivalent (WaveViewProperties const& other)
+	bool is_equivalent (WaveViewProperties const& other) const
 	{
 		return (samples_per_pixel == other.samples_per_pixel &&
-		        contains (other.sample_start, other.sample_end) && channel == other.channel &&
+		        contains (other.sample_start, other.sample_end) && looks_like (other));
+		// region_start && start_shift??
+	}
+
+	/** @return true if an image drawn with these properties only differs
+	 * from one drawn with @p other in zoom level and extent.
+	 */
+	bool looks_like (WaveViewProperties const& other) const
+	{
+		return (channel == other.channel &&
 		        height == other.height && amplitude == other.amplitude &&
 		        amplitude_above_axis == other.amplitude_above_axis && fill_color == other.fill_color &&
 		        outline_color == other.outline_color && zero_color == other.zero_color &&
 		        clip_color == other.clip_color && show_zero == other.show_zero &&
 		        logscaled == other.logscaled && shape == other.shape &&
 		        gradient_depth == other.gradient_depth);
-		// region_start && start_shift??
 	}
 
-	bool contains (samplepos_t start, samplepos_t end)
+	bool contains (samplepos_t start, samplepos_t end) const
 	{
 		return (sample_start <= start && end <= sample_end);
 	}
+
+	/** @return the number of samples of [start, end) that are covered */
+	ARDOUR::samplecnt_t overlap (samplepos_t start, samplepos_t end) const
+	{
+		return std::max<ARDOUR::samplecnt_t> (0, std::min (end, sample_end) - std::max (start, sample_start));
+	}
 };
 
 struct WaveViewImage {
@@ -231,15 +245,40 @@ public:
 	// @return image with matching properties or null
 	std::shared_ptr<WaveViewImage> lookup_image (WaveViewProperties const&);
 
+	/**
+	 * @return a finished image that only differs from the required properties
+	 * in zoom level (by no more than a factor of max_zoom_ratio()) and that
+	 * overlaps the required range, or null. The image with the largest overlap
+	 * is preferred, then the one closest in zoom level.
+	 */
+	std::shared_ptr<WaveViewImage> lookup_scaled_image (WaveViewProperties const&);
+
 	void add_image (std::shared_ptr<WaveViewImage>);
 
 	bool full () const { return _cached_images.size() > max_size(); }
 
 	static uint32_t max_size () { return 16; }
 
+	static double max_zoom_ratio () { return 4.0; }
+
 	void clear_cache ();
 
 private:
+	friend class WaveViewCache;
+
+	/**
+	 * Drop the least recently used image that is not referenced outside of
+	 * the cache (i.e. not displayed by any WaveView or being drawn).
+	 *
+	 * @return false if there was no such image
+	 */
+	bool evict_one (bool in_use_too);
+
+	/** @return timestamp of the least recently used image that is not in use,
+	 * or UINT64_MAX if there is none.
+	 */
+	uint64_t oldest_unused () const;
+
 
 	/**
 	 * At time of writing we don't strictly need a reference to the parent cache
@@ -266,6 +305,19 @@ public:
 
 	void reset_cache_group (std::shared_ptr<WaveViewCacheGroup>&);
 
+	uint64_t size () const { return image_cache_size; }
+
+	struct Stats {
+		Stats () : hits (0), scaled_hits (0), misses (0), evictions (0) {}
+		uint64_t hits;        ///< renders using an image of the exact zoom level
+		uint64_t scaled_hits; ///< misses that could show a re-scaled image meanwhile
+		uint64_t misses;      ///< images that had to be rendered, counted once per request
+		uint64_t evictions;   ///< images dropped to stay below the threshold
+	};
+
+	Stats& stats () { return _stats; }
+	void reset_stats () { _stats = Stats (); }
+
 private:
 	WaveViewCache();
 	~WaveViewCache();
@@ -278,6 +330,7 @@ private:
 
 	uint64_t image_cache_size;
 	uint64_t _image_cache_threshold;
+	Stats    _stats;
 
 private:
 	friend class WaveViewCacheGroup;
@@ -285,6 +338,12 @@ private:
 	void increase_size (uint64_t bytes);
 	void decrease_size (uint64_t bytes);
 
+	/** drop least recently used images across all groups until the cache
+	 * is below the threshold. Images that are in use are never dropped, they
+	 * stay alive with their users, so dropping them would not free memory.
+	 */
+	void evict ();
+
 	bool full () { return image_cache_size > _image_cache_threshold; }
 };
 
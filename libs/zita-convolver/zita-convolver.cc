@@ -65,6 +65,7 @@ Convproc::Convproc (void)
 	, _maxpart (0)
 	, _nlevels (0)
 	, _latecnt (0)
+	, _sched (0)
 {
 	memset (_inpbuff, 0, MAXINP * sizeof (float*));
 	memset (_outbuff, 0, MAXOUT * sizeof (float*));
@@ -229,6 +230,49 @@ Convproc::impdata_clear (uint32_t inp, uint32_t out)
 	return 0;
 }
 
+int
+Convproc::impdata_link (Convproc const& src)
+{
+	uint32_t k;
+
+	if (_state != ST_STOP || src._state == ST_IDLE) {
+		return Converror::BAD_STATE;
+	}
+	if (   (_ninp != src._ninp)
+	    || (_nout != src._nout)
+	    || (_quantum != src._quantum)
+	    || (_minpart != src._minpart)
+	    || (_nlevels != src._nlevels)) {
+		return Converror::BAD_PARAM;
+	}
+	for (k = 0; k < _nlevels; k++) {
+		Convlevel const* a = _convlev[k];
+		Convlevel const* b = src._convlev[k];
+		if (a->_offs != b->_offs || a->_npar != b->_npar || a->_parsize != b->_parsize || a->_options != b->_options) {
+			return Converror::BAD_PARAM;
+		}
+	}
+	try {
+		for (k = 0; k < _nlevels; k++) {
+			_convlev[k]->impdata_link (*src._convlev[k]);
+		}
+	} catch (...) {
+		cleanup ();
+		return Converror::MEM_ALLOC;
+	}
+	return 0;
+}
+
+int
+Convproc::set_scheduler (Convsched* sched)
+{
+	if (_state == ST_PROC || _state == ST_WAIT) {
+		return Converror::BAD_STATE;
+	}
+	_sched = sched;
+	return 0;
+}
+
 int
 Convproc::reset (void)
 {
@@ -263,6 +307,7 @@ Convproc::start_process (int abspri, int policy)
 	reset ();
 
 	for (k = (_minpart == _quantum) ? 1 : 0; k < _nlevels; k++) {
+		_convlev[k]->_sched = _sched;
 		_convlev[k]->start (abspri, policy);
 	}
 
@@ -405,6 +450,14 @@ Convproc::check_stop (void)
 {
 	uint32_t k;
 
+	for (k = 0; k < _nlevels; k++) {
+		/* levels on an external scheduler are done once all queued cycles completed */
+		Convlevel* C = _convlev[k];
+		if (C->_sched && C->_stat == Convlevel::ST_TERM && C->_queued.load () == 0) {
+			C->_stat = Convlevel::ST_IDLE;
+		}
+	}
+
 	for (k = 0; (k < _nlevels) && (_convlev[k]->_stat == Convlevel::ST_IDLE); k++) ;
 	if (k == _nlevels) {
 		_state = ST_STOP;
@@ -435,6 +488,9 @@ Convlevel::Convlevel (void)
 #ifndef PTW32_VERSION
 	, _pthr (0)
 #endif
+	, _sched (0)
+	, _queued (0)
+	, _job (JOB_IDLE)
 	, _inp_list (0)
 	, _out_list (0)
 	, _plan_r2c (0)
@@ -561,6 +617,23 @@ Convlevel::impdata_clear (uint32_t inp, uint32_t out)
 	}
 }
 
+void
+Convlevel::impdata_link (Convlevel const& src)
+{
+	Outnode const* Y;
+	Macnode*       S;
+	Macnode*       M;
+
+	for (Y = src._out_list; Y; Y = Y->_next) {
+		for (S = Y->_list; S; S = S->_next) {
+			M = findmacnode (S->_inpn->_inp, Y->_out, true);
+			if (M && !M->_fftb) {
+				M->_link = S->_link ? S->_link : S;
+			}
+		}
+	}
+}
+
 void
 Convlevel::reset (uint32_t inpsize,
                   uint32_t outsize,
@@ -595,6 +668,8 @@ Convlevel::reset (uint32_t inpsize,
 	_bits  = _parsize / _outsize;
 	_wait  = 0;
 	_ptind = 0;
+	_queued.store (0);
+	_job.store (JOB_IDLE);
 	_opind = 0;
 	_trig.init (0, 0);
 	_done.init (0, 0);
@@ -610,6 +685,12 @@ Convlevel::start (int abspri, int policy)
 #ifndef PTW32_VERSION
 	_pthr = 0;
 #endif
+	if (_sched) {
+		/* cycles are queued to the scheduler by readout () */
+		_stat = ST_PROC;
+		return;
+	}
+
 	min   = sched_get_priority_min (policy);
 	max   = sched_get_priority_max (policy);
 	abspri += _prio;
@@ -636,7 +717,9 @@ Convlevel::stop (void)
 {
 	if (_stat != ST_IDLE) {
 		_stat = ST_TERM;
-		_trig.post ();
+		if (!_sched) {
+			_trig.post ();
+		}
 	}
 }
 
@@ -709,6 +792,20 @@ Convlevel::main (void)
 	}
 }
 
+void
+Convlevel::run (void)
+{
+	int expected = JOB_QUEUED;
+	/* the process thread may have processed the cycle already, see complete () */
+	if (_job.compare_exchange_strong (expected, JOB_RUNNING)) {
+		process ();
+		_job.store (JOB_IDLE);
+		_done.post ();
+	}
+	/* last access, the level may be deleted once all queued cycles completed */
+	_queued.fetch_sub (1);
+}
+
 void
 Convlevel::process ()
 {
@@ -810,6 +907,34 @@ Convlevel::process ()
 	}
 }
 
+void
+Convlevel::complete (void)
+{
+	if (!_sched) {
+		while (_wait) {
+			_done.wait ();
+			_wait--;
+		}
+		return;
+	}
+
+	if (!_wait) {
+		return;
+	}
+
+	int expected = JOB_QUEUED;
+	if (_job.compare_exchange_strong (expected, JOB_IDLE)) {
+		/* not started by the scheduler (yet), never wait for
+		 * a lower priority thread, process the cycle here.
+		 */
+		process ();
+	} else {
+		/* in progress, wait for it to complete */
+		_done.wait ();
+	}
+	_wait = 0;
+}
+
 int
 Convlevel::readout ()
 {
@@ -821,15 +946,22 @@ Convlevel::readout ()
 	if (_outoffs == _parsize) {
 		_outoffs = 0;
 		if (_stat == ST_PROC) {
-			while (_wait) {
-				_done.wait ();
-				_wait--;
-			}
+			complete ();
 			if (++_opind == 3) {
 				_opind = 0;
 			}
-			_trig.post ();
-			_wait++;
+			if (!_sched) {
+				_trig.post ();
+				_wait++;
+			} else {
+				_job.store (JOB_QUEUED);
+				_wait++;
+				_queued.fetch_add (1);
+				if (!_sched->schedule (this)) {
+					/* queue overflow, complete () processes the cycle */
+					_queued.fetch_sub (1);
+				}
+			}
 		} else {
 			process ();
 			if (++_opind == 3) {
@@ -858,10 +990,7 @@ Convlevel::readtail (uint32_t n_samples)
 	uint32_t outoffs = _outoffs + _outsize;
 	if (outoffs == _parsize) {
 
-		while (_wait) {
-			_done.wait ();
-			_wait--;
-		}
+		complete ();
 
 		outoffs = 0;
 		if (++opind == 3) {
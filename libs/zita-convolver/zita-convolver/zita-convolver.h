@@ -21,6 +21,8 @@
 #define ARDOUR_ZITA_CONVOLVER_H
 
 
+#include <atomic>
+
 #include <fftw3.h>
 #include <pthread.h>
 #include <stdint.h>
@@ -227,8 +229,45 @@ private:
 	int _error;
 };
 
-class LIBZCONVOLVER_API Convlevel
+/* A unit of work: processing one cycle of a partition level. */
+class LIBZCONVOLVER_API Convjob
+{
+public:
+	virtual ~Convjob (void) {}
+
+	/* Process the cycle. The job must not be accessed after run () returns */
+	virtual void run (void) = 0;
+
+	/* Partition size of the level, i.e. the number of samples until the
+	 * result of the job is required.
+	 */
+	virtual uint32_t parsize (void) const = 0;
+};
+
+/* Optional external scheduler. When set, partition levels that would
+ * otherwise use a dedicated thread each, are queued to the scheduler.
+ */
+class LIBZCONVOLVER_API Convsched
+{
+public:
+	virtual ~Convsched (void) {}
+
+	/* Called from the process thread, must be realtime safe.
+	 * Returns false if the job cannot be queued, the cycle is then
+	 * processed by the process thread when its result is due.
+	 */
+	virtual bool schedule (Convjob*) = 0;
+};
+
+class LIBZCONVOLVER_API Convlevel : public Convjob
 {
+public:
+	void     run (void);
+	uint32_t parsize (void) const
+	{
+		return _parsize;
+	}
+
 private:
 	friend class Convproc;
 
@@ -244,6 +283,12 @@ private:
 		ST_PROC
 	};
 
+	enum {
+		JOB_IDLE,
+		JOB_QUEUED,
+		JOB_RUNNING
+	};
+
 	Convlevel (void);
 	~Convlevel (void);
 
@@ -264,6 +309,10 @@ private:
 	void impdata_clear (uint32_t inp,
 	                    uint32_t out);
 
+	void impdata_link (Convlevel const& src);
+
+	void complete (void);
+
 	void reset (uint32_t inpsize,
 	            uint32_t outsize,
 	            float**  inpbuff,
@@ -305,6 +354,9 @@ private:
 	int               _bits;      // bit identifiying this level
 	int               _wait;      // number of unfinished cycles
 	pthread_t         _pthr;      // posix thread executing this level
+	Convsched*        _sched;     // external scheduler, replaces _pthr
+	std::atomic<int>  _queued;    // cycles queued to the scheduler
+	std::atomic<int>  _job;       // state of the current cycle on the scheduler
 	ZCsema            _trig;      // sema used to trigger a cycle
 	ZCsema            _done;      // sema used to wait for a cycle
 	Inpnode*          _inp_list;  // linked list of active inputs
@@ -388,8 +440,19 @@ public:
 	int impdata_clear (uint32_t inp,
 	                   uint32_t out);
 
+	/* Use the impulse responses of another, identically configured,
+	 * processor instead of creating a copy. `src` must outlive this
+	 * instance and not be modified while it is in use.
+	 */
+	int impdata_link (Convproc const& src);
+
 	void set_options (uint32_t options);
 
+	/* Run partition levels on an external scheduler instead of
+	 * dedicated threads. Must be called before start_process ().
+	 */
+	int set_scheduler (Convsched* sched);
+
 	int reset (void);
 
 	int start_process (int abspri, int policy);
@@ -422,6 +485,7 @@ private:
 	uint32_t   _inpsize;         // size of input buffers
 	uint32_t   _latecnt;         // count of cycles ending too late
 	Convlevel* _convlev[MAXLEV]; // array of processors
+	Convsched* _sched;           // optional external scheduler
 	void*      _dummy[64];
 
 	static float _mac_cost;
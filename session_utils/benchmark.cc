@@ -0,0 +1,542 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <getopt.h>
+#include <iostream>
+#include <vector>
+
+#ifndef PLATFORM_WINDOWS
+#include <sys/resource.h>
+#endif
+
+#include <glibmm.h>
+
+#include "pbd/file_utils.h"
+#include "pbd/gstdio_compat.h"
+#include "pbd/microseconds.h"
+#include "pbd/ringbuffer.h"
+#include "pbd/signals.h"
+
+#include "ardour/audio_track.h"
+#include "ardour/audioengine.h"
+#include "ardour/audiofilesource.h"
+#include "ardour/butler.h"
+#include "ardour/playlist.h"
+#include "ardour/plugin_insert.h"
+#include "ardour/plugin_manager.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/region_factory.h"
+#include "ardour/track.h"
+
+#include "common.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace SessionUtils;
+
+struct SynthSettings
+{
+	SynthSettings ()
+		: tracks (0)
+		, busses (0)
+		, plugins (0)
+		, regions (0)
+		, plugin ("urn:ardour:a-eq")
+	{}
+
+	uint32_t    tracks;
+	uint32_t    busses;
+	uint32_t    plugins;
+	uint32_t    regions;
+	std::string plugin;
+};
+
+/* length of synthesized regions in seconds */
+static const int region_seconds = 5;
+
+static std::atomic<uint32_t> xrun_count (0);
+
+static void
+count_xrun ()
+{
+	xrun_count.fetch_add (1);
+}
+
+static PluginInfoPtr
+find_plugin_info (std::string const& uri)
+{
+	PluginManager& pm (PluginManager::instance ());
+
+	PluginInfoList const* lists[] = { &pm.lv2_plugin_info (), &pm.lua_plugin_info () };
+
+	for (size_t l = 0; l < sizeof (lists) / sizeof (lists[0]); ++l) {
+		for (PluginInfoList::const_iterator i = lists[l]->begin (); i != lists[l]->end (); ++i) {
+			if ((*i)->unique_id == uri) {
+				return *i;
+			}
+		}
+	}
+	return PluginInfoPtr ();
+}
+
+static std::shared_ptr<Region>
+synth_region (Session* s, std::string const& name)
+{
+	samplecnt_t const len = region_seconds * s->nominal_sample_rate ();
+
+	std::shared_ptr<AudioFileSource> src = s->create_audio_source_for_session (1, name, 0);
+	if (!src) {
+		return std::shared_ptr<Region> ();
+	}
+
+	/* low level noise */
+	std::vector<Sample> buf (8192);
+	for (samplecnt_t written = 0; written < len;) {
+		samplecnt_t const n = std::min<samplecnt_t> (buf.size (), len - written);
+		for (samplecnt_t i = 0; i < n; ++i) {
+			buf[i] = .1f * (g_random_double () - .5);
+		}
+		src->write (&buf[0], n);
+		written += n;
+	}
+	src->mark_immutable ();
+
+	PropertyList plist;
+	plist.add (Properties::start, timecnt_t (Temporal::AudioTime));
+	plist.add (Properties::length, src->length ());
+	plist.add (Properties::name, name);
+	plist.add (Properties::whole_file, true);
+
+	SourceList srcs;
+	srcs.push_back (src);
+	return RegionFactory::create (srcs, plist);
+}
+
+static bool
+synth_session (Session* s, SynthSettings const& settings)
+{
+	PluginInfoPtr pi;
+	if (settings.plugins > 0) {
+		pi = find_plugin_info (settings.plugin);
+		if (!pi) {
+			cerr << "Cannot find plugin '" << settings.plugin << "'\n";
+			return false;
+		}
+	}
+
+	RouteList busses;
+	if (settings.busses > 0) {
+		busses = s->new_audio_route (2, 2, 0, settings.busses, "Bus", PresentationInfo::AudioBus, PresentationInfo::max_order);
+		if (busses.size () != settings.busses) {
+			cerr << "Cannot create busses\n";
+			return false;
+		}
+	}
+
+	list<std::shared_ptr<AudioTrack> > tracks;
+	if (settings.tracks > 0) {
+		tracks = s->new_audio_track (1, 2, 0, settings.tracks, "Audio", PresentationInfo::max_order, Normal, false);
+		if (tracks.size () != settings.tracks) {
+			cerr << "Cannot create tracks\n";
+			return false;
+		}
+	}
+
+	RouteList::const_iterator b = busses.begin ();
+	for (list<std::shared_ptr<AudioTrack> >::const_iterator t = tracks.begin (); t != tracks.end (); ++t) {
+
+		for (uint32_t p = 0; p < settings.plugins; ++p) {
+			std::shared_ptr<Plugin> plugin = pi->load (*s);
+			if (!plugin) {
+				cerr << "Cannot instantiate plugin '" << settings.plugin << "'\n";
+				return false;
+			}
+			std::shared_ptr<Processor> proc (new PluginInsert (*s, **t, plugin));
+			(*t)->add_processor (proc, PreFader);
+		}
+
+		/* feed busses round-robin */
+		if (b != busses.end ()) {
+			(*t)->add_aux_send (*b, std::shared_ptr<Processor> ());
+			if (++b == busses.end ()) {
+				b = busses.begin ();
+			}
+		}
+
+		if (settings.regions > 0) {
+			std::shared_ptr<Region> whole = synth_region (s, (*t)->name ());
+			if (!whole) {
+				cerr << "Cannot create audio data for '" << (*t)->name () << "'\n";
+				return false;
+			}
+			std::shared_ptr<Playlist> pl = (*t)->playlist ();
+			for (uint32_t r = 0; r < settings.regions; ++r) {
+				PropertyList plist;
+				plist.add (Properties::whole_file, false);
+				std::shared_ptr<Region> copy (RegionFactory::create (whole, plist));
+				pl->add_region (copy, timepos_t (whole->length_samples () * r));
+			}
+		}
+	}
+
+	return true;
+}
+
+static int64_t
+max_rss_kb ()
+{
+#ifndef PLATFORM_WINDOWS
+	struct rusage ru;
+	if (getrusage (RUSAGE_SELF, &ru) == 0) {
+#ifdef __APPLE__
+		return ru.ru_maxrss / 1024;
+#else
+		return ru.ru_maxrss;
+#endif
+	}
+#endif
+	return -1;
+}
+
+static PBD::microseconds_t
+percentile (std::vector<PBD::microseconds_t> const& sorted, double p)
+{
+	if (sorted.empty ()) {
+		return 0;
+	}
+	size_t const i = std::min (sorted.size () - 1, (size_t) (p * sorted.size ()));
+	return sorted[i];
+}
+
+static void
+drain (PBD::RingBuffer<PBD::microseconds_t>& rb, std::vector<PBD::microseconds_t>* cycles)
+{
+	PBD::microseconds_t buf[256];
+	size_t              n;
+	while ((n = rb.read (buf, 256)) > 0) {
+		if (cycles) {
+			cycles->insert (cycles->end (), buf, buf + n);
+		}
+	}
+}
+
+static void usage ()
+{
+	// help2man compatible format (standard GNU help-text)
+	printf (UTILNAME " - measure the DSP performance of a session.\n\n");
+	printf ("Usage: " UTILNAME " [ OPTIONS ] [<session-dir> <session/snapshot-name>]\n\n");
+	printf ("Options:\n\
+  -b, --busses <num>         synthesize <num> stereo busses\n\
+  -d, --duration <sec>       measure for <sec> seconds (default 10)\n\
+  -f, --freewheel            process as fast as possible\n\
+  -h, --help                 display this help and exit\n\
+  -o, --output <file>        write the JSON report to <file>\n\
+  -p, --plugins <num>        add <num> plugins to every synthesized track\n\
+  -P, --plugin <uri>         plugin to use (default urn:ardour:a-eq)\n\
+  -r, --regions <num>        add <num> regions to every synthesized track\n\
+  -s, --samplerate <rate>    samplerate of a synthesized session (default 48000)\n\
+  -t, --tracks <num>         synthesize <num> mono tracks\n\
+  -V, --version              print version information and exit\n\
+  -w, --warmup <sec>         roll for <sec> seconds before measuring (default 2)\n\
+\n");
+	printf ("\n\
+This tool runs an Ardour session on the Dummy backend and reports the\n\
+process time of every engine cycle as JSON (percentiles in microseconds),\n\
+along with the number of xruns and late cycles (process time exceeding the\n\
+nominal period), the duration of butler refill passes and the peak resident\n\
+memory of the process.\n\
+\n\
+If no session is given, a new session is created in a temporary folder,\n\
+and populated with the given number of tracks, busses, plugins and regions.\n\
+Tracks are connected to the busses using aux-sends.\n\
+\n\
+By default the session is processed in realtime. With --freewheel cycles\n\
+are processed back to back.\n\
+\n\
+Note: the tool expects a session-name without .ardour file-name extension.\n\
+\n");
+
+	printf ("Report bugs to <https://tracker.ardour.org/>\n"
+	        "Website: <https://ardour.org/>\n");
+	::exit (EXIT_SUCCESS);
+}
+
+int main (int argc, char* argv[])
+{
+	SynthSettings settings;
+	std::string   outfile;
+	int           duration   = 10;
+	int           warmup     = 2;
+	int           samplerate = 48000;
+	bool          freewheel  = false;
+
+	const char *optstring = "b:d:fho:p:P:r:s:t:Vw:";
+
+	const struct option longopts[] = {
+		{ "busses",     1, 0, 'b' },
+		{ "duration",   1, 0, 'd' },
+		{ "freewheel",  0, 0, 'f' },
+		{ "help",       0, 0, 'h' },
+		{ "output",     1, 0, 'o' },
+		{ "plugins",    1, 0, 'p' },
+		{ "plugin",     1, 0, 'P' },
+		{ "regions",    1, 0, 'r' },
+		{ "samplerate", 1, 0, 's' },
+		{ "tracks",     1, 0, 't' },
+		{ "version",    0, 0, 'V' },
+		{ "warmup",     1, 0, 'w' },
+	};
+
+	int c = 0;
+	while (EOF != (c = getopt_long (argc, argv,
+					optstring, longopts, (int *) 0))) {
+		switch (c) {
+
+			case 'b':
+				settings.busses = atoi (optarg);
+				break;
+
+			case 'd':
+				duration = std::max (1, atoi (optarg));
+				break;
+
+			case 'f':
+				freewheel = true;
+				break;
+
+			case 'o':
+				outfile = optarg;
+				break;
+
+			case 'p':
+				settings.plugins = atoi (optarg);
+				break;
+
+			case 'P':
+				settings.plugin = optarg;
+				break;
+
+			case 'r':
+				settings.regions = atoi (optarg);
+				break;
+
+			case 's':
+				samplerate = atoi (optarg);
+				if (samplerate < 8000 || samplerate > 192000) {
+					cerr << "Error: Invalid Samplerate\n";
+					::exit (EXIT_FAILURE);
+				}
+				break;
+
+			case 't':
+				settings.tracks = atoi (optarg);
+				break;
+
+			case 'V':
+				printf ("ardour-utils version %s\n\n", VERSIONSTRING);
+				printf ("Copyright (C) GPL 2015,2017 Robin Gareus <robin@gareus.org>\n");
+				exit (EXIT_SUCCESS);
+				break;
+
+			case 'w':
+				warmup = std::max (0, atoi (optarg));
+				break;
+
+			case 'h':
+				usage ();
+				break;
+
+			default:
+				cerr << "Error: unrecognized option. See --help for usage information.\n";
+				::exit (EXIT_FAILURE);
+				break;
+		}
+	}
+
+	bool const synthesize = optind == argc;
+
+	if (!synthesize && optind + 2 != argc) {
+		cerr << "Error: Missing parameter. See --help for usage information.\n";
+		::exit (EXIT_FAILURE);
+	}
+
+	SessionUtils::init (false);
+	Session* s = 0;
+
+	std::string session_dir;
+
+	if (synthesize) {
+		gchar* tmp = g_dir_make_tmp ("ardour-benchmark-XXXXXX", NULL);
+		if (!tmp) {
+			cerr << "Error: Cannot create temporary folder.\n";
+			::exit (EXIT_FAILURE);
+		}
+		session_dir = Glib::build_filename (tmp, "benchmark");
+		g_free (tmp);
+
+		s = SessionUtils::create_session (session_dir, "benchmark", samplerate);
+		if (!s) {
+			cerr << "Error: Cannot create session.\n";
+			SessionUtils::cleanup ();
+			::exit (EXIT_FAILURE);
+		}
+		if (!synth_session (s, settings)) {
+			SessionUtils::unload_session (s);
+			SessionUtils::cleanup ();
+			::exit (EXIT_FAILURE);
+		}
+	} else {
+		session_dir = argv[optind];
+		s = SessionUtils::load_session (argv[optind], argv[optind + 1]);
+	}
+
+	AudioEngine* engine = AudioEngine::instance ();
+
+	PBD::ScopedConnection xrun_connection;
+	engine->Xrun.connect_same_thread (xrun_connection, &count_xrun);
+
+	PBD::RingBuffer<PBD::microseconds_t> rb (16384);
+
+	Config->set_stop_at_session_end (false);
+	s->request_roll ();
+
+	if (freewheel) {
+		engine->freewheel (true);
+	}
+
+	engine->set_cycle_time_log (&rb);
+
+	/* warm up, caches, butler */
+	for (int i = 0; i < warmup * 100; ++i) {
+		Glib::usleep (10000);
+		drain (rb, 0);
+	}
+
+	xrun_count.store (0);
+	s->butler ()->refill_stats.queue_reset ();
+
+	std::vector<PBD::microseconds_t> cycles;
+	cycles.reserve (duration * (samplerate / 32));
+
+	for (int i = 0; i < duration * 100; ++i) {
+		Glib::usleep (10000);
+		drain (rb, &cycles);
+	}
+
+	engine->set_cycle_time_log (0);
+	/* the process thread may still hold a pointer to the buffer */
+	Glib::usleep (100000);
+	drain (rb, &cycles);
+
+	uint32_t const xruns = xrun_count.load ();
+
+	if (freewheel) {
+		engine->freewheel (false);
+	}
+	s->request_stop ();
+
+	/* collect results */
+	std::shared_ptr<RouteList const> rl = s->get_routes ();
+	uint32_t n_tracks = 0;
+	uint32_t n_busses = 0;
+	for (RouteList::const_iterator r = rl->begin (); r != rl->end (); ++r) {
+		if ((*r)->is_singleton ()) {
+			continue;
+		}
+		if (std::dynamic_pointer_cast<Track> (*r)) {
+			++n_tracks;
+		} else {
+			++n_busses;
+		}
+	}
+
+	pframes_t const           period    = engine->samples_per_cycle ();
+	PBD::microseconds_t const period_us = 1e6 * period / engine->sample_rate ();
+
+	std::vector<PBD::microseconds_t> sorted (cycles);
+	std::sort (sorted.begin (), sorted.end ());
+
+	uint64_t late = 0;
+	double   sum  = 0;
+	for (std::vector<PBD::microseconds_t>::const_iterator i = cycles.begin (); i != cycles.end (); ++i) {
+		sum += *i;
+		if (*i > period_us) {
+			++late;
+		}
+	}
+
+	PBD::microseconds_t refill_min, refill_max;
+	double              refill_avg, refill_dev;
+	if (!s->butler ()->refill_stats.get_stats (refill_min, refill_max, refill_avg, refill_dev)) {
+		refill_min = refill_max = 0;
+		refill_avg = refill_dev = 0;
+	}
+
+	FILE* f = stdout;
+	if (!outfile.empty ()) {
+		f = g_fopen (outfile.c_str (), "w");
+		if (!f) {
+			cerr << "Error: Cannot write to '" << outfile << "'\n";
+			f = stdout;
+		}
+	}
+
+	gchar* session_json = g_strescape (session_dir.c_str (), NULL);
+
+	fprintf (f, "{\n");
+	fprintf (f, "  \"session\": \"%s\",\n", session_json);
+	fprintf (f, "  \"mode\": \"%s\",\n", freewheel ? "freewheel" : "realtime");
+	fprintf (f, "  \"samplerate\": %d,\n", (int) engine->sample_rate ());
+	fprintf (f, "  \"period\": %u,\n", (unsigned) period);
+	fprintf (f, "  \"period_us\": %lld,\n", (long long) period_us);
+	fprintf (f, "  \"tracks\": %u,\n", n_tracks);
+	fprintf (f, "  \"busses\": %u,\n", n_busses);
+	fprintf (f, "  \"cycles\": %lu,\n", (unsigned long) cycles.size ());
+	fprintf (f, "  \"process_us\": { \"avg\": %.1f, \"p50\": %lld, \"p99\": %lld, \"p99.9\": %lld, \"max\": %lld },\n",
+	         cycles.empty () ? 0. : sum / cycles.size (),
+	         (long long) percentile (sorted, .5),
+	         (long long) percentile (sorted, .99),
+	         (long long) percentile (sorted, .999),
+	         (long long) (sorted.empty () ? 0 : sorted.back ()));
+	fprintf (f, "  \"late_cycles\": %llu,\n", (unsigned long long) late);
+	fprintf (f, "  \"xruns\": %u,\n", xruns);
+	fprintf (f, "  \"butler_refill_us\": { \"min\": %lld, \"avg\": %.1f, \"max\": %lld },\n",
+	         (long long) refill_min, refill_avg, (long long) refill_max);
+	fprintf (f, "  \"max_rss_kb\": %lld\n", (long long) max_rss_kb ());
+	fprintf (f, "}\n");
+
+	g_free (session_json);
+
+	if (f != stdout) {
+		fclose (f);
+	}
+
+	xrun_connection.disconnect ();
+
+	SessionUtils::unload_session (s);
+
+	if (synthesize) {
+		PBD::remove_directory (Glib::path_get_dirname (session_dir));
+	}
+
+	SessionUtils::cleanup ();
+
+	return 0;
+}
@@ -16,7 +16,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
-import { Message } from './protocol.js';
+import { Message, StateNode } from './protocol.js';
 
 export default class MessageChannel {
 
@@ -29,23 +29,29 @@ export default class MessageChannel {
 	async open () {
 		return new Promise((resolve, reject) => {
 			this._socket = new WebSocket(`ws://${this._host}`);
+			this._socket.binaryType = 'arraybuffer';
 
 			this._socket.onclose = () => this.onClose();
 
 			this._socket.onerror = (error) => this.onError(error);
 
 			this._socket.onmessage = (event) => {
-				const msg = Message.fromJsonText(event.data);
-
-				if (this._pending && (this._pending.nodeAddrId == msg.nodeAddrId)) {
-					this._pending.resolve(msg);
-					this._pending = null;
-				} else {
-					this.onMessage(msg, true);
+				for (const msg of Message.fromFrame(event.data)) {
+					if (this._pending && (this._pending.nodeAddrId == msg.nodeAddrId)) {
+						this._pending.resolve(msg);
+						this._pending = null;
+					} else {
+						this.onMessage(msg, true);
+					}
 				}
 			};
 
-			this._socket.onopen = resolve;
+			this._socket.onopen = () => {
+				// receive coalesced feedback as batches and meters in binary form
+				const features = new Message(StateNode.CLIENT_FEATURES, [], ['batch', 'binary_meter']);
+				this._socket.send(features.toJsonText());
+				resolve();
+			};
 		});
 	}
 
@@ -31,7 +31,13 @@ export const StateNode = Object.freeze({
 	TRANSPORT_TEMPO                : 'transport_tempo',
 	TRANSPORT_TIME                 : 'transport_time',
 	TRANSPORT_ROLL                 : 'transport_roll',
-	TRANSPORT_RECORD               : 'transport_record'
+	TRANSPORT_RECORD               : 'transport_record',
+	CLIENT_FEATURES                : 'client_features'
+});
+
+// binary frame types, see NodeStateMessage::serialize_meters()
+const BinaryFrameType = Object.freeze({
+	STRIP_METERS : 1
 });
 
 export class Message {
@@ -61,6 +67,36 @@ export class Message {
 		return new Message(rawMsg.node, rawMsg.addr || [], rawMsg.val);
 	}
 
+	// a frame contains a single message, a JSON array of messages,
+	// or binary encoded meter values
+	static fromFrame (data) {
+		if (data instanceof ArrayBuffer) {
+			return Message.fromBinaryFrame(data);
+		}
+
+		let raw = JSON.parse(data);
+
+		if (!Array.isArray(raw)) {
+			raw = [raw];
+		}
+
+		return raw.map((rawMsg) => new Message(rawMsg.node, rawMsg.addr || [], rawMsg.val));
+	}
+
+	static fromBinaryFrame (buffer) {
+		const view = new DataView(buffer);
+		const messages = [];
+
+		if (view.getUint32(0, true) == BinaryFrameType.STRIP_METERS) {
+			for (let offset = 4; offset + 8 <= buffer.byteLength; offset += 8) {
+				messages.push(new Message(StateNode.STRIP_METER,
+					[view.getUint32(offset, true)], [view.getFloat32(offset + 4, true)]));
+			}
+		}
+
+		return messages;
+	}
+
 	toJsonText () {
 		let val = [];
 